@@ -3,6 +3,10 @@
         {
             "target_name": "irsdk_node",
             "sources": [],
+            "variables": {
+                # IRSDK_ALLOC_STATS=1 counts native allocations, see alloc_stats.h
+                "alloc_stats%": "<!(node -p \"process.env.IRSDK_ALLOC_STATS === '1' ? 1 : 0\")",
+            },
             "defines": [
                 "NAPI_DISABLE_CPP_EXCEPTIONS",
             ],
@@ -10,11 +14,43 @@
                 "<!(node -p \"require('node-addon-api').include_dir\")",
             ],
             "conditions": [
+                [
+                    "alloc_stats==1",
+                    {
+                        "defines": ["IRSDK_ALLOC_STATS"],
+                    },
+                ],
                 [
                     "OS=='win'",
                     {
                         "sources": [
                             "src/app/irsdk/native/irsdk_node.cc",
+                            "src/app/irsdk/native/car_table.cc",
+                            "src/app/irsdk/native/session_tables.cc",
+                            "src/app/irsdk/native/known_vars.cc",
+                            "src/app/irsdk/native/lap_timing.cc",
+                            "src/app/irsdk/native/lap_delta.cc",
+                            "src/app/irsdk/native/event_detector.cc",
+                            "src/app/irsdk/native/trigger_set.cc",
+                            "src/app/irsdk/native/telemetry_history.cc",
+                            "src/app/irsdk/native/sub_tick_stream.cc",
+                            "src/app/irsdk/native/frame_encoder.cc",
+                            "src/app/irsdk/native/frame_ring.cc",
+                            "src/app/irsdk/native/frame_reader_node.cc",
+                            "src/app/irsdk/native/recording_codec.cc",
+                            "src/app/irsdk/native/recording_reader_node.cc",
+                            "src/app/irsdk/native/connection_watcher.cc",
+                            "src/app/irsdk/native/connection_watcher_node.cc",
+                            "src/app/irsdk/native/shared_memory.cc",
+                            "src/app/irsdk/native/session_scan.cc",
+                            "src/app/irsdk/native/session_json.cc",
+                            "src/app/irsdk/native/session_worker.cc",
+                            "src/app/irsdk/native/sdk_context.cc",
+                            "src/app/irsdk/native/replay_context.cc",
+                            "src/app/irsdk/native/telemetry_source.cc",
+                            "src/app/irsdk/native/trace.cc",
+                            "src/app/irsdk/native/alloc_stats.cc",
+                            "src/app/irsdk/native/sim_producer.cc",
                             "src/app/irsdk/native/lib/irsdk_utils.cpp",
                             "src/app/irsdk/native/lib/yaml_parser.cpp",
                             "src/app/irsdk/native/lib/irsdk_defines.h",
@@ -22,6 +58,157 @@
                     },
                 ]
             ],
+        },
+        {
+            "target_name": "irsdk_relay",
+            "type": "executable",
+            "sources": [
+                "src/app/irsdk/native/relay_main.cc",
+                "src/app/irsdk/native/relay_server.cc",
+                "src/app/irsdk/native/telemetry_source.cc",
+                "src/app/irsdk/native/trace.cc",
+                "src/app/irsdk/native/frame_ring.cc",
+                "src/app/irsdk/native/shared_memory.cc",
+            ],
+            "conditions": [
+                [
+                    "OS=='linux'",
+                    {
+                        "libraries": ["-lrt", "-lpthread"],
+                    },
+                ]
+            ],
+        },
+        {
+            "target_name": "irsdk_context_bench",
+            "type": "executable",
+            "sources": [
+                "src/app/irsdk/native/context_bench_main.cc",
+                "src/app/irsdk/native/sdk_context.cc",
+                "src/app/irsdk/native/telemetry_source.cc",
+                "src/app/irsdk/native/trace.cc",
+                "src/app/irsdk/native/sim_producer.cc",
+                "src/app/irsdk/native/shared_memory.cc",
+            ],
+            "conditions": [
+                [
+                    "OS=='linux'",
+                    {
+                        "libraries": ["-lrt", "-lpthread"],
+                    },
+                ]
+            ],
+        },
+        {
+            "target_name": "irsdk_sim_producer",
+            "type": "executable",
+            "sources": [
+                "src/app/irsdk/native/sim_producer_main.cc",
+                "src/app/irsdk/native/sim_producer.cc",
+                "src/app/irsdk/native/shared_memory.cc",
+            ],
+            "conditions": [
+                [
+                    "OS=='linux'",
+                    {
+                        "libraries": ["-lrt", "-lpthread"],
+                    },
+                ]
+            ],
+        },
+        {
+            "target_name": "irsdk_alloc_test",
+            "type": "executable",
+            "defines": [
+                "IRSDK_ALLOC_STATS",
+            ],
+            "sources": [
+                "src/app/irsdk/native/alloc_test_main.cc",
+                "src/app/irsdk/native/alloc_stats.cc",
+                "src/app/irsdk/native/sdk_context.cc",
+                "src/app/irsdk/native/telemetry_source.cc",
+                "src/app/irsdk/native/trace.cc",
+                "src/app/irsdk/native/sim_producer.cc",
+                "src/app/irsdk/native/shared_memory.cc",
+                "src/app/irsdk/native/car_table.cc",
+                "src/app/irsdk/native/known_vars.cc",
+                "src/app/irsdk/native/lap_timing.cc",
+                "src/app/irsdk/native/lap_delta.cc",
+                "src/app/irsdk/native/event_detector.cc",
+                "src/app/irsdk/native/trigger_set.cc",
+                "src/app/irsdk/native/telemetry_history.cc",
+                "src/app/irsdk/native/sub_tick_stream.cc",
+                "src/app/irsdk/native/frame_encoder.cc",
+                "src/app/irsdk/native/frame_ring.cc",
+                "src/app/irsdk/native/recording_codec.cc",
+                "src/app/irsdk/native/session_scan.cc",
+            ],
+            "conditions": [
+                [
+                    "OS=='linux'",
+                    {
+                        "libraries": ["-lrt", "-lpthread"],
+                    },
+                ]
+            ],
+        },
+        {
+            "target_name": "irsdk_recording_test",
+            "type": "executable",
+            "sources": [
+                "src/app/irsdk/native/recording_test_main.cc",
+                "src/app/irsdk/native/recording_codec.cc",
+                "src/app/irsdk/native/replay_context.cc",
+                "src/app/irsdk/native/sdk_context.cc",
+                "src/app/irsdk/native/telemetry_source.cc",
+                "src/app/irsdk/native/trace.cc",
+                "src/app/irsdk/native/sim_producer.cc",
+                "src/app/irsdk/native/shared_memory.cc",
+            ],
+            "conditions": [
+                [
+                    "OS=='linux'",
+                    {
+                        "libraries": ["-lrt", "-lpthread"],
+                    },
+                ]
+            ],
+        },
+        {
+            "target_name": "irsdk_trigger_test",
+            "type": "executable",
+            "sources": [
+                "src/app/irsdk/native/trigger_test_main.cc",
+                "src/app/irsdk/native/trigger_set.cc",
+            ],
+        },
+        {
+            "target_name": "irsdk_replay_bench",
+            "type": "executable",
+            "sources": [
+                "src/app/irsdk/native/replay_bench_main.cc",
+                "src/app/irsdk/native/replay_context.cc",
+                "src/app/irsdk/native/sdk_context.cc",
+                "src/app/irsdk/native/recording_codec.cc",
+                "src/app/irsdk/native/telemetry_source.cc",
+                "src/app/irsdk/native/trace.cc",
+                "src/app/irsdk/native/sim_producer.cc",
+                "src/app/irsdk/native/shared_memory.cc",
+                "src/app/irsdk/native/event_detector.cc",
+                "src/app/irsdk/native/lap_timing.cc",
+                "src/app/irsdk/native/known_vars.cc",
+                "src/app/irsdk/native/session_scan.cc",
+                "src/app/irsdk/native/frame_encoder.cc",
+                "src/app/irsdk/native/frame_ring.cc",
+            ],
+            "conditions": [
+                [
+                    "OS=='linux'",
+                    {
+                        "libraries": ["-lrt", "-lpthread"],
+                    },
+                ]
+            ],
         }
     ]
 }
@@ -19,9 +19,12 @@ export async function dumpCurrentTelemetry() {
     if (sdk.waitForData(1000)) {
       const telemetry = JSON.stringify(sdk.getTelemetry(), null, 2);
       const session = JSON.stringify(sdk.getSessionData(), null, 2);
+      // Native spans are process wide, so this holds the bridge's recent frames
+      const trace = sdk.dumpTrace();
       await Promise.all([
         await writeFile(`${dirPath}/telemetry.json`, telemetry, 'utf-8'),
         await writeFile(`${dirPath}/session.json`, session, 'utf-8'),
+        await writeFile(`${dirPath}/native-trace.json`, trace, 'utf-8'),
       ]);
       console.log(`Saved to: ${dirPath}`);
       return { dirPath };
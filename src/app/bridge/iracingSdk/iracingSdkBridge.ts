@@ -1,41 +1,98 @@
 import { IRacingSDK } from '../../irsdk';
 import { TelemetrySink } from './telemetrySink';
+import { telemetryStreams } from './telemetryStreams';
 import { OverlayManager } from '../../overlayManager';
-import type { IrSdkBridge, Session, Telemetry } from '@irdashies/types';
+import type { IrSdkBridge, Session, SubTickSamples, Telemetry, TelemetryEvent } from '@irdashies/types';
+import type { ConnectionState, SdkSource } from '../../irsdk/types';
 
 const TIMEOUT = 1000;
 
+/**
+ * @param source Read another source than the sim, e.g. a replay of a recorded session.
+ * Overlays see it exactly like the sim, and it counts as connected until it ends.
+ */
 export async function publishIRacingSDKEvents(
   telemetrySink: TelemetrySink,
-  overlayManager: OverlayManager
+  overlayManager: OverlayManager,
+  source?: SdkSource
 ): Promise<IrSdkBridge> {
   console.log('Loading iRacing SDK bridge...');
 
   let shouldStop = false;
-  const runningStateInterval = setInterval(async () => {
-    const isSimRunning = await IRacingSDK.IsSimRunning();
-    console.log('Sending running state to window', isSimRunning);
-    overlayManager.publishMessage('runningState', isSimRunning);
+  let connection: ConnectionState = source ? 'connected' : 'absent';
+  let onConnectionChange: (() => void) | null = null;
+
+  // The native watcher reports the sim coming and going, nothing polls for it
+  const stopWatching = source
+    ? () => undefined
+    : await IRacingSDK.WatchConnection((state) => {
+        console.log('iRacing connection state', state);
+        connection = state;
+        overlayManager.publishMessage('runningState', state !== 'absent');
+        onConnectionChange?.();
+      });
+  const connectionChange = () =>
+    new Promise<void>((resolve) => {
+      onConnectionChange = resolve;
+    });
+
+  // Windows opened since the last change still need to hear the state
+  const runningStateInterval = setInterval(() => {
+    overlayManager.publishMessage('runningState', connection !== 'absent');
   }, 2000);
 
   // Start the telemetry loop in the background
   (async () => {
     while (!shouldStop) {
-      if (await IRacingSDK.IsSimRunning()) {
+      if (connection === 'connected') {
         console.log('iRacing is running');
-        const sdk = new IRacingSDK();
+        const sdk = new IRacingSDK(source);
         sdk.autoEnableTelemetry = true;
+        // Every consumer below serializes the frame before the next one is read
+        sdk.reuseTelemetry = true;
 
         await sdk.ready();
+        // IRDASHIES_NATIVE_TRACE=1 keeps native spans, saved along with a telemetry dump (F7)
+        if (process.env.IRDASHIES_NATIVE_TRACE) {
+          sdk.setTracing(true);
+        }
+
+        // Frames go to the overlays through shared memory when possible, so the
+        // main process serializes nothing per overlay window
+        const sharedFrames = sdk.startFramePublisher();
+        let subTickRow = 0;
 
         while (!shouldStop && sdk.waitForData(TIMEOUT)) {
           const telemetry = sdk.getTelemetry();
           const session = sdk.getSessionData();
+          const events = sdk.getEvents();
           await new Promise((resolve) => setTimeout(resolve, 1000 / 60));
 
-          if (telemetry) {
+          if (sharedFrames) {
+            overlayManager.publishMessage('frameReady', sdk.getPublishedFrame());
+          } else if (telemetry) {
             overlayManager.publishMessage('telemetry', telemetry);
-            telemetrySink.addTelemetry(telemetry);
+          }
+
+          if (telemetry) {
+            telemetrySink.recordLines(sdk);
+          }
+
+          // Binary frames for the OBS widgets, encoded natively per client
+          if (telemetryStreams.size) {
+            telemetryStreams.publish(sdk);
+          }
+
+          // 360Hz input traces, a handful of rows per line
+          const subTick = sdk.getSubTickSamples(subTickRow);
+          subTickRow = subTick.next;
+          if (subTick.time.length) {
+            overlayManager.publishMessage('subTickSamples', subTick);
+          }
+
+          // Low volume channel, only sent when something actually changed
+          if (events.length) {
+            overlayManager.publishMessage('events', events);
           }
 
           if (session) {
@@ -44,12 +101,17 @@ export async function publishIRacingSDKEvents(
           }
         }
 
+        sdk.stopFramePublisher();
         console.log('iRacing is no longer publishing telemetry');
+        if (source) {
+          // A replay that ended doesn't come back
+          connection = 'absent';
+          overlayManager.publishMessage('runningState', false);
+        }
+        await new Promise((resolve) => setTimeout(resolve, TIMEOUT));
       } else {
-        console.log('iRacing is not running');
+        await connectionChange();
       }
-
-      await new Promise((resolve) => setTimeout(resolve, TIMEOUT));
     }
   })();
 
@@ -57,9 +119,14 @@ export async function publishIRacingSDKEvents(
     onTelemetry: (callback: (value: Telemetry) => void) => callback({} as Telemetry),
     onSessionData: (callback: (value: Session) => void) => callback({} as Session),
     onRunningState: (callback: (value: boolean) => void) => callback(false),
+    onEvents: (callback: (value: TelemetryEvent[]) => void) => callback([]),
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    onSubTickSamples: (_callback: (value: SubTickSamples) => void) => undefined,
     stop: () => {
       shouldStop = true;
       clearInterval(runningStateInterval);
+      stopWatching();
+      onConnectionChange?.();
     }
   };
 }
@@ -1,4 +1,10 @@
-import type { Session, Telemetry, IrSdkBridge } from '@irdashies/types';
+import type {
+  Session,
+  Telemetry,
+  TelemetryEvent,
+  SubTickSamples,
+  IrSdkBridge,
+} from '@irdashies/types';
 import mockTelemetry from './telemetry.json';
 import mockSessionInfo from './session.json';
 
@@ -92,6 +98,14 @@ export function generateMockData(sessionData?: {
         callback(true);
       }, 1000);
     },
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    onEvents: (_callback: (value: TelemetryEvent[]) => void) => {
+      // Recorded mock data has no event stream
+    },
+    // eslint-disable-next-line @typescript-eslint/no-unused-vars
+    onSubTickSamples: (_callback: (value: SubTickSamples) => void) => {
+      // Nor sub tick rows
+    },
     stop: () => {
       clearInterval(telemetryInterval);
       clearInterval(sessionInfoInterval);
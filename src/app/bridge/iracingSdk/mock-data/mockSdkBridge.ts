@@ -13,10 +13,12 @@ export async function publishIRacingSDKEvents(
   });
   bridge.onTelemetry((telemetry) => {
     overlayManager.publishMessage('telemetry', telemetry);
-    telemetrySink.addTelemetry(telemetry);
   });
   bridge.onRunningState((running) => {
     overlayManager.publishMessage('runningState', running);
   });
+  bridge.onEvents((events) => {
+    overlayManager.publishMessage('events', events);
+  });
   return bridge;
 }
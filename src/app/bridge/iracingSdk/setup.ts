@@ -36,6 +36,21 @@ async function setupBridge(
       currentBridge = undefined;
     }
 
+    // IRDASHIES_REPLAY=<.ibt or recording> plays a recorded session to the
+    // overlays in place of the sim, IRDASHIES_REPLAY_SPEED sets its pace
+    const replay = process.env.IRDASHIES_REPLAY;
+    if (replay && !isDemoMode && process.platform === 'win32') {
+      const { publishIRacingSDKEvents } = await import('./iracingSdkBridge');
+      const speed = Number(process.env.IRDASHIES_REPLAY_SPEED ?? 1);
+      currentBridge = await publishIRacingSDKEvents(telemetrySink, overlayManager, {
+        source: 'replay',
+        path: replay,
+        speed: Number.isFinite(speed) ? speed : 1,
+        loop: true,
+      });
+      return;
+    }
+
     const module =
       isDemoMode || process.platform !== 'win32'
         ? await import('./mock-data/mockSdkBridge')
@@ -0,0 +1,69 @@
+import type { Telemetry } from '@irdashies/types';
+import type { FrameVar } from '../../irsdk/types';
+import type { FrameReader } from '../../irsdk/native';
+import { decodeTelemetryFrame, decodeTelemetryVar } from '../../irsdk/node/utils/decode-frame';
+
+export interface SharedTelemetryReader {
+  /**
+   * Decodes the newest frame, or returns null when there is none (not published
+   * yet, already read, or the native reader isn't available).
+   */
+  read: () => Telemetry | null;
+  /** Decodes one var of the frame `read` last returned, for vars it left out. */
+  readVar: (name: string) => Telemetry[keyof Telemetry] | null;
+  /** Only decode these vars in `read`, every var when null. */
+  setVars: (names: ReadonlySet<string> | null) => void;
+}
+
+/**
+ * Creates a reader for the telemetry frames the main process publishes to shared memory.
+ */
+export function createSharedTelemetryReader(): SharedTelemetryReader {
+  let reader: FrameReader | null = null;
+  let vars: FrameVar[] | null = null;
+  let varsByName = new Map<string, FrameVar>();
+  let layout = -1;
+  let names: ReadonlySet<string> | null = null;
+  // The reader's buffer holds the last frame until the next read
+  let lastFrame: DataView | null = null;
+
+  // Only the Windows build ships the native module, and a sandboxed preload
+  // can't load it; those windows get no shared frames
+  if (process.platform === 'win32' && !process.sandboxed) {
+    import('../../irsdk/native')
+      .then(({ FrameReader }) => {
+        reader = new FrameReader();
+      })
+      .catch((err) => {
+        console.error('Failed to load the shared frame reader', err);
+      });
+  }
+
+  return {
+    read: () => {
+      if (!reader) return null;
+      if (!reader.isOpen() && !reader.open()) return null;
+
+      const frame = reader.read();
+      if (!frame) return null;
+
+      if (frame.layout !== layout) {
+        vars = reader.getVars();
+        varsByName = new Map(vars?.map((v) => [v.name, v]));
+        layout = frame.layout;
+      }
+      if (!vars) return null;
+
+      lastFrame = new DataView(frame.buffer);
+      return decodeTelemetryFrame(vars, frame.buffer, names);
+    },
+    readVar: (name) => {
+      const v = varsByName.get(name);
+      if (!v || !lastFrame) return null;
+      return decodeTelemetryVar(v, lastFrame);
+    },
+    setVars: (next) => {
+      names = next;
+    },
+  };
+}
@@ -7,27 +7,40 @@ import { createReadStream, createWriteStream } from 'node:fs';
 import { createBrotliCompress, createBrotliDecompress } from 'zlib';
 import { parser } from 'stream-json';
 import { streamArray } from 'stream-json/streamers/StreamArray';
+import type { IRacingSDK } from '../../irsdk';
+import type { FrameVar } from '../../irsdk/types';
+import { decodeTelemetryFrame } from '../../irsdk/node/utils/decode-frame';
+
+export interface RecordingOptions {
+  /**
+   * Also write telemetry.json once the recording stopped, decoded from the
+   * raw lines. Slow and large, only for tools that need the JSON frames.
+   * @default false
+   */
+  exportJson?: boolean;
+}
 
 export class TelemetrySink {
   private isRecording = false;
   private currentPath = '';
   private sessionEmitter = new EventEmitter();
-  private telemetryEmitter = new EventEmitter();
-  private telemetry: Telemetry[] = [];
   private session: Session[] = [];
+  // Set while the SDK records the raw lines natively, see recordLines
+  private recorder: IRacingSDK | null = null;
 
   constructor() {
     this.sessionEmitter.on('session', (data) => {
       if (!this.isRecording) return;
+      // The SDK hands out the same object until the session changes
+      if (this.session[this.session.length - 1] === data) return;
       this.session.push(data);
     });
-    this.telemetryEmitter.on('telemetry', (data) => {
-      if (!this.isRecording) return;
-      this.telemetry.push(data);
-    });
   }
 
-  async startRecording(timeout = 5000) {
+  async startRecording(
+    timeout = 5000,
+    { exportJson = false }: RecordingOptions = {}
+  ) {
     if (this.isRecording) return;
     console.log('Recording started');
 
@@ -37,7 +50,6 @@ export class TelemetrySink {
     this.currentPath = dirPath;
 
     await mkdir(dirPath);
-    await writeFile(`${dirPath}/telemetry.json`, '', 'utf-8');
     await writeFile(`${dirPath}/session.json`, '', 'utf-8');
 
     this.isRecording = true;
@@ -46,17 +58,33 @@ export class TelemetrySink {
       this.isRecording = false;
       console.log('Recording stopped');
       console.log('Recording Path: ', dirPath);
-      console.log('Telemetry Entries: ', this.telemetry.length);
       console.log('Session Entries: ', this.session.length);
 
-      streamWriteLargeJSONArray(`${dirPath}/telemetry.json`, this.telemetry);
+      if (this.recorder) {
+        console.log('Raw lines: telemetry.irtc');
+        this.recorder.stopRecording();
+        this.recorder = null;
+        if (exportJson) {
+          exportRecordingJson(dirPath).catch((err) =>
+            console.error('Failed to export telemetry.json:', err)
+          );
+        }
+      } else {
+        console.warn('No telemetry recorded, the SDK recorded no lines');
+      }
       streamWriteLargeJSONArray(`${dirPath}/session.json`, this.session);
     }, timeout);
   }
 
-  addTelemetry(data: Telemetry) {
-    if (!this.isRecording || !this.currentPath) return;
-    this.telemetryEmitter.emit('telemetry', data);
+  /**
+   * Let the SDK record every raw line itself, losslessly compressed. This is
+   * the only telemetry the sink keeps, read it back with `readRecording`.
+   */
+  recordLines(sdk: IRacingSDK) {
+    if (!this.isRecording || !this.currentPath || this.recorder) return;
+    if (sdk.startRecording(`${this.currentPath}/telemetry.irtc`)) {
+      this.recorder = sdk;
+    }
   }
 
   addSession(data: Session) {
@@ -117,3 +145,41 @@ export const readBrotliStream = (filePath: string) => {
     pipeline.on('error', (err: unknown) => reject(err));
   });
 };
+
+/**
+ * Reads a recording made through `TelemetrySink.recordLines` back into
+ * telemetry objects. Needs the native module, so Windows only.
+ */
+export const readRecording = async (filePath: string) => {
+  const { RecordingReader } = await import('../../irsdk/native');
+  const reader = new RecordingReader();
+  if (!reader.open(filePath)) {
+    throw new Error(`Failed to open recording: ${filePath}`);
+  }
+
+  const items: Telemetry[] = [];
+  let vars: FrameVar[] | null = null;
+  let layout = -1;
+  try {
+    for (let frame = reader.next(); frame; frame = reader.next()) {
+      if (frame.layout !== layout) {
+        vars = reader.getVars();
+        layout = frame.layout;
+      }
+      if (vars) items.push(decodeTelemetryFrame(vars, frame.buffer));
+    }
+  } finally {
+    reader.close();
+  }
+  return items;
+};
+
+/**
+ * Writes the telemetry of a recording directory as telemetry.json, in the
+ * same compressed JSON array format as session.json.
+ */
+export const exportRecordingJson = async (dirPath: string) => {
+  const telemetry = await readRecording(`${dirPath}/telemetry.irtc`);
+  await streamWriteLargeJSONArray(`${dirPath}/telemetry.json`, telemetry);
+  console.log('Telemetry Entries: ', telemetry.length);
+};
@@ -0,0 +1,87 @@
+import type { IRacingSDK } from '../../irsdk';
+import type { QuantizationProfile } from '../../irsdk/types';
+
+/**
+ * A browser widget subscribed to the binary telemetry stream.
+ */
+export interface TelemetryStreamClient {
+  /** Vars to stream, every var when empty. */
+  vars: string[];
+  /** Only send the vars that changed since the previous frame. */
+  changeBitmap: boolean;
+  /** Float vars to send as fixed point codes, see `OVERLAY_QUANTIZATION`. */
+  quantization?: QuantizationProfile;
+  /** Pack quantized codes to their exact width, on by default. */
+  bitPack?: boolean;
+  /** Returns false once the client is backed up, call `resume` when it drains. */
+  write: (chunk: Buffer) => boolean;
+}
+
+interface ClientState {
+  sdk: IRacingSDK | null;
+  encoderId: number;
+  keyframe: boolean;
+  waiting: boolean;
+}
+
+/**
+ * Fans the current telemetry line out to the widget server's stream clients,
+ * each through its own native frame encoder.
+ */
+export class TelemetryStreams {
+  private clients = new Map<TelemetryStreamClient, ClientState>();
+
+  add(client: TelemetryStreamClient) {
+    this.clients.set(client, { sdk: null, encoderId: -1, keyframe: true, waiting: false });
+  }
+
+  remove(client: TelemetryStreamClient) {
+    const state = this.clients.get(client);
+    state?.sdk?.destroyFrameEncoder(state.encoderId);
+    this.clients.delete(client);
+  }
+
+  /**
+   * The client drained. Frames skipped meanwhile break the change bitmap
+   * chain, so the next one carries every value.
+   */
+  resume(client: TelemetryStreamClient) {
+    const state = this.clients.get(client);
+    if (!state) return;
+    state.waiting = false;
+    state.keyframe = true;
+  }
+
+  get size() {
+    return this.clients.size;
+  }
+
+  /**
+   * Encode the line the SDK last copied for every client that can take it.
+   */
+  publish(sdk: IRacingSDK) {
+    this.clients.forEach((state, client) => {
+      // A new SDK instance means a new connection and a fresh schema
+      if (state.sdk !== sdk) {
+        state.sdk = sdk;
+        state.encoderId = sdk.createFrameEncoder(
+          client.vars,
+          client.changeBitmap,
+          client.quantization,
+          client.bitPack
+        );
+        state.keyframe = true;
+      }
+      if (state.waiting || state.encoderId < 0) return;
+
+      const chunk = sdk.encodeFrame(state.encoderId, state.keyframe);
+      if (!chunk) return;
+      state.keyframe = false;
+      if (!client.write(Buffer.from(chunk))) {
+        state.waiting = true;
+      }
+    });
+  }
+}
+
+export const telemetryStreams = new TelemetryStreams();
@@ -2,18 +2,45 @@ import { contextBridge, ipcRenderer } from 'electron';
 import type {
   Session,
   Telemetry,
+  TelemetryEvent,
+  SubTickSamples,
   IrSdkBridge,
   DashboardBridge,
   DashboardLayout,
 } from '@irdashies/types';
 import type { HttpServerBridge } from './httpServerBridge';
+import { createSharedTelemetryReader } from './iracingSdk/sharedFrames';
+
+function pickTelemetryVars(telemetry: Telemetry, names: ReadonlySet<string>): Telemetry {
+  const picked: Record<string, unknown> = {};
+  names.forEach((name) => {
+    const value = telemetry[name as keyof Telemetry];
+    if (value) picked[name] = value;
+  });
+  return picked as unknown as Telemetry;
+}
 
 export function exposeBridge() {
+  const sharedTelemetry = createSharedTelemetryReader();
+  // Vars the overlay actually reads, every var is sent on while null
+  let hotVars: Set<string> | null = null;
+  // Last full frame that came over IPC, for the vars left out of it
+  let ipcTelemetry: Telemetry | null = null;
+
   contextBridge.exposeInMainWorld('irsdkBridge', {
-    onTelemetry: (callback: (value: Telemetry) => void) =>
-      ipcRenderer.on('telemetry', (_, value) => {
-        callback(value);
-      }),
+    onTelemetry: (callback: (value: Telemetry) => void) => {
+      ipcRenderer.on('telemetry', (_, value: Telemetry) => {
+        ipcTelemetry = value;
+        callback(hotVars ? pickTelemetryVars(value, hotVars) : value);
+      });
+      // Live telemetry arrives through shared memory, IPC only says a frame is ready
+      ipcRenderer.on('frameReady', () => {
+        const telemetry = sharedTelemetry.read();
+        if (!telemetry) return;
+        ipcTelemetry = null;
+        callback(telemetry);
+      });
+    },
     onSessionData: (callback: (value: Session) => void) =>
       ipcRenderer.on('sessionData', (_, value) => {
         callback(value);
@@ -22,10 +49,29 @@ export function exposeBridge() {
       ipcRenderer.on('runningState', (_, value) => {
         callback(value);
       }),
+    onEvents: (callback: (value: TelemetryEvent[]) => void) =>
+      ipcRenderer.on('events', (_, value) => {
+        callback(value);
+      }),
+    onSubTickSamples: (callback: (value: SubTickSamples) => void) =>
+      ipcRenderer.on('subTickSamples', (_, value) => {
+        callback(value);
+      }),
+    setHotTelemetryVars: (names: string[] | null) => {
+      hotVars = names ? new Set(names) : null;
+      sharedTelemetry.setVars(hotVars);
+    },
+    readTelemetryVar: (name: string) => {
+      if (ipcTelemetry) return ipcTelemetry[name as keyof Telemetry] ?? null;
+      return sharedTelemetry.readVar(name);
+    },
     stop: () => {
       ipcRenderer.removeAllListeners('telemetry');
+      ipcRenderer.removeAllListeners('frameReady');
       ipcRenderer.removeAllListeners('sessionData');
       ipcRenderer.removeAllListeners('runningState');
+      ipcRenderer.removeAllListeners('events');
+      ipcRenderer.removeAllListeners('subTickSamples');
     },
   } as IrSdkBridge);
 
@@ -21,6 +21,8 @@ import {
   WIDGET_DESCRIPTIONS,
   VALID_WIDGET_TYPES,
 } from '../types/httpServer';
+import { telemetryStreams } from './bridge/iracingSdk/telemetryStreams';
+import { OVERLAY_QUANTIZATION } from './irsdk/types';
 
 /**
  * Environment detection utilities
@@ -663,6 +665,42 @@ export class HttpWidgetServer implements HttpWidgetServer {
       res.json({ status: 'ok', timestamp: new Date().toISOString() });
     });
 
+    // Binary telemetry stream for widgets, decoded by TelemetryStreamDecoder
+    // ?vars=Speed,Gear limits the vars, ?changes=1 only sends changed values,
+    // ?quantize=1 rounds the high rate floats to what overlays need (?pack=0 keeps them byte aligned)
+    this.app.get('/telemetry/stream', (req, res) => {
+      const clientIP = req.ip || req.connection.remoteAddress || 'unknown';
+      const vars = typeof req.query.vars === 'string'
+        ? req.query.vars.split(',').map((name) => name.trim()).filter(Boolean)
+        : [];
+      const changeBitmap = req.query.changes === '1' || req.query.changes === 'true';
+      const quantize = req.query.quantize === '1' || req.query.quantize === 'true';
+      const bitPack = req.query.pack !== '0' && req.query.pack !== 'false';
+
+      logger.info(`Telemetry Stream Opened - Vars: ${vars.length || 'all'}, Changes: ${changeBitmap}, Quantize: ${quantize}, Client: ${clientIP}`);
+
+      res.writeHead(200, {
+        'Content-Type': 'application/octet-stream',
+        'Cache-Control': 'no-cache, no-store, must-revalidate',
+        'X-Content-Type-Options': 'nosniff',
+      });
+      res.flushHeaders();
+
+      const client = {
+        vars,
+        changeBitmap,
+        quantization: quantize ? OVERLAY_QUANTIZATION : undefined,
+        bitPack,
+        write: (chunk: Buffer) => res.write(chunk),
+      };
+      telemetryStreams.add(client);
+      res.on('drain', () => telemetryStreams.resume(client));
+      req.on('close', () => {
+        telemetryStreams.remove(client);
+        logger.info(`Telemetry Stream Closed - Client: ${clientIP}`);
+      });
+    });
+
     // Widget bundle serving endpoint - environment-aware
     this.app.get('/widget.js', async (req, res) => {
       const clientIP = req.ip || req.connection.remoteAddress || 'unknown';
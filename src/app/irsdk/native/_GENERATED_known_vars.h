@@ -0,0 +1,675 @@
+// ! THIS FILE IS AUTO-GENERATED, EDITS WILL BE OVERRIDDEN !
+// ! Make changes to scripts/generate-var-types.js !
+
+#ifndef GENERATED_KNOWN_VARS_H
+#define GENERATED_KNOWN_VARS_H
+
+#include "./lib/irsdk_defines.h"
+
+// The vars the sim had when this was generated, see known_vars.h
+struct KnownVarInfo
+{
+  const char *name;
+  irsdk_VarType type;
+  int count;
+};
+
+enum KnownVar
+{
+  KnownVar_SessionTime,
+  KnownVar_SessionTick,
+  KnownVar_SessionNum,
+  KnownVar_SessionState,
+  KnownVar_SessionUniqueID,
+  KnownVar_SessionFlags,
+  KnownVar_SessionTimeRemain,
+  KnownVar_SessionLapsRemain,
+  KnownVar_SessionLapsRemainEx,
+  KnownVar_SessionTimeTotal,
+  KnownVar_SessionLapsTotal,
+  KnownVar_SessionJokerLapsRemain,
+  KnownVar_SessionOnJokerLap,
+  KnownVar_SessionTimeOfDay,
+  KnownVar_RadioTransmitCarIdx,
+  KnownVar_RadioTransmitRadioIdx,
+  KnownVar_RadioTransmitFrequencyIdx,
+  KnownVar_DisplayUnits,
+  KnownVar_DriverMarker,
+  KnownVar_PushToTalk,
+  KnownVar_PushToPass,
+  KnownVar_ManualBoost,
+  KnownVar_ManualNoBoost,
+  KnownVar_IsOnTrack,
+  KnownVar_IsReplayPlaying,
+  KnownVar_ReplayFrameNum,
+  KnownVar_ReplayFrameNumEnd,
+  KnownVar_IsDiskLoggingEnabled,
+  KnownVar_IsDiskLoggingActive,
+  KnownVar_FrameRate,
+  KnownVar_CpuUsageFG,
+  KnownVar_GpuUsage,
+  KnownVar_ChanAvgLatency,
+  KnownVar_ChanLatency,
+  KnownVar_ChanQuality,
+  KnownVar_ChanPartnerQuality,
+  KnownVar_CpuUsageBG,
+  KnownVar_ChanClockSkew,
+  KnownVar_MemPageFaultSec,
+  KnownVar_MemSoftPageFaultSec,
+  KnownVar_PlayerCarPosition,
+  KnownVar_PlayerCarClassPosition,
+  KnownVar_PlayerCarClass,
+  KnownVar_PlayerTrackSurface,
+  KnownVar_PlayerTrackSurfaceMaterial,
+  KnownVar_PlayerCarIdx,
+  KnownVar_PlayerCarTeamIncidentCount,
+  KnownVar_PlayerCarMyIncidentCount,
+  KnownVar_PlayerCarDriverIncidentCount,
+  KnownVar_PlayerCarWeightPenalty,
+  KnownVar_PlayerCarPowerAdjust,
+  KnownVar_PlayerCarDryTireSetLimit,
+  KnownVar_PlayerCarTowTime,
+  KnownVar_PlayerCarInPitStall,
+  KnownVar_PlayerCarPitSvStatus,
+  KnownVar_PlayerTireCompound,
+  KnownVar_PlayerFastRepairsUsed,
+  KnownVar_CarIdxLap,
+  KnownVar_CarIdxLapCompleted,
+  KnownVar_CarIdxLapDistPct,
+  KnownVar_CarIdxTrackSurface,
+  KnownVar_CarIdxTrackSurfaceMaterial,
+  KnownVar_CarIdxOnPitRoad,
+  KnownVar_CarIdxPosition,
+  KnownVar_CarIdxClassPosition,
+  KnownVar_CarIdxClass,
+  KnownVar_CarIdxF2Time,
+  KnownVar_CarIdxEstTime,
+  KnownVar_CarIdxLastLapTime,
+  KnownVar_CarIdxBestLapTime,
+  KnownVar_CarIdxBestLapNum,
+  KnownVar_CarIdxTireCompound,
+  KnownVar_CarIdxQualTireCompound,
+  KnownVar_CarIdxQualTireCompoundLocked,
+  KnownVar_CarIdxFastRepairsUsed,
+  KnownVar_CarIdxSessionFlags,
+  KnownVar_PaceMode,
+  KnownVar_CarIdxPaceLine,
+  KnownVar_CarIdxPaceRow,
+  KnownVar_CarIdxPaceFlags,
+  KnownVar_OnPitRoad,
+  KnownVar_CarIdxSteer,
+  KnownVar_CarIdxRPM,
+  KnownVar_CarIdxGear,
+  KnownVar_SteeringWheelAngle,
+  KnownVar_Throttle,
+  KnownVar_Brake,
+  KnownVar_Clutch,
+  KnownVar_Gear,
+  KnownVar_RPM,
+  KnownVar_PlayerCarSLFirstRPM,
+  KnownVar_PlayerCarSLShiftRPM,
+  KnownVar_PlayerCarSLLastRPM,
+  KnownVar_PlayerCarSLBlinkRPM,
+  KnownVar_Lap,
+  KnownVar_LapCompleted,
+  KnownVar_LapDist,
+  KnownVar_LapDistPct,
+  KnownVar_RaceLaps,
+  KnownVar_CarDistAhead,
+  KnownVar_CarDistBehind,
+  KnownVar_LapBestLap,
+  KnownVar_LapBestLapTime,
+  KnownVar_LapLastLapTime,
+  KnownVar_LapCurrentLapTime,
+  KnownVar_LapLasNLapSeq,
+  KnownVar_LapLastNLapTime,
+  KnownVar_LapBestNLapLap,
+  KnownVar_LapBestNLapTime,
+  KnownVar_LapDeltaToBestLap,
+  KnownVar_LapDeltaToBestLap_DD,
+  KnownVar_LapDeltaToBestLap_OK,
+  KnownVar_LapDeltaToOptimalLap,
+  KnownVar_LapDeltaToOptimalLap_DD,
+  KnownVar_LapDeltaToOptimalLap_OK,
+  KnownVar_LapDeltaToSessionBestLap,
+  KnownVar_LapDeltaToSessionBestLap_DD,
+  KnownVar_LapDeltaToSessionBestLap_OK,
+  KnownVar_LapDeltaToSessionOptimalLap,
+  KnownVar_LapDeltaToSessionOptimalLap_DD,
+  KnownVar_LapDeltaToSessionOptimalLap_OK,
+  KnownVar_LapDeltaToSessionLastlLap,
+  KnownVar_LapDeltaToSessionLastlLap_DD,
+  KnownVar_LapDeltaToSessionLastlLap_OK,
+  KnownVar_Speed,
+  KnownVar_Yaw,
+  KnownVar_YawNorth,
+  KnownVar_Pitch,
+  KnownVar_Roll,
+  KnownVar_EnterExitReset,
+  KnownVar_TrackTemp,
+  KnownVar_TrackTempCrew,
+  KnownVar_AirTemp,
+  KnownVar_TrackWetness,
+  KnownVar_Skies,
+  KnownVar_AirDensity,
+  KnownVar_AirPressure,
+  KnownVar_WindVel,
+  KnownVar_WindDir,
+  KnownVar_RelativeHumidity,
+  KnownVar_FogLevel,
+  KnownVar_Precipitation,
+  KnownVar_SolarAltitude,
+  KnownVar_SolarAzimuth,
+  KnownVar_WeatherDeclaredWet,
+  KnownVar_DCLapStatus,
+  KnownVar_DCDriversSoFar,
+  KnownVar_OkToReloadTextures,
+  KnownVar_LoadNumTextures,
+  KnownVar_CarLeftRight,
+  KnownVar_PitsOpen,
+  KnownVar_VidCapEnabled,
+  KnownVar_VidCapActive,
+  KnownVar_PitRepairLeft,
+  KnownVar_PitOptRepairLeft,
+  KnownVar_PitstopActive,
+  KnownVar_FastRepairUsed,
+  KnownVar_FastRepairAvailable,
+  KnownVar_LFTiresUsed,
+  KnownVar_RFTiresUsed,
+  KnownVar_LRTiresUsed,
+  KnownVar_RRTiresUsed,
+  KnownVar_LeftTireSetsUsed,
+  KnownVar_RightTireSetsUsed,
+  KnownVar_FrontTireSetsUsed,
+  KnownVar_RearTireSetsUsed,
+  KnownVar_TireSetsUsed,
+  KnownVar_LFTiresAvailable,
+  KnownVar_RFTiresAvailable,
+  KnownVar_LRTiresAvailable,
+  KnownVar_RRTiresAvailable,
+  KnownVar_LeftTireSetsAvailable,
+  KnownVar_RightTireSetsAvailable,
+  KnownVar_FrontTireSetsAvailable,
+  KnownVar_RearTireSetsAvailable,
+  KnownVar_TireSetsAvailable,
+  KnownVar_CamCarIdx,
+  KnownVar_CamCameraNumber,
+  KnownVar_CamGroupNumber,
+  KnownVar_CamCameraState,
+  KnownVar_IsOnTrackCar,
+  KnownVar_IsInGarage,
+  KnownVar_SteeringWheelAngleMax,
+  KnownVar_ShiftPowerPct,
+  KnownVar_ShiftGrindRPM,
+  KnownVar_ThrottleRaw,
+  KnownVar_BrakeRaw,
+  KnownVar_ClutchRaw,
+  KnownVar_HandbrakeRaw,
+  KnownVar_BrakeABSactive,
+  KnownVar_EngineWarnings,
+  KnownVar_FuelLevelPct,
+  KnownVar_PitSvFlags,
+  KnownVar_PitSvLFP,
+  KnownVar_PitSvRFP,
+  KnownVar_PitSvLRP,
+  KnownVar_PitSvRRP,
+  KnownVar_PitSvFuel,
+  KnownVar_PitSvTireCompound,
+  KnownVar_CarIdxP2P_Status,
+  KnownVar_CarIdxP2P_Count,
+  KnownVar_P2P_Status,
+  KnownVar_P2P_Count,
+  KnownVar_SteeringWheelPctTorque,
+  KnownVar_SteeringWheelPctTorqueSign,
+  KnownVar_SteeringWheelPctTorqueSignStops,
+  KnownVar_SteeringWheelPctIntensity,
+  KnownVar_SteeringWheelPctSmoothing,
+  KnownVar_SteeringWheelPctDamper,
+  KnownVar_SteeringWheelLimiter,
+  KnownVar_SteeringWheelMaxForceNm,
+  KnownVar_SteeringWheelPeakForceNm,
+  KnownVar_SteeringWheelUseLinear,
+  KnownVar_ShiftIndicatorPct,
+  KnownVar_ReplayPlaySpeed,
+  KnownVar_ReplayPlaySlowMotion,
+  KnownVar_ReplaySessionTime,
+  KnownVar_ReplaySessionNum,
+  KnownVar_TireLF_RumblePitch,
+  KnownVar_TireRF_RumblePitch,
+  KnownVar_TireLR_RumblePitch,
+  KnownVar_TireRR_RumblePitch,
+  KnownVar_IsGarageVisible,
+  KnownVar_SteeringWheelTorque_ST,
+  KnownVar_SteeringWheelTorque,
+  KnownVar_VelocityZ_ST,
+  KnownVar_VelocityY_ST,
+  KnownVar_VelocityX_ST,
+  KnownVar_VelocityZ,
+  KnownVar_VelocityY,
+  KnownVar_VelocityX,
+  KnownVar_YawRate_ST,
+  KnownVar_PitchRate_ST,
+  KnownVar_RollRate_ST,
+  KnownVar_YawRate,
+  KnownVar_PitchRate,
+  KnownVar_RollRate,
+  KnownVar_VertAccel_ST,
+  KnownVar_LatAccel_ST,
+  KnownVar_LongAccel_ST,
+  KnownVar_VertAccel,
+  KnownVar_LatAccel,
+  KnownVar_LongAccel,
+  KnownVar_dcStarter,
+  KnownVar_dcTractionControlToggle,
+  KnownVar_dcPitSpeedLimiterToggle,
+  KnownVar_dcHeadlightFlash,
+  KnownVar_dpRFTireChange,
+  KnownVar_dpLFTireChange,
+  KnownVar_dpRRTireChange,
+  KnownVar_dpLRTireChange,
+  KnownVar_dpFuelFill,
+  KnownVar_dpFuelAutoFillEnabled,
+  KnownVar_dpFuelAutoFillActive,
+  KnownVar_dpWindshieldTearoff,
+  KnownVar_dpFuelAddKg,
+  KnownVar_dcToggleWindshieldWipers,
+  KnownVar_dcTriggerWindshieldWipers,
+  KnownVar_dpFastRepair,
+  KnownVar_dcBrakeBias,
+  KnownVar_dpLFTireColdPress,
+  KnownVar_dpRFTireColdPress,
+  KnownVar_dpLRTireColdPress,
+  KnownVar_dpRRTireColdPress,
+  KnownVar_dcTractionControl,
+  KnownVar_dcThrottleShape,
+  KnownVar_FuelUsePerHour,
+  KnownVar_Voltage,
+  KnownVar_WaterTemp,
+  KnownVar_WaterLevel,
+  KnownVar_FuelPress,
+  KnownVar_OilTemp,
+  KnownVar_OilPress,
+  KnownVar_OilLevel,
+  KnownVar_ManifoldPress,
+  KnownVar_FuelLevel,
+  KnownVar_Engine0_RPM,
+  KnownVar_RFbrakeLinePress,
+  KnownVar_RFcoldPressure,
+  KnownVar_RFtempCL,
+  KnownVar_RFtempCM,
+  KnownVar_RFtempCR,
+  KnownVar_RFwearL,
+  KnownVar_RFwearM,
+  KnownVar_RFwearR,
+  KnownVar_LFbrakeLinePress,
+  KnownVar_LFcoldPressure,
+  KnownVar_LFtempCL,
+  KnownVar_LFtempCM,
+  KnownVar_LFtempCR,
+  KnownVar_LFwearL,
+  KnownVar_LFwearM,
+  KnownVar_LFwearR,
+  KnownVar_RRbrakeLinePress,
+  KnownVar_RRcoldPressure,
+  KnownVar_RRtempCL,
+  KnownVar_RRtempCM,
+  KnownVar_RRtempCR,
+  KnownVar_RRwearL,
+  KnownVar_RRwearM,
+  KnownVar_RRwearR,
+  KnownVar_LRbrakeLinePress,
+  KnownVar_LRcoldPressure,
+  KnownVar_LRtempCL,
+  KnownVar_LRtempCM,
+  KnownVar_LRtempCR,
+  KnownVar_LRwearL,
+  KnownVar_LRwearM,
+  KnownVar_LRwearR,
+  KnownVar_LRshockDefl,
+  KnownVar_LRshockDefl_ST,
+  KnownVar_LRshockVel,
+  KnownVar_LRshockVel_ST,
+  KnownVar_RRshockDefl,
+  KnownVar_RRshockDefl_ST,
+  KnownVar_RRshockVel,
+  KnownVar_RRshockVel_ST,
+  KnownVar_LFshockDefl,
+  KnownVar_LFshockDefl_ST,
+  KnownVar_LFshockVel,
+  KnownVar_LFshockVel_ST,
+  KnownVar_RFshockDefl,
+  KnownVar_RFshockDefl_ST,
+  KnownVar_RFshockVel,
+  KnownVar_RFshockVel_ST,
+  KnownVarCount
+};
+
+static constexpr KnownVarInfo knownVarTable[KnownVarCount] = {
+  { "SessionTime", irsdk_double, 1 },
+  { "SessionTick", irsdk_int, 1 },
+  { "SessionNum", irsdk_int, 1 },
+  { "SessionState", irsdk_int, 1 },
+  { "SessionUniqueID", irsdk_int, 1 },
+  { "SessionFlags", irsdk_bitField, 1 },
+  { "SessionTimeRemain", irsdk_double, 1 },
+  { "SessionLapsRemain", irsdk_int, 1 },
+  { "SessionLapsRemainEx", irsdk_int, 1 },
+  { "SessionTimeTotal", irsdk_double, 1 },
+  { "SessionLapsTotal", irsdk_int, 1 },
+  { "SessionJokerLapsRemain", irsdk_int, 1 },
+  { "SessionOnJokerLap", irsdk_bool, 1 },
+  { "SessionTimeOfDay", irsdk_float, 1 },
+  { "RadioTransmitCarIdx", irsdk_int, 1 },
+  { "RadioTransmitRadioIdx", irsdk_int, 1 },
+  { "RadioTransmitFrequencyIdx", irsdk_int, 1 },
+  { "DisplayUnits", irsdk_int, 1 },
+  { "DriverMarker", irsdk_bool, 1 },
+  { "PushToTalk", irsdk_bool, 1 },
+  { "PushToPass", irsdk_bool, 1 },
+  { "ManualBoost", irsdk_bool, 1 },
+  { "ManualNoBoost", irsdk_bool, 1 },
+  { "IsOnTrack", irsdk_bool, 1 },
+  { "IsReplayPlaying", irsdk_bool, 1 },
+  { "ReplayFrameNum", irsdk_int, 1 },
+  { "ReplayFrameNumEnd", irsdk_int, 1 },
+  { "IsDiskLoggingEnabled", irsdk_bool, 1 },
+  { "IsDiskLoggingActive", irsdk_bool, 1 },
+  { "FrameRate", irsdk_float, 1 },
+  { "CpuUsageFG", irsdk_float, 1 },
+  { "GpuUsage", irsdk_float, 1 },
+  { "ChanAvgLatency", irsdk_float, 1 },
+  { "ChanLatency", irsdk_float, 1 },
+  { "ChanQuality", irsdk_float, 1 },
+  { "ChanPartnerQuality", irsdk_float, 1 },
+  { "CpuUsageBG", irsdk_float, 1 },
+  { "ChanClockSkew", irsdk_float, 1 },
+  { "MemPageFaultSec", irsdk_float, 1 },
+  { "MemSoftPageFaultSec", irsdk_float, 1 },
+  { "PlayerCarPosition", irsdk_int, 1 },
+  { "PlayerCarClassPosition", irsdk_int, 1 },
+  { "PlayerCarClass", irsdk_int, 1 },
+  { "PlayerTrackSurface", irsdk_int, 1 },
+  { "PlayerTrackSurfaceMaterial", irsdk_int, 1 },
+  { "PlayerCarIdx", irsdk_int, 1 },
+  { "PlayerCarTeamIncidentCount", irsdk_int, 1 },
+  { "PlayerCarMyIncidentCount", irsdk_int, 1 },
+  { "PlayerCarDriverIncidentCount", irsdk_int, 1 },
+  { "PlayerCarWeightPenalty", irsdk_float, 1 },
+  { "PlayerCarPowerAdjust", irsdk_float, 1 },
+  { "PlayerCarDryTireSetLimit", irsdk_int, 1 },
+  { "PlayerCarTowTime", irsdk_float, 1 },
+  { "PlayerCarInPitStall", irsdk_bool, 1 },
+  { "PlayerCarPitSvStatus", irsdk_int, 1 },
+  { "PlayerTireCompound", irsdk_int, 1 },
+  { "PlayerFastRepairsUsed", irsdk_int, 1 },
+  { "CarIdxLap", irsdk_int, 64 },
+  { "CarIdxLapCompleted", irsdk_int, 64 },
+  { "CarIdxLapDistPct", irsdk_float, 64 },
+  { "CarIdxTrackSurface", irsdk_int, 64 },
+  { "CarIdxTrackSurfaceMaterial", irsdk_int, 64 },
+  { "CarIdxOnPitRoad", irsdk_bool, 64 },
+  { "CarIdxPosition", irsdk_int, 64 },
+  { "CarIdxClassPosition", irsdk_int, 64 },
+  { "CarIdxClass", irsdk_int, 64 },
+  { "CarIdxF2Time", irsdk_float, 64 },
+  { "CarIdxEstTime", irsdk_float, 64 },
+  { "CarIdxLastLapTime", irsdk_float, 64 },
+  { "CarIdxBestLapTime", irsdk_float, 64 },
+  { "CarIdxBestLapNum", irsdk_int, 64 },
+  { "CarIdxTireCompound", irsdk_int, 64 },
+  { "CarIdxQualTireCompound", irsdk_int, 64 },
+  { "CarIdxQualTireCompoundLocked", irsdk_bool, 64 },
+  { "CarIdxFastRepairsUsed", irsdk_int, 64 },
+  { "CarIdxSessionFlags", irsdk_bitField, 64 },
+  { "PaceMode", irsdk_int, 1 },
+  { "CarIdxPaceLine", irsdk_int, 64 },
+  { "CarIdxPaceRow", irsdk_int, 64 },
+  { "CarIdxPaceFlags", irsdk_bitField, 64 },
+  { "OnPitRoad", irsdk_bool, 1 },
+  { "CarIdxSteer", irsdk_float, 64 },
+  { "CarIdxRPM", irsdk_float, 64 },
+  { "CarIdxGear", irsdk_int, 64 },
+  { "SteeringWheelAngle", irsdk_float, 1 },
+  { "Throttle", irsdk_float, 1 },
+  { "Brake", irsdk_float, 1 },
+  { "Clutch", irsdk_float, 1 },
+  { "Gear", irsdk_int, 1 },
+  { "RPM", irsdk_float, 1 },
+  { "PlayerCarSLFirstRPM", irsdk_float, 1 },
+  { "PlayerCarSLShiftRPM", irsdk_float, 1 },
+  { "PlayerCarSLLastRPM", irsdk_float, 1 },
+  { "PlayerCarSLBlinkRPM", irsdk_float, 1 },
+  { "Lap", irsdk_int, 1 },
+  { "LapCompleted", irsdk_int, 1 },
+  { "LapDist", irsdk_float, 1 },
+  { "LapDistPct", irsdk_float, 1 },
+  { "RaceLaps", irsdk_int, 1 },
+  { "CarDistAhead", irsdk_float, 1 },
+  { "CarDistBehind", irsdk_float, 1 },
+  { "LapBestLap", irsdk_int, 1 },
+  { "LapBestLapTime", irsdk_float, 1 },
+  { "LapLastLapTime", irsdk_float, 1 },
+  { "LapCurrentLapTime", irsdk_float, 1 },
+  { "LapLasNLapSeq", irsdk_int, 1 },
+  { "LapLastNLapTime", irsdk_float, 1 },
+  { "LapBestNLapLap", irsdk_int, 1 },
+  { "LapBestNLapTime", irsdk_float, 1 },
+  { "LapDeltaToBestLap", irsdk_float, 1 },
+  { "LapDeltaToBestLap_DD", irsdk_float, 1 },
+  { "LapDeltaToBestLap_OK", irsdk_bool, 1 },
+  { "LapDeltaToOptimalLap", irsdk_float, 1 },
+  { "LapDeltaToOptimalLap_DD", irsdk_float, 1 },
+  { "LapDeltaToOptimalLap_OK", irsdk_bool, 1 },
+  { "LapDeltaToSessionBestLap", irsdk_float, 1 },
+  { "LapDeltaToSessionBestLap_DD", irsdk_float, 1 },
+  { "LapDeltaToSessionBestLap_OK", irsdk_bool, 1 },
+  { "LapDeltaToSessionOptimalLap", irsdk_float, 1 },
+  { "LapDeltaToSessionOptimalLap_DD", irsdk_float, 1 },
+  { "LapDeltaToSessionOptimalLap_OK", irsdk_bool, 1 },
+  { "LapDeltaToSessionLastlLap", irsdk_float, 1 },
+  { "LapDeltaToSessionLastlLap_DD", irsdk_float, 1 },
+  { "LapDeltaToSessionLastlLap_OK", irsdk_bool, 1 },
+  { "Speed", irsdk_float, 1 },
+  { "Yaw", irsdk_float, 1 },
+  { "YawNorth", irsdk_float, 1 },
+  { "Pitch", irsdk_float, 1 },
+  { "Roll", irsdk_float, 1 },
+  { "EnterExitReset", irsdk_int, 1 },
+  { "TrackTemp", irsdk_float, 1 },
+  { "TrackTempCrew", irsdk_float, 1 },
+  { "AirTemp", irsdk_float, 1 },
+  { "TrackWetness", irsdk_int, 1 },
+  { "Skies", irsdk_int, 1 },
+  { "AirDensity", irsdk_float, 1 },
+  { "AirPressure", irsdk_float, 1 },
+  { "WindVel", irsdk_float, 1 },
+  { "WindDir", irsdk_float, 1 },
+  { "RelativeHumidity", irsdk_float, 1 },
+  { "FogLevel", irsdk_float, 1 },
+  { "Precipitation", irsdk_float, 1 },
+  { "SolarAltitude", irsdk_float, 1 },
+  { "SolarAzimuth", irsdk_float, 1 },
+  { "WeatherDeclaredWet", irsdk_bool, 1 },
+  { "DCLapStatus", irsdk_int, 1 },
+  { "DCDriversSoFar", irsdk_int, 1 },
+  { "OkToReloadTextures", irsdk_bool, 1 },
+  { "LoadNumTextures", irsdk_bool, 1 },
+  { "CarLeftRight", irsdk_int, 1 },
+  { "PitsOpen", irsdk_bool, 1 },
+  { "VidCapEnabled", irsdk_bool, 1 },
+  { "VidCapActive", irsdk_bool, 1 },
+  { "PitRepairLeft", irsdk_float, 1 },
+  { "PitOptRepairLeft", irsdk_float, 1 },
+  { "PitstopActive", irsdk_bool, 1 },
+  { "FastRepairUsed", irsdk_int, 1 },
+  { "FastRepairAvailable", irsdk_int, 1 },
+  { "LFTiresUsed", irsdk_int, 1 },
+  { "RFTiresUsed", irsdk_int, 1 },
+  { "LRTiresUsed", irsdk_int, 1 },
+  { "RRTiresUsed", irsdk_int, 1 },
+  { "LeftTireSetsUsed", irsdk_int, 1 },
+  { "RightTireSetsUsed", irsdk_int, 1 },
+  { "FrontTireSetsUsed", irsdk_int, 1 },
+  { "RearTireSetsUsed", irsdk_int, 1 },
+  { "TireSetsUsed", irsdk_int, 1 },
+  { "LFTiresAvailable", irsdk_int, 1 },
+  { "RFTiresAvailable", irsdk_int, 1 },
+  { "LRTiresAvailable", irsdk_int, 1 },
+  { "RRTiresAvailable", irsdk_int, 1 },
+  { "LeftTireSetsAvailable", irsdk_int, 1 },
+  { "RightTireSetsAvailable", irsdk_int, 1 },
+  { "FrontTireSetsAvailable", irsdk_int, 1 },
+  { "RearTireSetsAvailable", irsdk_int, 1 },
+  { "TireSetsAvailable", irsdk_int, 1 },
+  { "CamCarIdx", irsdk_int, 1 },
+  { "CamCameraNumber", irsdk_int, 1 },
+  { "CamGroupNumber", irsdk_int, 1 },
+  { "CamCameraState", irsdk_bitField, 1 },
+  { "IsOnTrackCar", irsdk_bool, 1 },
+  { "IsInGarage", irsdk_bool, 1 },
+  { "SteeringWheelAngleMax", irsdk_float, 1 },
+  { "ShiftPowerPct", irsdk_float, 1 },
+  { "ShiftGrindRPM", irsdk_float, 1 },
+  { "ThrottleRaw", irsdk_float, 1 },
+  { "BrakeRaw", irsdk_float, 1 },
+  { "ClutchRaw", irsdk_float, 1 },
+  { "HandbrakeRaw", irsdk_float, 1 },
+  { "BrakeABSactive", irsdk_bool, 1 },
+  { "EngineWarnings", irsdk_bitField, 1 },
+  { "FuelLevelPct", irsdk_float, 1 },
+  { "PitSvFlags", irsdk_bitField, 1 },
+  { "PitSvLFP", irsdk_float, 1 },
+  { "PitSvRFP", irsdk_float, 1 },
+  { "PitSvLRP", irsdk_float, 1 },
+  { "PitSvRRP", irsdk_float, 1 },
+  { "PitSvFuel", irsdk_float, 1 },
+  { "PitSvTireCompound", irsdk_int, 1 },
+  { "CarIdxP2P_Status", irsdk_bool, 64 },
+  { "CarIdxP2P_Count", irsdk_int, 64 },
+  { "P2P_Status", irsdk_bool, 1 },
+  { "P2P_Count", irsdk_int, 1 },
+  { "SteeringWheelPctTorque", irsdk_float, 1 },
+  { "SteeringWheelPctTorqueSign", irsdk_float, 1 },
+  { "SteeringWheelPctTorqueSignStops", irsdk_float, 1 },
+  { "SteeringWheelPctIntensity", irsdk_float, 1 },
+  { "SteeringWheelPctSmoothing", irsdk_float, 1 },
+  { "SteeringWheelPctDamper", irsdk_float, 1 },
+  { "SteeringWheelLimiter", irsdk_float, 1 },
+  { "SteeringWheelMaxForceNm", irsdk_float, 1 },
+  { "SteeringWheelPeakForceNm", irsdk_float, 1 },
+  { "SteeringWheelUseLinear", irsdk_bool, 1 },
+  { "ShiftIndicatorPct", irsdk_float, 1 },
+  { "ReplayPlaySpeed", irsdk_int, 1 },
+  { "ReplayPlaySlowMotion", irsdk_bool, 1 },
+  { "ReplaySessionTime", irsdk_double, 1 },
+  { "ReplaySessionNum", irsdk_int, 1 },
+  { "TireLF_RumblePitch", irsdk_float, 1 },
+  { "TireRF_RumblePitch", irsdk_float, 1 },
+  { "TireLR_RumblePitch", irsdk_float, 1 },
+  { "TireRR_RumblePitch", irsdk_float, 1 },
+  { "IsGarageVisible", irsdk_bool, 1 },
+  { "SteeringWheelTorque_ST", irsdk_float, 6 },
+  { "SteeringWheelTorque", irsdk_float, 1 },
+  { "VelocityZ_ST", irsdk_float, 6 },
+  { "VelocityY_ST", irsdk_float, 6 },
+  { "VelocityX_ST", irsdk_float, 6 },
+  { "VelocityZ", irsdk_float, 1 },
+  { "VelocityY", irsdk_float, 1 },
+  { "VelocityX", irsdk_float, 1 },
+  { "YawRate_ST", irsdk_float, 6 },
+  { "PitchRate_ST", irsdk_float, 6 },
+  { "RollRate_ST", irsdk_float, 6 },
+  { "YawRate", irsdk_float, 1 },
+  { "PitchRate", irsdk_float, 1 },
+  { "RollRate", irsdk_float, 1 },
+  { "VertAccel_ST", irsdk_float, 6 },
+  { "LatAccel_ST", irsdk_float, 6 },
+  { "LongAccel_ST", irsdk_float, 6 },
+  { "VertAccel", irsdk_float, 1 },
+  { "LatAccel", irsdk_float, 1 },
+  { "LongAccel", irsdk_float, 1 },
+  { "dcStarter", irsdk_bool, 1 },
+  { "dcTractionControlToggle", irsdk_bool, 1 },
+  { "dcPitSpeedLimiterToggle", irsdk_bool, 1 },
+  { "dcHeadlightFlash", irsdk_bool, 1 },
+  { "dpRFTireChange", irsdk_float, 1 },
+  { "dpLFTireChange", irsdk_float, 1 },
+  { "dpRRTireChange", irsdk_float, 1 },
+  { "dpLRTireChange", irsdk_float, 1 },
+  { "dpFuelFill", irsdk_float, 1 },
+  { "dpFuelAutoFillEnabled", irsdk_float, 1 },
+  { "dpFuelAutoFillActive", irsdk_float, 1 },
+  { "dpWindshieldTearoff", irsdk_float, 1 },
+  { "dpFuelAddKg", irsdk_float, 1 },
+  { "dcToggleWindshieldWipers", irsdk_bool, 1 },
+  { "dcTriggerWindshieldWipers", irsdk_bool, 1 },
+  { "dpFastRepair", irsdk_float, 1 },
+  { "dcBrakeBias", irsdk_float, 1 },
+  { "dpLFTireColdPress", irsdk_float, 1 },
+  { "dpRFTireColdPress", irsdk_float, 1 },
+  { "dpLRTireColdPress", irsdk_float, 1 },
+  { "dpRRTireColdPress", irsdk_float, 1 },
+  { "dcTractionControl", irsdk_float, 1 },
+  { "dcThrottleShape", irsdk_float, 1 },
+  { "FuelUsePerHour", irsdk_float, 1 },
+  { "Voltage", irsdk_float, 1 },
+  { "WaterTemp", irsdk_float, 1 },
+  { "WaterLevel", irsdk_float, 1 },
+  { "FuelPress", irsdk_float, 1 },
+  { "OilTemp", irsdk_float, 1 },
+  { "OilPress", irsdk_float, 1 },
+  { "OilLevel", irsdk_float, 1 },
+  { "ManifoldPress", irsdk_float, 1 },
+  { "FuelLevel", irsdk_float, 1 },
+  { "Engine0_RPM", irsdk_float, 1 },
+  { "RFbrakeLinePress", irsdk_float, 1 },
+  { "RFcoldPressure", irsdk_float, 1 },
+  { "RFtempCL", irsdk_float, 1 },
+  { "RFtempCM", irsdk_float, 1 },
+  { "RFtempCR", irsdk_float, 1 },
+  { "RFwearL", irsdk_float, 1 },
+  { "RFwearM", irsdk_float, 1 },
+  { "RFwearR", irsdk_float, 1 },
+  { "LFbrakeLinePress", irsdk_float, 1 },
+  { "LFcoldPressure", irsdk_float, 1 },
+  { "LFtempCL", irsdk_float, 1 },
+  { "LFtempCM", irsdk_float, 1 },
+  { "LFtempCR", irsdk_float, 1 },
+  { "LFwearL", irsdk_float, 1 },
+  { "LFwearM", irsdk_float, 1 },
+  { "LFwearR", irsdk_float, 1 },
+  { "RRbrakeLinePress", irsdk_float, 1 },
+  { "RRcoldPressure", irsdk_float, 1 },
+  { "RRtempCL", irsdk_float, 1 },
+  { "RRtempCM", irsdk_float, 1 },
+  { "RRtempCR", irsdk_float, 1 },
+  { "RRwearL", irsdk_float, 1 },
+  { "RRwearM", irsdk_float, 1 },
+  { "RRwearR", irsdk_float, 1 },
+  { "LRbrakeLinePress", irsdk_float, 1 },
+  { "LRcoldPressure", irsdk_float, 1 },
+  { "LRtempCL", irsdk_float, 1 },
+  { "LRtempCM", irsdk_float, 1 },
+  { "LRtempCR", irsdk_float, 1 },
+  { "LRwearL", irsdk_float, 1 },
+  { "LRwearM", irsdk_float, 1 },
+  { "LRwearR", irsdk_float, 1 },
+  { "LRshockDefl", irsdk_float, 1 },
+  { "LRshockDefl_ST", irsdk_float, 6 },
+  { "LRshockVel", irsdk_float, 1 },
+  { "LRshockVel_ST", irsdk_float, 6 },
+  { "RRshockDefl", irsdk_float, 1 },
+  { "RRshockDefl_ST", irsdk_float, 6 },
+  { "RRshockVel", irsdk_float, 1 },
+  { "RRshockVel_ST", irsdk_float, 6 },
+  { "LFshockDefl", irsdk_float, 1 },
+  { "LFshockDefl_ST", irsdk_float, 6 },
+  { "LFshockVel", irsdk_float, 1 },
+  { "LFshockVel_ST", irsdk_float, 6 },
+  { "RFshockDefl", irsdk_float, 1 },
+  { "RFshockDefl_ST", irsdk_float, 6 },
+  { "RFshockVel", irsdk_float, 1 },
+  { "RFshockVel_ST", irsdk_float, 6 },
+};
+
+#endif
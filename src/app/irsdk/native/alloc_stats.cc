@@ -0,0 +1,146 @@
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+#include "./alloc_stats.h"
+
+namespace
+{
+// Both zero initialized before anything runs, operator new may be called
+// before any constructor of this module
+std::atomic<long long> processCounts[AllocCounterCount];
+thread_local long long threadCounts[AllocCounterCount];
+
+inline void count(AllocCounter counter, long long value)
+{
+  threadCounts[counter] += value;
+  processCounts[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+#ifdef IRSDK_ALLOC_STATS
+// Built without exceptions, so no bad_alloc to throw
+bool retryAlloc()
+{
+  std::new_handler handler = std::get_new_handler();
+  if (!handler) return false;
+  handler();
+  return true;
+}
+
+void *countedAlloc(size_t size, bool nothrow)
+{
+  if (size == 0) size = 1;
+  void *p;
+  while (!(p = malloc(size))) {
+    if (nothrow) return NULL;
+    if (!retryAlloc()) abort();
+  }
+  count(AllocNativeAllocs, 1);
+  count(AllocNativeBytes, (long long)size);
+  return p;
+}
+
+void countedFree(void *p)
+{
+  if (!p) return;
+  count(AllocNativeFrees, 1);
+  free(p);
+}
+
+#ifdef __cpp_aligned_new
+// Over-aligned types, freed with the matching aligned free on Windows
+void *countedAlignedAlloc(size_t size, std::align_val_t align, bool nothrow)
+{
+  size_t alignment = static_cast<size_t>(align);
+  if (alignment < sizeof(void *)) alignment = sizeof(void *);
+  if (size == 0) size = 1;
+  void *p;
+  for (;;) {
+#ifdef _WIN32
+    p = _aligned_malloc(size, alignment);
+#else
+    if (posix_memalign(&p, alignment, size)) p = NULL;
+#endif
+    if (p) break;
+    if (nothrow) return NULL;
+    if (!retryAlloc()) abort();
+  }
+  count(AllocNativeAllocs, 1);
+  count(AllocNativeBytes, (long long)size);
+  return p;
+}
+
+void countedAlignedFree(void *p)
+{
+  if (!p) return;
+  count(AllocNativeFrees, 1);
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  free(p);
+#endif
+}
+#endif
+#endif
+} // namespace
+
+void allocThreadStats(AllocStats *stats)
+{
+  for (int i = 0; i < AllocCounterCount; i++) stats->counts[i] = threadCounts[i];
+}
+
+void allocProcessStats(AllocStats *stats)
+{
+  for (int i = 0; i < AllocCounterCount; i++) stats->counts[i] = processCounts[i].load(std::memory_order_relaxed);
+}
+
+void allocCountNapi(AllocCounter counter, long long value)
+{
+  count(counter, value);
+}
+
+#ifdef IRSDK_ALLOC_STATS
+bool allocCountsNative()
+{
+  return true;
+}
+
+// Every replaceable form, so nothing allocated here is freed uncounted, or
+// by the wrong free
+void *operator new(size_t size) { return countedAlloc(size, false); }
+void *operator new[](size_t size) { return countedAlloc(size, false); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size, true); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return countedAlloc(size, true); }
+
+void operator delete(void *p) noexcept { countedFree(p); }
+void operator delete[](void *p) noexcept { countedFree(p); }
+void operator delete(void *p, size_t) noexcept { countedFree(p); }
+void operator delete[](void *p, size_t) noexcept { countedFree(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { countedFree(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { countedFree(p); }
+
+#ifdef __cpp_aligned_new
+void *operator new(size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align, false); }
+void *operator new[](size_t size, std::align_val_t align) { return countedAlignedAlloc(size, align, false); }
+void *operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+  return countedAlignedAlloc(size, align, true);
+}
+void *operator new[](size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+  return countedAlignedAlloc(size, align, true);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { countedAlignedFree(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { countedAlignedFree(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { countedAlignedFree(p); }
+#endif
+#else
+bool allocCountsNative()
+{
+  return false;
+}
+#endif
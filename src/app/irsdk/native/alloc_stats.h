@@ -0,0 +1,45 @@
+#ifndef ALLOC_STATS_H
+#define ALLOC_STATS_H
+
+// Counts what the native side allocates, so the per frame paths can be held
+// to a budget.
+//
+// Built with IRSDK_ALLOC_STATS, alloc_stats.cc replaces the global operator
+// new and delete of whatever it is linked into (only that module on Windows,
+// where each DLL has its own), so every C++ heap allocation of the addon is
+// counted: string growth, vector resizes, new char[]. malloc and allocations
+// inside node or V8 are not. Without it the native counters stay at 0, so
+// release builds keep the allocator they'd have anyway; irsdk_alloc_test
+// always defines it and the addon does when built with IRSDK_ALLOC_STATS=1
+// set in the environment.
+//
+// N-API values have no such hook, the addon counts the ones it creates with
+// allocCountNapi() next to each creation, in every build. Numbers and
+// booleans aren't counted.
+enum AllocCounter
+{
+  AllocNativeAllocs,
+  AllocNativeFrees,
+  AllocNativeBytes,
+  AllocNapiObjects,
+  AllocNapiArrays,
+  AllocNapiStrings,
+  AllocNapiBuffers, // ArrayBuffers and typed arrays
+  AllocCounterCount
+};
+
+struct AllocStats
+{
+  long long counts[AllocCounterCount];
+};
+
+// Totals since the process started, kept per thread and for the whole process
+void allocThreadStats(AllocStats *stats);
+void allocProcessStats(AllocStats *stats);
+
+void allocCountNapi(AllocCounter counter, long long count = 1);
+
+// Whether the native counters are kept, i.e. built with IRSDK_ALLOC_STATS
+bool allocCountsNative();
+
+#endif
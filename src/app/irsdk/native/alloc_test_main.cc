@@ -0,0 +1,304 @@
+// irsdk_alloc_test: drives a simulated session through each per frame path
+// of the addon that doesn't need napi and fails when a steady state frame
+// allocates more than its budget. Every mode starts on a fresh session and
+// warms up first, so one-off allocations (binding, the first session parse,
+// buffers growing to size) aren't counted.
+//
+// scripts/test-alloc-budget.js does the same through the addon's API modes,
+// where the N-API values count too.
+//
+// Usage: irsdk_alloc_test [--frames <n>] [--mode <name>]
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "./alloc_stats.h"
+#include "./sdk_context.h"
+#include "./car_table.h"
+#include "./known_vars.h"
+#include "./lap_timing.h"
+#include "./lap_delta.h"
+#include "./event_detector.h"
+#include "./trigger_set.h"
+#include "./telemetry_history.h"
+#include "./sub_tick_stream.h"
+#include "./frame_encoder.h"
+#include "./frame_ring.h"
+#include "./recording_codec.h"
+
+static void usage()
+{
+  fprintf(stderr, "Usage: irsdk_alloc_test [--frames <n>] [--mode <name>]\n");
+}
+
+// One per frame path, set up against the first line and run on every line
+class Mode
+{
+public:
+  virtual ~Mode() {}
+  virtual void bind(SdkContext *context) = 0;
+  virtual void frame(const char *line, int bufLen, int tickCount) = 0;
+};
+
+// Reading the line alone
+class ReadMode : public Mode
+{
+public:
+  void bind(SdkContext *) {}
+  void frame(const char *, int, int) {}
+};
+
+// The tick engines ProcessTick keeps up to date once JS has asked for them
+class EnginesMode : public Mode
+{
+public:
+  EnginesMode()
+    : _carTableStorage(CarTable::byteLength())
+    , _lapTimingStorage(LapTiming::byteLength())
+    , _lapDeltaStorage(LapDelta::byteLength())
+  {
+    _carTable.attach(_carTableStorage.data());
+    _lapTiming.attach(_lapTimingStorage.data());
+    _lapDelta.attach(_lapDeltaStorage.data());
+    std::string error;
+    _triggers.add("Speed > 30", &error);
+    _sessionCt = -1;
+  }
+
+  void bind(SdkContext *context)
+  {
+    const irsdk_header *header = context->header();
+    _context = context;
+    _knownVars.bind(context->vars(), header->numVars);
+    _carTable.bindVars(context->vars(), header->numVars);
+    _lapTiming.bindVars(_knownVars);
+    _lapDelta.bindVars(_knownVars);
+    _events.bindVars(context->vars(), header->numVars);
+    _events.enable();
+    _triggers.bindVars(context->vars(), header->numVars);
+    _subTick.bindVars(context->vars(), header->numVars, header->tickRate);
+  }
+
+  void frame(const char *line, int, int)
+  {
+    // Session updates aren't steady state, but the simulated session doesn't
+    // change after the first one
+    const char *session = NULL;
+    if (_context->sessionInfoUpdate() != _sessionCt) {
+      _sessionCt = _context->sessionInfoUpdate();
+      session = _context->sessionInfo();
+    }
+    if (session) _carTable.updateSession(session);
+    _carTable.updateTelemetry(line);
+    if (session) _lapTiming.updateSectors(session);
+    _lapTiming.update(line);
+    if (session) _lapDelta.updateSession(session);
+    _lapDelta.update(line);
+    _events.update(line);
+    DetectedEvent drained[EventDetector::Capacity];
+    _events.drain(drained, EventDetector::Capacity);
+    _triggers.update(line);
+    _fired.clear();
+    _triggers.drainFired(&_fired);
+    _subTick.update(line);
+  }
+
+private:
+  SdkContext *_context;
+  int _sessionCt;
+  KnownVarMap _knownVars;
+  std::vector<char> _carTableStorage;
+  std::vector<char> _lapTimingStorage;
+  std::vector<char> _lapDeltaStorage;
+  CarTable _carTable;
+  LapTiming _lapTiming;
+  LapDelta _lapDelta;
+  EventDetector _events;
+  TriggerSet _triggers;
+  std::vector<int> _fired;
+  SubTickStream _subTick;
+};
+
+// History channels keep every sample, so their levels grow until they reach
+// capacity, by doubling
+class HistoryMode : public Mode
+{
+public:
+  HistoryMode()
+  {
+    _history.add("Speed", 0, 0);
+    _history.add("CarIdxLapDistPct", 0, 0);
+  }
+  void bind(SdkContext *context) { _history.bindVars(context->vars(), context->header()->numVars); }
+  void frame(const char *line, int, int) { _history.update(line); }
+
+private:
+  TelemetryHistory _history;
+};
+
+// encodeFrame, minus the ArrayBuffer it's copied into
+class EncodeMode : public Mode
+{
+public:
+  EncodeMode()
+    : _encoder(std::vector<std::string>(), true)
+  {
+  }
+  void bind(SdkContext *context) { _encoder.bindVars(context->vars(), context->header()->numVars); }
+  void frame(const char *line, int, int tickCount)
+  {
+    _encoded.clear();
+    _encoder.encode(line, tickCount, false, &_encoded);
+  }
+
+private:
+  FrameEncoder _encoder;
+  std::vector<char> _encoded;
+};
+
+// The frame publishers, over process memory instead of a mapping
+class PublishMode : public Mode
+{
+public:
+  void bind(SdkContext *context)
+  {
+    const irsdk_header *header = context->header();
+    int slotCapacity = (header->bufLen + 7) & ~7;
+    _memory.assign(FrameRing::byteLength(slotCapacity), 0);
+    _ring.attach(_memory.data(), (int)_memory.size(), slotCapacity);
+    _ring.setLayout(context->vars(), header->numVars, header->bufLen);
+  }
+  void frame(const char *line, int bufLen, int tickCount) { _ring.publish(line, bufLen, tickCount); }
+
+private:
+  std::vector<char> _memory;
+  FrameRingWriter _ring;
+};
+
+// Recording, written out once per block like WriteRecording() does
+class RecordMode : public Mode
+{
+public:
+  void bind(SdkContext *context)
+  {
+    const irsdk_header *header = context->header();
+    _recorder.begin(&_out);
+    _recorder.setLayout(context->vars(), header->numVars, header->bufLen, &_out);
+    _out.clear();
+  }
+  void frame(const char *line, int, int tickCount)
+  {
+    _recorder.add(line, tickCount, &_out);
+    _out.clear();
+  }
+
+private:
+  RecordingEncoder _recorder;
+  std::vector<char> _out;
+};
+
+struct ModeInfo
+{
+  const char *name;
+  Mode *(*create)();
+  double budget; // Native allocations per frame
+};
+
+template <class T> static Mode *createMode() { return new T(); }
+
+static const ModeInfo modes[] = {
+  { "read", &createMode<ReadMode>, 0 },
+  { "engines", &createMode<EnginesMode>, 0 },
+  { "history", &createMode<HistoryMode>, 0.05 },
+  { "encode", &createMode<EncodeMode>, 0 },
+  { "publish", &createMode<PublishMode>, 0 },
+  { "record", &createMode<RecordMode>, 0 },
+};
+
+// Allocations per frame over frames, -1 when the session doesn't come up
+static double measure(const ModeInfo &info, int warmup, int frames, double *bytesPerFrame)
+{
+  SimulatedContext context(60, false);
+  if (!context.startup()) return -1;
+
+  std::unique_ptr<Mode> mode(info.create());
+  std::vector<char> line(context.header()->bufLen);
+  bool bound = false;
+  AllocStats before;
+  AllocStats after;
+  for (int i = 0; i < warmup + frames; i++) {
+    if (i == warmup) allocThreadStats(&before);
+    const irsdk_header *header = context.header();
+    if (!context.waitForData(16, line.data())) return -1;
+    if (!bound) {
+      mode->bind(&context);
+      bound = true;
+    }
+    mode->frame(line.data(), header->bufLen, context.tickCount());
+  }
+  allocThreadStats(&after);
+
+  *bytesPerFrame = (double)(after.counts[AllocNativeBytes] - before.counts[AllocNativeBytes]) / frames;
+  return (double)(after.counts[AllocNativeAllocs] - before.counts[AllocNativeAllocs]) / frames;
+}
+
+int main(int argc, char **argv)
+{
+  int frames = 5000;
+  std::string only;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (0 == strcmp(arg, "--frames")) frames = atoi(value);
+    else if (0 == strcmp(arg, "--mode")) only = value;
+    else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+  if (frames <= 0) {
+    usage();
+    return 2;
+  }
+
+  if (!allocCountsNative()) {
+    fprintf(stderr, "irsdk_alloc_test has to be built with IRSDK_ALLOC_STATS\n");
+    return 2;
+  }
+
+  // Past a whole recording block, so every buffer has reached its size
+  int warmup = 2 * RecordingEncoder::BlockFrames;
+  int failed = 0;
+  int ran = 0;
+  for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+    const ModeInfo &info = modes[m];
+    if (!only.empty() && only != info.name) continue;
+    ran++;
+
+    double bytes = 0;
+    double allocs = measure(info, warmup, frames, &bytes);
+    bool ok = allocs >= 0 && allocs <= info.budget;
+    if (allocs < 0) {
+      printf("FAIL %-8s simulated session didn't start\n", info.name);
+    } else {
+      printf("%s %-8s %.3f allocs/frame (budget %g), %.1f bytes/frame\n", ok ? "ok  " : "FAIL", info.name, allocs,
+             info.budget, bytes);
+    }
+    if (!ok) failed++;
+  }
+  if (!ran) {
+    usage();
+    return 2;
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,184 @@
+#include <string.h>
+
+#include "./car_table.h"
+#include "./session_scan.h"
+#include "./var_lookup.h"
+
+enum CarTableSource
+{
+  CarTable_Telemetry = 0, // CarIdx* telemetry array, refreshed every tick
+  CarTable_Session,       // numeric DriverInfo:Drivers field
+  CarTable_SessionString  // string DriverInfo:Drivers field, stored as an intern id
+};
+
+struct CarTableColumn
+{
+  ViewColumn view; // Named after the telemetry variable or DriverInfo:Drivers key
+  CarTableSource source;
+};
+
+static const int carBytes = CarTable::MaxCars * 4;
+
+static const CarTableColumn carTableColumns[] = {
+  // Telemetry
+  { { "CarIdxLap", ViewColumn_Int32, CarTable::MaxCars, 0 }, CarTable_Telemetry },
+  { { "CarIdxLapCompleted", ViewColumn_Int32, CarTable::MaxCars, carBytes }, CarTable_Telemetry },
+  { { "CarIdxLapDistPct", ViewColumn_Float32, CarTable::MaxCars, carBytes * 2 }, CarTable_Telemetry },
+  { { "CarIdxPosition", ViewColumn_Int32, CarTable::MaxCars, carBytes * 3 }, CarTable_Telemetry },
+  { { "CarIdxClassPosition", ViewColumn_Int32, CarTable::MaxCars, carBytes * 4 }, CarTable_Telemetry },
+  { { "CarIdxOnPitRoad", ViewColumn_Int32, CarTable::MaxCars, carBytes * 5 }, CarTable_Telemetry },
+  { { "CarIdxTrackSurface", ViewColumn_Int32, CarTable::MaxCars, carBytes * 6 }, CarTable_Telemetry },
+  { { "CarIdxLastLapTime", ViewColumn_Float32, CarTable::MaxCars, carBytes * 7 }, CarTable_Telemetry },
+  { { "CarIdxBestLapTime", ViewColumn_Float32, CarTable::MaxCars, carBytes * 8 }, CarTable_Telemetry },
+  { { "CarIdxEstTime", ViewColumn_Float32, CarTable::MaxCars, carBytes * 9 }, CarTable_Telemetry },
+  { { "CarIdxF2Time", ViewColumn_Float32, CarTable::MaxCars, carBytes * 10 }, CarTable_Telemetry },
+  // Session (DriverInfo:Drivers)
+  { { "UserName", ViewColumn_Int32, CarTable::MaxCars, carBytes * 11 }, CarTable_SessionString },
+  { { "CarNumber", ViewColumn_Int32, CarTable::MaxCars, carBytes * 12 }, CarTable_SessionString },
+  { { "CarNumberRaw", ViewColumn_Int32, CarTable::MaxCars, carBytes * 13 }, CarTable_Session },
+  { { "CarClassID", ViewColumn_Int32, CarTable::MaxCars, carBytes * 14 }, CarTable_Session },
+  { { "CarClassShortName", ViewColumn_Int32, CarTable::MaxCars, carBytes * 15 }, CarTable_SessionString },
+  { { "CarClassColor", ViewColumn_Int32, CarTable::MaxCars, carBytes * 16 }, CarTable_Session },
+  { { "IRating", ViewColumn_Int32, CarTable::MaxCars, carBytes * 17 }, CarTable_Session },
+  { { "CarIsPaceCar", ViewColumn_Int32, CarTable::MaxCars, carBytes * 18 }, CarTable_Session },
+  { { "IsSpectator", ViewColumn_Int32, CarTable::MaxCars, carBytes * 19 }, CarTable_Session },
+};
+
+static const int carTableColumnCount = sizeof(carTableColumns) / sizeof(carTableColumns[0]);
+
+int CarTable::columnCount()
+{
+  return carTableColumnCount;
+}
+
+const ViewColumn &CarTable::column(int index)
+{
+  return carTableColumns[index].view;
+}
+
+CarTable::CarTable()
+  : _storage(NULL)
+{
+  for (int i = 0; i < carTableColumnCount; i++) {
+    _vars[i].offset = -1;
+  }
+}
+
+void CarTable::attach(char *storage)
+{
+  _storage = storage;
+  memset(_storage, 0, byteLength());
+  clearSessionColumns();
+}
+
+void CarTable::bindVars(const irsdk_varHeader *vars, int count)
+{
+  for (int col = 0; col < carTableColumnCount; col++) {
+    _vars[col].offset = -1;
+    if (carTableColumns[col].source != CarTable_Telemetry) continue;
+
+    const irsdk_varHeader *var = findVarHeader(vars, count, carTableColumns[col].view.name);
+    if (var) {
+      _vars[col].offset = var->offset;
+      _vars[col].type = var->type;
+      _vars[col].count = var->count < MaxCars ? var->count : MaxCars;
+    }
+  }
+}
+
+void CarTable::updateTelemetry(const char *data)
+{
+  if (!_storage || !data) return;
+
+  for (int col = 0; col < carTableColumnCount; col++) {
+    const BoundVar &var = _vars[col];
+    if (var.offset < 0) continue;
+
+    const char *src = data + var.offset;
+    for (int car = 0; car < var.count; car++) {
+      switch (var.type) {
+      case irsdk_char:
+      case irsdk_bool:
+        writeInt(col, car, src[car]);
+        break;
+      case irsdk_int:
+      case irsdk_bitField:
+        if (carTableColumns[col].view.type == ViewColumn_Int32) {
+          writeInt(col, car, reinterpret_cast<const int *>(src)[car]);
+        } else {
+          writeFloat(col, car, (float)reinterpret_cast<const int *>(src)[car]);
+        }
+        break;
+      case irsdk_float:
+        if (carTableColumns[col].view.type == ViewColumn_Float32) {
+          writeFloat(col, car, reinterpret_cast<const float *>(src)[car]);
+        } else {
+          writeInt(col, car, (int)reinterpret_cast<const float *>(src)[car]);
+        }
+        break;
+      case irsdk_double:
+        writeFloat(col, car, (float)reinterpret_cast<const double *>(src)[car]);
+        break;
+      }
+    }
+  }
+}
+
+void CarTable::updateSession(const char *yaml)
+{
+  if (!_storage) return;
+  clearSessionColumns();
+
+  SessionBlock drivers;
+  if (!sessionFindBlock(sessionRoot(yaml), "DriverInfo:Drivers:", &drivers)) return;
+
+  SessionListCursor entries(drivers);
+  SessionBlock entry;
+  while (entries.next(&entry)) {
+    SessionField field;
+    if (!sessionFindValue(entry, "CarIdx", &field)) continue;
+    int carIdx = sessionFieldInt(field, -1);
+    if (carIdx < 0 || carIdx >= MaxCars) continue;
+
+    SessionFieldCursor fields(entry);
+    while (fields.next(&field)) {
+      for (int col = 0; col < carTableColumnCount; col++) {
+        const CarTableColumn &def = carTableColumns[col];
+        if (def.source == CarTable_Telemetry || !sessionKeyIs(field, def.view.name)) continue;
+
+        if (def.source == CarTable_SessionString) {
+          const char *str;
+          int len = sessionFieldString(field, &str);
+          writeInt(col, carIdx, _strings.intern(str, len));
+        } else {
+          writeInt(col, carIdx, sessionFieldInt(field));
+        }
+        break;
+      }
+    }
+  }
+}
+
+void CarTable::clearSessionColumns()
+{
+  for (int col = 0; col < carTableColumnCount; col++) {
+    CarTableSource source = carTableColumns[col].source;
+    if (source == CarTable_Telemetry) continue;
+
+    // Intern ids use -1 for "no driver in this slot"
+    int empty = source == CarTable_SessionString ? -1 : 0;
+    for (int car = 0; car < MaxCars; car++) {
+      writeInt(col, car, empty);
+    }
+  }
+}
+
+void CarTable::writeInt(int column, int carIdx, int value)
+{
+  reinterpret_cast<int *>(_storage + carTableColumns[column].view.byteOffset)[carIdx] = value;
+}
+
+void CarTable::writeFloat(int column, int carIdx, float value)
+{
+  reinterpret_cast<float *>(_storage + carTableColumns[column].view.byteOffset)[carIdx] = value;
+}
@@ -0,0 +1,54 @@
+#ifndef CAR_TABLE_H
+#define CAR_TABLE_H
+
+#include "./lib/irsdk_defines.h"
+#include "./string_table.h"
+#include "./view_column.h"
+
+// Struct-of-arrays table joining the per-car telemetry arrays with the
+// DriverInfo:Drivers entries by CarIdx. Every column is MaxCars 4-byte values
+// so the storage can be exposed to JS as one ArrayBuffer with typed-array
+// views at fixed offsets.
+class CarTable
+{
+public:
+  static const int MaxCars = 64;
+
+  static int columnCount();
+  static const ViewColumn &column(int index);
+  static int byteLength() { return columnCount() * MaxCars * 4; }
+
+  CarTable();
+
+  // Storage must be at least byteLength() bytes and outlive the table, or
+  // until detach() is called. Nothing is written while detached.
+  void attach(char *storage);
+  void detach() { _storage = NULL; }
+  bool isAttached() const { return _storage != NULL; }
+
+  // Resolves the telemetry columns against a (new) variable header table
+  void bindVars(const irsdk_varHeader *vars, int count);
+
+  void updateTelemetry(const char *data);
+  void updateSession(const char *yaml);
+
+  const StringTable &strings() const { return _strings; }
+
+private:
+  void clearSessionColumns();
+  void writeInt(int column, int carIdx, int value);
+  void writeFloat(int column, int carIdx, float value);
+
+  struct BoundVar
+  {
+    int offset; // -1 when the sim does not provide the variable
+    int type;
+    int count;
+  };
+
+  char *_storage;
+  BoundVar _vars[32];
+  StringTable _strings;
+};
+
+#endif
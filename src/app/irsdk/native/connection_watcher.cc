@@ -0,0 +1,106 @@
+#include <chrono>
+
+#include "./connection_watcher.h"
+#include "./telemetry_source.h"
+
+// How long one wait for a line lasts. The sim's event ends it as soon as a line
+// is written, so this only bounds how quickly a dropped connection or stop()
+// is noticed.
+static const int lineWaitMs = 100;
+
+// Same as irsdk_isConnected(): no new line for this long means the sim is gone
+static const std::chrono::seconds connectionTimeout(30);
+
+// A mapping without lines is let go of after this long and looked for again,
+// otherwise our handle would keep the mapping of an exited sim around
+static const std::chrono::seconds reopenAfter(5);
+
+ConnectionWatcher::ConnectionWatcher()
+  : _stopping(false)
+  , _reported(false)
+  , _state(ConnectionAbsent)
+  , _probes(0)
+{
+}
+
+bool ConnectionWatcher::start(const char *name, const Listener &listener)
+{
+  if (_thread.joinable()) return false;
+
+  _name = name;
+  _listener = listener;
+  _stopping = false;
+  _reported = false;
+  _state.store(ConnectionAbsent);
+  _probes.store(0);
+  _thread = std::thread(&ConnectionWatcher::run, this);
+  return true;
+}
+
+void ConnectionWatcher::stop()
+{
+  if (!_thread.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  _thread.join();
+  _listener = Listener();
+}
+
+bool ConnectionWatcher::sleep(int ms)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  return !_wake.wait_for(lock, std::chrono::milliseconds(ms), [this]() { return _stopping; });
+}
+
+bool ConnectionWatcher::stopping()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stopping;
+}
+
+void ConnectionWatcher::setState(ConnectionState state)
+{
+  if (_reported && _state.load() == state) return;
+  _reported = true;
+  _state.store(state);
+  if (_listener) _listener(state);
+}
+
+void ConnectionWatcher::run()
+{
+  TelemetrySource source;
+  int backoffMs = MinBackoffMs;
+  std::chrono::steady_clock::time_point lastLine;
+  std::chrono::steady_clock::time_point waitingSince;
+
+  while (!stopping()) {
+    if (!source.isOpen()) {
+      _probes++;
+      if (!source.open(_name.c_str())) {
+        setState(ConnectionAbsent);
+        if (!sleep(backoffMs)) break;
+        backoffMs = backoffMs * 2 < MaxBackoffMs ? backoffMs * 2 : MaxBackoffMs;
+        continue;
+      }
+      backoffMs = MinBackoffMs;
+      lastLine = waitingSince = std::chrono::steady_clock::now();
+    }
+
+    // Paced by the sim's own lines while it writes them
+    if (source.waitForData(lineWaitMs, NULL)) {
+      lastLine = std::chrono::steady_clock::now();
+      setState(ConnectionConnected);
+      continue;
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (source.isConnected() && now - lastLine < connectionTimeout) continue;
+
+    if (_state.load() != ConnectionWaiting) waitingSince = now;
+    setState(ConnectionWaiting);
+    if (now - waitingSince > reopenAfter) source.close();
+  }
+}
@@ -0,0 +1,66 @@
+#ifndef CONNECTION_WATCHER_H
+#define CONNECTION_WATCHER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "./lib/irsdk_defines.h"
+
+enum ConnectionState
+{
+  ConnectionAbsent,    // No mapping, the sim isn't running
+  ConnectionWaiting,   // Mapping there, but no lines coming in
+  ConnectionConnected, // The sim is writing lines
+};
+
+// Follows the sim's mapping on a thread of its own and reports state changes,
+// so nothing else has to poll for it. While the mapping is missing it is looked
+// for with a backoff; once it is there the thread waits on the sim's lines and
+// reports the connection within a tick of the first one.
+class ConnectionWatcher
+{
+public:
+  typedef std::function<void(ConnectionState)> Listener;
+
+  static const int MinBackoffMs = 100;
+  static const int MaxBackoffMs = 2000;
+
+  ConnectionWatcher();
+  ~ConnectionWatcher() { stop(); }
+
+  // Calls listener on the watcher thread, with the first state found and then
+  // on every change
+  bool start(const char *name, const Listener &listener);
+  void stop();
+  bool isRunning() const { return _thread.joinable(); }
+
+  ConnectionState state() const { return (ConnectionState)_state.load(); }
+  // How often the mapping was looked for, to check an idle watcher stays idle
+  long long probes() const { return _probes.load(); }
+
+private:
+  ConnectionWatcher(const ConnectionWatcher &);
+  ConnectionWatcher &operator=(const ConnectionWatcher &);
+
+  void run();
+  void setState(ConnectionState state);
+  // False when stop() was called, early or meanwhile
+  bool sleep(int ms);
+  bool stopping();
+
+  std::string _name;
+  Listener _listener;
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  bool _stopping;
+  bool _reported;
+  std::atomic<int> _state;
+  std::atomic<long long> _probes;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include <stdint.h>
+
+#include "./connection_watcher_node.h"
+
+struct ConnectionWatcherNode::Watch
+{
+  ConnectionWatcher watcher;
+  Napi::ThreadSafeFunction callback;
+  bool finalized = false;
+};
+
+static const char *StateName(int state)
+{
+  switch (state) {
+    case ConnectionWaiting: return "waiting";
+    case ConnectionConnected: return "connected";
+    default: return "absent";
+  }
+}
+
+Napi::Object ConnectionWatcherNode::Init(Napi::Env env, Napi::Object exports)
+{
+  Napi::Function func = DefineClass(env, "ConnectionWatcher", {
+    InstanceAccessor<&ConnectionWatcherNode::GetState>("state"),
+    InstanceMethod("start", &ConnectionWatcherNode::Start),
+    InstanceMethod("stop", &ConnectionWatcherNode::Stop),
+  });
+
+  exports.Set("ConnectionWatcher", func);
+  return exports;
+}
+
+ConnectionWatcherNode::ConnectionWatcherNode(const Napi::CallbackInfo &info)
+  : Napi::ObjectWrap<ConnectionWatcherNode>(info)
+{
+}
+
+ConnectionWatcherNode::~ConnectionWatcherNode()
+{
+  this->Release();
+}
+
+// start(callback, name?): callback(state) runs on the JS thread for the first
+// state found and every change after it
+Napi::Value ConnectionWatcherNode::Start(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Expected a callback").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (this->_watch) return Napi::Boolean::New(env, false);
+
+  std::string name = IRSDK_MEMMAPFILENAME;
+  if (info.Length() > 1 && info[1].IsString()) {
+    name = info[1].As<Napi::String>().Utf8Value();
+  }
+
+  // Env teardown finalizes the callback before it collects this object, so
+  // the finalizer has to stop the thread calling it
+  std::shared_ptr<Watch> watch = std::make_shared<Watch>();
+  watch->callback = Napi::ThreadSafeFunction::New(env, info[0].As<Napi::Function>(), "ConnectionWatcher", 0, 1,
+    [watch](Napi::Env) {
+      watch->watcher.stop();
+      watch->finalized = true;
+    });
+  // Watching alone doesn't keep the process alive
+  watch->callback.Unref(env);
+
+  Watch *raw = watch.get();
+  watch->watcher.start(name.c_str(), [raw](ConnectionState state) {
+    // The state travels as the data pointer, there is nothing to free
+    raw->callback.NonBlockingCall(reinterpret_cast<void *>((intptr_t)state), [](Napi::Env env, Napi::Function fn, void *data) {
+      fn.Call({ Napi::String::New(env, StateName((int)(intptr_t)data)) });
+    });
+  });
+  this->_watch = watch;
+  return Napi::Boolean::New(env, true);
+}
+
+Napi::Value ConnectionWatcherNode::Stop(const Napi::CallbackInfo &info)
+{
+  this->Release();
+  return info.Env().Undefined();
+}
+
+Napi::Value ConnectionWatcherNode::GetState(const Napi::CallbackInfo &info)
+{
+  int state = this->_watch ? this->_watch->watcher.state() : ConnectionAbsent;
+  return Napi::String::New(info.Env(), StateName(state));
+}
+
+// The thread is joined before the callback goes, so it never calls a released one
+void ConnectionWatcherNode::Release()
+{
+  if (!this->_watch) return;
+  this->_watch->watcher.stop();
+  if (!this->_watch->finalized) this->_watch->callback.Release();
+  this->_watch.reset();
+}
@@ -0,0 +1,30 @@
+#ifndef CONNECTION_WATCHER_NODE_H
+#define CONNECTION_WATCHER_NODE_H
+
+#include <napi.h>
+#include <memory>
+#include "./connection_watcher.h"
+
+// Reports the sim's connection state to JS as it changes, see
+// connection_watcher.h. Takes the place of polling for the sim.
+class ConnectionWatcherNode : public Napi::ObjectWrap<ConnectionWatcherNode>
+{
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    ConnectionWatcherNode(const Napi::CallbackInfo &info);
+    ~ConnectionWatcherNode();
+
+private:
+    Napi::Value Start(const Napi::CallbackInfo &info);
+    Napi::Value Stop(const Napi::CallbackInfo &info);
+    Napi::Value GetState(const Napi::CallbackInfo &info);
+
+    void Release();
+
+    // One per start(), shared with the callback's finalizer, which may run
+    // after this object is gone or before it, when a worker's env goes away
+    struct Watch;
+    std::shared_ptr<Watch> _watch;
+};
+
+#endif
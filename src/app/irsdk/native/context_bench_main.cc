@@ -0,0 +1,128 @@
+// irsdk_context_bench: reads one SdkContext per thread, each on its own
+// simulated session (or its own pass over a telemetry file), and reports how
+// the total line rate scales with the number of threads. Contexts share no
+// state, so per thread rates should hold until the cores run out.
+//
+// Usage: irsdk_context_bench [--threads <max>] [--seconds <n>] [--file <ibt>]
+
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "./sdk_context.h"
+
+static void usage()
+{
+  fprintf(stderr, "Usage: irsdk_context_bench [--threads <max>] [--seconds <n>] [--file <ibt>]\n");
+}
+
+// Reads lines as fast as the context hands them out, touching a few vars of
+// each the way the tick engines do. Returns the number of lines read.
+static long long readLines(SdkContext *context, double seconds, bool rewind)
+{
+  if (!context->startup()) return -1;
+
+  std::vector<char> line(context->header()->bufLen);
+  const irsdk_varHeader *speed = context->varEntry(context->varIndex("Speed"));
+  const irsdk_varHeader *lapDistPct = context->varEntry(context->varIndex("CarIdxLapDistPct"));
+
+  long long lines = 0;
+  float sink = 0;
+  std::chrono::steady_clock::time_point end =
+    std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(seconds));
+  while (std::chrono::steady_clock::now() < end) {
+    if (!context->waitForData(16, line.data())) {
+      if (!rewind) break;
+      // Start the file over
+      context->shutdown();
+      if (!context->startup()) break;
+      continue;
+    }
+    lines++;
+
+    float value;
+    if (speed) {
+      memcpy(&value, line.data() + speed->offset, sizeof(value));
+      sink += value;
+    }
+    for (int car = 0; lapDistPct && car < lapDistPct->count; car++) {
+      memcpy(&value, line.data() + lapDistPct->offset + car * sizeof(float), sizeof(value));
+      sink += value;
+    }
+  }
+
+  // Keep the reads from being optimized away
+  if (sink == -1) printf(" ");
+  return lines;
+}
+
+int main(int argc, char **argv)
+{
+  int maxThreads = (int)std::thread::hardware_concurrency();
+  double seconds = 2;
+  std::string file;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (0 == strcmp(arg, "--threads")) maxThreads = atoi(value);
+    else if (0 == strcmp(arg, "--seconds")) seconds = atof(value);
+    else if (0 == strcmp(arg, "--file")) file = value;
+    else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+  if (maxThreads < 1) maxThreads = 1;
+
+  printf("%s contexts, %.1fs per run\n", file.empty() ? "Simulated" : file.c_str(), seconds);
+  printf("threads  lines/s total  lines/s per thread  scaling\n");
+
+  // Powers of two, then the max itself
+  std::vector<int> runs;
+  for (int threads = 1; threads < maxThreads; threads *= 2) runs.push_back(threads);
+  runs.push_back(maxThreads);
+
+  double single = 0;
+  for (size_t run = 0; run < runs.size(); run++) {
+    int threads = runs[run];
+    std::vector<std::unique_ptr<SdkContext> > contexts;
+    for (int t = 0; t < threads; t++) {
+      if (file.empty()) contexts.push_back(std::unique_ptr<SdkContext>(new SimulatedContext(60, false)));
+      else contexts.push_back(std::unique_ptr<SdkContext>(new FileContext(file.c_str())));
+    }
+
+    std::vector<long long> lines(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+      workers.push_back(std::thread([&, t]() {
+        lines[t] = readLines(contexts[t].get(), seconds, !file.empty());
+      }));
+    }
+    long long total = 0;
+    for (int t = 0; t < threads; t++) {
+      workers[t].join();
+      if (lines[t] < 0) {
+        fprintf(stderr, "irsdk_context_bench: can't open a context\n");
+        return 1;
+      }
+      total += lines[t];
+    }
+
+    double rate = total / seconds;
+    if (threads == 1) single = rate;
+    printf("%7d  %13.0f  %18.0f  %6.2fx\n", threads, rate, rate / threads, single > 0 ? rate / single : 0);
+  }
+  return 0;
+}
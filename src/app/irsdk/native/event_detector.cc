@@ -0,0 +1,133 @@
+#include <string.h>
+
+#include "./event_detector.h"
+#include "./var_lookup.h"
+
+struct EventWatch
+{
+  const char *name;
+  unsigned int mask; // Only changes in these bits are reported
+  bool player;       // Player scoped scalar, reported against PlayerCarIdx
+};
+
+// Indexed by DetectedEventType
+static const EventWatch eventWatches[Event_TypeCount] = {
+  // "servicible" isn't a flag and toggles whenever the car enters the pits
+  { "SessionFlags", ~(unsigned int)irsdk_servicible, false },
+  { "SessionState", 0xFFFFFFFF, false },
+  { "CarIdxTrackSurface", 0xFFFFFFFF, false },
+  { "CarIdxOnPitRoad", 0xFFFFFFFF, false },
+  { "CarIdxLapCompleted", 0xFFFFFFFF, false },
+  { "PlayerCarMyIncidentCount", 0xFFFFFFFF, true },
+  { "PlayerCarPitSvStatus", 0xFFFFFFFF, true },
+  { "PitSvFlags", irsdk_LFTireChange | irsdk_RFTireChange | irsdk_LRTireChange | irsdk_RRTireChange
+    | irsdk_FuelFill | irsdk_WindshieldTearoff | irsdk_FastRepair, true },
+};
+
+EventDetector::EventDetector()
+  : _enabled(false)
+  , _sessionTimeOffset(-1)
+  , _playerCarIdxOffset(-1)
+  , _hasPrevious(false)
+  , _lastTime(-1.0)
+  , _head(0)
+  , _size(0)
+  , _dropped(0)
+{
+  for (int i = 0; i < Event_TypeCount; i++) {
+    _vars[i].offset = -1;
+  }
+}
+
+void EventDetector::bindVars(const irsdk_varHeader *vars, int count)
+{
+  const irsdk_varHeader *sessionTime = findVarHeader(vars, count, "SessionTime");
+  const irsdk_varHeader *playerCarIdx = findVarHeader(vars, count, "PlayerCarIdx");
+  _sessionTimeOffset = sessionTime && sessionTime->type == irsdk_double ? sessionTime->offset : -1;
+  _playerCarIdxOffset = playerCarIdx && playerCarIdx->type == irsdk_int ? playerCarIdx->offset : -1;
+
+  for (int i = 0; i < Event_TypeCount; i++) {
+    _vars[i].offset = -1;
+
+    // Only integral types can be diffed bitwise
+    const irsdk_varHeader *var = findVarHeader(vars, count, eventWatches[i].name);
+    if (!var || var->type == irsdk_float || var->type == irsdk_double) continue;
+
+    _vars[i].offset = var->offset;
+    _vars[i].type = var->type;
+    _vars[i].count = var->count < MaxCars ? var->count : MaxCars;
+  }
+
+  // The previous connection's values mean nothing now
+  _hasPrevious = false;
+  _lastTime = -1.0;
+}
+
+void EventDetector::update(const char *data)
+{
+  if (!_enabled || !data) return;
+
+  double time = _sessionTimeOffset >= 0 ? *reinterpret_cast<const double *>(data + _sessionTimeOffset) : 0.0;
+  int player = _playerCarIdxOffset >= 0 ? *reinterpret_cast<const int *>(data + _playerCarIdxOffset) : -1;
+
+  // A replay rewind jumps between unrelated states, take a new baseline instead of reporting it
+  bool baseline = !_hasPrevious || time < _lastTime;
+  _hasPrevious = true;
+  _lastTime = time;
+
+  for (int type = 0; type < Event_TypeCount; type++) {
+    const BoundVar &var = _vars[type];
+    if (var.offset < 0) continue;
+
+    const EventWatch &watch = eventWatches[type];
+    int *previous = _previous[type];
+    for (int i = 0; i < var.count; i++) {
+      int value = read(data, var, i);
+      if (!baseline && ((unsigned int)(value ^ previous[i]) & watch.mask)) {
+        push(time, type, watch.player ? player : (var.count > 1 ? i : -1), previous[i], value);
+      }
+      previous[i] = value;
+    }
+  }
+}
+
+int EventDetector::drain(DetectedEvent *out, int max)
+{
+  int count = _size < max ? _size : max;
+  int tail = (_head - _size + Capacity) % Capacity;
+  for (int i = 0; i < count; i++) {
+    out[i] = _ring[(tail + i) % Capacity];
+  }
+  _size -= count;
+  _dropped = 0;
+  return count;
+}
+
+int EventDetector::read(const char *data, const BoundVar &var, int index) const
+{
+  const char *src = data + var.offset;
+  switch (var.type) {
+  case irsdk_char:
+  case irsdk_bool:
+    return (unsigned char)src[index];
+  default:
+    return reinterpret_cast<const int *>(src)[index];
+  }
+}
+
+void EventDetector::push(double time, int type, int carIdx, int oldValue, int newValue)
+{
+  DetectedEvent &event = _ring[_head];
+  event.sessionTime = time;
+  event.type = type;
+  event.carIdx = carIdx;
+  event.oldValue = oldValue;
+  event.newValue = newValue;
+
+  _head = (_head + 1) % Capacity;
+  if (_size < Capacity) {
+    _size++;
+  } else {
+    _dropped++;
+  }
+}
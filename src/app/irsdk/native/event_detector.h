@@ -0,0 +1,83 @@
+#ifndef EVENT_DETECTOR_H
+#define EVENT_DETECTOR_H
+
+#include "./lib/irsdk_defines.h"
+
+enum DetectedEventType
+{
+  Event_SessionFlags = 0,   // SessionFlags, irsdk_Flags
+  Event_SessionState,       // SessionState, irsdk_SessionState
+  Event_TrackSurface,       // CarIdxTrackSurface, irsdk_TrkLoc
+  Event_PitRoad,            // CarIdxOnPitRoad
+  Event_LapCompleted,       // CarIdxLapCompleted
+  Event_Incidents,          // PlayerCarMyIncidentCount
+  Event_PitServiceStatus,   // PlayerCarPitSvStatus, irsdk_PitSvStatus
+  Event_PitServiceFlags,    // PitSvFlags, irsdk_PitSvFlags
+  Event_TypeCount
+};
+
+struct DetectedEvent
+{
+  double sessionTime;
+  int type;
+  int carIdx; // -1 for session wide events
+  int oldValue;
+  int newValue;
+};
+
+// Turns changes of selected enum / bitfield variables between consecutive
+// lines into a small event stream, so consumers don't have to diff whole
+// telemetry frames. Each watched variable is compared with a masked XOR
+// against its value on the previous line.
+//
+// Events are kept in a fixed ring until drained; when nobody drains the
+// oldest ones are overwritten.
+class EventDetector
+{
+public:
+  static const int MaxCars = 64;
+  static const int Capacity = 1024;
+
+  EventDetector();
+
+  // Nothing is detected until the first consumer shows up
+  void enable() { _enabled = true; }
+  bool isEnabled() const { return _enabled; }
+
+  void bindVars(const irsdk_varHeader *vars, int count);
+  void update(const char *data);
+
+  // Copies up to max events, oldest first, and removes them from the ring
+  int drain(DetectedEvent *out, int max);
+  int pending() const { return _size; }
+  // Events overwritten since the last drain
+  int dropped() const { return _dropped; }
+
+private:
+  struct BoundVar
+  {
+    int offset; // -1 when the variable isn't in this session
+    int type;
+    int count;
+  };
+
+  int read(const char *data, const BoundVar &var, int index) const;
+  void push(double time, int type, int carIdx, int oldValue, int newValue);
+
+  bool _enabled;
+  int _sessionTimeOffset;
+  int _playerCarIdxOffset;
+  BoundVar _vars[Event_TypeCount];
+
+  // Baseline to diff against, invalid until the first line after bindVars
+  bool _hasPrevious;
+  double _lastTime;
+  int _previous[Event_TypeCount][MaxCars];
+
+  DetectedEvent _ring[Capacity];
+  int _head;
+  int _size;
+  int _dropped;
+};
+
+#endif
@@ -0,0 +1,264 @@
+#include <math.h>
+#include <string.h>
+
+#include "./frame_encoder.h"
+
+template <typename T>
+static void put(std::vector<char> *out, T value)
+{
+  const char *bytes = reinterpret_cast<const char *>(&value);
+  out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+static void patchLength(std::vector<char> *out, size_t at)
+{
+  uint32_t length = (uint32_t)(out->size() - at - sizeof(uint32_t));
+  memcpy(&(*out)[at], &length, sizeof(length));
+}
+
+// Appends codes of `bits` each, LSB first, padded to a byte
+class BitWriter
+{
+public:
+  BitWriter(std::vector<char> *out) : _out(out), _acc(0), _n(0) {}
+
+  void put(uint32_t code, int bits)
+  {
+    _acc |= (uint64_t)code << _n;
+    _n += bits;
+    while (_n >= 8) {
+      _out->push_back((char)(_acc & 0xff));
+      _acc >>= 8;
+      _n -= 8;
+    }
+  }
+
+  void flush()
+  {
+    if (_n > 0) _out->push_back((char)(_acc & 0xff));
+    _acc = 0;
+    _n = 0;
+  }
+
+private:
+  std::vector<char> *_out;
+  uint64_t _acc;
+  int _n;
+};
+
+FrameEncoder::FrameEncoder(const std::vector<std::string> &names, bool changeBitmap,
+                           const std::vector<FrameQuantization> &quantization, bool bitPack)
+  : _names(names)
+  , _changeBitmap(changeBitmap)
+  , _quantization(quantization)
+  , _bitPack(bitPack)
+  , _bound(false)
+  , _valuesLength(0)
+  , _schemaId(0)
+  , _schemaPending(false)
+  , _hasPrevious(false)
+{
+}
+
+void FrameEncoder::bindVars(const irsdk_varHeader *vars, int count)
+{
+  std::vector<int> selected;
+  if (_names.empty()) {
+    for (int i = 0; i < count; i++) selected.push_back(i);
+  } else {
+    for (size_t n = 0; n < _names.size(); n++) {
+      for (int i = 0; i < count; i++) {
+        if (0 == strncmp(vars[i].name, _names[n].c_str(), IRSDK_MAX_STRING)) {
+          selected.push_back(i);
+          break;
+        }
+      }
+    }
+  }
+
+  _fields.clear();
+  _schema.clear();
+  _valuesLength = 0;
+  _schemaId++;
+  bool quantized = !_quantization.empty();
+  int codeCount = 0;
+
+  put<uint32_t>(&_schema, 0);
+  put<uint8_t>(&_schema, SchemaRecord);
+  put<uint8_t>(&_schema, Version);
+  put<uint16_t>(&_schema, _schemaId);
+  size_t countAt = _schema.size();
+  put<uint16_t>(&_schema, 0);
+  put<uint16_t>(&_schema, quantized ? SchemaFlagQuantized : 0);
+
+  for (size_t s = 0; s < selected.size(); s++) {
+    const irsdk_varHeader &var = vars[selected[s]];
+    if (var.type < 0 || var.type >= irsdk_ETCount || var.count <= 0) continue;
+
+    Field field;
+    field.offset = var.offset;
+    field.length = irsdk_VarTypeBytes[var.type] * var.count;
+    field.type = var.type;
+    field.count = var.count;
+    field.bits = 0;
+    field.min = 0;
+    field.step = 0;
+    field.maxCode = 0;
+    field.codeAt = 0;
+
+    for (size_t q = 0; q < _quantization.size() && (var.type == irsdk_float || var.type == irsdk_double); q++) {
+      const FrameQuantization &profile = _quantization[q];
+      if (0 != strncmp(var.name, profile.name.c_str(), IRSDK_MAX_STRING)) continue;
+
+      // Codes run 0..maxCode, the all ones code above that is NaN
+      double range = (profile.max - profile.min) / profile.precision;
+      if (!(profile.precision > 0) || !(range > 0) || range >= 4294967294.0) break;
+      field.maxCode = (uint32_t)floor(range + 0.5);
+      field.bits = 1;
+      while (field.bits < 32 && ((1ull << field.bits) - 1) <= field.maxCode) field.bits++;
+      if (!_bitPack) field.bits = field.bits <= 8 ? 8 : field.bits <= 16 ? 16 : 32;
+      field.min = profile.min;
+      field.step = profile.precision;
+      field.codeAt = codeCount;
+      codeCount += var.count;
+      break;
+    }
+    _fields.push_back(field);
+    if (!field.bits) _valuesLength += field.length;
+
+    uint8_t nameLength = (uint8_t)strnlen(var.name, IRSDK_MAX_STRING);
+    put<uint16_t>(&_schema, (uint16_t)selected[s]);
+    put<uint8_t>(&_schema, (uint8_t)var.type);
+    put<uint8_t>(&_schema, nameLength);
+    put<uint16_t>(&_schema, (uint16_t)var.count);
+    _schema.insert(_schema.end(), var.name, var.name + nameLength);
+    if (quantized) {
+      put<uint8_t>(&_schema, (uint8_t)field.bits);
+      if (field.bits) {
+        put<double>(&_schema, field.min);
+        put<double>(&_schema, field.step);
+      }
+    }
+  }
+
+  uint16_t varCount = (uint16_t)_fields.size();
+  memcpy(&_schema[countAt], &varCount, sizeof(varCount));
+  patchLength(&_schema, 0);
+
+  _codes.assign(codeCount, 0);
+  _previousCodes.assign(codeCount, 0);
+  _previous.assign(_valuesLength, 0);
+  _hasPrevious = false;
+  _schemaPending = true;
+  _bound = true;
+}
+
+uint32_t FrameEncoder::quantize(const Field &field, const char *value) const
+{
+  double v;
+  if (field.type == irsdk_float) {
+    float f;
+    memcpy(&f, value, sizeof(f));
+    v = f;
+  } else {
+    memcpy(&v, value, sizeof(v));
+  }
+
+  if (v != v) return (uint32_t)((1ull << field.bits) - 1);
+  double code = floor((v - field.min) / field.step + 0.5);
+  if (code < 0) return 0;
+  if (code > field.maxCode) return field.maxCode;
+  return (uint32_t)code;
+}
+
+bool FrameEncoder::encode(const char *line, int tickCount, bool keyframe, std::vector<char> *out)
+{
+  if (!_bound || !line) return false;
+
+  bool bitmap = _changeBitmap && _hasPrevious && !keyframe && !_schemaPending;
+  size_t bitmapLength = (_fields.size() + 7) / 8;
+
+  // Quantize up front, the change bitmap compares codes rather than raw values
+  for (size_t f = 0; f < _fields.size(); f++) {
+    const Field &field = _fields[f];
+    if (!field.bits) continue;
+    int size = irsdk_VarTypeBytes[field.type];
+    for (int e = 0; e < field.count; e++) {
+      _codes[field.codeAt + e] = quantize(field, line + field.offset + e * size);
+    }
+  }
+
+  size_t start = out->size();
+  if (_schemaPending) out->insert(out->end(), _schema.begin(), _schema.end());
+
+  size_t frameAt = out->size();
+  put<uint32_t>(out, 0);
+  put<uint8_t>(out, FrameRecord);
+  put<uint8_t>(out, bitmap ? FlagChangeBitmap : 0);
+  put<uint16_t>(out, _schemaId);
+  put<int32_t>(out, tickCount);
+
+  if (bitmap) {
+    size_t bitmapAt = out->size();
+    out->resize(bitmapAt + bitmapLength, 0);
+
+    bool changed = false;
+    int previous = 0;
+    for (size_t f = 0; f < _fields.size(); f++) {
+      const Field &field = _fields[f];
+      if (field.bits) {
+        const uint32_t *codes = &_codes[field.codeAt];
+        if (0 != memcmp(codes, &_previousCodes[field.codeAt], field.count * sizeof(uint32_t))) {
+          (*out)[bitmapAt + f / 8] |= (char)(1 << (f % 8));
+          changed = true;
+        }
+        continue;
+      }
+
+      const char *value = line + field.offset;
+      if (0 != memcmp(value, &_previous[previous], field.length)) {
+        (*out)[bitmapAt + f / 8] |= (char)(1 << (f % 8));
+        out->insert(out->end(), value, value + field.length);
+        memcpy(&_previous[previous], value, field.length);
+        changed = true;
+      }
+      previous += field.length;
+    }
+
+    if (!changed) {
+      out->resize(start);
+      return false;
+    }
+
+    BitWriter bits(out);
+    for (size_t f = 0; f < _fields.size(); f++) {
+      const Field &field = _fields[f];
+      if (!field.bits || !((*out)[bitmapAt + f / 8] & (1 << (f % 8)))) continue;
+      for (int e = 0; e < field.count; e++) bits.put(_codes[field.codeAt + e], field.bits);
+    }
+    bits.flush();
+  } else {
+    size_t valuesAt = out->size();
+    out->resize(valuesAt + _valuesLength);
+    char *values = &(*out)[valuesAt];
+    for (size_t f = 0; f < _fields.size(); f++) {
+      if (_fields[f].bits) continue;
+      memcpy(values, line + _fields[f].offset, _fields[f].length);
+      values += _fields[f].length;
+    }
+    if (_changeBitmap && _valuesLength) memcpy(&_previous[0], &(*out)[valuesAt], _valuesLength);
+
+    BitWriter bits(out);
+    for (size_t f = 0; f < _fields.size(); f++) {
+      const Field &field = _fields[f];
+      for (int e = 0; field.bits && e < field.count; e++) bits.put(_codes[field.codeAt + e], field.bits);
+    }
+    bits.flush();
+  }
+
+  if (!_codes.empty()) _previousCodes = _codes;
+  patchLength(out, frameAt);
+  _hasPrevious = true;
+  _schemaPending = false;
+  return true;
+}
@@ -0,0 +1,105 @@
+#ifndef FRAME_ENCODER_H
+#define FRAME_ENCODER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+
+// Encodes telemetry lines for streaming to browser widgets: the var names and
+// types go out once in a schema record, after that each frame is just the
+// values packed back to back. With change bitmaps on, a frame only carries
+// the vars that changed since the previous one.
+//
+// The output is a stream of records, each prefixed with its uint32 length.
+// Everything is little endian.
+//
+//   Schema: uint8 'S', uint8 version, uint16 schemaId, uint16 varCount,
+//           uint16 schemaFlags, then varCount x { uint16 id, uint8 type,
+//           uint8 nameLength, uint16 count, char name[nameLength],
+//           [uint8 bits, [double min, double step when bits]
+//            when schemaFlags & SchemaFlagQuantized] }
+//   Frame:  uint8 'F', uint8 flags, uint16 schemaId, int32 tickCount,
+//           [uint8 changed[(varCount + 7) / 8] when flags & FlagChangeBitmap],
+//           then the values of every var, or only of the changed ones, in
+//           schema order, skipping quantized vars, then the codes of the
+//           quantized ones in a bit stream of `bits` each (LSB first, padded
+//           to a byte)
+//
+// id is the var's index in the sim's var table and type its irsdk_VarType.
+// A schema record is emitted ahead of the first frame and again whenever the
+// var table changes, which bumps schemaId.
+//
+// Float and double vars can be quantized to a declared precision over a
+// declared range: code = round((value - min) / step), clamped to the range,
+// and the all ones code is NaN. Without bit packing the codes are widened to
+// 8, 16 or 32 bits so they stay byte aligned. Changes smaller than the step
+// don't count for the change bitmap.
+struct FrameQuantization
+{
+  std::string name;
+  double precision;
+  double min;
+  double max;
+};
+
+class FrameEncoder
+{
+public:
+  static const uint8_t Version = 1;
+  static const uint8_t SchemaRecord = 'S';
+  static const uint8_t FrameRecord = 'F';
+  static const uint8_t FlagChangeBitmap = 1;
+  static const uint16_t SchemaFlagQuantized = 1;
+
+  // No names for every var. Quantization entries for vars that aren't
+  // streamed, or aren't float or double, are ignored.
+  FrameEncoder(const std::vector<std::string> &names, bool changeBitmap,
+               const std::vector<FrameQuantization> &quantization = std::vector<FrameQuantization>(),
+               bool bitPack = true);
+
+  void bindVars(const irsdk_varHeader *vars, int count);
+  bool isBound() const { return _bound; }
+
+  // Appends the schema when it's due and then the frame. A keyframe carries
+  // every value even with change bitmaps on; use one after dropping output.
+  // Returns false with nothing appended when there is nothing to send.
+  bool encode(const char *line, int tickCount, bool keyframe, std::vector<char> *out);
+
+private:
+  struct Field
+  {
+    int offset; // In the line
+    int length;
+    // Quantized fields only
+    int type;
+    int count;
+    int bits;
+    double min;
+    double step;
+    uint32_t maxCode;
+    int codeAt; // In _codes
+  };
+
+  uint32_t quantize(const Field &field, const char *value) const;
+
+  std::vector<std::string> _names;
+  bool _changeBitmap;
+  std::vector<FrameQuantization> _quantization;
+  bool _bitPack;
+  bool _bound;
+
+  std::vector<Field> _fields;
+  std::vector<char> _schema;
+  std::vector<char> _previous;
+  int _valuesLength;
+  // Codes of the quantized fields for the current and the previous line
+  std::vector<uint32_t> _codes;
+  std::vector<uint32_t> _previousCodes;
+  uint16_t _schemaId;
+  bool _schemaPending;
+  bool _hasPrevious;
+};
+
+#endif
@@ -0,0 +1,124 @@
+#include <string.h>
+
+#include "./frame_reader_node.h"
+
+Napi::Object FrameReaderNode::Init(Napi::Env env, Napi::Object exports)
+{
+  Napi::Function func = DefineClass(env, "FrameReader", {
+    InstanceMethod("open", &FrameReaderNode::Open),
+    InstanceMethod("close", &FrameReaderNode::Close),
+    InstanceMethod("isOpen", &FrameReaderNode::IsOpen),
+    InstanceMethod("getVars", &FrameReaderNode::GetVars),
+    InstanceMethod("read", &FrameReaderNode::Read),
+  });
+
+  exports.Set("FrameReader", func);
+  return exports;
+}
+
+FrameReaderNode::FrameReaderNode(const Napi::CallbackInfo &info)
+  : Napi::ObjectWrap<FrameReaderNode>(info)
+  , _layout(1)
+  , _bufLen(0)
+  , _lastFrame(0)
+{
+}
+
+Napi::Value FrameReaderNode::Open(const Napi::CallbackInfo &info)
+{
+  std::string name = FRAME_RING_DEFAULT_NAME;
+  if (info.Length() > 0 && info[0].IsString()) {
+    name = info[0].As<Napi::String>().Utf8Value();
+  }
+
+  bool ok = this->_memory.open(name.c_str(), true)
+    && this->_reader.attach(this->_memory.data(), this->_memory.size());
+  if (!ok) this->_memory.close();
+
+  // Odd, so the first read always refreshes the layout
+  this->_layout = 1;
+  this->_lastFrame = 0;
+  return Napi::Boolean::New(info.Env(), ok);
+}
+
+Napi::Value FrameReaderNode::Close(const Napi::CallbackInfo &info)
+{
+  this->_reader.detach();
+  this->_memory.close();
+  return info.Env().Undefined();
+}
+
+Napi::Value FrameReaderNode::IsOpen(const Napi::CallbackInfo &info)
+{
+  return Napi::Boolean::New(info.Env(), this->_reader.isAttached());
+}
+
+Napi::Value FrameReaderNode::GetVars(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (!this->_reader.isAttached()) return env.Null();
+  if (this->_reader.layout() != this->_layout && !this->RefreshLayout(env)) return env.Null();
+  return this->_vars.Value();
+}
+
+Napi::Value FrameReaderNode::Read(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (!this->_reader.isAttached()) return env.Null();
+
+  // Nothing new since the last read
+  uint32_t latest = this->_reader.latestFrame();
+  if (latest == 0 || latest == this->_lastFrame) return env.Null();
+
+  if (this->_reader.layout() != this->_layout && !this->RefreshLayout(env)) return env.Null();
+
+  uint32_t frame;
+  uint32_t layout;
+  int tickCount;
+  int length = this->_reader.read(this->_scratch.data(), (int)this->_scratch.size(), &frame, &layout, &tickCount);
+  // The writer points latest at the new slot before it bumps the frame
+  // count, so between the two the frame just read is still the latest
+  if (length <= 0 || layout != this->_layout || frame == this->_lastFrame) return env.Null();
+  this->_lastFrame = frame;
+
+  // The buffer is reused by every read; decode it before reading again
+  auto buffer = this->_buffer.Value().As<Napi::ArrayBuffer>();
+  memcpy(buffer.Data(), this->_scratch.data(), length < this->_bufLen ? length : this->_bufLen);
+
+  auto result = Napi::Object::New(env);
+  result.Set("frame", frame);
+  result.Set("layout", layout);
+  result.Set("tickCount", tickCount);
+  result.Set("buffer", buffer);
+  return result;
+}
+
+bool FrameReaderNode::RefreshLayout(Napi::Env env)
+{
+  std::vector<irsdk_varHeader> vars(FrameRing::MaxVars);
+  int bufLen;
+  uint32_t layout;
+  int count = this->_reader.readLayout(vars.data(), FrameRing::MaxVars, &bufLen, &layout);
+  if (count < 0) return false;
+
+  auto result = Napi::Array::New(env, count);
+  for (int i = 0; i < count; i++) {
+    const irsdk_varHeader &var = vars[i];
+    auto entry = Napi::Object::New(env);
+    entry.Set("name", var.name);
+    entry.Set("description", var.desc);
+    entry.Set("unit", var.unit);
+    entry.Set("countAsTime", var.countAsTime);
+    entry.Set("length", var.count);
+    entry.Set("varType", var.type);
+    entry.Set("offset", var.offset);
+    result.Set(i, entry);
+  }
+
+  this->_vars = Napi::Persistent(result.As<Napi::Object>());
+  this->_buffer = Napi::Persistent(Napi::ArrayBuffer::New(env, bufLen).As<Napi::Object>());
+  this->_scratch.resize(bufLen > 0 ? bufLen : 1);
+  this->_bufLen = bufLen;
+  this->_layout = layout;
+  return true;
+}
@@ -0,0 +1,39 @@
+#ifndef FRAME_READER_NODE_H
+#define FRAME_READER_NODE_H
+
+#include <napi.h>
+#include <vector>
+#include "./frame_ring.h"
+#include "./shared_memory.h"
+
+// Read-only view of the frames iRacingSdkNode publishes with
+// startFramePublisher(), for overlay renderer processes. It never touches the
+// sim itself, so any number of these can run next to the one real reader.
+class FrameReaderNode : public Napi::ObjectWrap<FrameReaderNode>
+{
+public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    FrameReaderNode(const Napi::CallbackInfo &info);
+
+private:
+    Napi::Value Open(const Napi::CallbackInfo &info);
+    Napi::Value Close(const Napi::CallbackInfo &info);
+    Napi::Value IsOpen(const Napi::CallbackInfo &info);
+    Napi::Value GetVars(const Napi::CallbackInfo &info);
+    Napi::Value Read(const Napi::CallbackInfo &info);
+
+    bool RefreshLayout(Napi::Env env);
+
+    SharedMemory _memory;
+    FrameRingReader _reader;
+
+    // Var table and line buffer of the layout last handed to JS
+    uint32_t _layout;
+    int _bufLen;
+    Napi::ObjectReference _vars;
+    Napi::ObjectReference _buffer;
+    uint32_t _lastFrame;
+    std::vector<char> _scratch;
+};
+
+#endif
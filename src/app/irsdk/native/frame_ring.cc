@@ -0,0 +1,185 @@
+#include <new>
+#include <string.h>
+
+#include "./frame_ring.h"
+
+static const uint32_t frameRingMagic = 0x46524452; // "RDRF"
+static const uint32_t frameRingVersion = 1;
+
+// A reader gives up after this many torn copies, the next notification will retry
+static const int maxReadAttempts = 8;
+
+static int slotsOffset()
+{
+  return (int)sizeof(FrameRingHeader) + FrameRing::MaxVars * (int)sizeof(irsdk_varHeader);
+}
+
+int FrameRing::byteLength(int slotCapacity)
+{
+  return slotsOffset() + SlotCount * slotCapacity;
+}
+
+FrameRingWriter::FrameRingWriter()
+  : _header(NULL)
+  , _vars(NULL)
+  , _slots(NULL)
+  , _frame(0)
+{
+}
+
+bool FrameRingWriter::attach(char *base, int size, int slotCapacity)
+{
+  if (!base || size < FrameRing::byteLength(slotCapacity)) return false;
+
+  // Re-creating the segment while readers still map it hands back the same
+  // memory on Windows, so keep the counters moving forward for them
+  const FrameRingHeader *previous = reinterpret_cast<const FrameRingHeader *>(base);
+  uint32_t layoutSeq = 0;
+  _frame = 0;
+  if (previous->magic == frameRingMagic && previous->version == frameRingVersion) {
+    layoutSeq = (previous->layoutSeq.load() & ~1u) + 2;
+    _frame = previous->frame.load();
+  }
+
+  memset(base, 0, slotsOffset());
+  _header = new (base) FrameRingHeader();
+  _vars = reinterpret_cast<irsdk_varHeader *>(base + sizeof(FrameRingHeader));
+  _slots = base + slotsOffset();
+
+  _header->slotCapacity = slotCapacity;
+  _header->maxVars = FrameRing::MaxVars;
+  _header->latest.store(-1);
+  _header->layoutSeq.store(layoutSeq);
+  _header->frame.store(_frame);
+  _header->version = frameRingVersion;
+  // Readers check the magic last
+  std::atomic_thread_fence(std::memory_order_release);
+  _header->magic = frameRingMagic;
+  return true;
+}
+
+void FrameRingWriter::setLayout(const irsdk_varHeader *vars, int count, int bufLen)
+{
+  if (!_header) return;
+  if (count > FrameRing::MaxVars) count = FrameRing::MaxVars;
+
+  uint32_t seq = _header->layoutSeq.load(std::memory_order_relaxed);
+  _header->layoutSeq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  memcpy(_vars, vars, sizeof(irsdk_varHeader) * count);
+  _header->varCount = count;
+  _header->bufLen = bufLen;
+
+  _header->layoutSeq.store(seq + 2, std::memory_order_release);
+}
+
+uint32_t FrameRingWriter::publish(const char *line, int length, int tickCount)
+{
+  if (!_header || !line || length > _header->slotCapacity) return 0;
+
+  // Never touch the slot readers are most likely copying
+  int latest = _header->latest.load(std::memory_order_relaxed);
+  int index = (latest + 1) % FrameRing::SlotCount;
+  FrameRingSlot &slot = _header->slots[index];
+
+  uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+  slot.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  memcpy(_slots + index * _header->slotCapacity, line, length);
+  slot.frame = ++_frame;
+  slot.layout = _header->layoutSeq.load(std::memory_order_relaxed);
+  slot.tickCount = tickCount;
+  slot.length = length;
+
+  slot.seq.store(seq + 2, std::memory_order_release);
+  _header->latest.store(index, std::memory_order_release);
+  _header->frame.store(_frame, std::memory_order_release);
+  return _frame;
+}
+
+FrameRingReader::FrameRingReader()
+  : _header(NULL)
+  , _vars(NULL)
+  , _slots(NULL)
+{
+}
+
+bool FrameRingReader::attach(const char *base, int size)
+{
+  if (!base || size < (int)sizeof(FrameRingHeader)) return false;
+
+  const FrameRingHeader *header = reinterpret_cast<const FrameRingHeader *>(base);
+  if (header->magic != frameRingMagic) return false;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (header->version != frameRingVersion || size < FrameRing::byteLength(header->slotCapacity)) return false;
+
+  _header = header;
+  _vars = reinterpret_cast<const irsdk_varHeader *>(base + sizeof(FrameRingHeader));
+  _slots = base + slotsOffset();
+  return true;
+}
+
+uint32_t FrameRingReader::layout() const
+{
+  return _header ? (_header->layoutSeq.load(std::memory_order_acquire) & ~1u) : 0;
+}
+
+uint32_t FrameRingReader::latestFrame() const
+{
+  return _header ? _header->frame.load(std::memory_order_acquire) : 0;
+}
+
+int FrameRingReader::readLayout(irsdk_varHeader *out, int max, int *bufLen, uint32_t *layout) const
+{
+  if (!_header) return -1;
+
+  for (int attempt = 0; attempt < maxReadAttempts; attempt++) {
+    uint32_t before = _header->layoutSeq.load(std::memory_order_acquire);
+    if (before & 1) continue;
+
+    int count = _header->varCount;
+    if (count > max) count = max;
+    memcpy(out, _vars, sizeof(irsdk_varHeader) * count);
+    int length = _header->bufLen;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_header->layoutSeq.load(std::memory_order_relaxed) != before) continue;
+
+    if (bufLen) *bufLen = length;
+    if (layout) *layout = before;
+    return count;
+  }
+  return -1;
+}
+
+int FrameRingReader::read(char *out, int capacity, uint32_t *frame, uint32_t *layout, int *tickCount) const
+{
+  if (!_header) return -1;
+
+  for (int attempt = 0; attempt < maxReadAttempts; attempt++) {
+    int index = _header->latest.load(std::memory_order_acquire);
+    if (index < 0) return 0;
+
+    const FrameRingSlot &slot = _header->slots[index];
+    uint32_t before = slot.seq.load(std::memory_order_acquire);
+    if (before & 1) continue;
+
+    int length = slot.length;
+    if (length > capacity) return -1;
+    memcpy(out, _slots + index * _header->slotCapacity, length);
+    uint32_t slotFrame = slot.frame;
+    uint32_t slotLayout = slot.layout;
+    int slotTick = slot.tickCount;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.seq.load(std::memory_order_relaxed) != before) continue;
+
+    if (frame) *frame = slotFrame;
+    if (layout) *layout = slotLayout;
+    if (tickCount) *tickCount = slotTick;
+    return length;
+  }
+  return -1;
+}
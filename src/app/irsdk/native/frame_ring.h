@@ -0,0 +1,106 @@
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <atomic>
+#include <stdint.h>
+
+#include "./lib/irsdk_defines.h"
+
+// Telemetry line buffers published once into shared memory for any number of
+// reader processes. Three slots, each guarded by a seqlock: the writer never
+// waits, and a reader retries if the slot it copied was overwritten meanwhile.
+//
+// The var header table is published next to the slots so a reader can decode
+// lines without its own connection to the sim. Its layout counter is bumped on
+// every new connection and each slot records the layout it was written with.
+//
+// Segment layout:
+//   FrameRingHeader | irsdk_varHeader[MaxVars] | slot data[SlotCount][slotCapacity]
+
+static const char FRAME_RING_DEFAULT_NAME[] = "Local\\IRDashiesFrames";
+
+struct FrameRingSlot
+{
+  std::atomic<uint32_t> seq; // Odd while being written
+  uint32_t frame;
+  uint32_t layout;
+  int32_t tickCount;
+  int32_t length;
+  int32_t reserved[3];
+};
+
+struct FrameRingHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  int32_t slotCapacity;
+  int32_t maxVars;
+  std::atomic<uint32_t> layoutSeq; // Seqlock over varCount, bufLen and the var table
+  int32_t varCount;
+  int32_t bufLen;
+  std::atomic<int32_t> latest;     // Slot of the newest complete frame, -1 for none
+  std::atomic<uint32_t> frame;     // Number of the newest complete frame
+  int32_t reserved[7];
+  FrameRingSlot slots[3];
+};
+
+class FrameRing
+{
+public:
+  static const int SlotCount = 3;
+  static const int MaxVars = 1024;
+  static const int DefaultSlotCapacity = 256 * 1024;
+
+  static int byteLength(int slotCapacity);
+};
+
+class FrameRingWriter
+{
+public:
+  FrameRingWriter();
+
+  // Formats a fresh segment of at least FrameRing::byteLength(slotCapacity) bytes
+  bool attach(char *base, int size, int slotCapacity);
+  void detach() { _header = NULL; }
+  bool isAttached() const { return _header != NULL; }
+
+  void setLayout(const irsdk_varHeader *vars, int count, int bufLen);
+
+  // Returns the frame number, 0 when the line doesn't fit a slot
+  uint32_t publish(const char *line, int length, int tickCount);
+  uint32_t lastFrame() const { return _frame; }
+
+private:
+  FrameRingHeader *_header;
+  irsdk_varHeader *_vars;
+  char *_slots;
+  uint32_t _frame;
+};
+
+class FrameRingReader
+{
+public:
+  FrameRingReader();
+
+  bool attach(const char *base, int size);
+  void detach() { _header = NULL; }
+  bool isAttached() const { return _header != NULL; }
+
+  // Even value of the layout counter, changes whenever the var table does
+  uint32_t layout() const;
+  uint32_t latestFrame() const;
+
+  // Copies the var table; returns the var count or -1 if it kept changing
+  int readLayout(irsdk_varHeader *out, int max, int *bufLen, uint32_t *layout) const;
+
+  // Copies the newest frame; returns its length, 0 when there is none yet and
+  // -1 if the writer kept overwriting it or it doesn't fit
+  int read(char *out, int capacity, uint32_t *frame, uint32_t *layout, int *tickCount) const;
+
+private:
+  const FrameRingHeader *_header;
+  const irsdk_varHeader *_vars;
+  const char *_slots;
+};
+
+#endif
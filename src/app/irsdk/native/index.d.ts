@@ -12,6 +12,23 @@ import {
   VideoCaptureCommand,
   TelemetryVariable,
   TelemetryVarList,
+  CarTableView,
+  SessionTablesView,
+  LapTimingView,
+  LapDeltaView,
+  SdkEvent,
+  FrameVar,
+  SharedFrame,
+  RecordedFrame,
+  QuantizationProfile,
+  HistoryView,
+  SubTickSamples,
+  ParsedSession,
+  SessionKeys,
+  SdkSource,
+  ReplayState,
+  AllocationStats,
+  ConnectionState,
 } from '../types';
 
 type TelemetryTypesDict = Record<string, number>;
@@ -29,7 +46,63 @@ export interface INativeSDK {
   isRunning(): boolean;
   waitForData(timeout?: number): boolean;
   getSessionData(): string; // full yaml
-  getTelemetryData(): TelemetryVarList;
+  takeParsedSession?(): ParsedSession | null;
+  getSessionKeys?(path: string[]): SessionKeys | null;
+  getSessionJson?(path: string[]): string | null;
+  // With reuse, the same object is returned and its value buffers refreshed in place
+  getTelemetryData(reuse?: boolean): TelemetryVarList;
+  getCarTable(): CarTableView;
+  getSessionTables(): SessionTablesView;
+  getLapTiming(): LapTimingView;
+  getLapDelta(): LapDeltaView;
+  getEvents(): SdkEvent[];
+  getSubTickSamples(since?: number): SubTickSamples;
+
+  // Triggers
+  addTrigger(expression: string): number;
+  removeTrigger(id: number): boolean;
+  clearTriggers(): void;
+  getFiredTriggers(): number[];
+
+  // History
+  addHistoryChannel(name: string, index?: number, capacity?: number): number;
+  removeHistoryChannel(id: number): boolean;
+  getHistory(id: number, width: number, from?: number, to?: number): HistoryView | null;
+
+  // Frame publishing
+  startFramePublisher(name?: string): boolean;
+  stopFramePublisher(): void;
+  getPublishedFrame(): number;
+  startSharedFramePublisher(view: Uint8Array): boolean;
+  stopSharedFramePublisher(): void;
+
+  // Widget stream encoding
+  createFrameEncoder(vars?: string[], changeBitmap?: boolean, quantization?: QuantizationProfile, bitPack?: boolean): number;
+  encodeFrame(id: number, keyframe?: boolean): ArrayBuffer | null;
+  destroyFrameEncoder(id: number): boolean;
+
+  // Recording
+  startRecording(path: string): boolean;
+  stopRecording(): boolean;
+
+  // Replay
+  setReplaySpeed(speed: number): boolean;
+  setReplayLoop(loop: boolean): boolean;
+  seekReplay(line: number): boolean;
+  getReplayState(): ReplayState | null;
+
+  // Tracing
+  setTracing(enabled: boolean): boolean;
+  dumpTrace(clear?: boolean): string;
+
+  // Allocation stats
+  getAllocationStats(): AllocationStats;
+
+  // Lap delta
+  setLapDeltaCar(carIdx: number): boolean;
+  saveReferenceLap(path: string): boolean;
+  loadReferenceLap(path: string): boolean;
+  clearReferenceLap(): void;
 
   getTelemetryVariable<T>(index: number): TelemetryVariable<T>;
   // eslint-disable-next-line @typescript-eslint/unified-signatures
@@ -60,7 +133,8 @@ export class NativeSDK implements INativeSDK {
 
   public enableLogging: boolean;
 
-  constructor();
+  /** Reads the sim unless another source is given. */
+  constructor(source?: SdkSource);
 
   // Main API
   // Control
@@ -75,7 +149,96 @@ export class NativeSDK implements INativeSDK {
 
   public getSessionData(): string; // full yaml
 
-  public getTelemetryData(): TelemetryVarList;
+  public takeParsedSession(): ParsedSession | null;
+
+  public getSessionKeys(path: string[]): SessionKeys | null;
+
+  public getSessionJson(path: string[]): string | null;
+
+  public getTelemetryData(reuse?: boolean): TelemetryVarList;
+
+  public getCarTable(): CarTableView;
+
+  public getSessionTables(): SessionTablesView;
+
+  public getLapTiming(): LapTimingView;
+
+  public getLapDelta(): LapDeltaView;
+
+  public getEvents(): SdkEvent[];
+
+  public getSubTickSamples(since?: number): SubTickSamples;
+
+  // Triggers
+  public addTrigger(expression: string): number;
+
+  public removeTrigger(id: number): boolean;
+
+  public clearTriggers(): void;
+
+  public getFiredTriggers(): number[];
+
+  // History
+  public addHistoryChannel(name: string, index?: number, capacity?: number): number;
+
+  public removeHistoryChannel(id: number): boolean;
+
+  public getHistory(id: number, width: number, from?: number, to?: number): HistoryView | null;
+
+  // Frame publishing
+  public startFramePublisher(name?: string): boolean;
+
+  public stopFramePublisher(): void;
+
+  public getPublishedFrame(): number;
+
+  /** Publishes into a view of a SharedArrayBuffer sized with `sharedFrameRingByteLength()`. */
+  public startSharedFramePublisher(view: Uint8Array): boolean;
+
+  public stopSharedFramePublisher(): void;
+
+  // Widget stream encoding
+  public createFrameEncoder(
+    vars?: string[],
+    changeBitmap?: boolean,
+    quantization?: QuantizationProfile,
+    bitPack?: boolean
+  ): number;
+
+  public encodeFrame(id: number, keyframe?: boolean): ArrayBuffer | null;
+
+  public destroyFrameEncoder(id: number): boolean;
+
+  // Recording
+  public startRecording(path: string): boolean;
+
+  public stopRecording(): boolean;
+
+  // Replay
+  public setReplaySpeed(speed: number): boolean;
+
+  public setReplayLoop(loop: boolean): boolean;
+
+  public seekReplay(line: number): boolean;
+
+  public getReplayState(): ReplayState | null;
+
+  // Tracing
+  public setTracing(enabled: boolean): boolean;
+
+  public dumpTrace(clear?: boolean): string;
+
+  // Allocation stats
+  public getAllocationStats(): AllocationStats;
+
+  // Lap delta
+  public setLapDeltaCar(carIdx: number): boolean;
+
+  public saveReferenceLap(path: string): boolean;
+
+  public loadReferenceLap(path: string): boolean;
+
+  public clearReferenceLap(): void;
 
   public getTelemetryVariable<T extends number | boolean | string>(index: number): TelemetryVariable<T[]>;
 
@@ -85,6 +248,8 @@ export class NativeSDK implements INativeSDK {
   // Private helpers
   public __getTelemetryTypes(): TelemetryTypesDict;
 
+  public __evaluateTriggers(iterations?: number): boolean;
+
   // Broadcast command overloads
   // This is handled in the cpp side so no need to mess with it in js
   public broadcast(message: BroadcastMessages.CameraSwitchPos, pos: number, group: number, camera: number): void;
@@ -118,4 +283,55 @@ export class NativeSDK implements INativeSDK {
   public broadcast(message: BroadcastMessages.VideoCapture, command: VideoCaptureCommand): void;
 }
 
+export class FrameReader {
+  constructor();
+
+  public open(name?: string): boolean;
+
+  public close(): void;
+
+  public isOpen(): boolean;
+
+  public getVars(): FrameVar[] | null;
+
+  /** Returns null when there is no frame newer than the last one read. */
+  public read(): SharedFrame | null;
+}
+
+export interface INativeConnectionWatcher {
+  readonly state: ConnectionState;
+  start(callback: (state: ConnectionState) => void, name?: string): boolean;
+  stop(): void;
+}
+
+export class ConnectionWatcher implements INativeConnectionWatcher {
+  constructor();
+
+  /** The last state reported, `absent` while not started. */
+  public readonly state: ConnectionState;
+
+  /**
+   * Watches the sim's mapping on a native thread. The callback runs with the first state found
+   * and then with every change. Returns false if already started.
+   * @param name Another mapping laid out like the sim's.
+   */
+  public start(callback: (state: ConnectionState) => void, name?: string): boolean;
+
+  public stop(): void;
+}
+
+export class RecordingReader {
+  constructor();
+
+  public open(path: string): boolean;
+
+  public close(): void;
+
+  /** The var table of the frames next() returns, null before open(). */
+  public getVars(): FrameVar[] | null;
+
+  /** Returns null at the end of the recording. */
+  public next(): RecordedFrame | null;
+}
+
 // export const DebugSDK: typeof NativeSDK;
@@ -3,5 +3,14 @@
 // fake a module and then define that module... but those are gross, so no thanks
 // eslint-disable-next-line @typescript-eslint/no-require-imports
 export const NativeSDK = require('../build/Release/irsdk_node.node').iRacingSdkNode;
+// Shared memory frame reader, for renderer processes
+// eslint-disable-next-line @typescript-eslint/no-require-imports
+export const FrameReader = require('../build/Release/irsdk_node.node').FrameReader;
+// Reads back recordings made with startRecording()
+// eslint-disable-next-line @typescript-eslint/no-require-imports
+export const RecordingReader = require('../build/Release/irsdk_node.node').RecordingReader;
+// Reports the sim's connection state as it changes
+// eslint-disable-next-line @typescript-eslint/no-require-imports
+export const ConnectionWatcher = require('../build/Release/irsdk_node.node').ConnectionWatcher;
 // @todo For some reason this is not being built when being downloaded. It runs via prepack, but not in the built version.
 // export const DebugSDK = require("../build/Debug/irsdk_node.node").iRacingSdkNode;
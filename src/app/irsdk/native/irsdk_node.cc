@@ -1,5 +1,12 @@
 #include "./irsdk_node.h"
+#include "./frame_reader_node.h"
+#include "./recording_reader_node.h"
+#include "./connection_watcher_node.h"
+#include "./replay_context.h"
+#include "./trace.h"
+#include "./alloc_stats.h"
 #include "./lib/yaml_parser.h"
+#include "./session_json.h"
 
 /*
 Nan::SetPrototypeMethod(tmpl, "getSessionData", GetSessionData);
@@ -28,10 +35,57 @@ Napi::Object iRacingSdkNode::Init(Napi::Env env, Napi::Object exports)
     InstanceMethod("isRunning", &iRacingSdkNode::IsRunning),
     InstanceMethod("getSessionVersionNum", &iRacingSdkNode::GetSessionVersionNum),
     InstanceMethod("getSessionData", &iRacingSdkNode::GetSessionData),
+    InstanceMethod("takeParsedSession", &iRacingSdkNode::TakeParsedSession),
+    InstanceMethod("getSessionKeys", &iRacingSdkNode::GetSessionKeys),
+    InstanceMethod("getSessionJson", &iRacingSdkNode::GetSessionJson),
     InstanceMethod("getTelemetryData", &iRacingSdkNode::GetTelemetryData),
     InstanceMethod("getTelemetryVariable", &iRacingSdkNode::GetTelemetryVar),
+    InstanceMethod("getCarTable", &iRacingSdkNode::GetCarTable),
+    InstanceMethod("getSessionTables", &iRacingSdkNode::GetSessionTables),
+    InstanceMethod("getLapTiming", &iRacingSdkNode::GetLapTiming),
+    InstanceMethod("getLapDelta", &iRacingSdkNode::GetLapDelta),
+    InstanceMethod("getEvents", &iRacingSdkNode::GetEvents),
+    InstanceMethod("getSubTickSamples", &iRacingSdkNode::GetSubTickSamples),
+    // Triggers
+    InstanceMethod("addTrigger", &iRacingSdkNode::AddTrigger),
+    InstanceMethod("removeTrigger", &iRacingSdkNode::RemoveTrigger),
+    InstanceMethod("clearTriggers", &iRacingSdkNode::ClearTriggers),
+    InstanceMethod("getFiredTriggers", &iRacingSdkNode::GetFiredTriggers),
+    // History
+    InstanceMethod("addHistoryChannel", &iRacingSdkNode::AddHistoryChannel),
+    InstanceMethod("removeHistoryChannel", &iRacingSdkNode::RemoveHistoryChannel),
+    InstanceMethod("getHistory", &iRacingSdkNode::GetHistory),
+    // Frame publishing
+    InstanceMethod("startFramePublisher", &iRacingSdkNode::StartFramePublisher),
+    InstanceMethod("stopFramePublisher", &iRacingSdkNode::StopFramePublisher),
+    InstanceMethod("getPublishedFrame", &iRacingSdkNode::GetPublishedFrame),
+    InstanceMethod("startSharedFramePublisher", &iRacingSdkNode::StartSharedFramePublisher),
+    InstanceMethod("stopSharedFramePublisher", &iRacingSdkNode::StopSharedFramePublisher),
+    // Widget stream encoding
+    InstanceMethod("createFrameEncoder", &iRacingSdkNode::CreateFrameEncoder),
+    InstanceMethod("encodeFrame", &iRacingSdkNode::EncodeFrame),
+    InstanceMethod("destroyFrameEncoder", &iRacingSdkNode::DestroyFrameEncoder),
+    // Recording
+    InstanceMethod("startRecording", &iRacingSdkNode::StartRecording),
+    InstanceMethod("stopRecording", &iRacingSdkNode::StopRecording),
+    // Replay
+    InstanceMethod("setReplaySpeed", &iRacingSdkNode::SetReplaySpeed),
+    InstanceMethod("setReplayLoop", &iRacingSdkNode::SetReplayLoop),
+    InstanceMethod("seekReplay", &iRacingSdkNode::SeekReplay),
+    InstanceMethod("getReplayState", &iRacingSdkNode::GetReplayState),
+    // Tracing
+    InstanceMethod("setTracing", &iRacingSdkNode::SetTracing),
+    InstanceMethod("dumpTrace", &iRacingSdkNode::DumpTrace),
+    // Allocation stats
+    InstanceMethod("getAllocationStats", &iRacingSdkNode::GetAllocationStats),
+    // Lap delta
+    InstanceMethod("setLapDeltaCar", &iRacingSdkNode::SetLapDeltaCar),
+    InstanceMethod("saveReferenceLap", &iRacingSdkNode::SaveReferenceLap),
+    InstanceMethod("loadReferenceLap", &iRacingSdkNode::LoadReferenceLap),
+    InstanceMethod("clearReferenceLap", &iRacingSdkNode::ClearReferenceLap),
     // Helpers
-    InstanceMethod("__getTelemetryTypes", &iRacingSdkNode::__GetTelemetryTypes)
+    InstanceMethod("__getTelemetryTypes", &iRacingSdkNode::__GetTelemetryTypes),
+    InstanceMethod("__evaluateTriggers", &iRacingSdkNode::__EvaluateTriggers)
   });
 
   Napi::FunctionReference* constructor = new Napi::FunctionReference();
@@ -42,16 +96,83 @@ Napi::Object iRacingSdkNode::Init(Napi::Env env, Napi::Object exports)
   return exports;
 }
 
+// new iRacingSdkNode() reads the sim. Options pick another source:
+// { source: 'file', path } replays a telemetry file (.ibt),
+// { source: 'replay', path, speed, loop } plays an .ibt or a recording paced
+//   like the sim, at speed times real time or as fast as possible with 0,
+// { source: 'simulated', tickRate, paced } runs a made up session in process,
+// { name } reads another mapping laid out like the sim's.
+static SdkContext *CreateContext(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsObject()) return new LiveContext();
+
+  Napi::Object options = info[0].As<Napi::Object>();
+  std::string source = options.Get("source").IsString() ? options.Get("source").As<Napi::String>().Utf8Value() : "live";
+
+  if (source == "file") {
+    if (!options.Get("path").IsString()) {
+      Napi::TypeError::New(info.Env(), "A file source needs a path").ThrowAsJavaScriptException();
+      return new LiveContext();
+    }
+    return new FileContext(options.Get("path").As<Napi::String>().Utf8Value().c_str());
+  }
+  if (source == "replay") {
+    if (!options.Get("path").IsString()) {
+      Napi::TypeError::New(info.Env(), "A replay source needs a path").ThrowAsJavaScriptException();
+      return new LiveContext();
+    }
+    double speed = options.Get("speed").IsNumber() ? options.Get("speed").As<Napi::Number>().DoubleValue() : 1;
+    bool loop = options.Get("loop").IsBoolean() && options.Get("loop").As<Napi::Boolean>().Value();
+    std::string path = options.Get("path").As<Napi::String>().Utf8Value();
+    return new ReplayContext(ReplayContext::openFile(path.c_str()), speed, loop);
+  }
+  if (source == "simulated") {
+    int tickRate = options.Get("tickRate").IsNumber() ? options.Get("tickRate").As<Napi::Number>().Int32Value() : 60;
+    bool paced = !options.Get("paced").IsBoolean() || options.Get("paced").As<Napi::Boolean>().Value();
+    return new SimulatedContext(tickRate, paced);
+  }
+  if (source != "live") {
+    Napi::TypeError::New(info.Env(), "Unknown source: " + source).ThrowAsJavaScriptException();
+    return new LiveContext();
+  }
+  if (options.Get("name").IsString()) {
+    return new LiveContext(options.Get("name").As<Napi::String>().Utf8Value().c_str());
+  }
+  return new LiveContext();
+}
+
 iRacingSdkNode::iRacingSdkNode(const Napi::CallbackInfo &info)
   : Napi::ObjectWrap<iRacingSdkNode>(info)
   , _data(NULL)
+  , _dataLen(0)
   , _bufLineLen(0)
   , _sessionStatusID(0)
   , _lastSessionCt(-1)
   , _sessionData(NULL)
   , _loggingEnabled(false)
+  , _telemetryViewStatusID(-1)
+  , _tickSessionCt(-1)
+  , _carTableStringCt(0)
+  , _sessionTablesStringCt(0)
+  , _nextEncoderId(1)
+  , _recordingFile(NULL)
 {
   printf("Initializing cpp class instance...\n");
+  this->_context.reset(CreateContext(info));
+}
+
+// Instances are collected with their worker thread, so nothing may outlive them
+iRacingSdkNode::~iRacingSdkNode()
+{
+  if (this->_recordingFile) {
+    this->_recorder.finish(&this->_recordingOut);
+    this->WriteRecording();
+    fclose(this->_recordingFile);
+  }
+  this->_sharedFrameWriter.detach();
+  this->_frameWriter.detach();
+  this->_context->shutdown();
+  if (this->_data) delete[] this->_data;
 }
 
 // ---------------------------
@@ -88,8 +209,8 @@ void iRacingSdkNode::SetEnableLogging(const Napi::CallbackInfo &info, const Napi
 Napi::Value iRacingSdkNode::StartSdk(const Napi::CallbackInfo &info)
 {
   printf("Starting SDK...\n");
-  if (!irsdk_isConnected()) {
-    bool result = irsdk_startup();
+  if (!this->_context->isConnected()) {
+    bool result = this->_context->startup();
     printf("Connected at least! %i\n", result);
     return Napi::Boolean::New(info.Env(), result);
   }
@@ -98,12 +219,14 @@ Napi::Value iRacingSdkNode::StartSdk(const Napi::CallbackInfo &info)
 
 Napi::Value iRacingSdkNode::StopSdk(const Napi::CallbackInfo &info)
 {
-  irsdk_shutdown();
+  this->_context->shutdown();
+  this->EndSession();
   return Napi::Boolean::New(info.Env(), true);
 }
 
 Napi::Value iRacingSdkNode::WaitForData(const Napi::CallbackInfo &info)
 {
+  TRACE_SPAN("waitForData");
   // Figure out the time to wait
   // This will default to the timeout set on the class
   Napi::Number timeout;
@@ -113,20 +236,23 @@ Napi::Value iRacingSdkNode::WaitForData(const Napi::CallbackInfo &info)
     timeout = info[0].As<Napi::Number>();
   }
 
-  if (!irsdk_isConnected() && !irsdk_startup()) {
+  if (!this->_context->isConnected() && !this->_context->startup()) {
     return Napi::Boolean::New(info.Env(), false);
   }
 
   // @todo: try to do this async instead
-  const irsdk_header* header = irsdk_getHeader();
+  const irsdk_header* header = this->_context->header();
 
   // @todo: This isn't the best way of doing this. Need to improve, but this works for now
-  if (!this->_data) {
+  // A replay announces a longer line of a new layout before handing it out
+  if (!this->_data || this->_dataLen < header->bufLen) {
+    if (this->_data) delete[] this->_data;
     this->_data = new char[header->bufLen];
+    this->_dataLen = header->bufLen;
   }
 
   // wait for start of sesh or new data
-  bool dataReady = irsdk_waitForDataReady(timeout, this->_data);
+  bool dataReady = this->_context->waitForData(timeout, this->_data);
   if (dataReady && header)
   {
     if (this->_loggingEnabled) ("Session started or we have new data.\n");
@@ -142,22 +268,23 @@ Napi::Value iRacingSdkNode::WaitForData(const Napi::CallbackInfo &info)
 
       // Reset info str status
       this->_lastSessionCt = -1;
+      this->ProcessTick(true);
       return Napi::Boolean::New(info.Env(), true);
     } else if (this->_data) {
       if (this->_loggingEnabled) printf("Data initialized and ready to process.\n");
       // already initialized and ready to process
+      this->ProcessTick(false);
       return Napi::Boolean::New(info.Env(), true);
     }
   }
-  else if (!(this->_data != NULL && irsdk_isConnected()))
+  else if (!(this->_data != NULL && this->_context->isConnected()))
   {
     printf("Session ended. Cleaning up.\n");
     // Session ended
     if (this->_data) delete[] this->_data;
     this->_data = NULL;
-
-    // Reset Info str
-    this->_lastSessionCt = -1;
+    this->_dataLen = 0;
+    this->EndSession();
   }
   printf("Session ended or something went wrong. Not successful.\n");
   return Napi::Boolean::New(info.Env(), false);
@@ -232,170 +359,27 @@ Napi::Value iRacingSdkNode::BroadcastMessage(const Napi::CallbackInfo &info)
 // SDK State Getters
 Napi::Value iRacingSdkNode::IsRunning(const Napi::CallbackInfo &info)
 {
-  bool result = irsdk_isConnected();
+  bool result = this->_context->isConnected();
   return Napi::Boolean::New(info.Env(), result);
 }
 
 Napi::Value iRacingSdkNode::GetSessionVersionNum(const Napi::CallbackInfo &info)
 {
-  int sessVer = irsdk_getSessionInfoStrUpdate();
+  int sessVer = this->_context->sessionInfoUpdate();
   return Napi::Number::New(info.Env(), sessVer);
 }
 
-// Helper function to convert Windows-1252 to UTF-8
-std::string ConvertToUTF8(const char* input) {
-    if (!input) return "";
-    
-    std::string result;
-    result.reserve(strlen(input) * 2); // Reserve space for potential UTF-8 expansion
-    
-    for (const char* p = input; *p; ++p) {
-        unsigned char c = *p;
-        if (c < 0x80) {
-            // ASCII character
-            result += c;
-        } else {
-            // Windows-1252 to UTF-8 conversion
-            switch (c) {
-                case 0x80: result += "\xE2\x82\xAC"; break; // €
-                case 0x82: result += "\xE2\x80\x9A"; break; // ‚
-                case 0x83: result += "\xC6\x92"; break;     // ƒ
-                case 0x84: result += "\xE2\x80\x9E"; break; // „
-                case 0x85: result += "\xE2\x80\xA6"; break; // …
-                case 0x86: result += "\xE2\x80\xA0"; break; // †
-                case 0x87: result += "\xE2\x80\xA1"; break; // ‡
-                case 0x88: result += "\xCB\x86"; break;     // ˆ
-                case 0x89: result += "\xE2\x80\xB0"; break; // ‰
-                case 0x8A: result += "\xC5\xA0"; break;     // Š
-                case 0x8B: result += "\xE2\x80\xB9"; break; // ‹
-                case 0x8C: result += "\xC5\x92"; break;     // Œ
-                case 0x8E: result += "\xC5\xBD"; break;     // Ž
-                case 0x91: result += "\xE2\x80\x98"; break; // '
-                case 0x92: result += "\xE2\x80\x99"; break; // '
-                case 0x93: result += "\xE2\x80\x9C"; break; // "
-                case 0x94: result += "\xE2\x80\x9D"; break; // "
-                case 0x95: result += "\xE2\x80\xA2"; break; // •
-                case 0x96: result += "\xE2\x80\x93"; break; // –
-                case 0x97: result += "\xE2\x80\x94"; break; // —
-                case 0x98: result += "\xCB\x9C"; break;     // ˜
-                case 0x99: result += "\xE2\x84\xA2"; break; // ™
-                case 0x9A: result += "\xC5\xA1"; break;     // š
-                case 0x9B: result += "\xE2\x80\xBA"; break; // ›
-                case 0x9C: result += "\xC5\x93"; break;     // œ
-                case 0x9E: result += "\xC5\xBE"; break;     // ž
-                case 0x9F: result += "\xC5\xB8"; break;     // Ÿ
-                case 0xA0: result += "\xC2\xA0"; break;     //  
-                case 0xA1: result += "\xC2\xA1"; break;     // ¡
-                case 0xA2: result += "\xC2\xA2"; break;     // ¢
-                case 0xA3: result += "\xC2\xA3"; break;     // £
-                case 0xA4: result += "\xC2\xA4"; break;     // ¤
-                case 0xA5: result += "\xC2\xA5"; break;     // ¥
-                case 0xA6: result += "\xC2\xA6"; break;     // ¦
-                case 0xA7: result += "\xC2\xA7"; break;     // §
-                case 0xA8: result += "\xC2\xA8"; break;     // ¨
-                case 0xA9: result += "\xC2\xA9"; break;     // ©
-                case 0xAA: result += "\xC2\xAA"; break;     // ª
-                case 0xAB: result += "\xC2\xAB"; break;     // «
-                case 0xAC: result += "\xC2\xAC"; break;     // ¬
-                case 0xAD: result += "\xC2\xAD"; break;     // ­
-                case 0xAE: result += "\xC2\xAE"; break;     // ®
-                case 0xAF: result += "\xC2\xAF"; break;     // ¯
-                case 0xB0: result += "\xC2\xB0"; break;     // °
-                case 0xB1: result += "\xC2\xB1"; break;     // ±
-                case 0xB2: result += "\xC2\xB2"; break;     // ²
-                case 0xB3: result += "\xC2\xB3"; break;     // ³
-                case 0xB4: result += "\xC2\xB4"; break;     // ´
-                case 0xB5: result += "\xC2\xB5"; break;     // µ
-                case 0xB6: result += "\xC2\xB6"; break;     // ¶
-                case 0xB7: result += "\xC2\xB7"; break;     // ·
-                case 0xB8: result += "\xC2\xB8"; break;     // ¸
-                case 0xB9: result += "\xC2\xB9"; break;     // ¹
-                case 0xBA: result += "\xC2\xBA"; break;     // º
-                case 0xBB: result += "\xC2\xBB"; break;     // »
-                case 0xBC: result += "\xC2\xBC"; break;     // ¼
-                case 0xBD: result += "\xC2\xBD"; break;     // ½
-                case 0xBE: result += "\xC2\xBE"; break;     // ¾
-                case 0xBF: result += "\xC2\xBF"; break;     // ¿
-                case 0xC0: result += "\xC3\x80"; break;     // À
-                case 0xC1: result += "\xC3\x81"; break;     // Á
-                case 0xC2: result += "\xC3\x82"; break;     // Â
-                case 0xC3: result += "\xC3\x83"; break;     // Ã
-                case 0xC4: result += "\xC3\x84"; break;     // Ä
-                case 0xC5: result += "\xC3\x85"; break;     // Å
-                case 0xC6: result += "\xC3\x86"; break;     // Æ
-                case 0xC7: result += "\xC3\x87"; break;     // Ç
-                case 0xC8: result += "\xC3\x88"; break;     // È
-                case 0xC9: result += "\xC3\x89"; break;     // É
-                case 0xCA: result += "\xC3\x8A"; break;     // Ê
-                case 0xCB: result += "\xC3\x8B"; break;     // Ë
-                case 0xCC: result += "\xC3\x8C"; break;     // Ì
-                case 0xCD: result += "\xC3\x8D"; break;     // Í
-                case 0xCE: result += "\xC3\x8E"; break;     // Î
-                case 0xCF: result += "\xC3\x8F"; break;     // Ï
-                case 0xD0: result += "\xC3\x90"; break;     // Ð
-                case 0xD1: result += "\xC3\x91"; break;     // Ñ
-                case 0xD2: result += "\xC3\x92"; break;     // Ò
-                case 0xD3: result += "\xC3\x93"; break;     // Ó
-                case 0xD4: result += "\xC3\x94"; break;     // Ô
-                case 0xD5: result += "\xC3\x95"; break;     // Õ
-                case 0xD6: result += "\xC3\x96"; break;     // Ö
-                case 0xD7: result += "\xC3\x97"; break;     // ×
-                case 0xD8: result += "\xC3\x98"; break;     // Ø
-                case 0xD9: result += "\xC3\x99"; break;     // Ù
-                case 0xDA: result += "\xC3\x9A"; break;     // Ú
-                case 0xDB: result += "\xC3\x9B"; break;     // Û
-                case 0xDC: result += "\xC3\x9C"; break;     // Ü
-                case 0xDD: result += "\xC3\x9D"; break;     // Ý
-                case 0xDE: result += "\xC3\x9E"; break;     // Þ
-                case 0xDF: result += "\xC3\x9F"; break;     // ß
-                case 0xE0: result += "\xC3\xA0"; break;     // à
-                case 0xE1: result += "\xC3\xA1"; break;     // á
-                case 0xE2: result += "\xC3\xA2"; break;     // â
-                case 0xE3: result += "\xC3\xA3"; break;     // ã
-                case 0xE4: result += "\xC3\xA4"; break;     // ä
-                case 0xE5: result += "\xC3\xA5"; break;     // å
-                case 0xE6: result += "\xC3\xA6"; break;     // æ
-                case 0xE7: result += "\xC3\xA7"; break;     // ç
-                case 0xE8: result += "\xC3\xA8"; break;     // è
-                case 0xE9: result += "\xC3\xA9"; break;     // é
-                case 0xEA: result += "\xC3\xAA"; break;     // ê
-                case 0xEB: result += "\xC3\xAB"; break;     // ë
-                case 0xEC: result += "\xC3\xAC"; break;     // ì
-                case 0xED: result += "\xC3\xAD"; break;     // í
-                case 0xEE: result += "\xC3\xAE"; break;     // î
-                case 0xEF: result += "\xC3\xAF"; break;     // ï
-                case 0xF0: result += "\xC3\xB0"; break;     // ð
-                case 0xF1: result += "\xC3\xB1"; break;     // ñ
-                case 0xF2: result += "\xC3\xB2"; break;     // ò
-                case 0xF3: result += "\xC3\xB3"; break;     // ó
-                case 0xF4: result += "\xC3\xB4"; break;     // ô
-                case 0xF5: result += "\xC3\xB5"; break;     // õ
-                case 0xF6: result += "\xC3\xB6"; break;     // ö
-                case 0xF7: result += "\xC3\xB7"; break;     // ÷
-                case 0xF8: result += "\xC3\xB8"; break;     // ø
-                case 0xF9: result += "\xC3\xB9"; break;     // ù
-                case 0xFA: result += "\xC3\xBA"; break;     // ú
-                case 0xFB: result += "\xC3\xBB"; break;     // û
-                case 0xFC: result += "\xC3\xBC"; break;     // ü
-                case 0xFD: result += "\xC3\xBD"; break;     // ý
-                case 0xFE: result += "\xC3\xBE"; break;     // þ
-                case 0xFF: result += "\xC3\xBF"; break;     // ÿ
-                default: result += c; break;
-            }
-        }
-    }
-    return result;
-}
-
 Napi::Value iRacingSdkNode::GetSessionData(const Napi::CallbackInfo &info)
 {
-  int latestUpdate = irsdk_getSessionInfoStrUpdate();
+  TRACE_SPAN("getSessionData");
+  int latestUpdate = this->_context->sessionInfoUpdate();
   if (this->_lastSessionCt != latestUpdate) {
     printf("Session data has been updated (prev: %d, new: %d)\n", this->_lastSessionCt, latestUpdate);
     this->_lastSessionCt = latestUpdate;
-    this->_sessionData = irsdk_getSessionInfoStr();
+    this->_sessionData = this->_context->sessionInfo();
   }
   const char *session = this->_sessionData;
+  allocCountNapi(AllocNapiStrings);
   if (session == NULL) {
     return Napi::String::New(info.Env(), "");
   }
@@ -405,6 +389,82 @@ Napi::Value iRacingSdkNode::GetSessionData(const Napi::CallbackInfo &info)
   return Napi::String::New(info.Env(), utf8Session.c_str());
 }
 
+// The newest session update the worker finished converting since the last
+// call, as { version, json }, or null while there is none
+Napi::Value iRacingSdkNode::TakeParsedSession(const Napi::CallbackInfo &info)
+{
+  TRACE_SPAN("takeParsedSession");
+  Napi::Env env = info.Env();
+  int version;
+  if (!this->_sessionWorker.take(&this->_parsedSession, &this->_sessionIndex, &version)) return env.Null();
+
+  allocCountNapi(AllocNapiObjects);
+  allocCountNapi(AllocNapiStrings);
+  Napi::Object parsed = Napi::Object::New(env);
+  parsed.Set("version", version);
+  parsed.Set("json", Napi::String::New(env, this->_parsedSession.data(), this->_parsedSession.size()));
+  return parsed;
+}
+
+// Walks a path of keys (a string array) through the session index, -1 when
+// it doesn't lead anywhere or nothing has been taken yet
+int iRacingSdkNode::FindSessionNode(const Napi::Value &path)
+{
+  if (!this->_sessionIndex) return -1;
+  if (!path.IsArray()) return 0;
+
+  Napi::Array keys = path.As<Napi::Array>();
+  int node = 0;
+  for (uint32_t i = 0; i < keys.Length() && node >= 0; i++) {
+    Napi::Value key = keys.Get(i);
+    if (!key.IsString()) return -1;
+    std::string name = key.As<Napi::String>().Utf8Value();
+    node = this->_sessionIndex->find(node, name.c_str(), (int)name.size());
+  }
+  return node;
+}
+
+// Keys of the map at a path of the last taken session, as { keys, maps } with
+// maps flagging the keys whose values are maps themselves, or null
+Napi::Value iRacingSdkNode::GetSessionKeys(const Napi::CallbackInfo &info)
+{
+  Napi::Env env = info.Env();
+  int node = this->FindSessionNode(info.Length() > 0 ? info[0] : env.Undefined());
+  if (node < 0 || !this->_sessionIndex->isMap(node)) return env.Null();
+
+  Napi::Array keys = Napi::Array::New(env);
+  Napi::Array maps = Napi::Array::New(env);
+  uint32_t count = 0;
+  for (int child = this->_sessionIndex->firstChild(node); child >= 0; child = this->_sessionIndex->nextSibling(child)) {
+    int length;
+    const char *key = this->_sessionIndex->key(child, &length);
+    keys.Set(count, Napi::String::New(env, key, length));
+    maps.Set(count, Napi::Boolean::New(env, this->_sessionIndex->isMap(child)));
+    count++;
+  }
+  allocCountNapi(AllocNapiArrays, 2);
+  allocCountNapi(AllocNapiStrings, count);
+  allocCountNapi(AllocNapiObjects);
+
+  Napi::Object view = Napi::Object::New(env);
+  view.Set("keys", keys);
+  view.Set("maps", maps);
+  return view;
+}
+
+// The value at a path of the last taken session as JSON, or null
+Napi::Value iRacingSdkNode::GetSessionJson(const Napi::CallbackInfo &info)
+{
+  TRACE_SPAN("getSessionJson");
+  Napi::Env env = info.Env();
+  int node = this->FindSessionNode(info.Length() > 0 ? info[0] : env.Undefined());
+  if (node < 0) return env.Null();
+
+  this->_sessionIndex->toJson(node, &this->_parsedSession);
+  allocCountNapi(AllocNapiStrings);
+  return Napi::String::New(env, this->_parsedSession.data(), this->_parsedSession.size());
+}
+
 Napi::Value iRacingSdkNode::GetTelemetryVar(const Napi::CallbackInfo &info)
 {
   Napi::Env env = info.Env();
@@ -425,31 +485,732 @@ Napi::Value iRacingSdkNode::GetTelemetryVar(const Napi::CallbackInfo &info)
 
 Napi::Value iRacingSdkNode::GetTelemetryData(const Napi::CallbackInfo &info)
 {
-  const irsdk_header* header = irsdk_getHeader();
+  TRACE_SPAN("getTelemetryData");
+  const irsdk_header* header = this->_context->header();
   auto env = info.Env();
+
+  // Reuse mode hands out the same objects and value buffers every call and
+  // only copies the new line into them, so steady state frames allocate nothing
+  bool reuse = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+  if (reuse && !this->_telemetryView.IsEmpty() && this->_telemetryViewStatusID == this->_sessionStatusID) {
+    for (size_t i = 0; i < this->_telemetryCopies.size(); i++) {
+      const TelemetryCopy &copy = this->_telemetryCopies[i];
+      memcpy(copy.value, this->_data + copy.offset, copy.size);
+    }
+    return this->_telemetryView.Value();
+  }
+
   auto telemVars = Napi::Object::New(env);
-  
+  allocCountNapi(AllocNapiObjects);
+  if (reuse) this->_telemetryCopies.clear();
+
   int count = header->numVars;
   for (int i = 0; i < count; i++) {
     auto telemVariable = this->GetTelemetryVarByIndex(env, i);
     if (telemVariable.IsObject() && telemVariable.Has("name")) {
       telemVars.Set(telemVariable.Get("name"), telemVariable);
+      if (reuse) {
+        const irsdk_varHeader *var = this->_context->varEntry(i);
+        TelemetryCopy copy;
+        copy.offset = var->offset;
+        copy.size = var->count * irsdk_VarTypeBytes[var->type];
+        copy.value = telemVariable.Get("value").As<Napi::ArrayBuffer>().Data();
+        this->_telemetryCopies.push_back(copy);
+      }
     }
   }
 
+  if (reuse) {
+    this->_telemetryView = Napi::Persistent(telemVars);
+    this->_telemetryViewStatusID = this->_sessionStatusID;
+  }
   return telemVars;
 }
 
+// Creates { buffer, columns } with one typed array per column, all over the
+// same V8-owned buffer. Engines then write into buffer.Data() in place, so
+// JS keeps the same views for the lifetime of the instance.
+static Napi::Object NewColumnView(Napi::Env env, int byteLength, int columnCount, const ViewColumn &(*column)(int))
+{
+  auto buffer = Napi::ArrayBuffer::New(env, byteLength);
+  auto columns = Napi::Object::New(env);
+  for (int i = 0; i < columnCount; i++) {
+    const ViewColumn &def = column(i);
+    switch (def.type) {
+    case ViewColumn_Int32:
+      columns.Set(def.name, Napi::Int32Array::New(env, def.length, buffer, def.byteOffset));
+      break;
+    case ViewColumn_Float32:
+      columns.Set(def.name, Napi::Float32Array::New(env, def.length, buffer, def.byteOffset));
+      break;
+    case ViewColumn_Float64:
+      columns.Set(def.name, Napi::Float64Array::New(env, def.length, buffer, def.byteOffset));
+      break;
+    }
+  }
+
+  auto view = Napi::Object::New(env);
+  view.Set("buffer", buffer);
+  view.Set("columns", columns);
+  allocCountNapi(AllocNapiObjects, 2);
+  allocCountNapi(AllocNapiBuffers, 1 + columnCount);
+  return view;
+}
+
+// Intern tables only grow, so just append the strings JS hasn't seen yet
+static void AppendStrings(Napi::Env env, Napi::Array names, const StringTable &strings, int *count)
+{
+  for (int i = *count; i < strings.size(); i++) {
+    std::string utf8 = ConvertToUTF8(strings.get(i).c_str());
+    names.Set(i, Napi::String::New(env, utf8));
+  }
+  allocCountNapi(AllocNapiStrings, strings.size() - *count);
+  *count = strings.size();
+}
+
+Napi::Value iRacingSdkNode::GetCarTable(const Napi::CallbackInfo &info)
+{
+  TRACE_SPAN("getCarTable");
+  auto env = info.Env();
+
+  if (this->_carTableView.IsEmpty()) {
+    auto view = NewColumnView(env, CarTable::byteLength(), CarTable::columnCount(), &CarTable::column);
+    view.Set("strings", Napi::Array::New(env));
+    allocCountNapi(AllocNapiArrays);
+    this->_carTableView = Napi::Persistent(view);
+
+    this->_carTable.attach(static_cast<char *>(view.Get("buffer").As<Napi::ArrayBuffer>().Data()));
+    this->_carTableStringCt = 0;
+    if (this->_data && this->_context->header()) {
+      this->_carTable.updateSession(this->_context->sessionInfo());
+      this->_carTable.updateTelemetry(this->_data);
+    }
+  }
+
+  auto view = this->_carTableView.Value();
+
+  AppendStrings(env, view.Get("strings").As<Napi::Array>(), this->_carTable.strings(), &this->_carTableStringCt);
+  view.Set("sessionVersion", this->_tickSessionCt);
+
+  return view;
+}
+
+Napi::Value iRacingSdkNode::GetSessionTables(const Napi::CallbackInfo &info)
+{
+  TRACE_SPAN("getSessionTables");
+  auto env = info.Env();
+
+  if (this->_sessionTablesView.IsEmpty()) {
+    auto drivers = NewColumnView(env, SessionTables::driversByteLength(), SessionTables::driverColumnCount(),
+                                 &SessionTables::driverColumn);
+    auto results = NewColumnView(env, SessionTables::resultsByteLength(), SessionTables::resultColumnCount(),
+                                 &SessionTables::resultColumn);
+    auto view = Napi::Object::New(env);
+    view.Set("drivers", drivers);
+    view.Set("results", results);
+    view.Set("strings", Napi::Array::New(env));
+    allocCountNapi(AllocNapiObjects);
+    allocCountNapi(AllocNapiArrays);
+    view.Set("maxCars", SessionTables::MaxCars);
+    view.Set("maxSessions", SessionTables::MaxSessions);
+    this->_sessionTablesView = Napi::Persistent(view);
+
+    this->_sessionTables.attach(static_cast<char *>(drivers.Get("buffer").As<Napi::ArrayBuffer>().Data()),
+                                static_cast<char *>(results.Get("buffer").As<Napi::ArrayBuffer>().Data()));
+    this->_sessionTablesStringCt = 0;
+    if (this->_data && this->_context->header()) {
+      this->_sessionTables.updateSession(this->_context->sessionInfo());
+    }
+  }
+
+  auto view = this->_sessionTablesView.Value();
+  AppendStrings(env, view.Get("strings").As<Napi::Array>(), this->_sessionTables.strings(), &this->_sessionTablesStringCt);
+  view.Set("sessionVersion", this->_tickSessionCt);
+
+  return view;
+}
+
+Napi::Value iRacingSdkNode::GetLapTiming(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+
+  if (this->_lapTimingView.IsEmpty()) {
+    auto view = NewColumnView(env, LapTiming::byteLength(), LapTiming::columnCount(), &LapTiming::column);
+    view.Set("maxCars", LapTiming::MaxCars);
+    view.Set("maxSectors", LapTiming::MaxSectors);
+    this->_lapTimingView = Napi::Persistent(view);
+
+    this->_lapTiming.attach(static_cast<char *>(view.Get("buffer").As<Napi::ArrayBuffer>().Data()));
+    if (this->_data && this->_context->header()) {
+      this->_lapTiming.updateSectors(this->_context->sessionInfo());
+    }
+  }
+
+  return this->_lapTimingView.Value();
+}
+
+Napi::Value iRacingSdkNode::GetLapDelta(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+
+  if (this->_lapDeltaView.IsEmpty()) {
+    auto view = NewColumnView(env, LapDelta::byteLength(), LapDelta::columnCount(), &LapDelta::column);
+    view.Set("resolution", LapDelta::Resolution);
+    this->_lapDeltaView = Napi::Persistent(view);
+
+    this->_lapDelta.attach(static_cast<char *>(view.Get("buffer").As<Napi::ArrayBuffer>().Data()));
+    if (this->_data && this->_context->header()) {
+      this->_lapDelta.updateSession(this->_context->sessionInfo());
+    }
+  }
+
+  return this->_lapDeltaView.Value();
+}
+
+Napi::Value iRacingSdkNode::GetEvents(const Napi::CallbackInfo &info)
+{
+  TRACE_SPAN("getEvents");
+  auto env = info.Env();
+
+  // Detection starts with the first poll; until then there is nothing to report
+  if (!this->_events.isEnabled()) {
+    this->_events.enable();
+    allocCountNapi(AllocNapiArrays);
+    return Napi::Array::New(env);
+  }
+
+  DetectedEvent events[EventDetector::Capacity];
+  int count = this->_events.drain(events, EventDetector::Capacity);
+
+  auto result = Napi::Array::New(env, count);
+  allocCountNapi(AllocNapiArrays);
+  allocCountNapi(AllocNapiObjects, count);
+  for (int i = 0; i < count; i++) {
+    auto event = Napi::Object::New(env);
+    event.Set("type", events[i].type);
+    event.Set("carIdx", events[i].carIdx);
+    event.Set("sessionTime", events[i].sessionTime);
+    event.Set("oldValue", events[i].oldValue);
+    event.Set("newValue", events[i].newValue);
+    result.Set(i, event);
+  }
+  return result;
+}
+
+Napi::Value iRacingSdkNode::GetSubTickSamples(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  double since = info.Length() > 0 && info[0].IsNumber() ? info[0].As<Napi::Number>().DoubleValue() : 0;
+  long long next = this->_subTick.read((long long)since, &this->_subTickTimes, &this->_subTickValues);
+
+  const std::vector<std::string> &names = this->_subTick.names();
+  size_t rows = this->_subTickTimes.size();
+  auto time = Napi::Float64Array::New(env, rows);
+  for (size_t r = 0; r < rows; r++) time[r] = this->_subTickTimes[r];
+
+  // Rows come out row major, JS gets a column per var
+  auto nameList = Napi::Array::New(env, names.size());
+  auto values = Napi::Object::New(env);
+  for (size_t c = 0; c < names.size(); c++) {
+    auto column = Napi::Float32Array::New(env, rows);
+    for (size_t r = 0; r < rows; r++) column[r] = this->_subTickValues[r * names.size() + c];
+    nameList.Set((uint32_t)c, names[c]);
+    values.Set(names[c], column);
+  }
+
+  auto result = Napi::Object::New(env);
+  allocCountNapi(AllocNapiObjects, 2);
+  allocCountNapi(AllocNapiArrays);
+  allocCountNapi(AllocNapiStrings, names.size());
+  allocCountNapi(AllocNapiBuffers, 1 + names.size());
+  result.Set("next", (double)next);
+  result.Set("names", nameList);
+  result.Set("time", time);
+  result.Set("values", values);
+  return result;
+}
+
+// Triggers
+Napi::Value iRacingSdkNode::AddTrigger(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected a trigger expression").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Resolved against the live session straight away if there is one
+  std::string source = info[0].As<Napi::String>().Utf8Value();
+  std::string error;
+  int id = this->_triggers.add(source.c_str(), &error);
+  if (id < 0) {
+    Napi::Error::New(env, "Invalid trigger expression: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, id);
+}
+
+Napi::Value iRacingSdkNode::RemoveTrigger(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  int id = info[0].As<Napi::Number>().Int32Value();
+  return Napi::Boolean::New(info.Env(), this->_triggers.remove(id));
+}
+
+Napi::Value iRacingSdkNode::ClearTriggers(const Napi::CallbackInfo &info)
+{
+  this->_triggers.clear();
+  return info.Env().Undefined();
+}
+
+Napi::Value iRacingSdkNode::GetFiredTriggers(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+
+  std::vector<int> fired;
+  this->_triggers.drainFired(&fired);
+
+  auto result = Napi::Array::New(env, fired.size());
+  allocCountNapi(AllocNapiArrays);
+  for (size_t i = 0; i < fired.size(); i++) {
+    result.Set((uint32_t)i, fired[i]);
+  }
+  return result;
+}
+
+// History
+Napi::Value iRacingSdkNode::AddHistoryChannel(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected a variable name").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Resolved against the live session straight away if there is one
+  std::string name = info[0].As<Napi::String>().Utf8Value();
+  int index = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : 0;
+  int capacity = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Int32Value() : 0;
+  return Napi::Number::New(env, this->_history.add(name.c_str(), index, capacity));
+}
+
+Napi::Value iRacingSdkNode::RemoveHistoryChannel(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  int id = info[0].As<Napi::Number>().Int32Value();
+  return Napi::Boolean::New(info.Env(), this->_history.remove(id));
+}
+
+Napi::Value iRacingSdkNode::GetHistory(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+    return env.Null();
+  }
+
+  const LodPyramid *pyramid = this->_history.find(info[0].As<Napi::Number>().Int32Value());
+  if (!pyramid) return env.Null();
+
+  int width = info[1].As<Napi::Number>().Int32Value();
+  double from = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().DoubleValue() : 0;
+  double to = info.Length() > 3 && info[3].IsNumber() ? info[3].As<Napi::Number>().DoubleValue() : (double)pyramid->length();
+
+  long long first = 0;
+  int level = pyramid->query((long long)from, (long long)to, width, &this->_historyBuckets, &first);
+  size_t count = this->_historyBuckets.size();
+
+  auto min = Napi::Float32Array::New(env, count);
+  auto max = Napi::Float32Array::New(env, count);
+  auto mean = Napi::Float32Array::New(env, count);
+  for (size_t i = 0; i < count; i++) {
+    const LodPyramid::Bucket &bucket = this->_historyBuckets[i];
+    min[i] = bucket.min;
+    max[i] = bucket.max;
+    mean[i] = bucket.mean;
+  }
+
+  auto result = Napi::Object::New(env);
+  allocCountNapi(AllocNapiObjects);
+  allocCountNapi(AllocNapiBuffers, 3);
+  result.Set("length", (double)pyramid->length());
+  result.Set("first", (double)first);
+  result.Set("step", (double)(1LL << level));
+  result.Set("min", min);
+  result.Set("max", max);
+  result.Set("mean", mean);
+  return result;
+}
+
+// Frame publishing
+Napi::Value iRacingSdkNode::StartFramePublisher(const Napi::CallbackInfo &info)
+{
+  std::string name = FRAME_RING_DEFAULT_NAME;
+  if (info.Length() > 0 && info[0].IsString()) {
+    name = info[0].As<Napi::String>().Utf8Value();
+  }
+
+  int slotCapacity = FrameRing::DefaultSlotCapacity;
+  bool ok = this->_frameMemory.create(name.c_str(), FrameRing::byteLength(slotCapacity))
+    && this->_frameWriter.attach(this->_frameMemory.data(), this->_frameMemory.size(), slotCapacity);
+  if (!ok) {
+    this->_frameWriter.detach();
+    this->_frameMemory.close();
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  const irsdk_header *header = this->_context->header();
+  if (this->_data && header) {
+    this->_frameWriter.setLayout(this->_context->vars(), header->numVars, header->bufLen);
+  }
+  return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value iRacingSdkNode::StopFramePublisher(const Napi::CallbackInfo &info)
+{
+  this->_frameWriter.detach();
+  this->_frameMemory.close();
+  return info.Env().Undefined();
+}
+
+Napi::Value iRacingSdkNode::GetPublishedFrame(const Napi::CallbackInfo &info)
+{
+  return Napi::Number::New(info.Env(), this->_frameWriter.lastFrame());
+}
+
+// Takes a Uint8Array over a SharedArrayBuffer, Node-API has no type for the
+// buffer itself. The slots get whatever the view has room for past the header.
+Napi::Value iRacingSdkNode::StartSharedFramePublisher(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (info.Length() < 1 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+    Napi::TypeError::New(env, "Expected a Uint8Array").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Uint8Array view = info[0].As<Napi::Uint8Array>();
+  int size = (int)view.ByteLength();
+  int slotCapacity = ((size - FrameRing::byteLength(0)) / FrameRing::SlotCount) & ~7;
+
+  this->_sharedFrameWriter.detach();
+  this->_sharedFrameBuffer.Reset();
+  if (slotCapacity <= 0 || !this->_sharedFrameWriter.attach((char *)view.Data(), size, slotCapacity)) {
+    return Napi::Boolean::New(env, false);
+  }
+  this->_sharedFrameBuffer = Napi::Persistent(view.As<Napi::Object>());
+
+  const irsdk_header *header = this->_context->header();
+  if (this->_data && header) {
+    this->_sharedFrameWriter.setLayout(this->_context->vars(), header->numVars, header->bufLen);
+  }
+  return Napi::Boolean::New(env, true);
+}
+
+Napi::Value iRacingSdkNode::StopSharedFramePublisher(const Napi::CallbackInfo &info)
+{
+  this->_sharedFrameWriter.detach();
+  this->_sharedFrameBuffer.Reset();
+  return info.Env().Undefined();
+}
+
+// Widget stream encoding
+Napi::Value iRacingSdkNode::CreateFrameEncoder(const Napi::CallbackInfo &info)
+{
+  std::vector<std::string> names;
+  if (info.Length() > 0 && info[0].IsArray()) {
+    Napi::Array list = info[0].As<Napi::Array>();
+    for (uint32_t i = 0; i < list.Length(); i++) {
+      Napi::Value name = list.Get(i);
+      if (name.IsString()) names.push_back(name.As<Napi::String>().Utf8Value());
+    }
+  }
+  bool changeBitmap = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Napi::Boolean>().Value();
+
+  // { [name]: { precision, min, max } }
+  std::vector<FrameQuantization> quantization;
+  if (info.Length() > 2 && info[2].IsObject()) {
+    Napi::Object profile = info[2].As<Napi::Object>();
+    Napi::Array keys = profile.GetPropertyNames();
+    for (uint32_t i = 0; i < keys.Length(); i++) {
+      Napi::Value entry = profile.Get(keys.Get(i));
+      if (!entry.IsObject()) continue;
+      Napi::Object options = entry.As<Napi::Object>();
+      Napi::Value precision = options.Get("precision");
+      Napi::Value min = options.Get("min");
+      Napi::Value max = options.Get("max");
+      if (!precision.IsNumber() || !min.IsNumber() || !max.IsNumber()) continue;
+
+      FrameQuantization q;
+      q.name = keys.Get(i).As<Napi::String>().Utf8Value();
+      q.precision = precision.As<Napi::Number>().DoubleValue();
+      q.min = min.As<Napi::Number>().DoubleValue();
+      q.max = max.As<Napi::Number>().DoubleValue();
+      quantization.push_back(q);
+    }
+  }
+  bool bitPack = info.Length() < 4 || !info[3].IsBoolean() || info[3].As<Napi::Boolean>().Value();
+
+  int id = this->_nextEncoderId++;
+  FrameEncoder &encoder = this->_encoders.insert(
+    std::make_pair(id, FrameEncoder(names, changeBitmap, quantization, bitPack))).first->second;
+
+  const irsdk_header *header = this->_context->header();
+  if (this->_data && header) {
+    encoder.bindVars(this->_context->vars(), header->numVars);
+  }
+  return Napi::Number::New(info.Env(), id);
+}
+
+Napi::Value iRacingSdkNode::EncodeFrame(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  if (info.Length() < 1 || !info[0].IsNumber() || !this->_data) {
+    return env.Null();
+  }
+
+  std::map<int, FrameEncoder>::iterator it = this->_encoders.find(info[0].As<Napi::Number>().Int32Value());
+  if (it == this->_encoders.end()) {
+    return env.Null();
+  }
+
+  bool keyframe = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Napi::Boolean>().Value();
+  this->_encoded.clear();
+  if (!it->second.encode(this->_data, this->_context->tickCount(), keyframe, &this->_encoded)) {
+    return env.Null();
+  }
+
+  auto buffer = Napi::ArrayBuffer::New(env, this->_encoded.size());
+  allocCountNapi(AllocNapiBuffers);
+  memcpy(buffer.Data(), this->_encoded.data(), this->_encoded.size());
+  return buffer;
+}
+
+Napi::Value iRacingSdkNode::DestroyFrameEncoder(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  int id = info[0].As<Napi::Number>().Int32Value();
+  return Napi::Boolean::New(info.Env(), this->_encoders.erase(id) > 0);
+}
+
+// Recording
+Napi::Value iRacingSdkNode::StartRecording(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsString() || this->_recordingFile) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  this->_recordingFile = fopen(path.c_str(), "wb");
+  if (!this->_recordingFile) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  this->_recorder = RecordingEncoder();
+  this->_recordingOut.clear();
+  this->_recorder.begin(&this->_recordingOut);
+  const irsdk_header *header = this->_context->header();
+  if (this->_data && header) {
+    this->_recorder.setLayout(this->_context->vars(), header->numVars, header->bufLen, &this->_recordingOut);
+  }
+  this->WriteRecording();
+  return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value iRacingSdkNode::StopRecording(const Napi::CallbackInfo &info)
+{
+  if (!this->_recordingFile) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  this->_recorder.finish(&this->_recordingOut);
+  this->WriteRecording();
+  bool ok = !ferror(this->_recordingFile);
+  ok = fclose(this->_recordingFile) == 0 && ok;
+  this->_recordingFile = NULL;
+  return Napi::Boolean::New(info.Env(), ok);
+}
+
+// Writes out whatever the recorder produced, at most once per block
+void iRacingSdkNode::WriteRecording()
+{
+  if (this->_recordingOut.empty()) return;
+  fwrite(this->_recordingOut.data(), 1, this->_recordingOut.size(), this->_recordingFile);
+  this->_recordingOut.clear();
+}
+
+// Replay
+Napi::Value iRacingSdkNode::SetReplaySpeed(const Napi::CallbackInfo &info)
+{
+  ReplayContext *replay = this->_context->replay();
+  if (!replay || info.Length() < 1 || !info[0].IsNumber()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  replay->setSpeed(info[0].As<Napi::Number>().DoubleValue());
+  return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value iRacingSdkNode::SetReplayLoop(const Napi::CallbackInfo &info)
+{
+  ReplayContext *replay = this->_context->replay();
+  if (!replay || info.Length() < 1 || !info[0].IsBoolean()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  replay->setLoop(info[0].As<Napi::Boolean>().Value());
+  return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value iRacingSdkNode::SeekReplay(const Napi::CallbackInfo &info)
+{
+  ReplayContext *replay = this->_context->replay();
+  if (!replay || info.Length() < 1 || !info[0].IsNumber()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  return Napi::Boolean::New(info.Env(), replay->seek(info[0].As<Napi::Number>().Int32Value()));
+}
+
+Napi::Value iRacingSdkNode::GetReplayState(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  ReplayContext *replay = this->_context->replay();
+  if (!replay) {
+    return env.Null();
+  }
+
+  Napi::Object state = Napi::Object::New(env);
+  allocCountNapi(AllocNapiObjects);
+  state.Set("line", replay->line());
+  state.Set("lineCount", replay->lineCount());
+  state.Set("speed", replay->speed());
+  state.Set("loop", replay->loop());
+  state.Set("dropped", (double)replay->dropped());
+  state.Set("loops", replay->loops());
+  return state;
+}
+
+// Tracing, process wide
+Napi::Value iRacingSdkNode::SetTracing(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsBoolean()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  bool enabled = info[0].As<Napi::Boolean>().Value();
+  if (enabled && !traceEnabled()) traceSetThreadName("irsdk main");
+  traceSetEnabled(enabled);
+  return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value iRacingSdkNode::DumpTrace(const Napi::CallbackInfo &info)
+{
+  bool clear = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+  std::string json = traceDumpJson();
+  if (clear) traceClear();
+  allocCountNapi(AllocNapiStrings);
+  return Napi::String::New(info.Env(), json);
+}
+
+// Allocation stats
+static Napi::Object NewAllocationCounts(Napi::Env env, const AllocStats &stats)
+{
+  auto counts = Napi::Object::New(env);
+  counts.Set("nativeAllocs", (double)stats.counts[AllocNativeAllocs]);
+  counts.Set("nativeFrees", (double)stats.counts[AllocNativeFrees]);
+  counts.Set("nativeBytes", (double)stats.counts[AllocNativeBytes]);
+  counts.Set("napiObjects", (double)stats.counts[AllocNapiObjects]);
+  counts.Set("napiArrays", (double)stats.counts[AllocNapiArrays]);
+  counts.Set("napiStrings", (double)stats.counts[AllocNapiStrings]);
+  counts.Set("napiBuffers", (double)stats.counts[AllocNapiBuffers]);
+  return counts;
+}
+
+// Counters since the process started, for the calling thread and for every
+// thread, see alloc_stats.h. Both are read before building the result, which
+// is left out of them, so two calls in a row differ by nothing. The native
+// ones are only kept in IRSDK_ALLOC_STATS builds, native says which.
+Napi::Value iRacingSdkNode::GetAllocationStats(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  AllocStats thread;
+  AllocStats process;
+  allocThreadStats(&thread);
+  allocProcessStats(&process);
+
+  auto result = Napi::Object::New(env);
+  result.Set("thread", NewAllocationCounts(env, thread));
+  result.Set("process", NewAllocationCounts(env, process));
+  result.Set("native", allocCountsNative());
+  return result;
+}
+
+// Lap delta
+Napi::Value iRacingSdkNode::SetLapDeltaCar(const Napi::CallbackInfo &info)
+{
+  int carIdx = -1;
+  if (info.Length() > 0 && info[0].IsNumber()) {
+    carIdx = info[0].As<Napi::Number>().Int32Value();
+  }
+  if (carIdx < -1 || carIdx >= 64) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  this->_lapDelta.setCarIdx(carIdx);
+  return Napi::Boolean::New(info.Env(), true);
+}
+
+Napi::Value iRacingSdkNode::SaveReferenceLap(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsString()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  return Napi::Boolean::New(info.Env(), this->_lapDelta.saveReference(path.c_str()));
+}
+
+Napi::Value iRacingSdkNode::LoadReferenceLap(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsString()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  // Make sure the track/car check runs against the current session
+  if (this->_data && this->_context->header()) {
+    this->_lapDelta.updateSession(this->_context->sessionInfo());
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  return Napi::Boolean::New(info.Env(), this->_lapDelta.loadReference(path.c_str()));
+}
+
+Napi::Value iRacingSdkNode::ClearReferenceLap(const Napi::CallbackInfo &info)
+{
+  this->_lapDelta.clearReference();
+  return info.Env().Undefined();
+}
+
 // Helpers
 Napi::Value iRacingSdkNode::__GetTelemetryTypes(const Napi::CallbackInfo &info)
 {
   auto env = info.Env();
   auto result = Napi::Object::New(env);
 
-  const int count = irsdk_getHeader()->numVars;
+  const int count = this->_context->header()->numVars;
   const irsdk_varHeader *varHeader;
   for (int i = 0; i < count; i++) {
-    varHeader = irsdk_getVarHeaderEntry(i);
+    varHeader = this->_context->varEntry(i);
     result.Set(varHeader->name, Napi::Number::New(env, varHeader->type));
   }
 
@@ -457,40 +1218,62 @@ Napi::Value iRacingSdkNode::__GetTelemetryTypes(const Napi::CallbackInfo &info)
 }
 
 
+// Re-evaluates every trigger against the current line, for benchmarking only
+Napi::Value iRacingSdkNode::__EvaluateTriggers(const Napi::CallbackInfo &info)
+{
+  if (!this->_data) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  int iterations = 1;
+  if (info.Length() > 0 && info[0].IsNumber()) {
+    iterations = info[0].As<Napi::Number>().Int32Value();
+  }
+  for (int i = 0; i < iterations; i++) {
+    this->_triggers.update(this->_data);
+  }
+
+  // Don't leak benchmark firings into the real stream
+  std::vector<int> fired;
+  this->_triggers.drainFired(&fired);
+  return Napi::Boolean::New(info.Env(), true);
+}
+
 // ---------------------------
 // Helper functions
 // ---------------------------
 bool iRacingSdkNode::GetTelemetryBool(int entry, int index)
 {
-  const irsdk_varHeader *headerVar = irsdk_getVarHeaderEntry(entry);
+  const irsdk_varHeader *headerVar = this->_context->varEntry(entry);
   return *(reinterpret_cast<bool const *>(_data + headerVar->offset) + index);
 }
 
 int iRacingSdkNode::GetTelemetryInt(int entry, int index)
 {
   // Each int is 4 bytes
-  const irsdk_varHeader *headerVar = irsdk_getVarHeaderEntry(entry);
+  const irsdk_varHeader *headerVar = this->_context->varEntry(entry);
   return *(reinterpret_cast<int const *>(_data + headerVar->offset) + index * 4);
 }
 
 float iRacingSdkNode::GetTelemetryFloat(int entry, int index)
 {
   // Each float is 4 bytes
-  const irsdk_varHeader *headerVar = irsdk_getVarHeaderEntry(entry);
+  const irsdk_varHeader *headerVar = this->_context->varEntry(entry);
   return *(reinterpret_cast<float const *>(_data + headerVar->offset) + index * 4);
 }
 
 double iRacingSdkNode::GetTelemetryDouble(int entry, int index)
 {
   // Each double is 8 bytes
-  const irsdk_varHeader *headerVar = irsdk_getVarHeaderEntry(entry);
+  const irsdk_varHeader *headerVar = this->_context->varEntry(entry);
   return *(reinterpret_cast<double const *>(_data + headerVar->offset) + index * 8);
 }
 
 Napi::Object iRacingSdkNode::GetTelemetryVarByIndex(const Napi::Env env, int index)
 {
-  auto headerVar = irsdk_getVarHeaderEntry(index);
+  auto headerVar = this->_context->varEntry(index);
   auto telemVar = Napi::Object::New(env);
+  allocCountNapi(AllocNapiObjects);
 
   // Create entry object
   telemVar.Set("countAsTime", headerVar->countAsTime);
@@ -502,6 +1285,9 @@ Napi::Object iRacingSdkNode::GetTelemetryVarByIndex(const Napi::Env env, int ind
 
   int dataSize = headerVar->count * irsdk_VarTypeBytes[headerVar->type];
   auto entryVal = Napi::ArrayBuffer::New(env, dataSize);
+  // name, description and unit
+  allocCountNapi(AllocNapiStrings, 3);
+  allocCountNapi(AllocNapiBuffers);
   memcpy(entryVal.Data(), this->_data + headerVar->offset, dataSize);
 
   telemVar.Set("value", entryVal);
@@ -510,13 +1296,101 @@ Napi::Object iRacingSdkNode::GetTelemetryVarByIndex(const Napi::Env env, int ind
 
 Napi::Object iRacingSdkNode::GetTelemetryVar(const Napi::Env env, const char *varName)
 {
-  int varIndex = irsdk_varNameToIndex(varName);
+  int varIndex = this->_context->varIndex(varName);
   return this->GetTelemetryVarByIndex(env, varIndex);
 }
 
+// Refreshes the native derived state after a new line has been copied into _data
+void iRacingSdkNode::ProcessTick(bool newConnection)
+{
+  TRACE_SPAN(newConnection ? "processTick (new connection)" : "processTick");
+  const irsdk_header *header = this->_context->header();
+  if (!header || !this->_data) return;
+
+  if (newConnection) {
+    const irsdk_varHeader *vars = this->_context->vars();
+    // Checked against the generated var table once, the engines reading known
+    // vars share the result
+    this->_knownVars.bind(vars, header->numVars);
+    if (this->_loggingEnabled) {
+      printf("Known vars: %d bound, %d missing, %d mismatched\n", this->_knownVars.boundCount(),
+             this->_knownVars.missingCount(), this->_knownVars.mismatchedCount());
+    }
+    this->_carTable.bindVars(vars, header->numVars);
+    this->_lapTiming.bindVars(this->_knownVars);
+    this->_lapDelta.bindVars(this->_knownVars);
+    this->_events.bindVars(vars, header->numVars);
+    this->_triggers.bindVars(vars, header->numVars);
+    this->_history.bindVars(vars, header->numVars);
+    this->_subTick.bindVars(vars, header->numVars, header->tickRate);
+    this->_frameWriter.setLayout(vars, header->numVars, header->bufLen);
+    this->_sharedFrameWriter.setLayout(vars, header->numVars, header->bufLen);
+    for (std::map<int, FrameEncoder>::iterator it = this->_encoders.begin(); it != this->_encoders.end(); ++it) {
+      it->second.bindVars(vars, header->numVars);
+    }
+    if (this->_recordingFile) {
+      this->_recorder.setLayout(vars, header->numVars, header->bufLen, &this->_recordingOut);
+    }
+    this->_tickSessionCt = -1;
+  }
+
+  // Session derived state is only rebuilt when the sim bumps the update counter
+  const char *session = NULL;
+  int sessionCt = this->_context->sessionInfoUpdate();
+  if (sessionCt != this->_tickSessionCt) {
+    this->_tickSessionCt = sessionCt;
+    session = this->_context->sessionInfo();
+    if (session) this->_sessionWorker.submit(sessionCt, session);
+  }
+
+  if (this->_carTable.isAttached()) {
+    if (session) this->_carTable.updateSession(session);
+    this->_carTable.updateTelemetry(this->_data);
+  }
+  if (session && this->_sessionTables.isAttached()) this->_sessionTables.updateSession(session);
+  if (this->_lapTiming.isAttached()) {
+    if (session) this->_lapTiming.updateSectors(session);
+    this->_lapTiming.update(this->_data);
+  }
+  if (this->_lapDelta.isAttached()) {
+    if (session) this->_lapDelta.updateSession(session);
+    this->_lapDelta.update(this->_data);
+  }
+  this->_events.update(this->_data);
+  if (this->_triggers.size()) this->_triggers.update(this->_data);
+  if (this->_history.size()) this->_history.update(this->_data);
+  if (this->_subTick.isAttached()) this->_subTick.update(this->_data);
+
+  // Of the line in _data, the sim may have written newer ones since
+  int tickCount = this->_context->tickCount();
+  if (this->_frameWriter.isAttached()) {
+    this->_frameWriter.publish(this->_data, header->bufLen, tickCount);
+  }
+  if (this->_sharedFrameWriter.isAttached()) {
+    this->_sharedFrameWriter.publish(this->_data, header->bufLen, tickCount);
+  }
+  if (this->_recordingFile) {
+    this->_recorder.add(this->_data, tickCount, &this->_recordingOut);
+    this->WriteRecording();
+  }
+}
+
+// Forgets the connection, its var table goes with the mapping. The next line
+// is handled as a new connection, rebinding everything in ProcessTick(true).
+void iRacingSdkNode::EndSession()
+{
+  this->_bufLineLen = 0;
+  this->_lastSessionCt = -1;
+  this->_triggers.unbindVars();
+  this->_history.unbindVars();
+}
+
 Napi::Object InitAll(Napi::Env env, Napi::Object exports)
 {
   iRacingSdkNode::Init(env, exports);
+  FrameReaderNode::Init(env, exports);
+  RecordingReaderNode::Init(env, exports);
+  ConnectionWatcherNode::Init(env, exports);
   return exports;
 }
 
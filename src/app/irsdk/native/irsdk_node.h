@@ -2,14 +2,30 @@
 #define IRSDK_NODE_H
 
 #include <napi.h>
+#include <map>
 #include "./lib/irsdk_defines.h"
-#include "./lib/irsdk_client.h"
+#include "./car_table.h"
+#include "./session_tables.h"
+#include "./known_vars.h"
+#include "./lap_timing.h"
+#include "./lap_delta.h"
+#include "./event_detector.h"
+#include "./trigger_set.h"
+#include "./telemetry_history.h"
+#include "./sub_tick_stream.h"
+#include "./frame_encoder.h"
+#include "./recording_codec.h"
+#include "./frame_ring.h"
+#include "./shared_memory.h"
+#include "./session_worker.h"
+#include "./sdk_context.h"
 
 class iRacingSdkNode : public Napi::ObjectWrap<iRacingSdkNode>
 {
 public:
     static Napi::Object Init(Napi::Env env, Napi::Object exports);
     iRacingSdkNode(const Napi::CallbackInfo& info);
+    ~iRacingSdkNode();
 
 private:
     // Properties
@@ -27,9 +43,56 @@ private:
     Napi::Value IsRunning(const Napi::CallbackInfo &info);
     Napi::Value GetSessionVersionNum(const Napi::CallbackInfo &info);
     Napi::Value GetSessionData(const Napi::CallbackInfo &info);
+    Napi::Value TakeParsedSession(const Napi::CallbackInfo &info);
+    Napi::Value GetSessionKeys(const Napi::CallbackInfo &info);
+    Napi::Value GetSessionJson(const Napi::CallbackInfo &info);
     Napi::Value GetTelemetryData(const Napi::CallbackInfo &info);
+    Napi::Value GetCarTable(const Napi::CallbackInfo &info);
+    Napi::Value GetSessionTables(const Napi::CallbackInfo &info);
+    Napi::Value GetLapTiming(const Napi::CallbackInfo &info);
+    Napi::Value GetLapDelta(const Napi::CallbackInfo &info);
+    Napi::Value GetEvents(const Napi::CallbackInfo &info);
+    Napi::Value GetSubTickSamples(const Napi::CallbackInfo &info);
+    // Triggers
+    Napi::Value AddTrigger(const Napi::CallbackInfo &info);
+    Napi::Value RemoveTrigger(const Napi::CallbackInfo &info);
+    Napi::Value ClearTriggers(const Napi::CallbackInfo &info);
+    Napi::Value GetFiredTriggers(const Napi::CallbackInfo &info);
+    // History
+    Napi::Value AddHistoryChannel(const Napi::CallbackInfo &info);
+    Napi::Value RemoveHistoryChannel(const Napi::CallbackInfo &info);
+    Napi::Value GetHistory(const Napi::CallbackInfo &info);
+    // Frame publishing
+    Napi::Value StartFramePublisher(const Napi::CallbackInfo &info);
+    Napi::Value StopFramePublisher(const Napi::CallbackInfo &info);
+    Napi::Value GetPublishedFrame(const Napi::CallbackInfo &info);
+    Napi::Value StartSharedFramePublisher(const Napi::CallbackInfo &info);
+    Napi::Value StopSharedFramePublisher(const Napi::CallbackInfo &info);
+    // Widget stream encoding
+    Napi::Value CreateFrameEncoder(const Napi::CallbackInfo &info);
+    Napi::Value EncodeFrame(const Napi::CallbackInfo &info);
+    Napi::Value DestroyFrameEncoder(const Napi::CallbackInfo &info);
+    // Recording
+    Napi::Value StartRecording(const Napi::CallbackInfo &info);
+    Napi::Value StopRecording(const Napi::CallbackInfo &info);
+
+    Napi::Value SetReplaySpeed(const Napi::CallbackInfo &info);
+    Napi::Value SetReplayLoop(const Napi::CallbackInfo &info);
+    Napi::Value SeekReplay(const Napi::CallbackInfo &info);
+    Napi::Value GetReplayState(const Napi::CallbackInfo &info);
+
+    Napi::Value SetTracing(const Napi::CallbackInfo &info);
+    Napi::Value DumpTrace(const Napi::CallbackInfo &info);
+
+    Napi::Value GetAllocationStats(const Napi::CallbackInfo &info);
+    // Lap delta
+    Napi::Value SetLapDeltaCar(const Napi::CallbackInfo &info);
+    Napi::Value SaveReferenceLap(const Napi::CallbackInfo &info);
+    Napi::Value LoadReferenceLap(const Napi::CallbackInfo &info);
+    Napi::Value ClearReferenceLap(const Napi::CallbackInfo &info);
     // Helpers
     Napi::Value __GetTelemetryTypes(const Napi::CallbackInfo &info);
+    Napi::Value __EvaluateTriggers(const Napi::CallbackInfo &info);
     Napi::Value GetTelemetryVar(const Napi::CallbackInfo &info);
 
     bool GetTelemetryBool(int entry, int index);
@@ -38,13 +101,78 @@ private:
     double GetTelemetryDouble(int entry, int index);
     Napi::Object GetTelemetryVarByIndex(const Napi::Env env, int index);
     Napi::Object GetTelemetryVar(const Napi::Env env, const char *varName);
+    void ProcessTick(bool newConnection);
+    void EndSession();
+    void WriteRecording();
+    int FindSessionNode(const Napi::Value &path);
+
+    // Where the lines come from, see sdk_context.h
+    std::unique_ptr<SdkContext> _context;
 
     bool _loggingEnabled;
     char* _data;
+    int _dataLen;
     int _bufLineLen;
     int _sessionStatusID;
     int _lastSessionCt;
     const char* _sessionData;
+
+    // getTelemetryData(true) result, rebuilt per connection and refreshed in place
+    struct TelemetryCopy
+    {
+      int offset;
+      int size;
+      void *value; // Backing store of the var's value ArrayBuffer
+    };
+    Napi::ObjectReference _telemetryView;
+    int _telemetryViewStatusID;
+    std::vector<TelemetryCopy> _telemetryCopies;
+
+    // Session info version the tick engines were last refreshed with
+    int _tickSessionCt;
+    // Converts every session info update to JSON off the main thread
+    SessionWorker _sessionWorker;
+    std::string _parsedSession;
+    // Index of the last session handed to JS, for its lazy view
+    std::unique_ptr<SessionIndex> _sessionIndex;
+
+    // Tick engines, only refreshed once JS has asked for their view
+    CarTable _carTable;
+    Napi::ObjectReference _carTableView;
+    int _carTableStringCt;
+    SessionTables _sessionTables;
+    Napi::ObjectReference _sessionTablesView;
+    int _sessionTablesStringCt;
+    KnownVarMap _knownVars;
+    LapTiming _lapTiming;
+    Napi::ObjectReference _lapTimingView;
+    LapDelta _lapDelta;
+    Napi::ObjectReference _lapDeltaView;
+    EventDetector _events;
+    TriggerSet _triggers;
+    TelemetryHistory _history;
+    SubTickStream _subTick;
+    std::vector<double> _subTickTimes;
+    std::vector<float> _subTickValues;
+    std::vector<LodPyramid::Bucket> _historyBuckets;
+
+    // Shared memory fan-out of every line to the overlay renderers
+    SharedMemory _frameMemory;
+    FrameRingWriter _frameWriter;
+    // Same ring in a SharedArrayBuffer, for worker threads of this process.
+    // The reference keeps the buffer alive while the writer points into it.
+    FrameRingWriter _sharedFrameWriter;
+    Napi::ObjectReference _sharedFrameBuffer;
+
+    // Binary frame encoders for the widget streams, by id
+    std::map<int, FrameEncoder> _encoders;
+    int _nextEncoderId;
+    std::vector<char> _encoded;
+
+    // Compressed recording of every line, see recording_codec.h
+    RecordingEncoder _recorder;
+    FILE *_recordingFile;
+    std::vector<char> _recordingOut;
 };
 
 #endif
@@ -0,0 +1,58 @@
+#include <string>
+#include <unordered_map>
+
+#include "./known_vars.h"
+
+KnownVarMap::KnownVarMap()
+{
+  clear();
+}
+
+void KnownVarMap::clear()
+{
+  for (int i = 0; i < KnownVarCount; i++) {
+    _offsets[i] = -1;
+    _counts[i] = 0;
+    _indices[i] = -1;
+  }
+  _bound = 0;
+  _missing = KnownVarCount;
+  _mismatched = 0;
+}
+
+void KnownVarMap::bind(const irsdk_varHeader *vars, int count)
+{
+  clear();
+  if (!vars || count <= 0) return;
+
+  // The sim keeps its vars in the generated order, so walk both tables side by
+  // side and only index the names when a car has a different set
+  std::unordered_map<std::string, int> names;
+  int next = 0;
+  for (int i = 0; i < KnownVarCount; i++) {
+    const KnownVarInfo &known = knownVarTable[i];
+    int index = -1;
+    if (next < count && 0 == strncmp(known.name, vars[next].name, IRSDK_MAX_STRING)) {
+      index = next;
+    } else {
+      if (names.empty()) {
+        for (int v = 0; v < count; v++) names[std::string(vars[v].name, strnlen(vars[v].name, IRSDK_MAX_STRING))] = v;
+      }
+      std::unordered_map<std::string, int>::const_iterator it = names.find(known.name);
+      if (it != names.end()) index = it->second;
+    }
+    if (index < 0) continue;
+    next = index + 1;
+
+    _missing--;
+    const irsdk_varHeader &var = vars[index];
+    if (var.type != known.type || var.count < 1) {
+      _mismatched++;
+      continue;
+    }
+    _offsets[i] = var.offset;
+    _counts[i] = var.count;
+    _indices[i] = index;
+    _bound++;
+  }
+}
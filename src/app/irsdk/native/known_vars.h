@@ -0,0 +1,75 @@
+#ifndef KNOWN_VARS_H
+#define KNOWN_VARS_H
+
+#include <string.h>
+
+#include "./lib/irsdk_defines.h"
+#include "./_GENERATED_known_vars.h"
+
+// C++ type of each irsdk_VarType, bitfields read as int like everywhere else
+template <int Type> struct KnownVarCType;
+template <> struct KnownVarCType<irsdk_char> { typedef char type; };
+template <> struct KnownVarCType<irsdk_bool> { typedef bool type; };
+template <> struct KnownVarCType<irsdk_int> { typedef int type; };
+template <> struct KnownVarCType<irsdk_bitField> { typedef int type; };
+template <> struct KnownVarCType<irsdk_float> { typedef float type; };
+template <> struct KnownVarCType<irsdk_double> { typedef double type; };
+
+// Offsets of the generated known vars in the current var table. bind() checks
+// the table once per connection: a var the sim doesn't have, or has with
+// another type, is left unbound and its reads return the fallback, so a car
+// with a different var set degrades instead of reading the wrong bytes.
+// Counts may differ from the generated ones, reads are checked against the
+// count the sim has.
+class KnownVarMap
+{
+public:
+  KnownVarMap();
+
+  void bind(const irsdk_varHeader *vars, int count);
+  void clear();
+
+  bool has(KnownVar var) const { return _offsets[var] >= 0; }
+  int offset(KnownVar var) const { return _offsets[var]; }
+  int count(KnownVar var) const { return _counts[var]; }
+  // Index in the var table, -1 when unbound
+  int index(KnownVar var) const { return _indices[var]; }
+
+  // From the last bind()
+  int boundCount() const { return _bound; }
+  int missingCount() const { return _missing; }
+  int mismatchedCount() const { return _mismatched; }
+
+  // Typed read with no name lookup, the type comes from the generated table
+  template <KnownVar Var>
+  typename KnownVarCType<knownVarTable[Var].type>::type read(
+    const char *line, int index = 0,
+    typename KnownVarCType<knownVarTable[Var].type>::type fallback =
+      typename KnownVarCType<knownVarTable[Var].type>::type()) const
+  {
+    typedef typename KnownVarCType<knownVarTable[Var].type>::type T;
+    if (!line || _offsets[Var] < 0 || index < 0 || index >= _counts[Var]) return fallback;
+    T value;
+    memcpy(&value, line + _offsets[Var] + index * sizeof(T), sizeof(T));
+    return value;
+  }
+
+  // Pointer to every element of an array var, NULL when unbound
+  template <KnownVar Var>
+  const typename KnownVarCType<knownVarTable[Var].type>::type *array(const char *line) const
+  {
+    typedef typename KnownVarCType<knownVarTable[Var].type>::type T;
+    if (!line || _offsets[Var] < 0) return NULL;
+    return reinterpret_cast<const T *>(line + _offsets[Var]);
+  }
+
+private:
+  int _offsets[KnownVarCount];
+  int _counts[KnownVarCount];
+  int _indices[KnownVarCount];
+  int _bound;
+  int _missing;
+  int _mismatched;
+};
+
+#endif
@@ -0,0 +1,360 @@
+#include <string.h>
+
+#include "./lap_delta.h"
+#include "./native_file.h"
+#include "./session_scan.h"
+
+enum LapDeltaColumn
+{
+  LapDelta_Delta = 0,
+  LapDelta_DeltaRate,
+  LapDelta_PredictedLapTime,
+  LapDelta_CurrentLapTime,
+  LapDelta_ReferenceLapTime,
+  LapDelta_Valid,
+  LapDelta_Reference,
+  LapDelta_ColumnCount
+};
+
+static const ViewColumn lapDeltaColumns[LapDelta_ColumnCount] = {
+  { "delta", ViewColumn_Float32, 1, 0 },
+  { "deltaRate", ViewColumn_Float32, 1, 4 },
+  { "predictedLapTime", ViewColumn_Float32, 1, 8 },
+  { "currentLapTime", ViewColumn_Float32, 1, 12 },
+  { "referenceLapTime", ViewColumn_Float32, 1, 16 },
+  { "valid", ViewColumn_Int32, 1, 20 },
+  { "reference", ViewColumn_Float32, LapDelta::Resolution + 1, 24 },
+};
+
+// Reference file layout: header followed by Resolution + 1 floats
+static const char referenceMagic[4] = { 'I', 'R', 'D', 'L' };
+static const int referenceVersion = 1;
+
+struct ReferenceHeader
+{
+  char magic[4];
+  int version;
+  int trackId;
+  int carId;
+  int resolution;
+};
+
+// Smoothing time constant for the delta rate, in seconds
+static const double deltaRateTau = 0.5;
+
+// See LapTiming, anything further in one tick is a reset or tow
+static const double maxTickDistance = 0.25;
+
+int LapDelta::columnCount()
+{
+  return LapDelta_ColumnCount;
+}
+
+const ViewColumn &LapDelta::column(int index)
+{
+  return lapDeltaColumns[index];
+}
+
+int LapDelta::byteLength()
+{
+  const ViewColumn &last = lapDeltaColumns[LapDelta_ColumnCount - 1];
+  return last.byteOffset + last.length * 4;
+}
+
+LapDelta::LapDelta()
+  : _storage(NULL)
+  , _lapDistPctCount(0)
+  , _carIdx(-1)
+  , _trackId(0)
+  , _playerCarIdx(-1)
+  , _hasReference(false)
+  , _referenceCarId(0)
+  , _nextBucket(0)
+  , _lapStart(-1.0)
+  , _lastCar(-1)
+  , _lastSessionNum(-1)
+  , _lastPct(-1.0)
+  , _lastTime(-1.0)
+  , _lastDelta(0.0)
+  , _deltaRate(0.0)
+{
+  memset(_carIds, 0, sizeof(_carIds));
+  memset(_reference, 0, sizeof(_reference));
+  memset(_recording, 0, sizeof(_recording));
+}
+
+void LapDelta::attach(char *storage)
+{
+  _storage = storage;
+  clearOutputs();
+  memcpy(floats(LapDelta_Reference), _reference, sizeof(_reference));
+  floats(LapDelta_ReferenceLapTime)[0] = _hasReference ? _reference[Resolution] : -1.0f;
+}
+
+void LapDelta::bindVars(const irsdk_varHeader *vars, int count)
+{
+  KnownVarMap known;
+  known.bind(vars, count);
+  bindVars(known);
+}
+
+void LapDelta::bindVars(const KnownVarMap &vars)
+{
+  _vars = vars;
+  int cars = _vars.count(KnownVar_CarIdxLapDistPct);
+  _lapDistPctCount = cars < 64 ? cars : 64;
+
+  _lastCar = -1;
+  _lapStart = -1.0;
+  _lastPct = -1.0;
+}
+
+void LapDelta::updateSession(const char *yaml)
+{
+  SessionBlock root = sessionRoot(yaml);
+  SessionField field;
+  if (sessionFindValue(root, "WeekendInfo:TrackID", &field)) {
+    int trackId = sessionFieldInt(field);
+    // A different track invalidates whatever we had
+    if (_trackId && trackId != _trackId) clearReference();
+    _trackId = trackId;
+  }
+  if (sessionFindValue(root, "DriverInfo:DriverCarIdx", &field)) _playerCarIdx = sessionFieldInt(field, -1);
+
+  memset(_carIds, 0, sizeof(_carIds));
+  SessionBlock drivers;
+  if (!sessionFindBlock(root, "DriverInfo:Drivers:", &drivers)) return;
+
+  SessionListCursor entries(drivers);
+  SessionBlock entry;
+  while (entries.next(&entry)) {
+    if (!sessionFindValue(entry, "CarIdx", &field)) continue;
+    int carIdx = sessionFieldInt(field, -1);
+    if (carIdx < 0 || carIdx >= 64 || !sessionFindValue(entry, "CarID", &field)) continue;
+    _carIds[carIdx] = sessionFieldInt(field);
+  }
+  // So does a different car, e.g. the player switched cars on the same track
+  checkReferenceCar(trackedCarId());
+}
+
+void LapDelta::setCarIdx(int carIdx)
+{
+  if (carIdx == _carIdx) return;
+  _carIdx = carIdx;
+  // Lap times of another car are not comparable
+  clearReference();
+  _lastCar = -1;
+}
+
+void LapDelta::clearReference()
+{
+  _hasReference = false;
+  _referenceCarId = 0;
+  memset(_reference, 0, sizeof(_reference));
+  if (_storage) attach(_storage);
+}
+
+void LapDelta::update(const char *data)
+{
+  if (!_storage || !data || !_vars.has(KnownVar_SessionTime) || !_vars.has(KnownVar_CarIdxLapDistPct)) return;
+
+  double time = _vars.read<KnownVar_SessionTime>(data);
+  int sessionNum = _vars.read<KnownVar_SessionNum>(data);
+  int car = trackedCar(data);
+  if (car < 0 || car >= _lapDistPctCount) {
+    clearOutputs();
+    _lastCar = -1;
+    return;
+  }
+
+  // New session, different car or a replay rewind: start over at the next line crossing
+  if (car != _lastCar || sessionNum != _lastSessionNum || time < _lastTime) {
+    if (car != _lastCar) checkReferenceCar(_carIds[car]);
+    _lastCar = car;
+    _lastSessionNum = sessionNum;
+    _lapStart = -1.0;
+    _lastPct = -1.0;
+  }
+  if (time == _lastTime) return;
+
+  double pct = _vars.array<KnownVar_CarIdxLapDistPct>(data)[car];
+  if (pct < 0.0 || _lastPct < 0.0) {
+    _lapStart = -1.0;
+  } else {
+    double distance = pct - _lastPct;
+    if (distance < -0.5) distance += 1.0;
+    else if (distance > 0.5) distance -= 1.0;
+
+    if (distance < 0.0 || distance > maxTickDistance) {
+      _lapStart = -1.0;
+    } else if (pct < _lastPct) {
+      // Crossed the line, interpolate when
+      double crossing = _lastTime + (time - _lastTime) * ((1.0 - _lastPct) / distance);
+      if (_lapStart >= 0.0) {
+        record(_lastPct, _lastTime, 1.0, crossing);
+        completeLap(crossing);
+      }
+      restartLap(crossing);
+      record(0.0, crossing, pct, time);
+    } else if (_lapStart >= 0.0) {
+      record(_lastPct, _lastTime, pct, time);
+    }
+  }
+
+  double dt = time - _lastTime;
+  _lastPct = pct;
+  _lastTime = time;
+
+  if (_lapStart < 0.0 || !_hasReference) {
+    clearOutputs();
+    floats(LapDelta_CurrentLapTime)[0] = _lapStart >= 0.0 ? (float)(time - _lapStart) : -1.0f;
+    return;
+  }
+
+  double elapsed = time - _lapStart;
+  double delta = elapsed - referenceAt(pct);
+  int *valid = ints(LapDelta_Valid);
+  if (valid[0] && dt > 0.0) {
+    double rate = (delta - _lastDelta) / dt;
+    _deltaRate += (rate - _deltaRate) * (dt / (deltaRateTau + dt));
+  } else {
+    _deltaRate = 0.0;
+  }
+  _lastDelta = delta;
+
+  floats(LapDelta_Delta)[0] = (float)delta;
+  floats(LapDelta_DeltaRate)[0] = (float)_deltaRate;
+  floats(LapDelta_PredictedLapTime)[0] = (float)(_reference[Resolution] + delta);
+  floats(LapDelta_CurrentLapTime)[0] = (float)elapsed;
+  valid[0] = 1;
+}
+
+int LapDelta::trackedCar(const char *data) const
+{
+  if (_carIdx >= 0) return _carIdx;
+  return _vars.read<KnownVar_PlayerCarIdx>(data, 0, -1);
+}
+
+// CarID of the tracked car by the session alone, 0 when not known
+int LapDelta::trackedCarId() const
+{
+  int car = _carIdx >= 0 ? _carIdx : _playerCarIdx;
+  return car >= 0 && car < 64 ? _carIds[car] : 0;
+}
+
+// Drops a reference driven in another car than carId
+void LapDelta::checkReferenceCar(int carId)
+{
+  if (_hasReference && _referenceCarId && carId && carId != _referenceCarId) clearReference();
+}
+
+void LapDelta::restartLap(double lapStart)
+{
+  // The delta starts over at about 0, that jump is no rate
+  clearOutputs();
+  _lapStart = lapStart;
+  _recording[0] = 0.0f;
+  _nextBucket = 1;
+}
+
+// Fills every bucket passed between two samples with the interpolated elapsed time
+void LapDelta::record(double fromPct, double fromTime, double toPct, double toTime)
+{
+  double span = toPct - fromPct;
+  for (; _nextBucket <= Resolution; _nextBucket++) {
+    double bucketPct = (double)_nextBucket / Resolution;
+    if (bucketPct > toPct) break;
+
+    double t = span > 0.0 ? fromTime + (toTime - fromTime) * ((bucketPct - fromPct) / span) : toTime;
+    _recording[_nextBucket] = (float)(t - _lapStart);
+  }
+}
+
+void LapDelta::completeLap(double crossing)
+{
+  // Only fully observed laps can become the reference
+  if (_nextBucket != Resolution + 1) return;
+
+  _recording[Resolution] = (float)(crossing - _lapStart);
+  if (_hasReference && _recording[Resolution] >= _reference[Resolution]) return;
+
+  memcpy(_reference, _recording, sizeof(_reference));
+  _hasReference = true;
+  _referenceCarId = _lastCar >= 0 ? _carIds[_lastCar] : 0;
+  memcpy(floats(LapDelta_Reference), _reference, sizeof(_reference));
+  floats(LapDelta_ReferenceLapTime)[0] = _reference[Resolution];
+}
+
+double LapDelta::referenceAt(double pct) const
+{
+  double pos = pct * Resolution;
+  int index = (int)pos;
+  if (index >= Resolution) return _reference[Resolution];
+  if (index < 0) return 0.0;
+
+  double frac = pos - index;
+  return _reference[index] + (_reference[index + 1] - _reference[index]) * frac;
+}
+
+// Also restarts the delta rate: a new lap (a completed one swaps the
+// reference just before) and attach() after clearing or loading one
+void LapDelta::clearOutputs()
+{
+  _lastDelta = 0.0;
+  _deltaRate = 0.0;
+  if (!_storage) return;
+  floats(LapDelta_Delta)[0] = 0.0f;
+  floats(LapDelta_DeltaRate)[0] = 0.0f;
+  floats(LapDelta_PredictedLapTime)[0] = -1.0f;
+  floats(LapDelta_CurrentLapTime)[0] = -1.0f;
+  ints(LapDelta_Valid)[0] = 0;
+}
+
+bool LapDelta::saveReference(const char *path) const
+{
+  if (!_hasReference || !path) return false;
+
+  FILE *file = openFileUtf8(path, "wb");
+  if (!file) return false;
+
+  ReferenceHeader header;
+  memcpy(header.magic, referenceMagic, sizeof(header.magic));
+  header.version = referenceVersion;
+  header.trackId = _trackId;
+  header.carId = _referenceCarId;
+  header.resolution = Resolution;
+
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+    && fwrite(_reference, sizeof(_reference), 1, file) == 1;
+  ok = 0 == fclose(file) && ok;
+  return ok;
+}
+
+bool LapDelta::loadReference(const char *path)
+{
+  if (!path) return false;
+
+  FILE *file = openFileUtf8(path, "rb");
+  if (!file) return false;
+
+  ReferenceHeader header;
+  float reference[Resolution + 1];
+  bool ok = fread(&header, sizeof(header), 1, file) == 1
+    && 0 == memcmp(header.magic, referenceMagic, sizeof(header.magic))
+    && header.version == referenceVersion
+    && header.resolution == Resolution
+    && fread(reference, sizeof(reference), 1, file) == 1;
+  fclose(file);
+  if (!ok) return false;
+
+  // Refuse laps driven elsewhere or in another car
+  if (_trackId && header.trackId != _trackId) return false;
+  int carId = trackedCarId();
+  if (carId && header.carId != carId) return false;
+
+  memcpy(_reference, reference, sizeof(_reference));
+  _hasReference = true;
+  _referenceCarId = header.carId;
+  if (_storage) attach(_storage);
+  return true;
+}
@@ -0,0 +1,85 @@
+#ifndef LAP_DELTA_H
+#define LAP_DELTA_H
+
+#include "./lib/irsdk_defines.h"
+#include "./view_column.h"
+#include "./known_vars.h"
+
+// Live delta to a reference lap for one car (the player's by default).
+// The reference is a fixed-resolution LapDistPct -> elapsed time table, so
+// each tick is an O(1) interpolated lookup instead of a search.
+//
+// The reference is the fastest fully observed lap, or one loaded from disk
+// until it is beaten.
+class LapDelta
+{
+public:
+  // Buckets per lap; entry i is the elapsed time at LapDistPct i / Resolution,
+  // entry Resolution is the lap time itself.
+  static const int Resolution = 1000;
+
+  static int columnCount();
+  static const ViewColumn &column(int index);
+  static int byteLength();
+
+  LapDelta();
+
+  // Storage must be at least byteLength() bytes, see CarTable::attach
+  void attach(char *storage);
+  void detach() { _storage = NULL; }
+  bool isAttached() const { return _storage != NULL; }
+
+  void bindVars(const irsdk_varHeader *vars, int count);
+  // Same, with a table already checked for this connection
+  void bindVars(const KnownVarMap &vars);
+  void updateSession(const char *yaml);
+  void update(const char *data);
+
+  // -1 follows PlayerCarIdx
+  void setCarIdx(int carIdx);
+  void clearReference();
+
+  // Compact binary reference file, tagged with the track and car it was driven with
+  bool saveReference(const char *path) const;
+  bool loadReference(const char *path);
+
+private:
+  int trackedCar(const char *data) const;
+  int trackedCarId() const;
+  void checkReferenceCar(int carId);
+  void restartLap(double lapStart);
+  void record(double fromPct, double fromTime, double toPct, double toTime);
+  void completeLap(double crossing);
+  double referenceAt(double pct) const;
+  void clearOutputs();
+
+  float *floats(int column) const { return reinterpret_cast<float *>(_storage + LapDelta::column(column).byteOffset); }
+  int *ints(int column) const { return reinterpret_cast<int *>(_storage + LapDelta::column(column).byteOffset); }
+
+  char *_storage;
+  KnownVarMap _vars;
+  int _lapDistPctCount;
+
+  int _carIdx;
+  int _trackId;
+  int _playerCarIdx; // From the session, for checks made between lines
+  int _carIds[64];
+
+  // Reference lap, also mirrored into the "reference" column
+  float _reference[Resolution + 1];
+  bool _hasReference;
+  int _referenceCarId;
+
+  // Lap being recorded
+  float _recording[Resolution + 1];
+  int _nextBucket;
+  double _lapStart;
+  int _lastCar;
+  int _lastSessionNum;
+  double _lastPct;
+  double _lastTime;
+  double _lastDelta;
+  double _deltaRate;
+};
+
+#endif
@@ -0,0 +1,275 @@
+#include <string.h>
+
+#include "./lap_timing.h"
+#include "./session_scan.h"
+
+enum LapTimingColumn
+{
+  LapTiming_CurrentLapTime = 0,
+  LapTiming_LastLapTime,
+  LapTiming_BestLapTime,
+  LapTiming_CurrentSector,
+  LapTiming_TimedLaps,
+  LapTiming_CurrentSectorTimes,
+  LapTiming_LastSectorTimes,
+  LapTiming_BestSectorTimes,
+  LapTiming_SectorStartPct,
+  LapTiming_SectorCount,
+  LapTiming_ColumnCount
+};
+
+static const int carBytes = LapTiming::MaxCars * 4;
+static const int sectorBytes = LapTiming::MaxCars * LapTiming::MaxSectors * 4;
+
+static const ViewColumn lapTimingColumns[LapTiming_ColumnCount] = {
+  { "currentLapTime", ViewColumn_Float32, LapTiming::MaxCars, 0 },
+  { "lastLapTime", ViewColumn_Float32, LapTiming::MaxCars, carBytes },
+  { "bestLapTime", ViewColumn_Float32, LapTiming::MaxCars, carBytes * 2 },
+  { "currentSector", ViewColumn_Int32, LapTiming::MaxCars, carBytes * 3 },
+  { "timedLaps", ViewColumn_Int32, LapTiming::MaxCars, carBytes * 4 },
+  { "currentSectorTimes", ViewColumn_Float32, LapTiming::MaxCars * LapTiming::MaxSectors, carBytes * 5 },
+  { "lastSectorTimes", ViewColumn_Float32, LapTiming::MaxCars * LapTiming::MaxSectors, carBytes * 5 + sectorBytes },
+  { "bestSectorTimes", ViewColumn_Float32, LapTiming::MaxCars * LapTiming::MaxSectors, carBytes * 5 + sectorBytes * 2 },
+  { "sectorStartPct", ViewColumn_Float32, LapTiming::MaxSectors, carBytes * 5 + sectorBytes * 3 },
+  { "sectorCount", ViewColumn_Int32, 1, carBytes * 5 + sectorBytes * 3 + LapTiming::MaxSectors * 4 },
+};
+
+// A car moving further than this in one tick was reset or towed, not driven
+static const double maxTickDistance = 0.25;
+
+int LapTiming::columnCount()
+{
+  return LapTiming_ColumnCount;
+}
+
+const ViewColumn &LapTiming::column(int index)
+{
+  return lapTimingColumns[index];
+}
+
+int LapTiming::byteLength()
+{
+  const ViewColumn &last = lapTimingColumns[LapTiming_ColumnCount - 1];
+  return last.byteOffset + last.length * 4;
+}
+
+LapTiming::LapTiming()
+  : _storage(NULL)
+  , _lapDistPctCount(0)
+  , _sectorCount(1)
+  , _lastSessionTime(-1.0)
+  , _lastSessionNum(-1)
+{
+  _sectorStart[0] = 0.0;
+  for (int i = 0; i < MaxCars; i++) {
+    _cars[i].lastPct = -1.0;
+  }
+}
+
+void LapTiming::attach(char *storage)
+{
+  _storage = storage;
+  reset();
+
+  float *starts = floats(LapTiming_SectorStartPct);
+  for (int i = 0; i < MaxSectors; i++) {
+    starts[i] = i < _sectorCount ? (float)_sectorStart[i] : -1.0f;
+  }
+  ints(LapTiming_SectorCount)[0] = _sectorCount;
+}
+
+void LapTiming::bindVars(const irsdk_varHeader *vars, int count)
+{
+  KnownVarMap known;
+  known.bind(vars, count);
+  bindVars(known);
+}
+
+void LapTiming::bindVars(const KnownVarMap &vars)
+{
+  _vars = vars;
+  int cars = _vars.count(KnownVar_CarIdxLapDistPct);
+  _lapDistPctCount = cars < MaxCars ? cars : MaxCars;
+  reset();
+}
+
+void LapTiming::updateSectors(const char *yaml)
+{
+  int count = 0;
+  double starts[MaxSectors];
+
+  SessionBlock sectors;
+  if (sessionFindBlock(sessionRoot(yaml), "SplitTimeInfo:Sectors:", &sectors)) {
+    SessionListCursor entries(sectors);
+    SessionBlock entry;
+    while (count < MaxSectors && entries.next(&entry)) {
+      SessionField field;
+      if (!sessionFindValue(entry, "SectorStartPct", &field)) continue;
+      starts[count++] = sessionFieldDouble(field);
+    }
+  }
+
+  // Without split info (or a malformed one) fall back to whole laps only
+  bool valid = count > 0 && starts[0] == 0.0;
+  for (int i = 1; valid && i < count; i++) {
+    valid = starts[i] > starts[i - 1] && starts[i] < 1.0;
+  }
+  if (!valid) {
+    starts[0] = 0.0;
+    count = 1;
+  }
+
+  bool changed = count != _sectorCount || 0 != memcmp(starts, _sectorStart, sizeof(double) * count);
+  if (!changed) return;
+
+  _sectorCount = count;
+  memcpy(_sectorStart, starts, sizeof(double) * count);
+  if (_storage) attach(_storage);
+}
+
+void LapTiming::reset()
+{
+  for (int i = 0; i < MaxCars; i++) {
+    _cars[i].lastPct = -1.0;
+    _cars[i].lapStart = -1.0;
+    _cars[i].sectorStart = -1.0;
+    _cars[i].sector = 0;
+  }
+  _lastSessionTime = -1.0;
+
+  if (!_storage) return;
+  for (int col = LapTiming_CurrentLapTime; col <= LapTiming_BestSectorTimes; col++) {
+    const ViewColumn &def = lapTimingColumns[col];
+    if (def.type == ViewColumn_Float32) {
+      float *values = floats(col);
+      for (int i = 0; i < def.length; i++) values[i] = -1.0f;
+    } else {
+      memset(ints(col), 0, def.length * 4);
+    }
+  }
+}
+
+void LapTiming::update(const char *data)
+{
+  if (!_storage || !data || !_vars.has(KnownVar_SessionTime) || !_vars.has(KnownVar_CarIdxLapDistPct)) return;
+
+  double time = _vars.read<KnownVar_SessionTime>(data);
+  int sessionNum = _vars.read<KnownVar_SessionNum>(data);
+
+  // New session, or time jumped backwards (replay rewind)
+  if (sessionNum != _lastSessionNum || time < _lastSessionTime) {
+    reset();
+    _lastSessionNum = sessionNum;
+  }
+  // Paused, nothing moved
+  if (time == _lastSessionTime) return;
+  _lastSessionTime = time;
+
+  const float *pcts = _vars.array<KnownVar_CarIdxLapDistPct>(data);
+  float *currentLapTime = floats(LapTiming_CurrentLapTime);
+  int *currentSector = ints(LapTiming_CurrentSector);
+
+  for (int car = 0; car < _lapDistPctCount; car++) {
+    CarState &state = _cars[car];
+    double pct = pcts[car];
+
+    if (pct < 0.0) {
+      // Not in world
+      state.lastPct = -1.0;
+      state.lapStart = -1.0;
+      state.sectorStart = -1.0;
+      currentLapTime[car] = -1.0f;
+      continue;
+    }
+
+    if (state.lastPct < 0.0) {
+      invalidate(car, pct);
+    } else {
+      double distance = pct - state.lastPct;
+      if (distance < -0.5) distance += 1.0;
+      else if (distance > 0.5) distance -= 1.0;
+
+      if (distance < 0.0 || distance > maxTickDistance) {
+        // Reversing, reset to pits or towed; the current lap can't be timed
+        invalidate(car, pct);
+      } else {
+        // Walk every boundary passed since the previous tick
+        while (distance > 0.0) {
+          int next = (state.sector + 1) % _sectorCount;
+          double toBoundary = _sectorStart[next] - state.lastPct;
+          if (toBoundary <= 0.0) toBoundary += 1.0;
+          if (toBoundary > distance) break;
+
+          double fraction = toBoundary / distance;
+          double crossing = state.lastTime + (time - state.lastTime) * fraction;
+          crossBoundary(car, crossing);
+
+          distance -= toBoundary;
+          state.lastPct = _sectorStart[next];
+          state.lastTime = crossing;
+        }
+      }
+    }
+
+    state.lastPct = pct;
+    state.lastTime = time;
+    currentSector[car] = state.sector;
+    currentLapTime[car] = state.lapStart >= 0.0 ? (float)(time - state.lapStart) : -1.0f;
+  }
+}
+
+int LapTiming::sectorOf(double pct) const
+{
+  int sector = 0;
+  for (int i = 1; i < _sectorCount; i++) {
+    if (_sectorStart[i] <= pct) sector = i;
+  }
+  return sector;
+}
+
+void LapTiming::invalidate(int carIdx, double pct)
+{
+  CarState &state = _cars[carIdx];
+  state.sector = sectorOf(pct);
+  state.lapStart = -1.0;
+  state.sectorStart = -1.0;
+
+  float *sectorTimes = floats(LapTiming_CurrentSectorTimes) + carIdx * MaxSectors;
+  for (int i = 0; i < MaxSectors; i++) sectorTimes[i] = -1.0f;
+}
+
+void LapTiming::crossBoundary(int carIdx, double time)
+{
+  CarState &state = _cars[carIdx];
+  float *current = floats(LapTiming_CurrentSectorTimes) + carIdx * MaxSectors;
+
+  if (state.sectorStart >= 0.0) {
+    float sectorTime = (float)(time - state.sectorStart);
+    float *best = floats(LapTiming_BestSectorTimes) + carIdx * MaxSectors;
+    current[state.sector] = sectorTime;
+    if (best[state.sector] < 0.0f || sectorTime < best[state.sector]) {
+      best[state.sector] = sectorTime;
+    }
+  }
+
+  state.sector = (state.sector + 1) % _sectorCount;
+  state.sectorStart = time;
+
+  if (state.sector != 0) return;
+
+  // Crossed the line
+  if (state.lapStart >= 0.0) {
+    float lapTime = (float)(time - state.lapStart);
+    float *best = floats(LapTiming_BestLapTime);
+    floats(LapTiming_LastLapTime)[carIdx] = lapTime;
+    if (best[carIdx] < 0.0f || lapTime < best[carIdx]) {
+      best[carIdx] = lapTime;
+    }
+    ints(LapTiming_TimedLaps)[carIdx]++;
+
+    float *last = floats(LapTiming_LastSectorTimes) + carIdx * MaxSectors;
+    memcpy(last, current, sizeof(float) * MaxSectors);
+  }
+  for (int i = 0; i < MaxSectors; i++) current[i] = -1.0f;
+  state.lapStart = time;
+}
@@ -0,0 +1,70 @@
+#ifndef LAP_TIMING_H
+#define LAP_TIMING_H
+
+#include "./lib/irsdk_defines.h"
+#include "./view_column.h"
+#include "./known_vars.h"
+
+// Lap and sector timing for every car, derived from CarIdxLapDistPct and the
+// SplitTimeInfo sector boundaries. Crossings are interpolated between ticks
+// using SessionTime so splits are not quantised to the 16ms tick.
+//
+// All times are in seconds, -1 when unknown (e.g. the car has not completed a
+// fully observed lap yet). Sector arrays are flattened as
+// [carIdx * MaxSectors + sectorNum].
+class LapTiming
+{
+public:
+  static const int MaxCars = 64;
+  static const int MaxSectors = 16;
+
+  static int columnCount();
+  static const ViewColumn &column(int index);
+  static int byteLength();
+
+  LapTiming();
+
+  // Storage must be at least byteLength() bytes, see CarTable::attach
+  void attach(char *storage);
+  void detach() { _storage = NULL; }
+  bool isAttached() const { return _storage != NULL; }
+
+  void bindVars(const irsdk_varHeader *vars, int count);
+  // Same, with a table already checked for this connection
+  void bindVars(const KnownVarMap &vars);
+  void updateSectors(const char *yaml);
+  void update(const char *data);
+
+  // Forget all timing state, e.g. when a new session starts
+  void reset();
+
+private:
+  struct CarState
+  {
+    double lastPct;     // -1 when not in world
+    double lastTime;
+    double lapStart;    // -1 until the car has crossed the line under observation
+    double sectorStart; // -1 until the car has crossed a sector boundary
+    int sector;
+  };
+
+  int sectorOf(double pct) const;
+  void invalidate(int carIdx, double pct);
+  void crossBoundary(int carIdx, double time);
+
+  float *floats(int column) const { return reinterpret_cast<float *>(_storage + LapTiming::column(column).byteOffset); }
+  int *ints(int column) const { return reinterpret_cast<int *>(_storage + LapTiming::column(column).byteOffset); }
+
+  char *_storage;
+  KnownVarMap _vars;
+  int _lapDistPctCount;
+
+  int _sectorCount;
+  double _sectorStart[MaxSectors];
+
+  double _lastSessionTime;
+  int _lastSessionNum;
+  CarState _cars[MaxCars];
+};
+
+#endif
@@ -81,7 +81,15 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Constant Definitions
 
+#ifdef _WIN32
 #include <tchar.h>
+#else
+// The relay and the simulated producer also build on POSIX
+#include <string.h>
+#include <time.h>
+typedef char _TCHAR;
+#define _T(x) x
+#endif
 
 static const _TCHAR IRSDK_DATAVALIDEVENTNAME[] = _T("Local\\IRSDKDataValidEvent");
 static const _TCHAR IRSDK_MEMMAPFILENAME[]     = _T("Local\\IRSDKMemMapFileName");
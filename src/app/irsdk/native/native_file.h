@@ -0,0 +1,35 @@
+#ifndef NATIVE_FILE_H
+#define NATIVE_FILE_H
+
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// fopen for UTF-8 paths coming from JS. On Windows the narrow fopen uses the
+// ANSI code page, which breaks user data paths with non-ASCII user names.
+inline FILE *openFileUtf8(const char *path, const char *mode)
+{
+#ifdef _WIN32
+  wchar_t wpath[MAX_PATH * 2];
+  wchar_t wmode[8];
+  if (!MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath, MAX_PATH * 2)) return NULL;
+  if (!MultiByteToWideChar(CP_UTF8, 0, mode, -1, wmode, 8)) return NULL;
+  return _wfopen(wpath, wmode);
+#else
+  return fopen(path, mode);
+#endif
+}
+
+// fseek past 2GB, where long is 32 bits on Windows
+inline bool seekFile(FILE *file, long long offset)
+{
+#ifdef _WIN32
+  return 0 == _fseeki64(file, offset, SEEK_SET);
+#else
+  return 0 == fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+#endif
@@ -0,0 +1,513 @@
+#include <string.h>
+
+#include "./recording_codec.h"
+
+static const char recordingMagic[4] = {'I', 'R', 'T', 'C'};
+static const uint32_t recordingVersion = 1;
+static const char layoutRecord = 'L';
+static const char blockRecord = 'B';
+static const int recordHeaderSize = 5;
+
+enum ChannelKind
+{
+  Kind_Xor32 = 0,
+  Kind_Xor64,
+  Kind_Delta,
+  Kind_Run8,
+  Kind_Run32,
+};
+
+static int channelKind(int varType)
+{
+  switch (varType) {
+    case irsdk_float: return Kind_Xor32;
+    case irsdk_double: return Kind_Xor64;
+    case irsdk_int: return Kind_Delta;
+    case irsdk_bitField: return Kind_Run32;
+    default: return Kind_Run8; // char, bool
+  }
+}
+
+// ---------------------------
+// Byte and bit streams
+// ---------------------------
+static void putVarint(std::vector<char> *out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out->push_back((char)(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back((char)value);
+}
+
+static bool getVarint(const char **at, const char *end, uint64_t *value)
+{
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64 && *at < end; shift += 7) {
+    uint8_t byte = (uint8_t)*(*at)++;
+    result |= (uint64_t)(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+static uint64_t zigzag(int64_t value)
+{
+  return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value)
+{
+  return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+class BitWriter
+{
+public:
+  explicit BitWriter(std::vector<char> *out) : _out(out), _acc(0), _bits(0) {}
+
+  void write(uint64_t value, int bits)
+  {
+    while (bits > 0) {
+      int take = bits < 8 - _bits ? bits : 8 - _bits;
+      uint8_t chunk = (uint8_t)((value >> (bits - take)) & ((1u << take) - 1));
+      _acc = (uint8_t)((_acc << take) | chunk);
+      _bits += take;
+      bits -= take;
+      if (_bits == 8) {
+        _out->push_back((char)_acc);
+        _acc = 0;
+        _bits = 0;
+      }
+    }
+  }
+
+  void flush()
+  {
+    if (_bits) _out->push_back((char)(_acc << (8 - _bits)));
+    _acc = 0;
+    _bits = 0;
+  }
+
+private:
+  std::vector<char> *_out;
+  uint8_t _acc;
+  int _bits;
+};
+
+class BitReader
+{
+public:
+  BitReader(const char *data, const char *end) : _at(data), _end(end), _bit(0), _overrun(false) {}
+
+  uint64_t read(int bits)
+  {
+    uint64_t value = 0;
+    while (bits > 0) {
+      if (_at >= _end) {
+        _overrun = true;
+        return 0;
+      }
+      int take = bits < 8 - _bit ? bits : 8 - _bit;
+      uint8_t byte = (uint8_t)*_at;
+      value = (value << take) | ((byte >> (8 - _bit - take)) & ((1u << take) - 1));
+      _bit += take;
+      bits -= take;
+      if (_bit == 8) {
+        _at++;
+        _bit = 0;
+      }
+    }
+    return value;
+  }
+
+  bool overrun() const { return _overrun; }
+
+private:
+  const char *_at;
+  const char *_end;
+  int _bit;
+  bool _overrun;
+};
+
+static int leadingZeros(uint64_t value, int width)
+{
+  int n = 0;
+  for (uint64_t bit = (uint64_t)1 << (width - 1); bit && !(value & bit); bit >>= 1) n++;
+  return n;
+}
+
+static int trailingZeros(uint64_t value)
+{
+  int n = 0;
+  while (!(value & 1)) {
+    value >>= 1;
+    n++;
+  }
+  return n;
+}
+
+// ---------------------------
+// Channel codecs, one column of a block at a time
+// ---------------------------
+static uint64_t loadBits(const char *at, int size)
+{
+  uint64_t value = 0;
+  memcpy(&value, at, size);
+  return value;
+}
+
+// Gorilla: '0' for a repeat, '10' + meaningful bits when they fit the previous
+// window, otherwise '11' + 5 bits leading zeros + 6 bits length-1 + bits
+static void encodeXor(const char *lines, int stride, int frames, int offset, int size, std::vector<char> *out)
+{
+  int width = size * 8;
+  BitWriter bits(out);
+  uint64_t previous = loadBits(lines + offset, size);
+  bits.write(previous, width);
+
+  int lead = -1;
+  int trail = 0;
+  for (int f = 1; f < frames; f++) {
+    uint64_t value = loadBits(lines + f * stride + offset, size);
+    uint64_t x = value ^ previous;
+    previous = value;
+    if (!x) {
+      bits.write(0, 1);
+      continue;
+    }
+
+    int l = leadingZeros(x, width);
+    int t = trailingZeros(x);
+    if (l > 31) l = 31;
+    if (lead >= 0 && l >= lead && t >= trail) {
+      bits.write(2, 2);
+      bits.write(x >> trail, width - lead - trail);
+    } else {
+      lead = l;
+      trail = t;
+      int length = width - lead - trail;
+      bits.write(3, 2);
+      bits.write(lead, 5);
+      bits.write(length - 1, 6);
+      bits.write(x >> trail, length);
+    }
+  }
+  bits.flush();
+}
+
+static bool decodeXor(const char *data, const char *end, char *lines, int stride, int frames, int offset, int size)
+{
+  int width = size * 8;
+  BitReader bits(data, end);
+  uint64_t value = bits.read(width);
+  memcpy(lines + offset, &value, size);
+
+  int lead = 0;
+  int trail = 0;
+  for (int f = 1; f < frames; f++) {
+    if (bits.read(1)) {
+      if (bits.read(1)) {
+        lead = (int)bits.read(5);
+        int length = (int)bits.read(6) + 1;
+        trail = width - lead - length;
+        if (trail < 0) return false;
+      }
+      value ^= bits.read(width - lead - trail) << trail;
+    }
+    memcpy(lines + f * stride + offset, &value, size);
+  }
+  return !bits.overrun();
+}
+
+static void encodeDelta(const char *lines, int stride, int frames, int offset, std::vector<char> *out)
+{
+  int64_t previous = 0;
+  int64_t delta = 0;
+  for (int f = 0; f < frames; f++) {
+    int32_t value;
+    memcpy(&value, lines + f * stride + offset, sizeof(value));
+    int64_t d = (int64_t)value - previous;
+    putVarint(out, zigzag(f == 0 ? value : d - delta));
+    delta = f == 0 ? 0 : d;
+    previous = value;
+  }
+}
+
+static bool decodeDelta(const char *data, const char *end, char *lines, int stride, int frames, int offset)
+{
+  int64_t previous = 0;
+  int64_t delta = 0;
+  for (int f = 0; f < frames; f++) {
+    uint64_t raw;
+    if (!getVarint(&data, end, &raw)) return false;
+    int64_t value;
+    if (f == 0) {
+      value = unzigzag(raw);
+    } else {
+      delta += unzigzag(raw);
+      value = previous + delta;
+    }
+    int32_t out = (int32_t)value;
+    memcpy(lines + f * stride + offset, &out, sizeof(out));
+    previous = value;
+  }
+  return true;
+}
+
+static void encodeRuns(const char *lines, int stride, int frames, int offset, int size, std::vector<char> *out)
+{
+  int f = 0;
+  while (f < frames) {
+    uint64_t value = loadBits(lines + f * stride + offset, size);
+    int run = 1;
+    while (f + run < frames && loadBits(lines + (f + run) * stride + offset, size) == value) run++;
+    putVarint(out, value);
+    putVarint(out, run);
+    f += run;
+  }
+}
+
+static bool decodeRuns(const char *data, const char *end, char *lines, int stride, int frames, int offset, int size)
+{
+  int f = 0;
+  while (f < frames) {
+    uint64_t value;
+    uint64_t run;
+    if (!getVarint(&data, end, &value) || !getVarint(&data, end, &run)) return false;
+    if (run == 0 || run > (uint64_t)(frames - f)) return false;
+    for (uint64_t r = 0; r < run; r++, f++) {
+      memcpy(lines + f * stride + offset, &value, size);
+    }
+  }
+  return true;
+}
+
+template <typename T>
+static void put(std::vector<char> *out, T value)
+{
+  const char *bytes = reinterpret_cast<const char *>(&value);
+  out->insert(out->end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static T get(const char *at)
+{
+  T value;
+  memcpy(&value, at, sizeof(T));
+  return value;
+}
+
+static size_t beginRecord(std::vector<char> *out, char kind)
+{
+  out->push_back(kind);
+  size_t at = out->size();
+  put<uint32_t>(out, 0);
+  return at;
+}
+
+static void endRecord(std::vector<char> *out, size_t at)
+{
+  uint32_t length = (uint32_t)(out->size() - at - sizeof(uint32_t));
+  memcpy(&(*out)[at], &length, sizeof(length));
+}
+
+// ---------------------------
+// Encoder
+// ---------------------------
+RecordingEncoder::RecordingEncoder()
+  : _bufLen(0)
+  , _frames(0)
+{
+}
+
+void RecordingEncoder::begin(std::vector<char> *out)
+{
+  out->insert(out->end(), recordingMagic, recordingMagic + 4);
+  put<uint32_t>(out, recordingVersion);
+  _channels.clear();
+  _frames = 0;
+}
+
+void RecordingEncoder::setLayout(const irsdk_varHeader *vars, int count, int bufLen, std::vector<char> *out)
+{
+  flushBlock(out);
+
+  _channels.clear();
+  _bufLen = bufLen;
+  for (int i = 0; i < count; i++) {
+    const irsdk_varHeader &var = vars[i];
+    if (var.type < 0 || var.type >= irsdk_ETCount) continue;
+    int size = irsdk_VarTypeBytes[var.type];
+    if (var.offset < 0 || var.offset + size * var.count > bufLen) continue;
+    for (int e = 0; e < var.count; e++) {
+      Channel channel = { channelKind(var.type), var.offset + e * size, size };
+      _channels.push_back(channel);
+    }
+  }
+
+  size_t at = beginRecord(out, layoutRecord);
+  put<int32_t>(out, bufLen);
+  put<int32_t>(out, count);
+  const char *table = reinterpret_cast<const char *>(vars);
+  out->insert(out->end(), table, table + count * sizeof(irsdk_varHeader));
+  endRecord(out, at);
+
+  _lines.resize((size_t)BlockFrames * bufLen);
+  _ticks.resize(BlockFrames);
+}
+
+void RecordingEncoder::add(const char *line, int tickCount, std::vector<char> *out)
+{
+  if (_lines.empty()) return;
+
+  memcpy(&_lines[(size_t)_frames * _bufLen], line, _bufLen);
+  _ticks[_frames] = tickCount;
+  if (++_frames == BlockFrames) flushBlock(out);
+}
+
+void RecordingEncoder::finish(std::vector<char> *out)
+{
+  flushBlock(out);
+}
+
+void RecordingEncoder::flushBlock(std::vector<char> *out)
+{
+  if (!_frames) return;
+
+  size_t at = beginRecord(out, blockRecord);
+  put<uint32_t>(out, _frames);
+
+  // Kept across blocks, so steady state flushes don't allocate
+  std::vector<char> &column = _column;
+  column.clear();
+  encodeDelta(reinterpret_cast<const char *>(&_ticks[0]), sizeof(int), _frames, 0, &column);
+  putVarint(out, column.size());
+  out->insert(out->end(), column.begin(), column.end());
+
+  const char *lines = &_lines[0];
+  for (size_t c = 0; c < _channels.size(); c++) {
+    const Channel &channel = _channels[c];
+    column.clear();
+    switch (channel.kind) {
+      case Kind_Xor32:
+      case Kind_Xor64:
+        encodeXor(lines, _bufLen, _frames, channel.offset, channel.size, &column);
+        break;
+      case Kind_Delta:
+        encodeDelta(lines, _bufLen, _frames, channel.offset, &column);
+        break;
+      default:
+        encodeRuns(lines, _bufLen, _frames, channel.offset, channel.size, &column);
+        break;
+    }
+    putVarint(out, column.size());
+    out->insert(out->end(), column.begin(), column.end());
+  }
+
+  endRecord(out, at);
+  _frames = 0;
+}
+
+// ---------------------------
+// Decoder
+// ---------------------------
+RecordingDecoder::RecordingDecoder()
+  : _bufLen(0)
+  , _layout(0)
+{
+}
+
+int RecordingDecoder::begin(const char *data, int size)
+{
+  if (size < 8 || 0 != memcmp(data, recordingMagic, 4)) return -1;
+  if (get<uint32_t>(data + 4) != recordingVersion) return -1;
+  return 8;
+}
+
+int RecordingDecoder::next(const char *data, int size, std::vector<char> *lines, std::vector<int> *ticks)
+{
+  if (size < recordHeaderSize) return 0;
+  char kind = data[0];
+  uint32_t length = get<uint32_t>(data + 1);
+  if (length > (uint32_t)size - recordHeaderSize) return 0;
+  const char *payload = data + recordHeaderSize;
+
+  if (kind == layoutRecord) {
+    if (length < 8) return -1;
+    int bufLen = get<int32_t>(payload);
+    int count = get<int32_t>(payload + 4);
+    if (bufLen <= 0 || count < 0 || 8 + (uint64_t)count * sizeof(irsdk_varHeader) > length) return -1;
+
+    _vars.resize(count);
+    if (count) memcpy(&_vars[0], payload + 8, count * sizeof(irsdk_varHeader));
+    _bufLen = bufLen;
+    _channels.clear();
+    for (int i = 0; i < count; i++) {
+      const irsdk_varHeader &var = _vars[i];
+      if (var.type < 0 || var.type >= irsdk_ETCount) continue;
+      int size = irsdk_VarTypeBytes[var.type];
+      if (var.offset < 0 || var.offset + size * var.count > bufLen) continue;
+      for (int e = 0; e < var.count; e++) {
+        Channel channel = { channelKind(var.type), var.offset + e * size, size };
+        _channels.push_back(channel);
+      }
+    }
+    _layout++;
+    lines->clear();
+    ticks->clear();
+  } else if (kind == blockRecord) {
+    if (!_bufLen || !decodeBlock(payload, length, lines, ticks)) return -1;
+  } else {
+    // Unknown records are skipped, newer writers may add some
+    lines->clear();
+    ticks->clear();
+  }
+
+  return recordHeaderSize + length;
+}
+
+bool RecordingDecoder::decodeBlock(const char *data, int size, std::vector<char> *lines, std::vector<int> *ticks)
+{
+  const char *end = data + size;
+  if (size < 4) return false;
+  uint32_t frames = get<uint32_t>(data);
+  if (!frames || frames > (uint32_t)RecordingEncoder::BlockFrames) return false;
+  data += 4;
+
+  lines->assign((size_t)frames * _bufLen, 0);
+  ticks->resize(frames);
+
+  uint64_t length;
+  if (!getVarint(&data, end, &length) || length > (uint64_t)(end - data)) return false;
+  if (!decodeDelta(data, data + length, reinterpret_cast<char *>(&(*ticks)[0]), sizeof(int), frames, 0)) return false;
+  data += length;
+
+  char *out = &(*lines)[0];
+  for (size_t c = 0; c < _channels.size(); c++) {
+    const Channel &channel = _channels[c];
+    if (!getVarint(&data, end, &length) || length > (uint64_t)(end - data)) return false;
+    const char *column = data;
+    const char *columnEnd = data + length;
+    data = columnEnd;
+
+    bool ok;
+    switch (channel.kind) {
+      case Kind_Xor32:
+      case Kind_Xor64:
+        ok = decodeXor(column, columnEnd, out, _bufLen, frames, channel.offset, channel.size);
+        break;
+      case Kind_Delta:
+        ok = decodeDelta(column, columnEnd, out, _bufLen, frames, channel.offset);
+        break;
+      default:
+        ok = decodeRuns(column, columnEnd, out, _bufLen, frames, channel.offset, channel.size);
+        break;
+    }
+    if (!ok) return false;
+  }
+  return true;
+}
@@ -0,0 +1,97 @@
+#ifndef RECORDING_CODEC_H
+#define RECORDING_CODEC_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+
+// Lossless compression of recorded telemetry lines. Every element of every var
+// is its own channel, encoded the way its values tend to move:
+//   float, double     Gorilla style XOR against the previous value
+//   int               delta of delta, zigzag varints
+//   bool, char, bitfield  run lengths
+//
+// Lines are buffered into blocks of BlockFrames and each channel restarts at a
+// block boundary, so a recording can be written and read back one block at a
+// time. A layout record goes out first and again whenever the var table
+// changes, e.g. on a new connection.
+//
+// File: "IRTC" uint32 version, then records of uint8 kind, uint32 length:
+//   'L' layout: int32 bufLen, int32 varCount, irsdk_varHeader[varCount]
+//   'B' block:  uint32 frameCount, then the tick count channel and every var
+//               channel in var table order, each as varint length + bytes
+class RecordingEncoder
+{
+public:
+  static const int BlockFrames = 600;
+
+  RecordingEncoder();
+
+  // Appends the file header, call once before anything else
+  void begin(std::vector<char> *out);
+  // Flushes any partial block and appends the new layout
+  void setLayout(const irsdk_varHeader *vars, int count, int bufLen, std::vector<char> *out);
+  // Appends a block record every BlockFrames lines
+  void add(const char *line, int tickCount, std::vector<char> *out);
+  // Flushes the partial block
+  void finish(std::vector<char> *out);
+
+  int bufferedFrames() const { return _frames; }
+
+private:
+  struct Channel
+  {
+    int kind;
+    int offset;
+    int size;
+  };
+
+  void flushBlock(std::vector<char> *out);
+
+  std::vector<Channel> _channels;
+  int _bufLen;
+  int _frames;
+
+  // Lines and ticks of the current block, encoded column by column on flush
+  std::vector<char> _lines;
+  std::vector<int> _ticks;
+  // Scratch for the channel being encoded
+  std::vector<char> _column;
+};
+
+class RecordingDecoder
+{
+public:
+  RecordingDecoder();
+
+  // Checks the file header, returns the bytes consumed or -1
+  int begin(const char *data, int size);
+
+  // Decodes the next record. Returns the bytes consumed, 0 when data doesn't
+  // hold the whole record yet and -1 for a corrupt one. A block's lines land
+  // in lines (frameCount * bufLen bytes) and its ticks in ticks.
+  int next(const char *data, int size, std::vector<char> *lines, std::vector<int> *ticks);
+
+  const std::vector<irsdk_varHeader> &vars() const { return _vars; }
+  int bufLen() const { return _bufLen; }
+  // Bumped by every layout record
+  int layout() const { return _layout; }
+
+private:
+  struct Channel
+  {
+    int kind;
+    int offset;
+    int size;
+  };
+
+  bool decodeBlock(const char *data, int size, std::vector<char> *lines, std::vector<int> *ticks);
+
+  std::vector<irsdk_varHeader> _vars;
+  std::vector<Channel> _channels;
+  int _bufLen;
+  int _layout;
+};
+
+#endif
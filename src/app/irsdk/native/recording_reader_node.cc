@@ -0,0 +1,132 @@
+#include <string.h>
+#include <string>
+
+#include "./recording_reader_node.h"
+
+Napi::Object RecordingReaderNode::Init(Napi::Env env, Napi::Object exports)
+{
+  Napi::Function func = DefineClass(env, "RecordingReader", {
+    InstanceMethod("open", &RecordingReaderNode::Open),
+    InstanceMethod("close", &RecordingReaderNode::Close),
+    InstanceMethod("getVars", &RecordingReaderNode::GetVars),
+    InstanceMethod("next", &RecordingReaderNode::Next),
+  });
+
+  exports.Set("RecordingReader", func);
+  return exports;
+}
+
+RecordingReaderNode::RecordingReaderNode(const Napi::CallbackInfo &info)
+  : Napi::ObjectWrap<RecordingReaderNode>(info)
+  , _file(NULL)
+  , _index(0)
+{
+}
+
+RecordingReaderNode::~RecordingReaderNode()
+{
+  this->CloseFile();
+}
+
+void RecordingReaderNode::CloseFile()
+{
+  if (this->_file) fclose(this->_file);
+  this->_file = NULL;
+  this->_decoder = RecordingDecoder();
+  this->_lines.clear();
+  this->_ticks.clear();
+  this->_index = 0;
+}
+
+Napi::Value RecordingReaderNode::Open(const Napi::CallbackInfo &info)
+{
+  if (info.Length() < 1 || !info[0].IsString()) {
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  this->CloseFile();
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  this->_file = fopen(path.c_str(), "rb");
+  if (!this->_file) return Napi::Boolean::New(info.Env(), false);
+
+  char header[8];
+  if (fread(header, 1, sizeof(header), this->_file) != sizeof(header) ||
+      this->_decoder.begin(header, sizeof(header)) < 0) {
+    this->CloseFile();
+    return Napi::Boolean::New(info.Env(), false);
+  }
+
+  // Read up to the first layout so getVars() works straight away
+  bool ok = this->ReadRecord();
+  if (!ok) this->CloseFile();
+  return Napi::Boolean::New(info.Env(), ok);
+}
+
+Napi::Value RecordingReaderNode::Close(const Napi::CallbackInfo &info)
+{
+  this->CloseFile();
+  return info.Env().Undefined();
+}
+
+// Reads and decodes the next record, false at the end of the file or on a
+// corrupt record
+bool RecordingReaderNode::ReadRecord()
+{
+  if (!this->_file) return false;
+
+  char header[5];
+  if (fread(header, 1, sizeof(header), this->_file) != sizeof(header)) return false;
+  uint32_t length;
+  memcpy(&length, header + 1, sizeof(length));
+
+  this->_record.resize(sizeof(header) + length);
+  memcpy(&this->_record[0], header, sizeof(header));
+  if (length && fread(&this->_record[sizeof(header)], 1, length, this->_file) != length) return false;
+
+  this->_index = 0;
+  int size = (int)this->_record.size();
+  return this->_decoder.next(&this->_record[0], size, &this->_lines, &this->_ticks) == size;
+}
+
+Napi::Value RecordingReaderNode::GetVars(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+  const std::vector<irsdk_varHeader> &vars = this->_decoder.vars();
+  if (!this->_file || !this->_decoder.layout()) return env.Null();
+
+  auto result = Napi::Array::New(env, vars.size());
+  for (size_t i = 0; i < vars.size(); i++) {
+    const irsdk_varHeader &var = vars[i];
+    auto entry = Napi::Object::New(env);
+    entry.Set("name", std::string(var.name, strnlen(var.name, IRSDK_MAX_STRING)));
+    entry.Set("description", std::string(var.desc, strnlen(var.desc, IRSDK_MAX_DESC)));
+    entry.Set("unit", std::string(var.unit, strnlen(var.unit, IRSDK_MAX_STRING)));
+    entry.Set("countAsTime", var.countAsTime);
+    entry.Set("length", var.count);
+    entry.Set("varType", var.type);
+    entry.Set("offset", var.offset);
+    result.Set((uint32_t)i, entry);
+  }
+  return result;
+}
+
+Napi::Value RecordingReaderNode::Next(const Napi::CallbackInfo &info)
+{
+  auto env = info.Env();
+
+  // Layout records carry no lines, keep going until a block does
+  while (this->_index >= this->_ticks.size()) {
+    if (!this->ReadRecord()) return env.Null();
+  }
+
+  int bufLen = this->_decoder.bufLen();
+  auto buffer = Napi::ArrayBuffer::New(env, bufLen);
+  memcpy(buffer.Data(), &this->_lines[this->_index * bufLen], bufLen);
+
+  auto result = Napi::Object::New(env);
+  result.Set("layout", this->_decoder.layout());
+  result.Set("tickCount", this->_ticks[this->_index]);
+  result.Set("buffer", buffer);
+  this->_index++;
+  return result;
+}
@@ -0,0 +1,35 @@
+#ifndef RECORDING_READER_NODE_H
+#define RECORDING_READER_NODE_H
+
+#include <napi.h>
+#include <stdio.h>
+#include <vector>
+#include "./recording_codec.h"
+
+// Streams the lines of a recording written by startRecording() back out, one
+// block in memory at a time.
+class RecordingReaderNode : public Napi::ObjectWrap<RecordingReaderNode>
+{
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  RecordingReaderNode(const Napi::CallbackInfo &info);
+  ~RecordingReaderNode();
+
+private:
+  Napi::Value Open(const Napi::CallbackInfo &info);
+  Napi::Value Close(const Napi::CallbackInfo &info);
+  Napi::Value GetVars(const Napi::CallbackInfo &info);
+  Napi::Value Next(const Napi::CallbackInfo &info);
+
+  void CloseFile();
+  bool ReadRecord();
+
+  FILE *_file;
+  RecordingDecoder _decoder;
+  std::vector<char> _record;
+  std::vector<char> _lines;
+  std::vector<int> _ticks;
+  size_t _index;
+};
+
+#endif
@@ -0,0 +1,508 @@
+// irsdk_recording_test: encodes synthetic telemetry with RecordingEncoder,
+// decodes it back with RecordingDecoder and fails unless every line, tick
+// count and var table comes back bit for bit. The lines cover each channel
+// kind (XOR floats and doubles, delta-of-delta ints, runs of bools, chars and
+// bitfields), values that are hard on them, a partial last block and a layout
+// change mid-file. The replay cases play a recording back through
+// ReplayContext and check every line comes with the header and var table it
+// was written with.
+//
+// Usage: irsdk_recording_test [--case <name>]
+
+#include <algorithm>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "./recording_codec.h"
+#include "./replay_context.h"
+#include "./native_file.h"
+
+static void usage()
+{
+  fprintf(stderr, "Usage: irsdk_recording_test [--case <name>]\n");
+}
+
+// ---------------------------
+// Synthetic sessions
+// ---------------------------
+// A var table laid out back to back, like the sim's
+class Layout
+{
+public:
+  Layout()
+    : _bufLen(0)
+  {
+  }
+
+  int add(const char *name, int type, int count)
+  {
+    irsdk_varHeader var;
+    memset(&var, 0, sizeof(var));
+    var.type = type;
+    var.offset = _bufLen;
+    var.count = count;
+    strncpy(var.name, name, IRSDK_MAX_STRING - 1);
+    _vars.push_back(var);
+    _bufLen += count * irsdk_VarTypeBytes[type];
+    return var.offset;
+  }
+
+  const irsdk_varHeader *vars() const { return &_vars[0]; }
+  int count() const { return (int)_vars.size(); }
+  int bufLen() const { return _bufLen; }
+
+private:
+  std::vector<irsdk_varHeader> _vars;
+  int _bufLen;
+};
+
+template <class T> static void store(std::vector<char> *line, int offset, int index, T value)
+{
+  memcpy(&(*line)[offset + index * sizeof(T)], &value, sizeof(T));
+}
+
+// What one layout's lines hold, written per frame
+class Session
+{
+public:
+  virtual ~Session() {}
+  virtual const Layout &layout() const = 0;
+  virtual void fill(int frame, std::vector<char> *line) = 0;
+};
+
+// Values the way the sim moves them
+class DrivingSession : public Session
+{
+public:
+  DrivingSession()
+  {
+    _speed = _layout.add("Speed", irsdk_float, 1);
+    _time = _layout.add("SessionTime", irsdk_double, 1);
+    _lap = _layout.add("Lap", irsdk_int, 1);
+    _pct = _layout.add("CarIdxLapDistPct", irsdk_float, 4);
+    _carLap = _layout.add("CarIdxLap", irsdk_int, 4);
+    _onPit = _layout.add("OnPitRoad", irsdk_bool, 1);
+    _gear = _layout.add("CarIdxGear", irsdk_char, 4);
+    _flags = _layout.add("SessionFlags", irsdk_bitField, 1);
+  }
+
+  const Layout &layout() const { return _layout; }
+
+  void fill(int frame, std::vector<char> *line)
+  {
+    store<float>(line, _speed, 0, 40.0f + 20.0f * (float)sin(frame * 0.01));
+    store<double>(line, _time, 0, 120.0 + frame / 60.0);
+    store<int>(line, _lap, 0, 3 + frame / 500);
+    for (int car = 0; car < 4; car++) {
+      float pct = (float)fmod(frame * (0.0011 + car * 0.0001) + car * 0.25, 1.0);
+      store<float>(line, _pct, car, car == 3 && frame > 700 ? -1.0f : pct);
+      store<int>(line, _carLap, car, car == 3 && frame > 700 ? -1 : 3 + frame / (450 + car * 10));
+      (*line)[_gear + car] = (char)(1 + (frame / 97 + car) % 6);
+    }
+    (*line)[_onPit] = frame > 300 && frame < 420;
+    store<int>(line, _flags, 0, frame < 900 ? 0x00000004 : 0x10000004);
+  }
+
+private:
+  Layout _layout;
+  int _speed, _time, _lap, _pct, _carLap, _onPit, _gear, _flags;
+};
+
+// Values the encoders have to get exactly right: NaN payloads, signed zeros,
+// infinities and denormals for XOR, int extremes whose deltas overflow
+static const uint32_t floatEdges[] = { 0x7fc00000, 0x7fc00001, 0xffc00000, 0x80000000, 0x00000000,
+                                       0x7f800000, 0xff800000, 0x00000001, 0x7f7fffff, 0x3f800000 };
+static const uint64_t doubleEdges[] = { 0x7ff8000000000000ULL, 0x7ff8000000000001ULL, 0x8000000000000000ULL,
+                                        0x0000000000000000ULL, 0x7ff0000000000000ULL, 0xfff0000000000000ULL,
+                                        0x0000000000000001ULL, 0x7fefffffffffffffULL };
+static const int intEdges[] = { INT_MIN, INT_MAX, 0, -1, INT_MIN, INT_MIN, INT_MAX, 1, INT_MAX };
+
+class EdgeSession : public Session
+{
+public:
+  EdgeSession()
+  {
+    _float = _layout.add("EdgeFloat", irsdk_float, 1);
+    _double = _layout.add("EdgeDouble", irsdk_double, 1);
+    _int = _layout.add("EdgeInt", irsdk_int, 2);
+    _bits = _layout.add("EdgeBits", irsdk_bitField, 1);
+    _chars = _layout.add("EdgeChars", irsdk_char, 3);
+  }
+
+  const Layout &layout() const { return _layout; }
+
+  void fill(int frame, std::vector<char> *line)
+  {
+    store<uint32_t>(line, _float, 0, floatEdges[frame % (sizeof(floatEdges) / sizeof(floatEdges[0]))]);
+    store<uint64_t>(line, _double, 0, doubleEdges[frame % (sizeof(doubleEdges) / sizeof(doubleEdges[0]))]);
+    store<int>(line, _int, 0, intEdges[frame % (sizeof(intEdges) / sizeof(intEdges[0]))]);
+    // A wrapping counter, its second difference wraps too
+    store<int>(line, _int, 1, (int)((unsigned)INT_MAX - 3u + (unsigned)frame * 0x40000001u));
+    // Every value changes on every line, runs of one
+    store<uint32_t>(line, _bits, 0, 0x80000000u ^ (uint32_t)frame);
+    for (int i = 0; i < 3; i++) (*line)[_chars + i] = (char)(frame * (i + 1) - 128);
+  }
+
+private:
+  Layout _layout;
+  int _float, _double, _int, _bits, _chars;
+};
+
+// Nothing moves, every channel collapses to one run or one repeated delta
+class ConstantSession : public Session
+{
+public:
+  ConstantSession()
+  {
+    _layout.add("Speed", irsdk_float, 8);
+    _layout.add("SessionTime", irsdk_double, 8);
+    _layout.add("Lap", irsdk_int, 8);
+    _layout.add("OnPitRoad", irsdk_bool, 8);
+    _layout.add("SessionFlags", irsdk_bitField, 8);
+  }
+
+  const Layout &layout() const { return _layout; }
+
+  void fill(int, std::vector<char> *line)
+  {
+    for (size_t i = 0; i < line->size(); i++) (*line)[i] = (char)(i * 7 + 1);
+  }
+
+private:
+  Layout _layout;
+};
+
+// ---------------------------
+// Round trip
+// ---------------------------
+// One stretch of the recording under a single layout
+struct Segment
+{
+  Session *session;
+  int frames;
+  int tickStep;
+};
+
+struct Expected
+{
+  std::vector<std::vector<char> > lines;
+  std::vector<int> ticks;
+  // Index into the segments, per line
+  std::vector<int> segment;
+};
+
+static std::vector<char> encode(const std::vector<Segment> &segments, Expected *expected)
+{
+  RecordingEncoder encoder;
+  std::vector<char> out;
+  encoder.begin(&out);
+
+  int tick = 1000;
+  for (size_t s = 0; s < segments.size(); s++) {
+    const Segment &segment = segments[s];
+    const Layout &layout = segment.session->layout();
+    encoder.setLayout(layout.vars(), layout.count(), layout.bufLen(), &out);
+
+    std::vector<char> line(layout.bufLen());
+    for (int f = 0; f < segment.frames; f++) {
+      std::fill(line.begin(), line.end(), 0);
+      segment.session->fill(f, &line);
+      tick += segment.tickStep + (f % 97 == 0 ? 3 : 0);
+      encoder.add(&line[0], tick, &out);
+      expected->lines.push_back(line);
+      expected->ticks.push_back(tick);
+      expected->segment.push_back((int)s);
+    }
+  }
+  encoder.finish(&out);
+  return out;
+}
+
+static bool fail(std::string *error, const std::string &message)
+{
+  *error = message;
+  return false;
+}
+
+// Decodes data handed over chunk bytes at a time (all at once for 0), like
+// RecordingReader reads files, and checks it against what went in
+static bool decode(const std::vector<char> &data, int chunk, const std::vector<Segment> &segments,
+                   const Expected &expected, std::string *error)
+{
+  RecordingDecoder decoder;
+  int at = decoder.begin(&data[0], (int)data.size());
+  if (at < 0) return fail(error, "bad file header");
+
+  std::vector<char> lines;
+  std::vector<int> ticks;
+  size_t frame = 0;
+  int layouts = 0;
+  int available = chunk ? at : (int)data.size();
+  while (at < (int)data.size()) {
+    int used = decoder.next(&data[at], available - at, &lines, &ticks);
+    if (used < 0) return fail(error, "corrupt record at byte " + std::to_string(at));
+    if (used == 0) {
+      if (available == (int)data.size()) return fail(error, "truncated record at byte " + std::to_string(at));
+      available = std::min((int)data.size(), available + chunk);
+      continue;
+    }
+    at += used;
+
+    if (decoder.layout() != layouts) {
+      layouts = decoder.layout();
+      if (layouts > (int)segments.size()) return fail(error, "more layouts than segments");
+      const Layout &layout = segments[layouts - 1].session->layout();
+      if (decoder.bufLen() != layout.bufLen() || (int)decoder.vars().size() != layout.count() ||
+          0 != memcmp(&decoder.vars()[0], layout.vars(), layout.count() * sizeof(irsdk_varHeader))) {
+        return fail(error, "layout " + std::to_string(layouts) + " differs");
+      }
+    }
+
+    for (size_t i = 0; i < ticks.size(); i++, frame++) {
+      if (frame >= expected.lines.size()) return fail(error, "more lines than were encoded");
+      if (expected.segment[frame] != layouts - 1) {
+        return fail(error, "line " + std::to_string(frame) + " decoded under the wrong layout");
+      }
+      if (ticks[i] != expected.ticks[frame]) return fail(error, "tick count of line " + std::to_string(frame));
+      const std::vector<char> &want = expected.lines[frame];
+      if (0 != memcmp(&lines[i * decoder.bufLen()], &want[0], want.size())) {
+        return fail(error, "line " + std::to_string(frame) + " differs");
+      }
+    }
+  }
+
+  if (frame != expected.lines.size()) {
+    return fail(error, std::to_string(frame) + " of " + std::to_string(expected.lines.size()) + " lines decoded");
+  }
+  if (layouts != (int)segments.size()) return fail(error, "layouts missing");
+  return true;
+}
+
+static bool roundTrip(const std::vector<Segment> &segments, std::string *error, size_t *encodedSize = NULL,
+                      size_t *rawSize = NULL)
+{
+  Expected expected;
+  std::vector<char> data = encode(segments, &expected);
+  if (encodedSize) *encodedSize = data.size();
+  if (rawSize) {
+    *rawSize = 0;
+    for (size_t i = 0; i < expected.lines.size(); i++) *rawSize += expected.lines[i].size();
+  }
+  // At once, then a few bytes at a time
+  return decode(data, 0, segments, expected, error) && decode(data, 13, segments, expected, error);
+}
+
+// Where the replay cases write their recording
+static std::string tempPath()
+{
+  const char *names[] = { "TMPDIR", "TEMP", "TMP" };
+  std::string dir = ".";
+  for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    const char *value = getenv(names[i]);
+    if (value && *value) {
+      dir = value;
+      break;
+    }
+  }
+  return dir + "/irsdk_recording_test.irtc";
+}
+
+// Plays the recording back as fast as it can be read and checks each line
+// handed out against the header and var table at that moment
+static bool replay(const std::vector<Segment> &segments, std::string *error)
+{
+  Expected expected;
+  std::vector<char> data = encode(segments, &expected);
+  std::string path = tempPath();
+  FILE *file = openFileUtf8(path.c_str(), "wb");
+  if (!file) return fail(error, "can't write " + path);
+  bool written = fwrite(&data[0], 1, data.size(), file) == data.size();
+  fclose(file);
+  if (!written) return fail(error, "can't write " + path);
+
+  bool ok = true;
+  {
+    ReplayContext context(ReplayContext::openFile(path.c_str()), 0, false);
+    if (!context.startup()) ok = fail(error, "can't replay " + path);
+    std::vector<char> line;
+    size_t frame = 0;
+    while (ok) {
+      const irsdk_header *header = context.header();
+      line.resize(std::max((int)line.size(), header->bufLen));
+      if (!context.waitForData(0, &line[0])) {
+        // A new layout is announced with a false first
+        if (context.isConnected()) continue;
+        break;
+      }
+      header = context.header();
+      if (frame >= expected.lines.size()) {
+        ok = fail(error, "more lines than were recorded");
+        break;
+      }
+      const Layout &layout = segments[expected.segment[frame]].session->layout();
+      const std::vector<char> &want = expected.lines[frame];
+      if (header->numVars != layout.count() || header->bufLen != layout.bufLen()) {
+        ok = fail(error, "header of line " + std::to_string(frame) + " describes another layout");
+      } else if (0 != memcmp(context.vars(), layout.vars(), layout.count() * sizeof(irsdk_varHeader))) {
+        ok = fail(error, "var table of line " + std::to_string(frame) + " is another layout's");
+      } else if (0 != memcmp(&line[0], &want[0], want.size())) {
+        ok = fail(error, "line " + std::to_string(frame) + " differs");
+      }
+      frame++;
+    }
+    if (ok && frame != expected.lines.size()) {
+      ok = fail(error, std::to_string(frame) + " of " + std::to_string(expected.lines.size()) + " lines replayed");
+    }
+  }
+  remove(path.c_str());
+  return ok;
+}
+
+// ---------------------------
+// Cases
+// ---------------------------
+static const int Block = RecordingEncoder::BlockFrames;
+
+// Two whole blocks and a partial one, a new layout, another partial block,
+// then the first layout back
+static bool layoutChange(std::string *error)
+{
+  DrivingSession driving;
+  EdgeSession edges;
+  std::vector<Segment> segments;
+  segments.push_back(Segment{ &driving, 2 * Block + 137, 1 });
+  segments.push_back(Segment{ &edges, Block / 2, 2 });
+  segments.push_back(Segment{ &driving, Block, 1 });
+  return roundTrip(segments, error);
+}
+
+// A layout change right at a block boundary, no partial block between
+static bool blockBoundary(std::string *error)
+{
+  DrivingSession driving;
+  EdgeSession edges;
+  std::vector<Segment> segments;
+  segments.push_back(Segment{ &driving, Block, 1 });
+  segments.push_back(Segment{ &edges, Block, 1 });
+  return roundTrip(segments, error);
+}
+
+static bool edgeValues(std::string *error)
+{
+  EdgeSession edges;
+  std::vector<Segment> segments;
+  segments.push_back(Segment{ &edges, Block + 1, 1 });
+  return roundTrip(segments, error);
+}
+
+// Fewer lines than a block, the only block is partial
+static bool shortRecording(std::string *error)
+{
+  DrivingSession driving;
+  std::vector<Segment> segments;
+  segments.push_back(Segment{ &driving, 1, 1 });
+  if (!roundTrip(segments, error)) return false;
+  segments[0].frames = Block - 1;
+  return roundTrip(segments, error);
+}
+
+// Repeats have to come out much smaller than the lines. Ints still take a
+// byte per line for their zero second difference.
+static bool constantLines(std::string *error)
+{
+  ConstantSession constant;
+  std::vector<Segment> segments;
+  segments.push_back(Segment{ &constant, 3 * Block, 1 });
+  size_t encoded;
+  size_t raw;
+  if (!roundTrip(segments, error, &encoded, &raw)) return false;
+  if (encoded * 10 > raw) {
+    return fail(error, "constant lines encoded to " + std::to_string(encoded) + " of " + std::to_string(raw) +
+                         " bytes");
+  }
+  return true;
+}
+
+// A layout with no lines before the next one
+static bool emptyLayout(std::string *error)
+{
+  DrivingSession driving;
+  EdgeSession edges;
+  std::vector<Segment> segments;
+  segments.push_back(Segment{ &driving, 0, 1 });
+  segments.push_back(Segment{ &edges, 10, 1 });
+  return roundTrip(segments, error);
+}
+
+// The source reads a line ahead, the last line of a layout mustn't get the
+// next layout's var table
+static bool replayLayoutChange(std::string *error)
+{
+  DrivingSession driving;
+  EdgeSession edges;
+  std::vector<Segment> segments;
+  segments.push_back(Segment{ &driving, Block, 1 });
+  segments.push_back(Segment{ &edges, Block + 50, 1 });
+  segments.push_back(Segment{ &driving, 30, 1 });
+  return replay(segments, error);
+}
+
+struct CaseInfo
+{
+  const char *name;
+  bool (*run)(std::string *error);
+};
+
+static const CaseInfo cases[] = {
+  { "layoutChange", &layoutChange },
+  { "blockBoundary", &blockBoundary },
+  { "edgeValues", &edgeValues },
+  { "shortRecording", &shortRecording },
+  { "constantLines", &constantLines },
+  { "emptyLayout", &emptyLayout },
+  { "replayLayoutChange", &replayLayoutChange },
+};
+
+int main(int argc, char **argv)
+{
+  std::string only;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (0 == strcmp(arg, "--case")) only = value;
+    else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+
+  int failed = 0;
+  int ran = 0;
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    const CaseInfo &info = cases[c];
+    if (!only.empty() && only != info.name) continue;
+    ran++;
+
+    std::string error;
+    bool ok = info.run(&error);
+    if (ok) printf("ok   %s\n", info.name);
+    else printf("FAIL %s: %s\n", info.name, error.c_str());
+    if (!ok) failed++;
+  }
+  if (!ran) {
+    usage();
+    return 2;
+  }
+  return failed ? 1 : 0;
+}
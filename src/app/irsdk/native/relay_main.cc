@@ -0,0 +1,164 @@
+// irsdk_relay: reads the sim once and serves it to any number of local
+// clients, over a socket (see relay_server.h) and as a frame ring segment in
+// the same format iRacingSdkNode.startFramePublisher() writes, so FrameReader
+// works against either.
+//
+// Usage: irsdk_relay [--source <mapping>] [--socket <path>] [--export <name>|none]
+
+#include <chrono>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "./frame_ring.h"
+#include "./relay_server.h"
+#include "./shared_memory.h"
+#include "./telemetry_source.h"
+
+static const char RELAY_DEFAULT_EXPORT[] = "Local\\IRDashiesRelayFrames";
+
+// How long to wait for a line before servicing clients again
+static const int waitTimeoutMs = 16;
+// How often to look for the sim while it isn't running
+static const int reconnectIntervalMs = 500;
+// The sim can die without clearing its connected flag
+static const int staleTimeoutMs = 5000;
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int)
+{
+  running = 0;
+}
+
+static int64_t nowMs()
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::string defaultSocketPath()
+{
+#ifdef _WIN32
+  const char *dir = getenv("TEMP");
+  return std::string(dir ? dir : ".") + "\\irdashies-relay.sock";
+#else
+  return "/tmp/irdashies-relay.sock";
+#endif
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: irsdk_relay [--source <mapping>] [--socket <path>] [--export <name>|none]\n");
+}
+
+int main(int argc, char **argv)
+{
+  std::string sourceName = IRSDK_MEMMAPFILENAME;
+  std::string socketPath = defaultSocketPath();
+  std::string exportName = RELAY_DEFAULT_EXPORT;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (0 == strcmp(arg, "--source")) sourceName = value;
+    else if (0 == strcmp(arg, "--socket")) socketPath = value;
+    else if (0 == strcmp(arg, "--export")) exportName = value;
+    else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+#ifndef _WIN32
+  signal(SIGPIPE, SIG_IGN);
+#endif
+
+  RelayServer server;
+  if (!server.listen(socketPath.c_str())) {
+    fprintf(stderr, "irsdk_relay: can't listen on %s\n", socketPath.c_str());
+    return 1;
+  }
+
+  SharedMemory exported;
+  FrameRingWriter writer;
+  if (exportName != "none") {
+    int slotCapacity = FrameRing::DefaultSlotCapacity;
+    if (!exported.create(exportName.c_str(), FrameRing::byteLength(slotCapacity)) ||
+        !writer.attach(exported.data(), exported.size(), slotCapacity)) {
+      fprintf(stderr, "irsdk_relay: can't create shared memory %s\n", exportName.c_str());
+      return 1;
+    }
+  }
+
+  fprintf(stderr, "irsdk_relay: serving %s on %s\n", sourceName.c_str(), socketPath.c_str());
+
+  TelemetrySource source;
+  std::vector<char> line;
+  int connection = 0;
+  int sessionUpdate = -1;
+  uint32_t frame = 0;
+  int64_t lastDataMs = 0;
+
+  while (running) {
+    if (!source.isOpen()) {
+      if (!source.open(sourceName.c_str())) {
+        server.service(reconnectIntervalMs);
+        continue;
+      }
+      lastDataMs = nowMs();
+    }
+
+    // Reopen rather than wait on a mapping the producer has let go of; on
+    // POSIX a restarted producer creates a new segment under the same name
+    if (!source.isConnected() || nowMs() - lastDataMs > staleTimeoutMs) {
+      if (connection) fprintf(stderr, "irsdk_relay: disconnected\n");
+      connection = 0;
+      source.close();
+      server.service(reconnectIntervalMs);
+      continue;
+    }
+
+    const irsdk_header *header = source.header();
+    line.resize(header->bufLen);
+    if (source.waitForData(waitTimeoutMs, &line[0])) {
+      int64_t now = nowMs();
+      lastDataMs = now;
+
+      if (source.connection() != connection) {
+        connection = source.connection();
+        sessionUpdate = -1;
+        server.setLayout(source.vars(), header->numVars, header->bufLen);
+        if (writer.isAttached()) writer.setLayout(source.vars(), header->numVars, header->bufLen);
+        fprintf(stderr, "irsdk_relay: connected, %d vars\n", header->numVars);
+      }
+
+      if (header->sessionInfoUpdate != sessionUpdate) {
+        sessionUpdate = header->sessionInfoUpdate;
+        const char *session = source.sessionInfo();
+        int length = 0;
+        while (length < header->sessionInfoLen && session[length]) length++;
+        server.setSessionInfo(session, length);
+      }
+
+      frame = writer.isAttached() ? writer.publish(&line[0], header->bufLen, source.tickCount()) : frame + 1;
+      server.broadcast(&line[0], source.tickCount(), frame, now);
+    }
+
+    server.service(0);
+  }
+
+  fprintf(stderr, "irsdk_relay: stopping, %llu frames dropped for slow clients\n",
+    (unsigned long long)server.droppedFrames());
+  return 0;
+}
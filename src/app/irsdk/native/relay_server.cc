@@ -0,0 +1,365 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./relay_server.h"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32")
+
+typedef WSAPOLLFD relay_pollfd;
+static const relay_socket_t invalidSocket = INVALID_SOCKET;
+
+static int pollSockets(relay_pollfd *fds, int count, int timeoutMs) { return WSAPoll(fds, count, timeoutMs); }
+static void closeSocket(relay_socket_t s) { closesocket(s); }
+static bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+
+static bool setNonBlocking(relay_socket_t s)
+{
+  u_long on = 1;
+  return 0 == ioctlsocket(s, FIONBIO, &on);
+}
+
+static bool startSockets()
+{
+  WSADATA data;
+  return 0 == WSAStartup(MAKEWORD(2, 2), &data);
+}
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+typedef struct pollfd relay_pollfd;
+static const relay_socket_t invalidSocket = -1;
+
+static int pollSockets(relay_pollfd *fds, int count, int timeoutMs) { return poll(fds, count, timeoutMs); }
+static void closeSocket(relay_socket_t s) { ::close(s); }
+static bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR; }
+
+static bool setNonBlocking(relay_socket_t s)
+{
+  int flags = fcntl(s, F_GETFL, 0);
+  return flags >= 0 && 0 == fcntl(s, F_SETFL, flags | O_NONBLOCK);
+}
+
+static bool startSockets() { return true; }
+#endif
+
+// Commands are short, anything longer than this without a newline is garbage
+static const size_t maxInputBytes = 64 * 1024;
+static const int nameLength = IRSDK_MAX_STRING;
+
+static void appendInt(std::string &out, int32_t value)
+{
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+RelayServer::RelayServer()
+  : _listener(invalidSocket)
+  , _bufLen(0)
+  , _droppedFrames(0)
+{
+}
+
+bool RelayServer::listen(const char *path)
+{
+  close();
+  if (!startSockets()) return false;
+
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  if (strlen(path) >= sizeof(address.sun_path)) return false;
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+
+  relay_socket_t s = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (s == invalidSocket) return false;
+
+  // A stale socket file from a relay that didn't shut down cleanly
+  remove(path);
+  if (0 != bind(s, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) ||
+      0 != ::listen(s, 16) || !setNonBlocking(s)) {
+    closeSocket(s);
+    return false;
+  }
+
+  _listener = s;
+  _path = path;
+  return true;
+}
+
+void RelayServer::close()
+{
+  for (size_t i = 0; i < _clients.size(); i++) {
+    closeSocket(_clients[i].socket);
+  }
+  _clients.clear();
+
+  if (_listener != invalidSocket) {
+    closeSocket(_listener);
+    remove(_path.c_str());
+  }
+  _listener = invalidSocket;
+  _path.clear();
+}
+
+bool RelayServer::isListening() const
+{
+  return _listener != invalidSocket;
+}
+
+void RelayServer::service(int timeoutMs)
+{
+  if (_listener == invalidSocket) return;
+
+  std::vector<relay_pollfd> fds(_clients.size() + 1);
+  fds[0].fd = _listener;
+  fds[0].events = POLLIN;
+  fds[0].revents = 0;
+  for (size_t i = 0; i < _clients.size(); i++) {
+    fds[i + 1].fd = _clients[i].socket;
+    fds[i + 1].events = POLLIN | (_clients[i].output.empty() ? 0 : POLLOUT);
+    fds[i + 1].revents = 0;
+  }
+
+  if (pollSockets(&fds[0], (int)fds.size(), timeoutMs) <= 0) return;
+
+  // Clients only ever get appended, so the indices still line up
+  size_t count = fds.size() - 1;
+  for (size_t i = 0; i < count; i++) {
+    short revents = fds[i + 1].revents;
+    if (revents & (POLLIN | POLLHUP | POLLERR)) read(_clients[i]);
+    if (revents & POLLOUT) flush(_clients[i]);
+  }
+  if (fds[0].revents & POLLIN) accept();
+
+  for (size_t i = _clients.size(); i-- > 0;) {
+    if (_clients[i].closing) {
+      closeSocket(_clients[i].socket);
+      _clients.erase(_clients.begin() + i);
+    }
+  }
+}
+
+void RelayServer::accept()
+{
+  for (;;) {
+    relay_socket_t s = ::accept(_listener, NULL, NULL);
+    if (s == invalidSocket) return;
+    if (!setNonBlocking(s)) {
+      closeSocket(s);
+      continue;
+    }
+
+    Client client;
+    client.socket = s;
+    client.frameLength = 0;
+    client.minIntervalMs = 0;
+    client.nextFrameMs = 0;
+    client.closing = false;
+    _clients.push_back(client);
+
+    Client &added = _clients.back();
+    resolve(added);
+    if (!_vars.empty()) sendLayout(added);
+    if (!_session.empty()) sendSession(added);
+  }
+}
+
+void RelayServer::read(Client &client)
+{
+  char buffer[4096];
+  for (;;) {
+    int length = (int)recv(client.socket, buffer, sizeof(buffer), 0);
+    if (length == 0 || (length < 0 && !wouldBlock())) {
+      client.closing = true;
+      return;
+    }
+    if (length < 0) break;
+    client.input.append(buffer, length);
+  }
+
+  size_t start = 0;
+  size_t end;
+  while ((end = client.input.find('\n', start)) != std::string::npos) {
+    std::string line = client.input.substr(start, end - start);
+    if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+    if (!line.empty()) command(client, line);
+    start = end + 1;
+  }
+  client.input.erase(0, start);
+  if (client.input.size() > maxInputBytes) client.closing = true;
+}
+
+void RelayServer::flush(Client &client)
+{
+  while (!client.output.empty() && !client.closing) {
+    int sent = (int)::send(client.socket, client.output.data(), (int)client.output.size(), MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (!wouldBlock()) client.closing = true;
+      return;
+    }
+    client.output.erase(0, sent);
+  }
+}
+
+void RelayServer::command(Client &client, const std::string &line)
+{
+  std::vector<std::string> words;
+  size_t start = 0;
+  while (start < line.size()) {
+    size_t end = line.find_first_of(" \t,", start);
+    if (end == std::string::npos) end = line.size();
+    if (end > start) words.push_back(line.substr(start, end - start));
+    start = end + 1;
+  }
+  if (words.empty()) return;
+
+  if (words[0] == "subscribe") {
+    client.names.assign(words.begin() + 1, words.end());
+    resolve(client);
+    if (!_vars.empty()) sendLayout(client);
+  } else if (words[0] == "rate" && words.size() == 2) {
+    int hz = atoi(words[1].c_str());
+    client.minIntervalMs = hz > 0 ? 1000 / hz : 0;
+    client.nextFrameMs = 0;
+  } else if (words[0] == "session") {
+    sendSession(client);
+  } else {
+    sendError(client, "unknown command: " + words[0]);
+  }
+}
+
+void RelayServer::resolve(Client &client)
+{
+  client.fields.clear();
+  client.frameLength = 0;
+  if (_vars.empty()) return;
+
+  std::string unknown;
+  int count = client.names.empty() ? (int)_vars.size() : (int)client.names.size();
+  for (int i = 0; i < count; i++) {
+    int var = i;
+    if (!client.names.empty()) {
+      var = -1;
+      for (size_t v = 0; v < _vars.size(); v++) {
+        if (0 == strncmp(_vars[v].name, client.names[i].c_str(), nameLength)) {
+          var = (int)v;
+          break;
+        }
+      }
+      if (var < 0) {
+        unknown += unknown.empty() ? client.names[i] : " " + client.names[i];
+        continue;
+      }
+    }
+
+    const irsdk_varHeader &header = _vars[var];
+    if (header.type < 0 || header.type >= irsdk_ETCount) continue;
+    Field field;
+    field.var = var;
+    field.offset = client.frameLength;
+    field.length = irsdk_VarTypeBytes[header.type] * header.count;
+    if (header.offset < 0 || header.offset + field.length > _bufLen) continue;
+    client.fields.push_back(field);
+    client.frameLength += field.length;
+  }
+
+  if (!unknown.empty()) sendError(client, "unknown vars: " + unknown);
+}
+
+void RelayServer::send(Client &client, char kind, const char *payload, int length)
+{
+  if (client.closing) return;
+  if (client.output.size() > (size_t)MaxPendingBytes) {
+    client.closing = true;
+    return;
+  }
+
+  appendInt(client.output, length);
+  client.output.push_back(kind);
+  client.output.append(payload, length);
+  flush(client);
+}
+
+void RelayServer::sendLayout(Client &client)
+{
+  std::string payload;
+  appendInt(payload, (int32_t)client.fields.size());
+  for (size_t i = 0; i < client.fields.size(); i++) {
+    const irsdk_varHeader &header = _vars[client.fields[i].var];
+    appendInt(payload, header.type);
+    appendInt(payload, header.count);
+    appendInt(payload, client.fields[i].offset);
+    payload.append(header.name, nameLength);
+  }
+  send(client, 'L', payload.data(), (int)payload.size());
+}
+
+void RelayServer::sendSession(Client &client)
+{
+  send(client, 'S', _session.data(), (int)_session.size());
+}
+
+void RelayServer::sendError(Client &client, const std::string &message)
+{
+  send(client, 'E', message.data(), (int)message.size());
+}
+
+void RelayServer::setLayout(const irsdk_varHeader *vars, int count, int bufLen)
+{
+  _vars.assign(vars, vars + (count > 0 ? count : 0));
+  _bufLen = bufLen;
+  for (size_t i = 0; i < _clients.size(); i++) {
+    resolve(_clients[i]);
+    sendLayout(_clients[i]);
+  }
+}
+
+void RelayServer::setSessionInfo(const char *yaml, int length)
+{
+  _session.assign(yaml, length > 0 ? length : 0);
+  for (size_t i = 0; i < _clients.size(); i++) {
+    sendSession(_clients[i]);
+  }
+}
+
+void RelayServer::broadcast(const char *line, int tickCount, uint32_t frame, int64_t nowMs)
+{
+  for (size_t i = 0; i < _clients.size(); i++) {
+    Client &client = _clients[i];
+    if (client.closing || client.fields.empty()) continue;
+
+    if (client.minIntervalMs > 0) {
+      if (nowMs < client.nextFrameMs) continue;
+      // Keep to the requested rate on average without bursting after a stall
+      client.nextFrameMs += client.minIntervalMs;
+      if (client.nextFrameMs <= nowMs) client.nextFrameMs = nowMs + client.minIntervalMs;
+    }
+
+    if (client.output.size() > (size_t)FramePendingBytes) {
+      _droppedFrames++;
+      continue;
+    }
+
+    _frame.resize(8 + client.frameLength);
+    char *out = &_frame[0];
+    memcpy(out, &tickCount, 4);
+    memcpy(out + 4, &frame, 4);
+    for (size_t f = 0; f < client.fields.size(); f++) {
+      const Field &field = client.fields[f];
+      memcpy(out + 8 + field.offset, line + _vars[field.var].offset, field.length);
+    }
+    send(client, 'F', _frame.data(), (int)_frame.size());
+  }
+}
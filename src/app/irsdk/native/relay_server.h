@@ -0,0 +1,112 @@
+#ifndef RELAY_SERVER_H
+#define RELAY_SERVER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+
+#ifdef _WIN32
+typedef uintptr_t relay_socket_t;
+#else
+typedef int relay_socket_t;
+#endif
+
+// Serves telemetry lines to local clients over a Unix domain socket (AF_UNIX,
+// which Windows 10 supports as well). Each client picks the vars it wants and
+// how often it wants them; everything is non-blocking and a client that stops
+// reading only loses frames, it never holds up the relay.
+//
+// Client to relay, newline terminated text commands:
+//   subscribe [name...]   only these vars, every var when none are given
+//   rate <hz>             at most this many frames per second, 0 for every tick
+//   session               send the session info string again
+//
+// Relay to client, messages of: uint32 payload length, uint8 kind, payload.
+// Numbers are little endian.
+//   'L' layout:  int32 count, then count x { int32 type, int32 count,
+//                int32 offset, char name[32] } describing a frame's values
+//   'F' frame:   int32 tickCount, uint32 frame, then the subscribed values
+//                packed back to back at the layout's offsets
+//   'S' session: the session info YAML
+//   'E' error:   a message, e.g. for an unknown var or command
+//
+// A client gets the layout and session on connect and again whenever either
+// changes, so it never has to ask before decoding frames.
+class RelayServer
+{
+public:
+  // A slow client's unsent frames are dropped past this many bytes, and the
+  // client is dropped past MaxPendingBytes
+  static const int FramePendingBytes = 256 * 1024;
+  static const int MaxPendingBytes = 4 * 1024 * 1024;
+
+  RelayServer();
+  ~RelayServer() { close(); }
+
+  bool listen(const char *path);
+  void close();
+  bool isListening() const;
+
+  // Accepts clients, reads their commands and flushes what they haven't
+  // received yet. Waits up to timeoutMs for any of that to happen.
+  void service(int timeoutMs);
+
+  void setLayout(const irsdk_varHeader *vars, int count, int bufLen);
+  void setSessionInfo(const char *yaml, int length);
+
+  // Queues the line for every client that is due a frame. nowMs is any
+  // monotonic clock in milliseconds.
+  void broadcast(const char *line, int tickCount, uint32_t frame, int64_t nowMs);
+
+  int clientCount() const { return (int)_clients.size(); }
+  uint64_t droppedFrames() const { return _droppedFrames; }
+
+private:
+  struct Field
+  {
+    int var;
+    int offset;   // In the packed frame
+    int length;
+  };
+
+  struct Client
+  {
+    relay_socket_t socket;
+    std::vector<std::string> names; // Empty for every var
+    std::vector<Field> fields;
+    int frameLength;
+    int minIntervalMs;
+    int64_t nextFrameMs;
+    std::string input;
+    std::string output;
+    bool closing;
+  };
+
+  RelayServer(const RelayServer &);
+  RelayServer &operator=(const RelayServer &);
+
+  void accept();
+  void read(Client &client);
+  void flush(Client &client);
+  void command(Client &client, const std::string &line);
+  void resolve(Client &client);
+  void send(Client &client, char kind, const char *payload, int length);
+  void sendLayout(Client &client);
+  void sendSession(Client &client);
+  void sendError(Client &client, const std::string &message);
+  void closeClient(Client &client);
+
+  relay_socket_t _listener;
+  std::string _path;
+  std::vector<Client> _clients;
+
+  std::vector<irsdk_varHeader> _vars;
+  int _bufLen;
+  std::string _session;
+  std::string _frame;
+  uint64_t _droppedFrames;
+};
+
+#endif
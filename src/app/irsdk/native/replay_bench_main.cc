@@ -0,0 +1,198 @@
+// irsdk_replay_bench: replays an .ibt or a recording through the tick engines
+// the way the addon consumes the sim, to soak and benchmark them away from the
+// sim. At --speed N lines come paced at N times real time and the report shows
+// how closely the pacing held; --speed 0 replays as fast as the engines keep
+// up and shows their line rate.
+//
+// --trace <json> writes the spans of the run as a Chrome trace.
+//
+// Usage: irsdk_replay_bench --file <ibt|recording> [--speed <n>] [--seconds <n>] [--loop] [--trace <json>]
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "./replay_context.h"
+#include "./event_detector.h"
+#include "./lap_timing.h"
+#include "./frame_encoder.h"
+#include "./frame_ring.h"
+#include "./trace.h"
+
+static void usage()
+{
+  fprintf(stderr, "Usage: irsdk_replay_bench --file <ibt|recording> [--speed <n>] [--seconds <n>] [--loop] [--trace <json>]\n");
+}
+
+// The engines the addon runs on every line, minus the ones needing napi
+struct Consumers
+{
+  EventDetector events;
+  LapTiming lapTiming;
+  std::vector<char> lapTimingStorage;
+  FrameEncoder encoder;
+  std::vector<char> encoded;
+  FrameRingWriter ring;
+  std::vector<char> ringMemory;
+  long long eventCount;
+
+  Consumers()
+    : lapTimingStorage(LapTiming::byteLength())
+    , encoder(std::vector<std::string>(), true)
+    , eventCount(0)
+  {
+    lapTiming.attach(lapTimingStorage.data());
+  }
+
+  void bind(SdkContext *context)
+  {
+    const irsdk_header *header = context->header();
+    events.bindVars(context->vars(), header->numVars);
+    lapTiming.bindVars(context->vars(), header->numVars);
+    encoder.bindVars(context->vars(), header->numVars);
+
+    int slotCapacity = (header->bufLen + 7) & ~7;
+    ringMemory.assign(FrameRing::byteLength(slotCapacity), 0);
+    ring.attach(ringMemory.data(), (int)ringMemory.size(), slotCapacity);
+    ring.setLayout(context->vars(), header->numVars, header->bufLen);
+  }
+
+  void update(const char *line, int bufLen, int tickCount)
+  {
+    TRACE_SPAN("processTick");
+    events.update(line);
+    DetectedEvent drained[64];
+    while (int count = events.drain(drained, 64)) eventCount += count;
+    lapTiming.update(line);
+    encoded.clear();
+    encoder.encode(line, tickCount, false, &encoded);
+    ring.publish(line, bufLen, tickCount);
+  }
+};
+
+int main(int argc, char **argv)
+{
+  std::string file;
+  std::string trace;
+  double speed = 1;
+  double seconds = 5;
+  bool loop = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (0 == strcmp(arg, "--loop")) {
+      loop = true;
+      continue;
+    }
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (0 == strcmp(arg, "--file")) file = value;
+    else if (0 == strcmp(arg, "--speed")) speed = atof(value);
+    else if (0 == strcmp(arg, "--seconds")) seconds = atof(value);
+    else if (0 == strcmp(arg, "--trace")) trace = value;
+    else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+  if (file.empty()) {
+    usage();
+    return 2;
+  }
+
+  ReplayContext replay(ReplayContext::openFile(file.c_str()), speed, loop);
+  if (!replay.startup()) {
+    fprintf(stderr, "irsdk_replay_bench: can't open %s\n", file.c_str());
+    return 1;
+  }
+
+  if (!trace.empty()) {
+    traceSetThreadName("irsdk_replay_bench");
+    traceSetEnabled(true);
+  }
+
+  std::unique_ptr<Consumers> consumers(new Consumers());
+  std::vector<char> line;
+  int bufLen = -1;
+  int numVars = -1;
+  int tickRate = replay.header()->tickRate;
+
+  // Lateness of every line against when it was due, from the first line on
+  std::vector<double> lateness;
+  int firstTick = 0;
+  int lastTick = 0;
+  long long lines = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point first;
+  std::chrono::steady_clock::time_point end =
+    start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+
+  char pace[32];
+  if (speed > 0) snprintf(pace, sizeof(pace), "%gx", speed);
+  else snprintf(pace, sizeof(pace), "max speed");
+  printf("%s at %s, %.1fs%s\n", file.c_str(), pace, seconds, loop ? ", looping" : "");
+
+  while (std::chrono::steady_clock::now() < end) {
+    const irsdk_header *header = replay.header();
+    if ((int)line.size() < header->bufLen) line.resize(header->bufLen);
+    if (!replay.waitForData(16, line.data())) {
+      if (!replay.isConnected()) break;
+      continue;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    int tick = replay.tickCount();
+
+    if (bufLen != header->bufLen || numVars != header->numVars) {
+      bufLen = header->bufLen;
+      numVars = header->numVars;
+      consumers->bind(&replay);
+    }
+    consumers->update(line.data(), bufLen, tick);
+
+    if (lines == 0) {
+      first = now;
+      firstTick = tick;
+    } else if (speed > 0) {
+      std::chrono::duration<double> due((tick - firstTick) / (tickRate * speed));
+      lateness.push_back(std::chrono::duration<double>(now - first - due).count() * 1e6);
+    }
+    lastTick = tick;
+    lines++;
+  }
+
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double played = lines ? (double)(lastTick - firstTick) / tickRate : 0;
+  printf("lines      %lld (%.0f/s), %lld events\n", lines, lines / elapsed, consumers->eventCount);
+  printf("played     %.1fs of telemetry in %.1fs, %.2fx\n", played, elapsed, elapsed > 0 ? played / elapsed : 0);
+  printf("dropped    %lld, loops %d\n", replay.dropped(), replay.loops());
+
+  if (!lateness.empty()) {
+    std::sort(lateness.begin(), lateness.end());
+    double sum = 0;
+    for (size_t i = 0; i < lateness.size(); i++) sum += lateness[i];
+    printf("lateness   mean %.0fus  p50 %.0fus  p99 %.0fus  max %.0fus\n", sum / lateness.size(),
+           lateness[lateness.size() / 2], lateness[lateness.size() * 99 / 100], lateness.back());
+  }
+
+  if (!trace.empty()) {
+    std::string json = traceDumpJson();
+    FILE *out = fopen(trace.c_str(), "wb");
+    if (!out || fwrite(json.data(), 1, json.size(), out) != json.size()) {
+      fprintf(stderr, "irsdk_replay_bench: can't write %s\n", trace.c_str());
+      if (out) fclose(out);
+      return 1;
+    }
+    fclose(out);
+    printf("trace      %s\n", trace.c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,387 @@
+#include <algorithm>
+#include <string.h>
+#include <thread>
+
+#include "./replay_context.h"
+#include "./native_file.h"
+#include "./trace.h"
+
+// sleep_until can oversleep by a scheduler tick, so the last stretch before a
+// line is due is spun instead
+static const std::chrono::microseconds spinMargin(500);
+
+static void waitUntil(std::chrono::steady_clock::time_point due)
+{
+  TRACE_SPAN("waitForLine");
+  if (due - std::chrono::steady_clock::now() > spinMargin) std::this_thread::sleep_until(due - spinMargin);
+  while (std::chrono::steady_clock::now() < due) std::this_thread::yield();
+}
+
+// ---------------------------
+// RecordingContext
+// ---------------------------
+RecordingContext::RecordingContext(const char *path)
+  : _path(path)
+  , _file(NULL)
+  , _block(-1)
+  , _index(0)
+  , _layout(0)
+  , _line(0)
+  , _lineCount(0)
+{
+}
+
+bool RecordingContext::startup()
+{
+  if (_file) return true;
+
+  FILE *file = openFileUtf8(_path.c_str(), "rb");
+  if (!file) return false;
+
+  _decoder = RecordingDecoder();
+  char magic[8];
+  if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) || _decoder.begin(magic, sizeof(magic)) < 0) {
+    fclose(file);
+    return false;
+  }
+  _file = file;
+
+  // Looks like a connected sim with a single buffer to the rest of the addon.
+  // Recordings don't keep the tick rate, they are all made from the sim's 60Hz.
+  memset(&_header, 0, sizeof(_header));
+  _header.ver = IRSDK_VER;
+  _header.status = irsdk_stConnected;
+  _header.tickRate = 60;
+  _header.numBuf = 1;
+
+  _block = -1;
+  _layout = 0;
+  if (!index() || !seek(0)) {
+    shutdown();
+    return false;
+  }
+  return true;
+}
+
+void RecordingContext::shutdown()
+{
+  if (_file) fclose(_file);
+  _file = NULL;
+  _blocks.clear();
+  _lines.clear();
+  _ticks.clear();
+  _block = -1;
+  _line = 0;
+  _lineCount = 0;
+}
+
+// Skips over every record once, reading no more than a block's frame count
+bool RecordingContext::index()
+{
+  _blocks.clear();
+  long long offset = 8;
+  long long layoutOffset = -1;
+  int lines = 0;
+
+  char header[5];
+  while (seekFile(_file, offset) && fread(header, 1, 5, _file) == 5) {
+    uint32_t length;
+    memcpy(&length, header + 1, sizeof(length));
+    if (header[0] == 'L') {
+      layoutOffset = offset;
+    } else if (header[0] == 'B') {
+      uint32_t frames;
+      if (length < sizeof(frames) || fread(&frames, 1, sizeof(frames), _file) != sizeof(frames)) break;
+      if (layoutOffset < 0 || frames == 0) break;
+      Block block = { offset, layoutOffset, lines };
+      _blocks.push_back(block);
+      lines += (int)frames;
+    }
+    offset += 5 + (long long)length;
+  }
+
+  // A recording cut short by a crash ends with a partial record, reading
+  // simply stops at the last whole block
+  _lineCount = lines;
+  return !_blocks.empty();
+}
+
+bool RecordingContext::readRecord(long long offset)
+{
+  char header[5];
+  if (!seekFile(_file, offset) || fread(header, 1, sizeof(header), _file) != sizeof(header)) return false;
+  uint32_t length;
+  memcpy(&length, header + 1, sizeof(length));
+
+  _record.resize(sizeof(header) + length);
+  memcpy(&_record[0], header, sizeof(header));
+  if (length && fread(&_record[sizeof(header)], 1, length, _file) != length) return false;
+
+  int size = (int)_record.size();
+  return _decoder.next(&_record[0], size, &_lines, &_ticks) == size;
+}
+
+void RecordingContext::applyLayout()
+{
+  _header.numVars = (int)_decoder.vars().size();
+  _header.bufLen = _decoder.bufLen();
+  _layout = _decoder.layout();
+}
+
+bool RecordingContext::seek(int line)
+{
+  if (!_file || line < 0 || line >= _lineCount) return false;
+
+  // The last block starting at or before the line
+  int block = 0;
+  for (int lo = 0, hi = (int)_blocks.size() - 1; lo <= hi;) {
+    int mid = (lo + hi) / 2;
+    if (_blocks[mid].firstLine <= line) {
+      block = mid;
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  if (block != _block) {
+    // Blocks restart every channel, only the layout they follow is needed
+    if (_block < 0 || _blocks[_block].layoutOffset != _blocks[block].layoutOffset) {
+      if (!readRecord(_blocks[block].layoutOffset)) return false;
+      applyLayout();
+    }
+    _block = -1;
+    if (!readRecord(_blocks[block].offset)) return false;
+    _block = block;
+  }
+
+  _index = line - _blocks[block].firstLine;
+  _line = line;
+  _header.status = irsdk_stConnected;
+  return _index < (int)_ticks.size();
+}
+
+bool RecordingContext::waitForData(int, char *data)
+{
+  if (!startup() || !isConnected() || _block < 0) {
+    _header.status = 0;
+    return false;
+  }
+
+  memcpy(data, &_lines[(size_t)_index * _header.bufLen], _header.bufLen);
+  _header.varBuf[0].tickCount = _ticks[_index];
+  _index++;
+  _line++;
+
+  // Load the next block straight away, so header() always describes the line
+  // the next call hands out
+  if (_index >= (int)_ticks.size() && _line < _lineCount && !seek(_line)) _lineCount = _line;
+  return true;
+}
+
+// ---------------------------
+// ReplayContext
+// ---------------------------
+ReplayContext::ReplayContext(RecordedContext *source, double speed, bool loop)
+  : _source(source)
+  , _speed(speed > 0 ? speed : 0)
+  , _loop(loop)
+  , _open(false)
+  , _varsLayout(-1)
+  , _hasPending(false)
+  , _pendingTick(0)
+  , _pendingLine(0)
+  , _pendingLayout(-1)
+  , _nextLayout(-1)
+  , _clockTick(0)
+  , _restartClock(true)
+  , _tickOffset(0)
+  , _lastTick(0)
+  , _line(-1)
+  , _dropped(0)
+  , _loops(0)
+{
+}
+
+RecordedContext *ReplayContext::openFile(const char *path)
+{
+  char magic[4];
+  FILE *file = openFileUtf8(path, "rb");
+  bool recording = file && fread(magic, 1, sizeof(magic), file) == sizeof(magic) && 0 == memcmp(magic, "IRTC", 4);
+  if (file) fclose(file);
+
+  if (recording) return new RecordingContext(path);
+  return new FileContext(path);
+}
+
+bool ReplayContext::startup()
+{
+  if (_open) return true;
+  if (!_source->startup()) return false;
+
+  _header = *_source->header();
+  _header.status = irsdk_stConnected;
+  _header.numBuf = 1;
+  _header.varBuf[0].tickCount = 0;
+  if (_header.tickRate <= 0) _header.tickRate = 60;
+  _vars.assign(_source->vars(), _source->vars() + _header.numVars);
+  _varsLayout = _source->layout();
+  _pendingLayout = -1;
+  _nextLayout = -1;
+
+  _open = true;
+  _hasPending = false;
+  _restartClock = true;
+  _tickOffset = 0;
+  _lastTick = 0;
+  _line = -1;
+  return true;
+}
+
+void ReplayContext::shutdown()
+{
+  _source->shutdown();
+  _open = false;
+  _hasPending = false;
+}
+
+bool ReplayContext::isConnected() const
+{
+  return _open && (_hasPending || _loop || _source->isConnected());
+}
+
+std::chrono::duration<double> ReplayContext::tickPeriod() const
+{
+  return std::chrono::duration<double>(1.0 / (_header.tickRate * _speed));
+}
+
+std::chrono::steady_clock::time_point ReplayContext::due(int tick) const
+{
+  return _clockStart + std::chrono::duration_cast<std::chrono::steady_clock::duration>((tick - _clockTick) * tickPeriod());
+}
+
+// Reads the source's next line into _pending, with the var table it was
+// written with in _pendingVars. The table is only copied when the layout
+// changes, and kept as it was when there is no next line.
+bool ReplayContext::readSourceLine()
+{
+  // The source's header describes the line it hands out next
+  const irsdk_header *source = _source->header();
+  int layout = _source->layout();
+  if (layout != _pendingLayout && layout != _nextLayout) {
+    _nextVars.assign(_source->vars(), _source->vars() + source->numVars);
+    _nextLayout = layout;
+  }
+  _pending.resize(source->bufLen);
+  if (!_source->waitForData(0, _pending.data())) return false;
+
+  if (layout != _pendingLayout) {
+    _pendingVars.swap(_nextVars);
+    std::swap(_pendingLayout, _nextLayout);
+  }
+  return true;
+}
+
+// Reads the source's next line, going back to the start at the end when
+// looping
+bool ReplayContext::readPending()
+{
+  if (!_source->header()) return false;
+
+  int line = _source->line();
+  if (!readSourceLine()) {
+    if (!_loop || !_source->seek(0)) return false;
+    _loops++;
+    line = 0;
+    if (!readSourceLine()) return false;
+  }
+
+  _hasPending = true;
+  _pendingLine = line;
+  _pendingTick = _source->header()->varBuf[0].tickCount + _tickOffset;
+  if (_pendingTick <= _lastTick) {
+    // Looped or seeked back: carry on one tick after the last line handed
+    // out, so ticks keep going up like a sim that kept running
+    _tickOffset += _lastTick + 1 - _pendingTick;
+    _pendingTick = _lastTick + 1;
+  }
+  if (_restartClock) {
+    _clockStart = std::chrono::steady_clock::now();
+    _clockTick = _pendingTick;
+    _restartClock = false;
+  }
+  return true;
+}
+
+bool ReplayContext::waitForData(int timeoutMs, char *data)
+{
+  if (!startup()) return false;
+  if (!_hasPending && !readPending()) {
+    _header.status = 0;
+    return false;
+  }
+
+  if (_speed > 0) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point deadline = now + std::chrono::milliseconds(timeoutMs);
+    std::chrono::steady_clock::time_point at = due(_pendingTick);
+    if (at > deadline) {
+      std::this_thread::sleep_until(deadline);
+      return false;
+    }
+
+    // Like the sim, a consumer that fell behind gets the newest line due
+    std::vector<char> keep;
+    while (at + tickPeriod() < now && _source->isConnected()) {
+      keep.swap(_pending);
+      int tick = _pendingTick;
+      int line = _pendingLine;
+      if (!readPending()) {
+        keep.swap(_pending);
+        _pendingTick = tick;
+        _pendingLine = line;
+        _hasPending = true;
+        break;
+      }
+      _dropped++;
+      at = due(_pendingTick);
+    }
+    waitUntil(at);
+  }
+
+  // header() and vars() move on to the pending line's layout here
+  if (_pendingLayout != _varsLayout) {
+    _vars = _pendingVars;
+    _varsLayout = _pendingLayout;
+  }
+  // A new layout is announced in header() first, so the caller can make room
+  if ((int)_pending.size() != _header.bufLen || (int)_vars.size() != _header.numVars) {
+    _header.bufLen = (int)_pending.size();
+    _header.numVars = (int)_vars.size();
+    return false;
+  }
+
+  memcpy(data, _pending.data(), _pending.size());
+  _hasPending = false;
+  _lastTick = _pendingTick;
+  _line = _pendingLine;
+  _header.status = irsdk_stConnected;
+  _header.varBuf[0].tickCount = _pendingTick;
+  return true;
+}
+
+void ReplayContext::setSpeed(double speed)
+{
+  _speed = speed > 0 ? speed : 0;
+  // The next line is due one of the new ticks after now
+  _clockStart = std::chrono::steady_clock::now();
+  _clockTick = _hasPending ? _pendingTick - 1 : _lastTick;
+}
+
+bool ReplayContext::seek(int line)
+{
+  if (!startup() || !_source->seek(line)) return false;
+  _hasPending = false;
+  _restartClock = true;
+  return true;
+}
@@ -0,0 +1,143 @@
+#ifndef REPLAY_CONTEXT_H
+#define REPLAY_CONTEXT_H
+
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "./sdk_context.h"
+#include "./recording_codec.h"
+
+// A recording written by startRecording(), one line per waitForData() without
+// pacing. Recordings carry no session string, so the session info is empty.
+class RecordingContext : public RecordedContext
+{
+public:
+  explicit RecordingContext(const char *path);
+  ~RecordingContext() { shutdown(); }
+
+  bool startup();
+  void shutdown();
+  bool isConnected() const { return _file && _line < _lineCount; }
+  bool waitForData(int timeoutMs, char *data);
+
+  const irsdk_header *header() const { return _file ? &_header : NULL; }
+  const irsdk_varHeader *vars() const { return _file ? _decoder.vars().data() : NULL; }
+  const char *sessionInfo() const { return _file ? "" : NULL; }
+
+  bool seek(int line);
+  int line() const { return _line; }
+  int lineCount() const { return _lineCount; }
+  int layout() const { return _layout; }
+
+private:
+  RecordingContext(const RecordingContext &);
+  RecordingContext &operator=(const RecordingContext &);
+
+  // Where each block of lines starts, found by skipping over the records once
+  struct Block
+  {
+    long long offset;
+    long long layoutOffset; // The layout record the block was written with
+    int firstLine;
+  };
+
+  bool index();
+  bool readRecord(long long offset);
+  void applyLayout();
+
+  std::string _path;
+  FILE *_file;
+  irsdk_header _header;
+  RecordingDecoder _decoder;
+  std::vector<Block> _blocks;
+  std::vector<char> _record;
+  std::vector<char> _lines;
+  std::vector<int> _ticks;
+  int _block;  // Decoded into _lines, -1 for none
+  int _index;  // Next line of that block
+  int _layout; // Decoder layout _header was made from
+  int _line;
+  int _lineCount;
+};
+
+// Hands out the lines of a recorded source the way the sim would: paced by
+// their tick counts at a multiple of real time, or as fast as they can be read
+// with a speed of 0. A consumer that falls behind gets the newest line due and
+// the ones in between are dropped, like with the sim. Can seek and loop.
+class ReplayContext : public SdkContext
+{
+public:
+  // Takes ownership of source
+  ReplayContext(RecordedContext *source, double speed, bool loop);
+
+  // .ibt or a recording, by what the file starts with
+  static RecordedContext *openFile(const char *path);
+
+  bool startup();
+  void shutdown();
+  bool isConnected() const;
+  bool waitForData(int timeoutMs, char *data);
+
+  const irsdk_header *header() const { return _open ? &_header : NULL; }
+  // The source reads ahead, its table can already be the next layout's
+  const irsdk_varHeader *vars() const { return _open ? _vars.data() : NULL; }
+  const char *sessionInfo() const { return _source->sessionInfo(); }
+
+  ReplayContext *replay() { return this; }
+
+  void setSpeed(double speed);
+  double speed() const { return _speed; }
+  void setLoop(bool loop) { _loop = loop; }
+  bool loop() const { return _loop; }
+  bool seek(int line);
+
+  // Index of the line handed out last, -1 before the first
+  int line() const { return _line; }
+  int lineCount() const { return _source->lineCount(); }
+  // Lines skipped because the consumer fell behind
+  long long dropped() const { return _dropped; }
+  int loops() const { return _loops; }
+
+private:
+  bool readPending();
+  bool readSourceLine();
+  std::chrono::steady_clock::time_point due(int tick) const;
+  std::chrono::duration<double> tickPeriod() const;
+
+  std::unique_ptr<RecordedContext> _source;
+  double _speed;
+  bool _loop;
+  bool _open;
+  irsdk_header _header;
+  // Var table of the layout header() describes
+  std::vector<irsdk_varHeader> _vars;
+  int _varsLayout;
+
+  // Next line, read ahead to know when it is due
+  std::vector<char> _pending;
+  bool _hasPending;
+  int _pendingTick;
+  int _pendingLine;
+  std::vector<irsdk_varHeader> _pendingVars;
+  int _pendingLayout;
+  // Copied ahead of the source's next line, it may load a new layout over the old
+  std::vector<irsdk_varHeader> _nextVars;
+  int _nextLayout;
+
+  // The line with tick _clockTick is due at _clockStart
+  std::chrono::steady_clock::time_point _clockStart;
+  int _clockTick;
+  bool _restartClock;
+
+  // Ticks handed out keep going up across loops, like a sim that kept running
+  int _tickOffset;
+  int _lastTick;
+  int _line;
+  long long _dropped;
+  int _loops;
+};
+
+#endif
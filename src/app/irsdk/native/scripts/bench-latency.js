@@ -0,0 +1,264 @@
+/* eslint-disable @typescript-eslint/no-require-imports */
+const { spawn } = require("child_process");
+const fs = require("fs");
+const net = require("net");
+const os = require("os");
+const path = require("path");
+const { Worker } = require("worker_threads");
+
+// Sim to JS latency through every way JS can get a line: irsdk_sim_producer
+// stamps each line with the steady clock as it publishes it (ProducerTime,
+// the clock process.hrtime() reads too) and each mode measures how long until
+// JS has the line, plus the CPU this process spent per line.
+//
+//   waitForData   the addon's blocking loop, like the bridge runs it
+//   frameReader   that loop publishing to the frame ring, a worker thread
+//                 polling it with FrameReader like the overlays do
+//   relay         irsdk_relay pushing a few scalars to a socket subscription
+//   relayArrays   the same with the CarIdx arrays subscribed as well
+//
+// CPU is this process's alone, what the relay spends isn't in it. The relay
+// modes run anywhere irsdk_relay builds; the addon modes need the addon, so
+// Windows only, and are skipped when it doesn't load. Results go to stdout
+// and, with --json, to a file for comparing releases.
+// Usage: node bench-latency.js [--build <dir>] [--seconds <n>] [--rate <hz>] [--modes a,b] [--json <path>]
+const args = {};
+for (let i = 2; i < process.argv.length; i += 2) args[process.argv[i].replace(/^--/, "")] = process.argv[i + 1];
+const BUILD_DIR = path.resolve(args.build ?? path.join(__dirname, "../../../../../build/Release"));
+const SECONDS = Number(args.seconds ?? 10);
+const RATE = Number(args.rate ?? 60);
+const EXE = process.platform === "win32" ? ".exe" : "";
+const SOURCE = `Local\\IRDashiesLatencyBench${process.pid}`;
+const FRAMES = `Local\\IRDashiesLatencyBenchFrames${process.pid}`;
+const SOCKET = path.join(os.tmpdir(), `irdashies-latency-bench-${process.pid}.sock`);
+// How often the frame reader worker looks for a new frame
+const POLL_MS = 0.25;
+
+const children = [];
+const run = (name, runArgs) => {
+  const child = spawn(path.join(BUILD_DIR, name + EXE), runArgs, { stdio: ["ignore", "ignore", "inherit"] });
+  children.push(child);
+  return child;
+};
+const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+const nowSeconds = () => Number(process.hrtime.bigint()) / 1e9;
+
+let addon = null;
+try {
+  addon = require(path.join(BUILD_DIR, "irsdk_node.node"));
+} catch {
+  // Relay modes only
+}
+
+// Latency and CPU of one mode from the stamps it saw. Each sample is
+// [tickCount, producer time, receive time] in seconds.
+const summarize = (samples, cpu) => {
+  const latencies = samples.map(([, sent, received]) => (received - sent) * 1e6).sort((a, b) => a - b);
+  const at = (p) => latencies[Math.min(latencies.length - 1, Math.floor((latencies.length * p) / 100))];
+  const ticks = samples.map(([tick]) => tick);
+  const expected = ticks.length ? ticks[ticks.length - 1] - ticks[0] + 1 : 0;
+  const cpuUs = (cpu.user + cpu.system) / Math.max(1, samples.length);
+  return {
+    frames: samples.length,
+    missed: expected - new Set(ticks).size,
+    latencyUs: latencies.length
+      ? {
+          mean: latencies.reduce((sum, value) => sum + value, 0) / latencies.length,
+          p50: at(50),
+          p90: at(90),
+          p99: at(99),
+          p999: at(99.9),
+          max: latencies[latencies.length - 1],
+        }
+      : null,
+    cpuUsPerFrame: cpuUs,
+  };
+};
+
+// Blocks the main thread for the whole run, like the bridge's loop
+const consumeWaitForData = (sdk, onLine) => {
+  const telemetry = sdk.getTelemetryData(true);
+  const tick = new Int32Array(telemetry.SessionTick.value);
+  const stamp = new Float64Array(telemetry.ProducerTime.value);
+  const end = nowSeconds() + SECONDS;
+  while (nowSeconds() < end) {
+    if (!sdk.waitForData(100)) continue;
+    sdk.getTelemetryData(true);
+    onLine(tick[0], stamp[0]);
+  }
+};
+
+const openSdk = () => {
+  const sdk = new addon.iRacingSdkNode({ name: SOURCE });
+  sdk.startSDK();
+  if (!sdk.waitForData(2000)) throw new Error("the addon got no data from the producer");
+  return sdk;
+};
+
+const waitForData = async () => {
+  const sdk = openSdk();
+  const samples = [];
+  const cpu = process.cpuUsage();
+  consumeWaitForData(sdk, (tick, stamp) => samples.push([tick, stamp, nowSeconds()]));
+  const result = summarize(samples, process.cpuUsage(cpu));
+  sdk.stopSDK();
+  return result;
+};
+
+const FRAME_READER_WORKER = `
+const { parentPort, workerData } = require("worker_threads");
+const { FrameReader } = require(workerData.addon);
+const stop = new Int32Array(workerData.stop);
+const reader = new FrameReader();
+const samples = [];
+let stamp = null;
+let tick = null;
+while (!Atomics.load(stop, 0)) {
+  if (!reader.isOpen() && !reader.open(workerData.name)) {
+    Atomics.wait(stop, 0, 0, 10);
+    continue;
+  }
+  const frame = reader.read();
+  if (!frame) {
+    Atomics.wait(stop, 0, 0, workerData.pollMs);
+    continue;
+  }
+  const received = Number(process.hrtime.bigint()) / 1e9;
+  if (!stamp) {
+    const vars = reader.getVars();
+    const time = vars.find((v) => v.name === "ProducerTime");
+    const session = vars.find((v) => v.name === "SessionTick");
+    stamp = (view) => view.getFloat64(time.offset, true);
+    tick = (view) => view.getInt32(session.offset, true);
+  }
+  const view = new DataView(frame.buffer);
+  samples.push([tick(view), stamp(view), received]);
+}
+parentPort.postMessage(samples);
+`;
+
+const frameReader = async () => {
+  const sdk = openSdk();
+  if (!sdk.startFramePublisher(FRAMES)) throw new Error("startFramePublisher failed");
+  const stop = new SharedArrayBuffer(4);
+  const worker = new Worker(FRAME_READER_WORKER, {
+    eval: true,
+    workerData: { addon: path.join(BUILD_DIR, "irsdk_node.node"), name: FRAMES, stop, pollMs: POLL_MS },
+  });
+  const done = new Promise((resolve, reject) => {
+    worker.once("message", resolve);
+    worker.once("error", reject);
+  });
+  await sleep(200);
+
+  const cpu = process.cpuUsage();
+  consumeWaitForData(sdk, () => {});
+  Atomics.store(new Int32Array(stop), 0, 1);
+  Atomics.notify(new Int32Array(stop), 0);
+  const samples = await done;
+  const result = summarize(samples, process.cpuUsage(cpu));
+  sdk.stopFramePublisher();
+  sdk.stopSDK();
+  return result;
+};
+
+// Decodes the relay's frames as they arrive, see relay_server.h
+const relaySubscription = (vars) => async () => {
+  const samples = [];
+  let layout = null;
+  let pending = Buffer.alloc(0);
+  const socket = net.connect(SOCKET);
+  await new Promise((resolve, reject) => {
+    socket.once("connect", resolve);
+    socket.once("error", reject);
+  });
+
+  const cpu = process.cpuUsage();
+  socket.on("data", (chunk) => {
+    const received = nowSeconds();
+    pending = pending.length ? Buffer.concat([pending, chunk]) : chunk;
+    while (pending.length >= 5) {
+      const length = pending.readUInt32LE(0);
+      if (pending.length < 5 + length) break;
+      const kind = String.fromCharCode(pending[4]);
+      const payload = pending.subarray(5, 5 + length);
+      pending = pending.subarray(5 + length);
+      if (kind === "L") {
+        layout = {};
+        for (let i = 0; i < payload.readInt32LE(0); i++) {
+          const at = 4 + i * 44;
+          layout[payload.toString("latin1", at + 12, at + 44).replace(/\0.*$/, "")] = payload.readInt32LE(at + 8);
+        }
+      } else if (kind === "F" && layout) {
+        samples.push([payload.readInt32LE(0), payload.readDoubleLE(8 + layout.ProducerTime), received]);
+      }
+    }
+  });
+  socket.write(`subscribe ${vars.join(" ")}\nrate 0\n`);
+  await sleep(SECONDS * 1000);
+  socket.destroy();
+  return summarize(samples, process.cpuUsage(cpu));
+};
+
+const MODES = {
+  waitForData: { run: waitForData, needsAddon: true },
+  frameReader: { run: frameReader, needsAddon: true },
+  relay: { run: relaySubscription(["ProducerTime", "SessionTick", "Speed", "Gear"]) },
+  relayArrays: {
+    run: relaySubscription(["ProducerTime", "SessionTick", "CarIdxLap", "CarIdxLapDistPct", "CarIdxOnPitRoad"]),
+  },
+};
+
+const format = (value) => (value === undefined ? "-" : value.toFixed(0).padStart(6));
+
+(async () => {
+  const selected = args.modes ? args.modes.split(",") : Object.keys(MODES);
+  const unknown = selected.filter((name) => !MODES[name]);
+  if (unknown.length) throw new Error(`unknown modes: ${unknown.join(", ")}`);
+
+  run("irsdk_sim_producer", ["--name", SOURCE, "--rate", String(RATE)]);
+  await sleep(200);
+  if (selected.some((name) => name.startsWith("relay"))) {
+    run("irsdk_relay", ["--source", SOURCE, "--socket", SOCKET, "--export", "none"]);
+    await sleep(300);
+  }
+
+  const results = {};
+  console.log(`${RATE} Hz, ${SECONDS}s per mode, latency in us`);
+  console.log("mode          frames missed   mean    p50    p90    p99  p99.9    max  cpu/frame");
+  for (const name of selected) {
+    const mode = MODES[name];
+    if (mode.needsAddon && !addon) {
+      console.log(`${name.padEnd(13)} skipped, the addon didn't load from ${BUILD_DIR}`);
+      continue;
+    }
+    const result = await mode.run();
+    results[name] = result;
+    const l = result.latencyUs ?? {};
+    console.log(
+      `${name.padEnd(13)} ${String(result.frames).padStart(6)} ${String(result.missed).padStart(6)} ` +
+        `${format(l.mean)} ${format(l.p50)} ${format(l.p90)} ${format(l.p99)} ${format(l.p999)} ${format(l.max)} ` +
+        `${result.cpuUsPerFrame.toFixed(1).padStart(10)}`
+    );
+  }
+
+  if (args.json) {
+    const report = {
+      date: new Date().toISOString(),
+      platform: `${process.platform}-${process.arch}`,
+      cpu: os.cpus()[0]?.model,
+      node: process.version,
+      rate: RATE,
+      seconds: SECONDS,
+      pollMs: POLL_MS,
+      modes: results,
+    };
+    fs.writeFileSync(args.json, JSON.stringify(report, null, 2));
+    console.log(`results in ${args.json}`);
+  }
+  children.forEach((child) => child.kill("SIGINT"));
+})().catch((err) => {
+  process.stderr.write(`FAIL: ${err.message}\n`);
+  children.forEach((child) => child.kill());
+  process.exit(1);
+});
@@ -0,0 +1,51 @@
+/* eslint-disable @typescript-eslint/no-require-imports */
+const NativeSDK = require("../build/Release/irsdk_node.node").iRacingSdkNode;
+
+// Compares evaluating N native triggers against one full getTelemetryData()
+// call, on the addon's simulated session so no sim is needed and runs compare
+// between machines.
+// Usage: node bench-triggers.js [triggerCount] [iterations]
+const TRIGGER_COUNT = Number(process.argv[2] ?? 500);
+const ITERATIONS = Number(process.argv[3] ?? 1000);
+
+console.log("Benchmarking native triggers.");
+
+const sdk = new NativeSDK({ source: "simulated", paced: false });
+sdk.startSDK();
+
+if (!sdk.waitForData(5000)) {
+  process.stderr.write("The simulated session didn't start.");
+  process.exit(1);
+}
+
+const templates = [
+  (i) => `Speed > ${i % 90} && Brake > 0.5`,
+  (i) => `LapDistPct < Throttle * ${(i % 5) + 1}`,
+  (i) => `RPM > ${5000 + i} || !(Gear > 0)`,
+  (i) => `CarIdxLapDistPct[${i % 64}] > 0.5 && CarIdxOnPitRoad[${i % 64}] == 0`,
+];
+for (let i = 0; i < TRIGGER_COUNT; i++) {
+  sdk.addTrigger(templates[i % templates.length](i));
+}
+
+const time = (fn) => {
+  const start = process.hrtime.bigint();
+  fn();
+  return Number(process.hrtime.bigint() - start) / 1e3 / ITERATIONS;
+};
+
+// Warm up both paths first
+sdk.__evaluateTriggers(100);
+for (let i = 0; i < 10; i++) sdk.getTelemetryData();
+
+const triggersUs = time(() => sdk.__evaluateTriggers(ITERATIONS));
+const telemetryUs = time(() => {
+  for (let i = 0; i < ITERATIONS; i++) sdk.getTelemetryData();
+});
+
+console.log(`${TRIGGER_COUNT} triggers: ${triggersUs.toFixed(2)}us per tick`);
+console.log(`getTelemetryData(): ${telemetryUs.toFixed(2)}us per call`);
+console.log(`Triggers cost ${((triggersUs / telemetryUs) * 100).toFixed(1)}% of one telemetry read`);
+
+sdk.clearTriggers();
+sdk.stopSDK();
@@ -1,24 +1,55 @@
 /* eslint-disable @typescript-eslint/no-require-imports */
-const NativeSDK = require("../build/Debug/irsdk_node.node").iRacingSdkNode;
 const path = require("path");
 const fs = require("fs");
 
+// Usage: node scripts/generate-var-types.js [--from <telemetry.json>] [--only ts|cpp]
+// Reads the var table from the running sim, or from a getTelemetryData() dump
+// such as node/utils/mock-data/telemetry.json with --from.
+const args = process.argv.slice(2);
+const option = (name) => {
+  const i = args.indexOf(name);
+  return i >= 0 ? args[i + 1] : undefined;
+};
+const FROM = option("--from");
+const ONLY = option("--only");
+
 const TARGET_FILE = "_GENERATED_telemetry.ts";
 const OUT_PATH = path.resolve(process.cwd(), "../types/", TARGET_FILE);
+const CPP_TARGET_FILE = "_GENERATED_known_vars.h";
+const CPP_OUT_PATH = path.resolve(process.cwd(), CPP_TARGET_FILE);
 
 console.log("Generating iRacing telemetry variable types.");
-console.log("Make sure the sim is running!");
 
-const sdk = new NativeSDK();
-sdk.startSDK();
+// [{ name, varType, length }] in the sim's order
+const readVars = () => {
+  if (FROM) {
+    const dump = JSON.parse(fs.readFileSync(path.resolve(process.cwd(), FROM), "utf-8"));
+    return Object.values(dump).map(({ name, varType, length }) => ({ name, varType, length }));
+  }
 
-// Telemetry command, Start Recording
-sdk.broadcast(10, 1);
-// Wait a max of 5s
-if (!sdk.waitForData(5000)) {
-  process.stderr.write("No data. Make sure the sim is running and try again.");
-  process.exit(1);
-}
+  console.log("Make sure the sim is running!");
+  const NativeSDK = require("../build/Debug/irsdk_node.node").iRacingSdkNode;
+  const sdk = new NativeSDK();
+  sdk.startSDK();
+
+  // Telemetry command, Start Recording
+  sdk.broadcast(10, 1);
+  // Wait a max of 5s
+  if (!sdk.waitForData(5000)) {
+    process.stderr.write("No data. Make sure the sim is running and try again.");
+    process.exit(1);
+  }
+
+  // Get all the types
+  const types = sdk.__getTelemetryTypes();
+  return Object.keys(types).map((name) => ({
+    name,
+    varType: types[name],
+    length: sdk.getTelemetryVariable(name).length,
+  }));
+};
+
+const vars = readVars();
 
 const varTypes = [
   "string",
@@ -29,8 +60,6 @@ const varTypes = [
   "number",
 ];
 
-// Get all the types
-const types = sdk.__getTelemetryTypes();
 const out = `
 // ! THIS FILE IS AUTO-GENERATED, EDITS WILL BE OVERRIDDEN !
 // ! Make changes to the generate-var-types in @irsk-node/native !
@@ -56,17 +85,63 @@ export interface TelemetryVariable<VarType = number[]> {
 }
 
 export interface TelemetryVarList {
-${Object.keys(types).map((varName) => 
-  `  ${varName}: TelemetryVariable<${varTypes[types[varName]]}[]>`
+${vars.map(({ name, varType }) =>
+  `  ${name}: TelemetryVariable<${varTypes[varType]}[]>`
 ).join(";\n")};
 }
 `;
 
-fs.writeFile(OUT_PATH, out, "utf-8", (err) => {
-  if (err) {
+const cppVarTypes = [
+  "irsdk_char",
+  "irsdk_bool",
+  "irsdk_int",
+  "irsdk_bitField",
+  "irsdk_float",
+  "irsdk_double",
+];
+
+const cppOut = `// ! THIS FILE IS AUTO-GENERATED, EDITS WILL BE OVERRIDDEN !
+// ! Make changes to scripts/generate-var-types.js !
+
+#ifndef GENERATED_KNOWN_VARS_H
+#define GENERATED_KNOWN_VARS_H
+
+#include "./lib/irsdk_defines.h"
+
+// The vars the sim had when this was generated, see known_vars.h
+struct KnownVarInfo
+{
+  const char *name;
+  irsdk_VarType type;
+  int count;
+};
+
+enum KnownVar
+{
+${vars.map(({ name }) => `  KnownVar_${name},`).join("\n")}
+  KnownVarCount
+};
+
+static constexpr KnownVarInfo knownVarTable[KnownVarCount] = {
+${vars.map(({ name, varType, length }) =>
+  `  { "${name}", ${cppVarTypes[varType]}, ${length} },`
+).join("\n")}
+};
+
+#endif
+`;
+
+const outputs = [];
+if (ONLY !== "cpp") outputs.push([OUT_PATH, out]);
+if (ONLY !== "ts") outputs.push([CPP_OUT_PATH, cppOut]);
+
+for (const [file, content] of outputs) {
+  try {
+    fs.writeFileSync(file, content, "utf-8");
+  } catch (err) {
     console.error("There was an error creating the file:", err);
-    return;
+    process.exit(1);
   }
-  console.log("Successfully generated types!");
-  process.exit(0);
-});
+}
+console.log(`Successfully generated types for ${vars.length} vars!`);
+process.exit(0);
@@ -0,0 +1,126 @@
+/* eslint-disable @typescript-eslint/no-require-imports */
+const path = require("path");
+
+// Drives a simulated session through each API mode of the addon and checks
+// what every steady state frame allocates, native heap and N-API values, from
+// getAllocationStats() of the main thread. No sim needed, but it needs the
+// addon, so Windows only; build/Release/irsdk_alloc_test covers the native
+// paths anywhere. Native allocations are only counted in an addon built with
+// IRSDK_ALLOC_STATS=1 set, otherwise just the N-API budgets are checked.
+// Usage: node test-alloc-budget.js [buildDir] [frames]
+const BUILD_DIR = path.resolve(process.argv[2] ?? path.join(__dirname, "../../../../../build/Release"));
+const FRAMES = Number(process.argv[3] ?? 2000);
+const WARMUP = 200;
+
+const { iRacingSdkNode } = require(path.join(BUILD_DIR, "irsdk_node.node"));
+
+const napiCount = (counts) => counts.napiObjects + counts.napiArrays + counts.napiStrings + counts.napiBuffers;
+
+// Budgets are per frame, waitForData() included. setup() runs once on the
+// connected instance and may return a value frame() gets.
+const MODES = [
+  {
+    name: "waitForData",
+    frame: () => {},
+    native: 0,
+    napi: 0,
+  },
+  {
+    // A fresh object per var, with its name, description, unit and value
+    name: "getTelemetryData",
+    frame: (sdk) => sdk.getTelemetryData(),
+    native: 0,
+    napi: (sdk) => 1 + 5 * Object.keys(sdk.__getTelemetryTypes()).length,
+  },
+  {
+    name: "getTelemetryData(reuse)",
+    frame: (sdk) => sdk.getTelemetryData(true),
+    native: 0,
+    napi: 0,
+  },
+  {
+    name: "views",
+    frame: (sdk) => {
+      sdk.getCarTable();
+      sdk.getSessionTables();
+      sdk.getLapTiming();
+      sdk.getLapDelta();
+    },
+    native: 0,
+    napi: 0,
+  },
+  {
+    // The array every call, plus the odd event
+    name: "getEvents",
+    frame: (sdk) => sdk.getEvents(),
+    native: 0,
+    napi: 1.5,
+  },
+  {
+    name: "encodeFrame",
+    setup: (sdk) => sdk.createFrameEncoder(),
+    frame: (sdk, id) => sdk.encodeFrame(id),
+    native: 0,
+    napi: 1,
+  },
+  {
+    name: "sharedFramePublisher",
+    setup: (sdk) => {
+      const view = new Uint8Array(new SharedArrayBuffer(1 << 20));
+      if (!sdk.startSharedFramePublisher(view)) throw new Error("startSharedFramePublisher failed");
+      return view;
+    },
+    frame: () => {},
+    native: 0,
+    napi: 0,
+  },
+];
+
+const run = (mode) => {
+  const sdk = new iRacingSdkNode({ source: "simulated", paced: false });
+  sdk.startSDK();
+  if (!sdk.waitForData(1000)) throw new Error("simulated session didn't start");
+  const state = mode.setup ? mode.setup(sdk) : undefined;
+
+  let before;
+  for (let i = 0; i < WARMUP + FRAMES; i++) {
+    if (i === WARMUP) before = sdk.getAllocationStats().thread;
+    if (!sdk.waitForData(1000)) throw new Error("no data");
+    mode.frame(sdk, state);
+  }
+  const after = sdk.getAllocationStats().thread;
+
+  const result = {
+    native: (after.nativeAllocs - before.nativeAllocs) / FRAMES,
+    napi: (napiCount(after) - napiCount(before)) / FRAMES,
+    nativeBudget: typeof mode.native === "function" ? mode.native(sdk) : mode.native,
+    napiBudget: typeof mode.napi === "function" ? mode.napi(sdk) : mode.napi,
+  };
+  sdk.stopSDK();
+  return result;
+};
+
+const countsNative = new iRacingSdkNode({ source: "simulated" }).getAllocationStats().native;
+if (!countsNative) {
+  process.stdout.write("native allocations aren't counted, rebuild the addon with IRSDK_ALLOC_STATS=1 to check them\n");
+}
+
+let failed = 0;
+for (const mode of MODES) {
+  let result;
+  try {
+    result = run(mode);
+  } catch (error) {
+    process.stdout.write(`FAIL ${mode.name}: ${error.message}\n`);
+    failed++;
+    continue;
+  }
+  const ok = (!countsNative || result.native <= result.nativeBudget) && result.napi <= result.napiBudget;
+  if (!ok) failed++;
+  const native = countsNative ? `${result.native.toFixed(3)}/frame (budget ${result.nativeBudget})` : "not counted";
+  process.stdout.write(
+    `${ok ? "ok  " : "FAIL"} ${mode.name.padEnd(24)} native ${native}, ` +
+      `napi ${result.napi.toFixed(3)}/frame (budget ${result.napiBudget})\n`
+  );
+}
+process.exit(failed ? 1 : 0);
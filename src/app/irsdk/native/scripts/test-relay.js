@@ -0,0 +1,122 @@
+/* eslint-disable @typescript-eslint/no-require-imports */
+const { spawn } = require("child_process");
+const net = require("net");
+const os = require("os");
+const path = require("path");
+
+// Runs irsdk_relay against irsdk_sim_producer and checks what local clients get.
+// Works on Linux, no sim needed.
+// Usage: node test-relay.js [buildDir]
+const BUILD_DIR = path.resolve(process.argv[2] ?? path.join(__dirname, "../../../../../build/Release"));
+const EXE = process.platform === "win32" ? ".exe" : "";
+const SOURCE = `Local\\IRDashiesRelayTest${process.pid}`;
+const EXPORT = `Local\\IRDashiesRelayTestFrames${process.pid}`;
+const SOCKET = path.join(os.tmpdir(), `irdashies-relay-test-${process.pid}.sock`);
+const DURATION_MS = 2000;
+
+const children = [];
+const run = (name, args) => {
+  const child = spawn(path.join(BUILD_DIR, name + EXE), args, { stdio: ["ignore", "inherit", "inherit"] });
+  children.push(child);
+  return child;
+};
+const sleep = (ms) => new Promise((resolve) => setTimeout(resolve, ms));
+
+const fail = (message) => {
+  process.stderr.write(`FAIL: ${message}\n`);
+  children.forEach((child) => child.kill());
+  process.exit(1);
+};
+
+const VAR_BYTES = [1, 1, 4, 4, 4, 8];
+const readValue = (view, type, offset) => {
+  switch (type) {
+    case 0: case 1: return view.getUint8(offset);
+    case 2: case 3: return view.getInt32(offset, true);
+    case 4: return view.getFloat32(offset, true);
+    default: return view.getFloat64(offset, true);
+  }
+};
+
+// Connects, sends the commands and collects everything until stopped
+const connect = (commands) =>
+  new Promise((resolve, reject) => {
+    const client = { layout: null, frames: [], session: null, errors: [] };
+    let pending = Buffer.alloc(0);
+    const socket = net.connect(SOCKET, () => {
+      commands.forEach((command) => socket.write(command + "\n"));
+      resolve(client);
+    });
+    socket.on("error", reject);
+    socket.on("data", (chunk) => {
+      pending = Buffer.concat([pending, chunk]);
+      while (pending.length >= 5) {
+        const length = pending.readUInt32LE(0);
+        if (pending.length < 5 + length) break;
+        const kind = String.fromCharCode(pending[4]);
+        const payload = pending.subarray(5, 5 + length);
+        pending = pending.subarray(5 + length);
+
+        if (kind === "L") {
+          const count = payload.readInt32LE(0);
+          client.layout = [];
+          for (let i = 0; i < count; i++) {
+            const at = 4 + i * 44;
+            const name = payload.toString("latin1", at + 12, at + 44).replace(/\0.*$/, "");
+            client.layout.push({ name, type: payload.readInt32LE(at), count: payload.readInt32LE(at + 4), offset: payload.readInt32LE(at + 8) });
+          }
+        } else if (kind === "F") {
+          const view = new DataView(payload.buffer, payload.byteOffset, payload.length);
+          const values = {};
+          for (const v of client.layout) {
+            values[v.name] = readValue(view, v.type, 8 + v.offset);
+            if (v.count > 1) values[v.name + ".last"] = readValue(view, v.type, 8 + v.offset + (v.count - 1) * VAR_BYTES[v.type]);
+          }
+          client.frames.push({ tickCount: payload.readInt32LE(0), values });
+        } else if (kind === "S") {
+          client.session = payload.toString("utf8");
+        } else if (kind === "E") {
+          client.errors.push(payload.toString("utf8"));
+        }
+      }
+    });
+    client.close = () => socket.destroy();
+  });
+
+(async () => {
+  run("irsdk_sim_producer", ["--name", SOURCE]);
+  await sleep(200);
+  const relay = run("irsdk_relay", ["--source", SOURCE, "--socket", SOCKET, "--export", EXPORT]);
+  relay.on("exit", (code) => code && fail(`relay exited with ${code}`));
+  await sleep(300);
+
+  const full = await connect(["subscribe Speed Gear SessionTick CarIdxLapDistPct"]);
+  const limited = await connect(["subscribe Speed", "rate 10"]);
+  const everything = await connect([]);
+  const bad = await connect(["subscribe Speed NotAVar", "bogus"]);
+  await sleep(DURATION_MS);
+  [full, limited, everything, bad].forEach((client) => client.close());
+
+  const seconds = DURATION_MS / 1000;
+  console.log(`full rate:   ${full.frames.length} frames (${(full.frames.length / seconds).toFixed(1)} Hz)`);
+  console.log(`rate 10:     ${limited.frames.length} frames (${(limited.frames.length / seconds).toFixed(1)} Hz)`);
+  console.log(`every var:   ${everything.layout?.length} vars, ${everything.frames.length} frames`);
+
+  if (!full.layout || full.layout.map((v) => v.name).join() !== "Speed,Gear,SessionTick,CarIdxLapDistPct") fail("subscribed layout");
+  if (full.frames.length < 50 * seconds) fail("full rate client is missing frames");
+  for (let i = 1; i < full.frames.length; i++) {
+    const frame = full.frames[i];
+    if (frame.values.SessionTick <= full.frames[i - 1].values.SessionTick) fail("ticks out of order");
+    if (frame.values.Gear < 1 || frame.values.Gear > 6) fail(`bad gear ${frame.values.Gear}`);
+    if (frame.values.SessionTick !== frame.tickCount) fail("frame tick doesn't match SessionTick");
+  }
+  if (limited.layout?.length !== 1 || limited.frames.length < 8 * seconds || limited.frames.length > 12 * seconds) {
+    fail("rate limited client got the wrong number of frames");
+  }
+  if (!everything.session?.includes("TrackName: simtrack")) fail("session info");
+  if (everything.layout?.length < 10) fail("unsubscribed client should get every var");
+  if (bad.layout?.length !== 1 || bad.errors.length !== 2) fail(`errors: ${JSON.stringify(bad.errors)}`);
+
+  children.forEach((child) => child.kill("SIGINT"));
+  console.log("OK");
+})().catch((err) => fail(err.message));
@@ -0,0 +1,261 @@
+#include <atomic>
+#include <limits.h>
+#include <string.h>
+#include <thread>
+
+#include "./sdk_context.h"
+#include "./native_file.h"
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// Same as irsdk_isConnected(): no new line for this long means the sim is gone
+static const std::chrono::seconds connectionTimeout(30);
+
+int SdkContext::tickCount() const
+{
+  const irsdk_header *h = header();
+  int tickCount = 0;
+  for (int i = 0; h && i < h->numBuf; i++) {
+    if (h->varBuf[i].tickCount > tickCount) tickCount = h->varBuf[i].tickCount;
+  }
+  return tickCount;
+}
+
+// The source marks "no line yet" with INT_MAX
+static int copiedTickCount(const TelemetrySource &source)
+{
+  int tickCount = source.tickCount();
+  return tickCount == INT_MAX ? 0 : tickCount;
+}
+
+int SdkContext::sessionInfoUpdate() const
+{
+  const irsdk_header *h = header();
+  return h ? h->sessionInfoUpdate : -1;
+}
+
+const irsdk_varHeader *SdkContext::varEntry(int index) const
+{
+  const irsdk_header *h = header();
+  if (!h || index < 0 || index >= h->numVars) return NULL;
+  return &vars()[index];
+}
+
+int SdkContext::varIndex(const char *name) const
+{
+  const irsdk_header *h = header();
+  if (!h || !name) return -1;
+
+  const irsdk_varHeader *list = vars();
+  for (int i = 0; i < h->numVars; i++) {
+    if (0 == strncmp(name, list[i].name, IRSDK_MAX_STRING)) return i;
+  }
+  return -1;
+}
+
+// ---------------------------
+// LiveContext
+// ---------------------------
+LiveContext::LiveContext(const char *name)
+  : _name(name)
+{
+}
+
+bool LiveContext::startup()
+{
+  if (_source.isOpen()) return true;
+  return _source.open(_name.c_str());
+}
+
+void LiveContext::shutdown()
+{
+  _source.close();
+  _lastValid = std::chrono::steady_clock::time_point();
+}
+
+bool LiveContext::isConnected() const
+{
+  if (!_source.isConnected()) return false;
+  return std::chrono::steady_clock::now() - _lastValid < connectionTimeout;
+}
+
+int LiveContext::tickCount() const
+{
+  return copiedTickCount(_source);
+}
+
+bool LiveContext::waitForData(int timeoutMs, char *data)
+{
+  if (!startup()) {
+    // Don't let callers spin while the sim isn't running
+    if (timeoutMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs));
+    return false;
+  }
+
+  if (!_source.waitForData(timeoutMs, data)) return false;
+  _lastValid = std::chrono::steady_clock::now();
+  return true;
+}
+
+// ---------------------------
+// FileContext
+// ---------------------------
+FileContext::FileContext(const char *path)
+  : _path(path)
+  , _file(NULL)
+  , _line(0)
+  , _lineCount(0)
+{
+}
+
+bool FileContext::startup()
+{
+  if (_file) return true;
+
+  FILE *file = openFileUtf8(_path.c_str(), "rb");
+  if (!file) return false;
+
+  // An irsdk_header and an irsdk_diskSubHeader, then the offsets in the header
+  // point at the var headers, the session string and the first line
+  irsdk_header header;
+  irsdk_diskSubHeader subHeader;
+  bool valid = fread(&header, sizeof(header), 1, file) == 1 && fread(&subHeader, sizeof(subHeader), 1, file) == 1;
+  valid = valid && header.numVars > 0 && header.bufLen > 0 && header.varHeaderOffset > 0 &&
+          header.sessionInfoOffset > 0 && header.sessionInfoLen >= 0 && header.varBuf[0].bufOffset > 0;
+
+  std::vector<irsdk_varHeader> vars;
+  std::string session;
+  if (valid) {
+    vars.resize(header.numVars);
+    valid = 0 == fseek(file, header.varHeaderOffset, SEEK_SET) &&
+            fread(vars.data(), sizeof(irsdk_varHeader), vars.size(), file) == vars.size();
+  }
+  if (valid) {
+    session.resize(header.sessionInfoLen);
+    valid = 0 == fseek(file, header.sessionInfoOffset, SEEK_SET) &&
+            fread(&session[0], 1, session.size(), file) == session.size();
+    // The string is NUL padded within its length
+    session.resize(strnlen(session.c_str(), session.size()));
+  }
+  if (valid) {
+    valid = 0 == fseek(file, header.varBuf[0].bufOffset, SEEK_SET);
+  }
+  if (!valid) {
+    fclose(file);
+    return false;
+  }
+
+  _file = file;
+  _header = header;
+  _subHeader = subHeader;
+  _vars.swap(vars);
+  _session.swap(session);
+  _line = 0;
+  // Files cut short by a crash have lines missing, reading simply stops early
+  _lineCount = subHeader.sessionRecordCount > 0 ? subHeader.sessionRecordCount : INT_MAX;
+
+  // Looks like a connected sim with a single buffer to the rest of the addon
+  _header.status = irsdk_stConnected;
+  _header.numBuf = 1;
+  _header.varBuf[0].tickCount = 0;
+  return true;
+}
+
+void FileContext::shutdown()
+{
+  if (_file) fclose(_file);
+  _file = NULL;
+  _vars.clear();
+  _session.clear();
+  _line = 0;
+  _lineCount = 0;
+}
+
+bool FileContext::seek(int line)
+{
+  if (!startup() || line < 0 || line >= _lineCount) return false;
+  if (!seekFile(_file, _header.varBuf[0].bufOffset + (long long)line * _header.bufLen)) return false;
+
+  _line = line;
+  _header.status = irsdk_stConnected;
+  _header.varBuf[0].tickCount = line;
+  return true;
+}
+
+// The next line is always there already, so this never waits
+bool FileContext::waitForData(int, char *data)
+{
+  if (!startup() || !isConnected()) return false;
+
+  if (fread(data, 1, _header.bufLen, _file) != (size_t)_header.bufLen) {
+    _lineCount = _line;
+    _header.status = 0;
+    return false;
+  }
+  _line++;
+  _header.varBuf[0].tickCount = _line;
+  return true;
+}
+
+// ---------------------------
+// SimulatedContext
+// ---------------------------
+SimulatedContext::SimulatedContext(int tickRate, bool paced)
+  : _tickRate(tickRate > 0 ? tickRate : 60)
+  , _paced(paced)
+{
+}
+
+bool SimulatedContext::startup()
+{
+  if (_source.isOpen()) return true;
+
+  // Every context writes its own mapping, unique across processes too
+  static std::atomic<int> nextId(0);
+  char name[64];
+  snprintf(name, sizeof(name), "Local\\IRDashiesSimContext%d_%d", (int)getpid(), nextId++);
+  _name = name;
+
+  if (!_producer.create(_name.c_str(), _tickRate)) return false;
+  if (!_source.open(_name.c_str())) {
+    _producer.close();
+    return false;
+  }
+  _nextTick = std::chrono::steady_clock::now() + std::chrono::nanoseconds(1000000000LL / _tickRate);
+  return true;
+}
+
+void SimulatedContext::shutdown()
+{
+  _source.close();
+  _producer.close();
+}
+
+int SimulatedContext::tickCount() const
+{
+  return copiedTickCount(_source);
+}
+
+bool SimulatedContext::waitForData(int timeoutMs, char *data)
+{
+  if (!startup()) return false;
+
+  if (_paced) {
+    std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    if (_nextTick > deadline) {
+      std::this_thread::sleep_until(deadline);
+      return false;
+    }
+    std::this_thread::sleep_until(_nextTick);
+    _nextTick += std::chrono::nanoseconds(1000000000LL / _tickRate);
+  }
+
+  _producer.tick();
+  return _source.getNewData(data);
+}
@@ -0,0 +1,157 @@
+#ifndef SDK_CONTEXT_H
+#define SDK_CONTEXT_H
+
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+#include "./telemetry_source.h"
+#include "./sim_producer.h"
+
+class ReplayContext;
+
+// One telemetry source with its own connection and tick tracking, in place of
+// the file statics of irsdk_utils. Every iRacingSdkNode owns one, so an
+// instance can replay a file while another reads the sim, and each context can
+// be read from its own thread. A single context is not thread safe.
+class SdkContext
+{
+public:
+  virtual ~SdkContext() {}
+
+  // Opens the source if it isn't yet, false while it is unavailable
+  virtual bool startup() = 0;
+  virtual void shutdown() = 0;
+  virtual bool isConnected() const = 0;
+
+  // Waits up to timeoutMs for a line newer than the last one and copies it
+  // into data, which must hold header()->bufLen bytes
+  virtual bool waitForData(int timeoutMs, char *data) = 0;
+
+  // All NULL until startup() succeeded
+  virtual const irsdk_header *header() const = 0;
+  virtual const irsdk_varHeader *vars() const = 0;
+  virtual const char *sessionInfo() const = 0;
+
+  // Tick count of the line the last waitForData() copied, 0 before the first.
+  // The newest buffer of header() by default, which is that line for every
+  // context with a header of its own.
+  virtual int tickCount() const;
+  // Incremented whenever the session info changes, -1 when not open
+  int sessionInfoUpdate() const;
+  const irsdk_varHeader *varEntry(int index) const;
+  // Linear search, cache the result
+  int varIndex(const char *name) const;
+
+  // Playback controls when this is a replay, see replay_context.h
+  virtual ReplayContext *replay() { return NULL; }
+};
+
+// Recorded lines, one per waitForData() without pacing, that can be read from
+// any line on
+class RecordedContext : public SdkContext
+{
+public:
+  // The next waitForData() hands out this line, false past the end
+  virtual bool seek(int line) = 0;
+  // Index of the line the next waitForData() hands out
+  virtual int line() const = 0;
+  // INT_MAX while not known yet
+  virtual int lineCount() const = 0;
+  // Changes whenever vars() describes another table
+  virtual int layout() const = 0;
+};
+
+// A mapping laid out like the sim's, by name: the sim itself by default, or
+// anything SimProducer writes
+class LiveContext : public SdkContext
+{
+public:
+  explicit LiveContext(const char *name = IRSDK_MEMMAPFILENAME);
+
+  bool startup();
+  void shutdown();
+  bool isConnected() const;
+  bool waitForData(int timeoutMs, char *data);
+  // The producer keeps writing into header(), this is the line copied
+  int tickCount() const;
+
+  const irsdk_header *header() const { return _source.header(); }
+  const irsdk_varHeader *vars() const { return _source.vars(); }
+  const char *sessionInfo() const { return _source.sessionInfo(); }
+
+private:
+  std::string _name;
+  TelemetrySource _source;
+  // A producer that stops writing without clearing its status counts as gone after a while
+  std::chrono::steady_clock::time_point _lastValid;
+};
+
+// A telemetry file (.ibt) written by the sim, one line per waitForData()
+// without pacing. Connected until the last line has been read.
+class FileContext : public RecordedContext
+{
+public:
+  explicit FileContext(const char *path);
+  ~FileContext() { shutdown(); }
+
+  bool startup();
+  void shutdown();
+  bool isConnected() const { return _file && _line < _lineCount; }
+  bool waitForData(int timeoutMs, char *data);
+
+  const irsdk_header *header() const { return _file ? &_header : NULL; }
+  const irsdk_varHeader *vars() const { return _file ? _vars.data() : NULL; }
+  const char *sessionInfo() const { return _file ? _session.c_str() : NULL; }
+
+  bool seek(int line);
+  int line() const { return _line; }
+  int lineCount() const { return _lineCount; }
+  // One table for the whole file
+  int layout() const { return 0; }
+
+private:
+  FileContext(const FileContext &);
+  FileContext &operator=(const FileContext &);
+
+  std::string _path;
+  FILE *_file;
+  irsdk_header _header;
+  irsdk_diskSubHeader _subHeader;
+  std::vector<irsdk_varHeader> _vars;
+  std::string _session;
+  int _line;
+  int _lineCount;
+};
+
+// An in-process SimProducer of its own. Paced contexts hand out lines at the
+// tick rate like the sim; unpaced ones produce a line on every wait, which is
+// what the benchmarks use.
+class SimulatedContext : public SdkContext
+{
+public:
+  SimulatedContext(int tickRate, bool paced);
+  ~SimulatedContext() { shutdown(); }
+
+  bool startup();
+  void shutdown();
+  bool isConnected() const { return _source.isConnected(); }
+  bool waitForData(int timeoutMs, char *data);
+  int tickCount() const;
+
+  const irsdk_header *header() const { return _source.header(); }
+  const irsdk_varHeader *vars() const { return _source.vars(); }
+  const char *sessionInfo() const { return _source.sessionInfo(); }
+
+private:
+  int _tickRate;
+  bool _paced;
+  std::string _name;
+  SimProducer _producer;
+  TelemetrySource _source;
+  std::chrono::steady_clock::time_point _nextTick;
+};
+
+#endif
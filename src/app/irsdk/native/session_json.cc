@@ -0,0 +1,638 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "./session_json.h"
+#include "./trace.h"
+
+// Helper function to convert Windows-1252 to UTF-8
+std::string ConvertToUTF8(const char* input) {
+    if (!input) return "";
+    TRACE_SPAN("ConvertToUTF8");
+    
+    std::string result;
+    result.reserve(strlen(input) * 2); // Reserve space for potential UTF-8 expansion
+    
+    for (const char* p = input; *p; ++p) {
+        unsigned char c = *p;
+        if (c < 0x80) {
+            // ASCII character
+            result += c;
+        } else {
+            // Windows-1252 to UTF-8 conversion
+            switch (c) {
+                case 0x80: result += "\xE2\x82\xAC"; break; // €
+                case 0x82: result += "\xE2\x80\x9A"; break; // ‚
+                case 0x83: result += "\xC6\x92"; break;     // ƒ
+                case 0x84: result += "\xE2\x80\x9E"; break; // „
+                case 0x85: result += "\xE2\x80\xA6"; break; // …
+                case 0x86: result += "\xE2\x80\xA0"; break; // †
+                case 0x87: result += "\xE2\x80\xA1"; break; // ‡
+                case 0x88: result += "\xCB\x86"; break;     // ˆ
+                case 0x89: result += "\xE2\x80\xB0"; break; // ‰
+                case 0x8A: result += "\xC5\xA0"; break;     // Š
+                case 0x8B: result += "\xE2\x80\xB9"; break; // ‹
+                case 0x8C: result += "\xC5\x92"; break;     // Œ
+                case 0x8E: result += "\xC5\xBD"; break;     // Ž
+                case 0x91: result += "\xE2\x80\x98"; break; // '
+                case 0x92: result += "\xE2\x80\x99"; break; // '
+                case 0x93: result += "\xE2\x80\x9C"; break; // "
+                case 0x94: result += "\xE2\x80\x9D"; break; // "
+                case 0x95: result += "\xE2\x80\xA2"; break; // •
+                case 0x96: result += "\xE2\x80\x93"; break; // –
+                case 0x97: result += "\xE2\x80\x94"; break; // —
+                case 0x98: result += "\xCB\x9C"; break;     // ˜
+                case 0x99: result += "\xE2\x84\xA2"; break; // ™
+                case 0x9A: result += "\xC5\xA1"; break;     // š
+                case 0x9B: result += "\xE2\x80\xBA"; break; // ›
+                case 0x9C: result += "\xC5\x93"; break;     // œ
+                case 0x9E: result += "\xC5\xBE"; break;     // ž
+                case 0x9F: result += "\xC5\xB8"; break;     // Ÿ
+                case 0xA0: result += "\xC2\xA0"; break;     //  
+                case 0xA1: result += "\xC2\xA1"; break;     // ¡
+                case 0xA2: result += "\xC2\xA2"; break;     // ¢
+                case 0xA3: result += "\xC2\xA3"; break;     // £
+                case 0xA4: result += "\xC2\xA4"; break;     // ¤
+                case 0xA5: result += "\xC2\xA5"; break;     // ¥
+                case 0xA6: result += "\xC2\xA6"; break;     // ¦
+                case 0xA7: result += "\xC2\xA7"; break;     // §
+                case 0xA8: result += "\xC2\xA8"; break;     // ¨
+                case 0xA9: result += "\xC2\xA9"; break;     // ©
+                case 0xAA: result += "\xC2\xAA"; break;     // ª
+                case 0xAB: result += "\xC2\xAB"; break;     // «
+                case 0xAC: result += "\xC2\xAC"; break;     // ¬
+                case 0xAD: result += "\xC2\xAD"; break;     // ­
+                case 0xAE: result += "\xC2\xAE"; break;     // ®
+                case 0xAF: result += "\xC2\xAF"; break;     // ¯
+                case 0xB0: result += "\xC2\xB0"; break;     // °
+                case 0xB1: result += "\xC2\xB1"; break;     // ±
+                case 0xB2: result += "\xC2\xB2"; break;     // ²
+                case 0xB3: result += "\xC2\xB3"; break;     // ³
+                case 0xB4: result += "\xC2\xB4"; break;     // ´
+                case 0xB5: result += "\xC2\xB5"; break;     // µ
+                case 0xB6: result += "\xC2\xB6"; break;     // ¶
+                case 0xB7: result += "\xC2\xB7"; break;     // ·
+                case 0xB8: result += "\xC2\xB8"; break;     // ¸
+                case 0xB9: result += "\xC2\xB9"; break;     // ¹
+                case 0xBA: result += "\xC2\xBA"; break;     // º
+                case 0xBB: result += "\xC2\xBB"; break;     // »
+                case 0xBC: result += "\xC2\xBC"; break;     // ¼
+                case 0xBD: result += "\xC2\xBD"; break;     // ½
+                case 0xBE: result += "\xC2\xBE"; break;     // ¾
+                case 0xBF: result += "\xC2\xBF"; break;     // ¿
+                case 0xC0: result += "\xC3\x80"; break;     // À
+                case 0xC1: result += "\xC3\x81"; break;     // Á
+                case 0xC2: result += "\xC3\x82"; break;     // Â
+                case 0xC3: result += "\xC3\x83"; break;     // Ã
+                case 0xC4: result += "\xC3\x84"; break;     // Ä
+                case 0xC5: result += "\xC3\x85"; break;     // Å
+                case 0xC6: result += "\xC3\x86"; break;     // Æ
+                case 0xC7: result += "\xC3\x87"; break;     // Ç
+                case 0xC8: result += "\xC3\x88"; break;     // È
+                case 0xC9: result += "\xC3\x89"; break;     // É
+                case 0xCA: result += "\xC3\x8A"; break;     // Ê
+                case 0xCB: result += "\xC3\x8B"; break;     // Ë
+                case 0xCC: result += "\xC3\x8C"; break;     // Ì
+                case 0xCD: result += "\xC3\x8D"; break;     // Í
+                case 0xCE: result += "\xC3\x8E"; break;     // Î
+                case 0xCF: result += "\xC3\x8F"; break;     // Ï
+                case 0xD0: result += "\xC3\x90"; break;     // Ð
+                case 0xD1: result += "\xC3\x91"; break;     // Ñ
+                case 0xD2: result += "\xC3\x92"; break;     // Ò
+                case 0xD3: result += "\xC3\x93"; break;     // Ó
+                case 0xD4: result += "\xC3\x94"; break;     // Ô
+                case 0xD5: result += "\xC3\x95"; break;     // Õ
+                case 0xD6: result += "\xC3\x96"; break;     // Ö
+                case 0xD7: result += "\xC3\x97"; break;     // ×
+                case 0xD8: result += "\xC3\x98"; break;     // Ø
+                case 0xD9: result += "\xC3\x99"; break;     // Ù
+                case 0xDA: result += "\xC3\x9A"; break;     // Ú
+                case 0xDB: result += "\xC3\x9B"; break;     // Û
+                case 0xDC: result += "\xC3\x9C"; break;     // Ü
+                case 0xDD: result += "\xC3\x9D"; break;     // Ý
+                case 0xDE: result += "\xC3\x9E"; break;     // Þ
+                case 0xDF: result += "\xC3\x9F"; break;     // ß
+                case 0xE0: result += "\xC3\xA0"; break;     // à
+                case 0xE1: result += "\xC3\xA1"; break;     // á
+                case 0xE2: result += "\xC3\xA2"; break;     // â
+                case 0xE3: result += "\xC3\xA3"; break;     // ã
+                case 0xE4: result += "\xC3\xA4"; break;     // ä
+                case 0xE5: result += "\xC3\xA5"; break;     // å
+                case 0xE6: result += "\xC3\xA6"; break;     // æ
+                case 0xE7: result += "\xC3\xA7"; break;     // ç
+                case 0xE8: result += "\xC3\xA8"; break;     // è
+                case 0xE9: result += "\xC3\xA9"; break;     // é
+                case 0xEA: result += "\xC3\xAA"; break;     // ê
+                case 0xEB: result += "\xC3\xAB"; break;     // ë
+                case 0xEC: result += "\xC3\xAC"; break;     // ì
+                case 0xED: result += "\xC3\xAD"; break;     // í
+                case 0xEE: result += "\xC3\xAE"; break;     // î
+                case 0xEF: result += "\xC3\xAF"; break;     // ï
+                case 0xF0: result += "\xC3\xB0"; break;     // ð
+                case 0xF1: result += "\xC3\xB1"; break;     // ñ
+                case 0xF2: result += "\xC3\xB2"; break;     // ò
+                case 0xF3: result += "\xC3\xB3"; break;     // ó
+                case 0xF4: result += "\xC3\xB4"; break;     // ô
+                case 0xF5: result += "\xC3\xB5"; break;     // õ
+                case 0xF6: result += "\xC3\xB6"; break;     // ö
+                case 0xF7: result += "\xC3\xB7"; break;     // ÷
+                case 0xF8: result += "\xC3\xB8"; break;     // ø
+                case 0xF9: result += "\xC3\xB9"; break;     // ù
+                case 0xFA: result += "\xC3\xBA"; break;     // ú
+                case 0xFB: result += "\xC3\xBB"; break;     // û
+                case 0xFC: result += "\xC3\xBC"; break;     // ü
+                case 0xFD: result += "\xC3\xBD"; break;     // ý
+                case 0xFE: result += "\xC3\xBE"; break;     // þ
+                case 0xFF: result += "\xC3\xBF"; break;     // ÿ
+                default: result += c; break;
+            }
+        }
+    }
+    return result;
+}
+
+namespace {
+
+typedef SessionIndex::Line Line;
+
+bool isSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+// Cuts a " #" comment and trailing spaces, leaving quoted text alone
+int trimValue(const char *text, int length)
+{
+  char quote = 0;
+  for (int i = 0; i < length; i++) {
+    char c = text[i];
+    if (quote) {
+      if (c == quote) quote = 0;
+    } else if ((c == '"' || c == '\'') && (i == 0 || isSpace(text[i - 1]))) {
+      quote = c;
+    } else if (c == '#' && (i == 0 || isSpace(text[i - 1]))) {
+      length = i;
+      break;
+    }
+  }
+  while (length > 0 && isSpace(text[length - 1])) length--;
+  return length;
+}
+
+void splitLines(const std::string &yaml, std::vector<Line> *lines)
+{
+  const char *pos = yaml.c_str();
+  const char *end = pos + yaml.size();
+  while (pos < end) {
+    const char *eol = (const char *)memchr(pos, '\n', end - pos);
+    if (!eol) eol = end;
+
+    Line line;
+    line.indent = 0;
+    while (pos + line.indent < eol && pos[line.indent] == ' ') line.indent++;
+    line.text = pos + line.indent;
+    line.length = trimValue(line.text, (int)(eol - line.text));
+    pos = eol + 1;
+
+    if (!line.length) continue;
+    if (line.length == 3 && (0 == strncmp(line.text, "---", 3) || 0 == strncmp(line.text, "...", 3))) continue;
+    lines->push_back(line);
+  }
+}
+
+bool isListItem(const Line &line)
+{
+  return line.text[0] == '-' && (line.length == 1 || line.text[1] == ' ');
+}
+
+// Position of the ':' ending a "Key:" or "Key: value", -1 for a scalar
+int findColon(const Line &line)
+{
+  if (line.text[0] == '"' || line.text[0] == '\'') return -1;
+  for (int i = 0; i < line.length; i++) {
+    if (line.text[i] == ':' && (i + 1 == line.length || line.text[i + 1] == ' ')) return i;
+  }
+  return -1;
+}
+
+void appendString(std::string *json, const char *text, int length)
+{
+  json->push_back('"');
+  for (int i = 0; i < length; i++) {
+    unsigned char c = (unsigned char)text[i];
+    switch (c) {
+      case '"': json->append("\\\""); break;
+      case '\\': json->append("\\\\"); break;
+      case '\n': json->append("\\n"); break;
+      case '\t': json->append("\\t"); break;
+      case '\r': json->append("\\r"); break;
+      default:
+        if (c < 0x20) {
+          char escape[8];
+          snprintf(escape, sizeof(escape), "\\u%04x", c);
+          json->append(escape);
+        } else {
+          json->push_back((char)c);
+        }
+    }
+  }
+  json->push_back('"');
+}
+
+void appendNumber(std::string *json, double value)
+{
+  if (value != value) {
+    json->append("null");
+    return;
+  }
+  if (isinf(value)) {
+    // Parses back to Infinity
+    json->append(value < 0 ? "-1e999" : "1e999");
+    return;
+  }
+
+  char number[32];
+  snprintf(number, sizeof(number), "%.15g", value);
+  if (strtod(number, NULL) != value) snprintf(number, sizeof(number), "%.17g", value);
+  json->append(number);
+}
+
+bool oneOf(const std::string &value, const char *a, const char *b, const char *c)
+{
+  return value == a || value == b || value == c;
+}
+
+// js-yaml's int: optional sign, then 0b / 0o / 0x or decimal digits, with
+// any number of '_' in between
+bool parseInt(const std::string &value, double *out)
+{
+  size_t i = 0;
+  double sign = 1;
+  if (i < value.size() && (value[i] == '-' || value[i] == '+')) {
+    if (value[i] == '-') sign = -1;
+    i++;
+  }
+  if (i == value.size()) return false;
+
+  int base = 10;
+  if (value[i] == '0' && i + 1 < value.size()) {
+    char prefix = value[i + 1];
+    if (prefix == 'b') base = 2;
+    if (prefix == 'o') base = 8;
+    if (prefix == 'x') base = 16;
+    if (base != 10) i += 2;
+  }
+  if (base == 10 && value[i] == '_') return false;
+
+  double result = 0;
+  bool digits = false;
+  for (; i < value.size(); i++) {
+    char c = value[i];
+    if (c == '_') continue;
+    int digit;
+    if (isDigit(c)) digit = c - '0';
+    else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+    else return false;
+    if (digit >= base) return false;
+    result = result * base + digit;
+    digits = true;
+  }
+  if (!digits || value[value.size() - 1] == '_') return false;
+
+  *out = sign * result;
+  return true;
+}
+
+// js-yaml's float: [-+]?digits[.digits][e[-+]digits], [-+]?.digits or .inf / .nan
+bool parseFloat(const std::string &value, double *out)
+{
+  if (oneOf(value, ".nan", ".NaN", ".NAN")) {
+    *out = NAN;
+    return true;
+  }
+  std::string text = value;
+  double sign = 1;
+  if (!text.empty() && (text[0] == '-' || text[0] == '+')) {
+    if (text[0] == '-') sign = -1;
+    text = text.substr(1);
+  }
+  if (oneOf(text, ".inf", ".Inf", ".INF")) {
+    *out = sign * INFINITY;
+    return true;
+  }
+  if (text.empty() || text[text.size() - 1] == '_') return false;
+
+  size_t i = 0;
+  if (isDigit(text[i])) {
+    while (i < text.size() && (isDigit(text[i]) || text[i] == '_')) i++;
+    if (i < text.size() && text[i] == '.') {
+      i++;
+      while (i < text.size() && (isDigit(text[i]) || text[i] == '_')) i++;
+    }
+  } else if (text[i] == '.' && i + 1 < text.size() && isDigit(text[i + 1])) {
+    i++;
+    while (i < text.size() && (isDigit(text[i]) || text[i] == '_')) i++;
+  } else {
+    return false;
+  }
+  if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+    i++;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) i++;
+    if (i == text.size()) return false;
+    while (i < text.size() && isDigit(text[i])) i++;
+  }
+  if (i != text.size()) return false;
+
+  std::string digits;
+  for (size_t n = 0; n < text.size(); n++) {
+    if (text[n] != '_') digits.push_back(text[n]);
+  }
+  *out = sign * strtod(digits.c_str(), NULL);
+  return true;
+}
+
+// YYYY-MM-DD, which js-yaml turns into a Date at UTC midnight
+bool isDate(const std::string &value)
+{
+  if (value.size() != 10 || value[4] != '-' || value[7] != '-') return false;
+  for (size_t i = 0; i < value.size(); i++) {
+    if (i != 4 && i != 7 && !isDigit(value[i])) return false;
+  }
+  return true;
+}
+
+void appendScalar(std::string *json, const char *text, int length)
+{
+  if (length > 1 && text[0] == '"' && text[length - 1] == '"') {
+    // Double quoted, unescaping what the sim could write
+    std::string value;
+    for (int i = 1; i < length - 1; i++) {
+      if (text[i] == '\\' && i + 1 < length - 1) {
+        char c = text[++i];
+        value.push_back(c == 'n' ? '\n' : c == 't' ? '\t' : c);
+      } else {
+        value.push_back(text[i]);
+      }
+    }
+    appendString(json, value.c_str(), (int)value.size());
+    return;
+  }
+  if (length > 1 && text[0] == '\'' && text[length - 1] == '\'') {
+    std::string value;
+    for (int i = 1; i < length - 1; i++) {
+      value.push_back(text[i]);
+      if (text[i] == '\'' && text[i + 1] == '\'') i++;
+    }
+    appendString(json, value.c_str(), (int)value.size());
+    return;
+  }
+
+  std::string value(text, length);
+  double number;
+  if (value.empty() || value == "," || oneOf(value, "~", "null", "Null") || value == "NULL") {
+    json->append("null");
+  } else if (oneOf(value, "true", "True", "TRUE")) {
+    json->append("true");
+  } else if (oneOf(value, "false", "False", "FALSE")) {
+    json->append("false");
+  } else if (parseInt(value, &number) || parseFloat(value, &number)) {
+    appendNumber(json, number);
+  } else if (isDate(value)) {
+    json->push_back('"');
+    json->append(value);
+    json->append("T00:00:00.000Z\"");
+  } else {
+    appendString(json, text, length);
+  }
+}
+
+// Emits JSON for lines, which it rewrites in place while walking lists
+class Converter
+{
+public:
+  Converter(std::vector<Line> &lines, std::string *json) : _lines(lines), _json(json), _at(0) {}
+
+  void document()
+  {
+    if (_lines.empty()) {
+      _json->append("null");
+      return;
+    }
+    value(_lines[0].indent);
+  }
+
+  // Just the value of the "Key:" entry on the first line
+  void entry()
+  {
+    int colon = findColon(_lines[0]);
+    if (colon < 0) {
+      _json->append("null");
+      return;
+    }
+    entryValue(colon);
+  }
+
+private:
+  // The block starting at the current line, which is at indent
+  void value(int indent)
+  {
+    const Line &line = _lines[_at];
+    if (isListItem(line)) list(indent);
+    else if (findColon(line) >= 0) map(indent);
+    else scalar(indent);
+  }
+
+  void map(int indent)
+  {
+    _json->push_back('{');
+    bool first = true;
+    while (_at < _lines.size() && _lines[_at].indent == indent && !isListItem(_lines[_at])) {
+      const Line &line = _lines[_at];
+      int colon = findColon(line);
+      if (colon < 0) break;
+
+      if (!first) _json->push_back(',');
+      first = false;
+      appendString(_json, line.text, trimValue(line.text, colon));
+      _json->push_back(':');
+      entryValue(colon);
+    }
+    _json->push_back('}');
+  }
+
+  // Value of the "Key:" line at _at, consuming its lines
+  void entryValue(int colon)
+  {
+    const Line &line = _lines[_at];
+    int indent = line.indent;
+    const char *rest = line.text + colon + 1;
+    int restLength = line.length - colon - 1;
+    while (restLength > 0 && *rest == ' ') {
+      rest++;
+      restLength--;
+    }
+
+    _at++;
+    if (restLength > 0) {
+      appendFolded(rest, restLength, indent);
+    } else if (_at < _lines.size() && (_lines[_at].indent > indent ||
+                                       (_lines[_at].indent == indent && isListItem(_lines[_at])))) {
+      // Nested block, lists may sit at the key's own indent
+      value(_lines[_at].indent);
+    } else {
+      _json->append("null");
+    }
+  }
+  void list(int indent)
+  {
+    _json->push_back('[');
+    bool first = true;
+    while (_at < _lines.size() && _lines[_at].indent == indent && isListItem(_lines[_at])) {
+      if (!first) _json->push_back(',');
+      first = false;
+
+      // The item's content starts after "- ", treat it as its own line
+      Line &line = _lines[_at];
+      int skip = 1;
+      while (skip < line.length && line.text[skip] == ' ') skip++;
+      if (skip >= line.length) {
+        _at++;
+        if (_at < _lines.size() && _lines[_at].indent > indent) value(_lines[_at].indent);
+        else _json->append("null");
+        continue;
+      }
+      line.indent += skip;
+      line.text += skip;
+      line.length -= skip;
+      value(line.indent);
+    }
+    _json->push_back(']');
+  }
+
+  void scalar(int indent)
+  {
+    const Line &line = _lines[_at++];
+    appendFolded(line.text, line.length, indent);
+  }
+
+  // A plain scalar may continue on more deeply indented lines
+  void appendFolded(const char *text, int length, int indent)
+  {
+    if (_at >= _lines.size() || _lines[_at].indent <= indent || text[0] == '"' || text[0] == '\'') {
+      appendScalar(_json, text, length);
+      return;
+    }
+    std::string folded(text, length);
+    while (_at < _lines.size() && _lines[_at].indent > indent) {
+      folded.push_back(' ');
+      folded.append(_lines[_at].text, _lines[_at].length);
+      _at++;
+    }
+    appendScalar(_json, folded.c_str(), (int)folded.size());
+  }
+
+  std::vector<Line> &_lines;
+  std::string *_json;
+  size_t _at;
+};
+
+} // namespace
+
+SessionIndex::SessionIndex()
+{
+  Node root = { "", 0, 0, 0, false, -1, -1 };
+  this->_nodes.push_back(root);
+}
+
+void SessionIndex::build(std::string *yaml)
+{
+  this->_text.swap(*yaml);
+  yaml->clear();
+  this->_lines.clear();
+  this->_nodes.resize(1);
+  splitLines(this->_text, &this->_lines);
+
+  Node &root = this->_nodes[0];
+  root.firstChild = -1;
+  root.endLine = (int)this->_lines.size();
+  root.map = !this->_lines.empty() && !isListItem(this->_lines[0]) && findColon(this->_lines[0]) >= 0;
+  if (root.map) {
+    size_t at = 0;
+    this->indexMap(0, &at, this->_lines[0].indent);
+  }
+}
+
+// Walks the entries of the map at *at the way Converter::map does, keeping
+// only where each one starts and ends
+void SessionIndex::indexMap(int parent, size_t *at, int indent)
+{
+  const std::vector<Line> &lines = this->_lines;
+  int previous = -1;
+  while (*at < lines.size() && lines[*at].indent == indent && !isListItem(lines[*at])) {
+    const Line &line = lines[*at];
+    int colon = findColon(line);
+    if (colon < 0) break;
+
+    Node node = { line.text, trimValue(line.text, colon), (int)*at, 0, false, -1, -1 };
+    int id = (int)this->_nodes.size();
+    this->_nodes.push_back(node);
+    if (previous < 0) this->_nodes[parent].firstChild = id;
+    else this->_nodes[previous].nextSibling = id;
+    previous = id;
+
+    bool inlineValue = false;
+    for (int i = colon + 1; i < line.length; i++) {
+      if (line.text[i] != ' ') inlineValue = true;
+    }
+
+    (*at)++;
+    if (!inlineValue && *at < lines.size() && lines[*at].indent > indent && !isListItem(lines[*at]) &&
+        findColon(lines[*at]) >= 0) {
+      this->_nodes[id].map = true;
+      this->indexMap(id, at, lines[*at].indent);
+    }
+    // Lists (which may sit at the key's own indent), scalars and their
+    // continuation lines all stay unindexed
+    while (*at < lines.size() && (lines[*at].indent > indent ||
+                                  (!inlineValue && lines[*at].indent == indent && isListItem(lines[*at])))) {
+      (*at)++;
+    }
+    this->_nodes[id].endLine = (int)*at;
+  }
+}
+
+int SessionIndex::find(int node, const char *key, int keyLength) const
+{
+  for (int child = this->_nodes[node].firstChild; child >= 0; child = this->_nodes[child].nextSibling) {
+    const Node &entry = this->_nodes[child];
+    if (entry.keyLength == keyLength && 0 == memcmp(entry.key, key, keyLength)) return child;
+  }
+  return -1;
+}
+
+const char *SessionIndex::key(int node, int *length) const
+{
+  *length = this->_nodes[node].keyLength;
+  return this->_nodes[node].key;
+}
+
+void SessionIndex::toJson(int node, std::string *json) const
+{
+  const Node &entry = this->_nodes[node];
+  // Converter rewrites list lines as it goes, so it gets its own copy
+  std::vector<Line> lines(this->_lines.begin() + entry.firstLine, this->_lines.begin() + entry.endLine);
+
+  json->clear();
+  if (node == 0) json->reserve(this->_text.size() + this->_text.size() / 4);
+  Converter converter(lines, json);
+  if (node == 0) converter.document();
+  else converter.entry();
+}
@@ -0,0 +1,68 @@
+#ifndef SESSION_JSON_H
+#define SESSION_JSON_H
+
+#include <string>
+#include <vector>
+
+// The sim writes session info as Windows-1252
+std::string ConvertToUTF8(const char* input);
+
+// Line offsets of every map entry in a session info document, so single
+// subtrees can be converted to JSON without touching the rest. Node 0 is the
+// document.
+//
+// The JSON parses to the same object js-yaml's default schema builds from the
+// YAML, so JS can JSON.parse it instead. Handles the subset the sim writes
+// (block maps and lists, plain and quoted scalars, comments), plus the sim's
+// stray "Key: ," lines, read as null. Scalars are typed like js-yaml: null,
+// bools, ints (including hex), floats, and dates, which come out as ISO
+// strings rather than Date objects.
+class SessionIndex
+{
+public:
+  struct Line
+  {
+    int indent;
+    const char *text; // Past the indent, comments and trailing spaces cut
+    int length;
+  };
+
+  SessionIndex();
+
+  // Takes over the (UTF-8) yaml, leaving it empty
+  void build(std::string *yaml);
+
+  // Child entry of a map node by key, -1 when there is none
+  int find(int node, const char *key, int keyLength) const;
+  // Entries of a map node in document order, -1 past the last
+  int firstChild(int node) const { return this->_nodes[node].firstChild; }
+  int nextSibling(int node) const { return this->_nodes[node].nextSibling; }
+  // Whether the node's value is a map, i.e. has children
+  bool isMap(int node) const { return this->_nodes[node].map; }
+  const char *key(int node, int *length) const;
+
+  // The node's value as JSON, the whole document for node 0
+  void toJson(int node, std::string *json) const;
+
+  int size() const { return (int)this->_nodes.size(); }
+
+private:
+  struct Node
+  {
+    const char *key;
+    int keyLength;
+    int firstLine; // The "Key:" line, 0 for the document
+    int endLine;
+    bool map;
+    int firstChild;
+    int nextSibling;
+  };
+
+  void indexMap(int parent, size_t *at, int indent);
+
+  std::string _text;
+  std::vector<Line> _lines;
+  std::vector<Node> _nodes;
+};
+
+#endif
@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "./session_scan.h"
+
+namespace {
+
+struct ScanLine
+{
+  const char *start; // start of the line
+  const char *text; // first char after indent (and list dash)
+  const char *eol;  // end of text, excluding line terminators
+  const char *next; // start of the following line
+  int indent;       // column of text, the list dash counts as indent
+  int dash;         // column of the list dash, or -1
+};
+
+bool readLine(const char *pos, const char *end, ScanLine *line)
+{
+  if (pos >= end || *pos == '\0') return false;
+
+  const char *p = pos;
+  line->start = pos;
+  while (p < end && *p == ' ') p++;
+  line->dash = -1;
+  if (p + 1 < end && p[0] == '-' && p[1] == ' ') {
+    line->dash = (int)(p - pos);
+    p += 2;
+    while (p < end && *p == ' ') p++;
+  }
+  line->text = p;
+  line->indent = (int)(p - pos);
+
+  while (p < end && *p != '\n' && *p != '\0') p++;
+  line->next = (p < end && *p == '\n') ? p + 1 : p;
+  while (p > line->text && (p[-1] == '\r' || p[-1] == ' ')) p--;
+  line->eol = p;
+  return true;
+}
+
+bool splitField(const ScanLine &line, SessionField *field)
+{
+  const char *colon = (const char *)memchr(line.text, ':', line.eol - line.text);
+  if (!colon || colon == line.text) return false;
+
+  field->key = line.text;
+  field->keyLen = (int)(colon - line.text);
+
+  const char *value = colon + 1;
+  while (value < line.eol && *value == ' ') value++;
+  field->value = value;
+  field->valueLen = (int)(line.eol - value);
+  return true;
+}
+
+// The block opened by a "Key:" line spans every following line that is
+// indented deeper, plus list entries whose dash sits at the key's column.
+SessionBlock childBlock(const ScanLine &keyLine, const char *end)
+{
+  SessionBlock block = { keyLine.next, keyLine.next, -1 };
+  ScanLine line;
+  const char *pos = keyLine.next;
+  while (readLine(pos, end, &line)) {
+    bool blank = line.text == line.eol;
+    bool inside = line.dash >= 0 ? line.dash >= keyLine.indent : line.indent > keyLine.indent;
+    if (!blank && !inside) break;
+    if (!blank && block.indent < 0) {
+      block.indent = line.dash >= 0 ? line.dash : line.indent;
+    }
+    pos = line.next;
+    block.end = pos;
+  }
+  if (block.indent < 0) block.indent = keyLine.indent + 1;
+  return block;
+}
+
+} // namespace
+
+SessionBlock sessionRoot(const char *yaml)
+{
+  SessionBlock root = { yaml, yaml ? yaml + strlen(yaml) : yaml, 0 };
+  return root;
+}
+
+bool sessionFindBlock(const SessionBlock &scope, const char *path, SessionBlock *out)
+{
+  if (!scope.begin || !path || !out) return false;
+
+  SessionBlock current = scope;
+  const char *segment = path;
+  while (*segment) {
+    const char *sep = strchr(segment, ':');
+    int segmentLen = sep ? (int)(sep - segment) : (int)strlen(segment);
+
+    bool found = false;
+    ScanLine line;
+    SessionField field;
+    const char *pos = current.begin;
+    while (readLine(pos, current.end, &line)) {
+      pos = line.next;
+      if (line.indent != current.indent || !splitField(line, &field)) continue;
+      if (field.keyLen == segmentLen && 0 == strncmp(field.key, segment, segmentLen)) {
+        current = childBlock(line, current.end);
+        found = true;
+        break;
+      }
+    }
+    if (!found) return false;
+
+    segment += segmentLen;
+    if (*segment == ':') segment++;
+  }
+
+  *out = current;
+  return true;
+}
+
+bool sessionFindValue(const SessionBlock &scope, const char *path, SessionField *out)
+{
+  if (!path || !out) return false;
+
+  // Everything up to the last segment names the parent block
+  const char *last = path + strlen(path);
+  if (last > path && last[-1] == ':') last--;
+  const char *name = last;
+  while (name > path && name[-1] != ':') name--;
+
+  SessionBlock parent = scope;
+  if (name > path) {
+    char parentPath[256];
+    int parentLen = (int)(name - path);
+    if (parentLen >= (int)sizeof(parentPath)) return false;
+    memcpy(parentPath, path, parentLen);
+    parentPath[parentLen] = '\0';
+    if (!sessionFindBlock(scope, parentPath, &parent)) return false;
+  }
+
+  int nameLen = (int)(last - name);
+  SessionFieldCursor cursor(parent);
+  SessionField field;
+  while (cursor.next(&field)) {
+    if (field.keyLen == nameLen && 0 == strncmp(field.key, name, nameLen)) {
+      *out = field;
+      return true;
+    }
+  }
+  return false;
+}
+
+SessionListCursor::SessionListCursor(const SessionBlock &list)
+  : _pos(list.begin)
+  , _end(list.end)
+  , _indent(list.indent)
+{
+}
+
+bool SessionListCursor::next(SessionBlock *entry)
+{
+  ScanLine line;
+  while (readLine(_pos, _end, &line)) {
+    _pos = line.next;
+    if (line.dash != _indent) continue;
+
+    entry->begin = line.start;
+    entry->indent = line.indent;
+    entry->end = _pos;
+
+    // The entry runs until the next dash at our column
+    ScanLine inner;
+    while (readLine(_pos, _end, &inner)) {
+      if (inner.dash == _indent) break;
+      _pos = inner.next;
+      entry->end = _pos;
+    }
+    return true;
+  }
+  return false;
+}
+
+SessionFieldCursor::SessionFieldCursor(const SessionBlock &map)
+  : _pos(map.begin)
+  , _end(map.end)
+  , _indent(map.indent)
+{
+}
+
+bool SessionFieldCursor::next(SessionField *field)
+{
+  ScanLine line;
+  while (readLine(_pos, _end, &line)) {
+    _pos = line.next;
+    if (line.indent == _indent && splitField(line, field)) return true;
+  }
+  return false;
+}
+
+bool sessionKeyIs(const SessionField &field, const char *key)
+{
+  int len = (int)strlen(key);
+  return field.keyLen == len && 0 == strncmp(field.key, key, len);
+}
+
+int sessionFieldInt(const SessionField &field, int fallback)
+{
+  char buf[32];
+  if (field.valueLen <= 0 || field.valueLen >= (int)sizeof(buf)) return fallback;
+  memcpy(buf, field.value, field.valueLen);
+  buf[field.valueLen] = '\0';
+
+  char *endPtr = NULL;
+  // Colours are written as hex ("0xffda59")
+  bool hex = field.valueLen > 2 && buf[0] == '0' && (buf[1] == 'x' || buf[1] == 'X');
+  long val = strtol(buf, &endPtr, hex ? 16 : 10);
+  return endPtr == buf ? fallback : (int)val;
+}
+
+double sessionFieldDouble(const SessionField &field, double fallback)
+{
+  char buf[32];
+  if (field.valueLen <= 0 || field.valueLen >= (int)sizeof(buf)) return fallback;
+  memcpy(buf, field.value, field.valueLen);
+  buf[field.valueLen] = '\0';
+
+  char *endPtr = NULL;
+  double val = strtod(buf, &endPtr);
+  return endPtr == buf ? fallback : val;
+}
+
+int sessionFieldString(const SessionField &field, const char **str)
+{
+  const char *value = field.value;
+  int len = field.valueLen;
+  if (len >= 2 && (value[0] == '"' || value[0] == '\'') && value[len - 1] == value[0]) {
+    value++;
+    len -= 2;
+  }
+  *str = value;
+  return len;
+}
@@ -0,0 +1,71 @@
+#ifndef SESSION_SCAN_H
+#define SESSION_SCAN_H
+
+// Allocation free scanner for the session info YAML written by the sim.
+// The sim only emits a small subset of YAML (one space per indent level,
+// block lists of maps, no flow style), so the sections we care about can be
+// walked in place instead of converting the whole document.
+
+// A contiguous run of lines belonging to one map or list.
+struct SessionBlock
+{
+  const char *begin; // start of the first line
+  const char *end;   // one past the end of the last line
+  int indent;        // column of the block's keys (or list dashes)
+};
+
+// A single "Key: value" pair. Neither string is null terminated.
+struct SessionField
+{
+  const char *key;
+  int keyLen;
+  const char *value;
+  int valueLen;
+};
+
+// Block covering the whole document.
+SessionBlock sessionRoot(const char *yaml);
+
+// Finds the block nested under a "Key:Key:" path inside scope.
+// Uses the same path separator as parseYaml, but without the {value} filters.
+bool sessionFindBlock(const SessionBlock &scope, const char *path, SessionBlock *out);
+
+// Finds a scalar value under a "Key:Key:" path inside scope.
+bool sessionFindValue(const SessionBlock &scope, const char *path, SessionField *out);
+
+// Iterates the "- " entries of a list block.
+class SessionListCursor
+{
+public:
+  explicit SessionListCursor(const SessionBlock &list);
+
+  bool next(SessionBlock *entry);
+
+private:
+  const char *_pos;
+  const char *_end;
+  int _indent;
+};
+
+// Iterates the scalar fields of a map block (or list entry). Keys that open
+// nested blocks are returned with an empty value.
+class SessionFieldCursor
+{
+public:
+  explicit SessionFieldCursor(const SessionBlock &map);
+
+  bool next(SessionField *field);
+
+private:
+  const char *_pos;
+  const char *_end;
+  int _indent;
+};
+
+bool sessionKeyIs(const SessionField &field, const char *key);
+int sessionFieldInt(const SessionField &field, int fallback = 0);
+double sessionFieldDouble(const SessionField &field, double fallback = 0.0);
+// Trims optional quotes; returns the length of the unquoted value.
+int sessionFieldString(const SessionField &field, const char **str);
+
+#endif
@@ -0,0 +1,276 @@
+#include <string.h>
+
+#include "./session_tables.h"
+#include "./session_scan.h"
+
+enum SessionFieldKind
+{
+  Field_Int = 0,
+  Field_Float,
+  Field_Double,
+  Field_String
+};
+
+struct SessionTableColumn
+{
+  ViewColumn view; // Named after the YAML key it is read from
+  SessionFieldKind kind;
+};
+
+static const int carBytes = SessionTables::MaxCars * 4;
+static const int resultRows = SessionTables::MaxSessions * SessionTables::MaxCars;
+static const int resultBytes = resultRows * 4;
+
+static const SessionTableColumn driverColumns[] = {
+  { { "UserName", ViewColumn_Int32, SessionTables::MaxCars, 0 }, Field_String },
+  { { "AbbrevName", ViewColumn_Int32, SessionTables::MaxCars, carBytes }, Field_String },
+  { { "Initials", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 2 }, Field_String },
+  { { "UserID", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 3 }, Field_Int },
+  { { "TeamID", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 4 }, Field_Int },
+  { { "TeamName", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 5 }, Field_String },
+  { { "CarNumber", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 6 }, Field_String },
+  { { "CarNumberRaw", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 7 }, Field_Int },
+  { { "CarID", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 8 }, Field_Int },
+  { { "CarScreenName", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 9 }, Field_String },
+  { { "CarScreenNameShort", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 10 }, Field_String },
+  { { "CarClassID", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 11 }, Field_Int },
+  { { "CarClassShortName", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 12 }, Field_String },
+  { { "CarClassColor", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 13 }, Field_Int },
+  { { "CarClassEstLapTime", ViewColumn_Float32, SessionTables::MaxCars, carBytes * 14 }, Field_Float },
+  { { "IRating", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 15 }, Field_Int },
+  { { "LicLevel", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 16 }, Field_Int },
+  { { "LicSubLevel", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 17 }, Field_Int },
+  { { "LicString", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 18 }, Field_String },
+  { { "LicColor", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 19 }, Field_Int },
+  { { "ClubName", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 20 }, Field_String },
+  { { "DivisionName", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 21 }, Field_String },
+  { { "FlairName", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 22 }, Field_String },
+  { { "IsSpectator", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 23 }, Field_Int },
+  { { "CarIsPaceCar", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 24 }, Field_Int },
+  { { "CarIsAI", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 25 }, Field_Int },
+  { { "CurDriverIncidentCount", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 26 }, Field_Int },
+  { { "TeamIncidentCount", ViewColumn_Int32, SessionTables::MaxCars, carBytes * 27 }, Field_Int },
+};
+
+// The Float64 columns go first to keep them 8 byte aligned
+static const SessionTableColumn resultColumns[] = {
+  { { "Time", ViewColumn_Float64, resultRows, 0 }, Field_Double },
+  { { "FastestTime", ViewColumn_Float64, resultRows, resultBytes * 2 }, Field_Double },
+  { { "LastTime", ViewColumn_Float64, resultRows, resultBytes * 4 }, Field_Double },
+  { { "Position", ViewColumn_Int32, resultRows, resultBytes * 6 }, Field_Int },
+  { { "ClassPosition", ViewColumn_Int32, resultRows, resultBytes * 7 }, Field_Int },
+  { { "CarIdx", ViewColumn_Int32, resultRows, resultBytes * 8 }, Field_Int },
+  { { "Lap", ViewColumn_Int32, resultRows, resultBytes * 9 }, Field_Int },
+  { { "FastestLap", ViewColumn_Int32, resultRows, resultBytes * 10 }, Field_Int },
+  { { "LapsLed", ViewColumn_Int32, resultRows, resultBytes * 11 }, Field_Int },
+  { { "LapsComplete", ViewColumn_Int32, resultRows, resultBytes * 12 }, Field_Int },
+  { { "JokerLapsComplete", ViewColumn_Int32, resultRows, resultBytes * 13 }, Field_Int },
+  { { "LapsDriven", ViewColumn_Float32, resultRows, resultBytes * 14 }, Field_Float },
+  { { "Incidents", ViewColumn_Int32, resultRows, resultBytes * 15 }, Field_Int },
+  { { "ReasonOutId", ViewColumn_Int32, resultRows, resultBytes * 16 }, Field_Int },
+  { { "ReasonOutStr", ViewColumn_Int32, resultRows, resultBytes * 17 }, Field_String },
+  // Rows filled in per session, not read from a key
+  { { "count", ViewColumn_Int32, SessionTables::MaxSessions, resultBytes * 18 }, Field_Int },
+};
+
+static const int driverColumnTotal = sizeof(driverColumns) / sizeof(driverColumns[0]);
+static const int resultColumnTotal = sizeof(resultColumns) / sizeof(resultColumns[0]);
+static const int resultCountColumn = resultColumnTotal - 1;
+
+// FNV-1a over a section's text
+static uint64_t hashBlock(const SessionBlock &block)
+{
+  uint64_t hash = 14695981039346656037ULL;
+  for (const char *c = block.begin; c < block.end; c++) {
+    hash = (hash ^ (unsigned char)*c) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+// Writes the fields of one list entry that have a column into row
+static void writeRow(char *storage, const SessionTableColumn *columns, int columnCount, const SessionBlock &entry,
+                     int row, StringTable *strings)
+{
+  SessionFieldCursor fields(entry);
+  SessionField field;
+  while (fields.next(&field)) {
+    for (int col = 0; col < columnCount; col++) {
+      const SessionTableColumn &def = columns[col];
+      if (!sessionKeyIs(field, def.view.name)) continue;
+
+      char *column = storage + def.view.byteOffset;
+      switch (def.kind) {
+      case Field_Int:
+        reinterpret_cast<int *>(column)[row] = sessionFieldInt(field);
+        break;
+      case Field_Float:
+        reinterpret_cast<float *>(column)[row] = (float)sessionFieldDouble(field);
+        break;
+      case Field_Double:
+        reinterpret_cast<double *>(column)[row] = sessionFieldDouble(field);
+        break;
+      case Field_String: {
+        const char *str;
+        int len = sessionFieldString(field, &str);
+        // The sim writes "Key: ," for some unset strings
+        bool unset = len == 0 || (len == 1 && str[0] == ',');
+        reinterpret_cast<int *>(column)[row] = unset ? -1 : strings->intern(str, len);
+        break;
+      }
+      }
+      break;
+    }
+  }
+}
+
+int SessionTables::driverColumnCount()
+{
+  return driverColumnTotal;
+}
+
+const ViewColumn &SessionTables::driverColumn(int index)
+{
+  return driverColumns[index].view;
+}
+
+int SessionTables::driversByteLength()
+{
+  return driverColumnTotal * carBytes;
+}
+
+int SessionTables::resultColumnCount()
+{
+  return resultColumnTotal;
+}
+
+const ViewColumn &SessionTables::resultColumn(int index)
+{
+  return resultColumns[index].view;
+}
+
+int SessionTables::resultsByteLength()
+{
+  const ViewColumn &last = resultColumns[resultColumnTotal - 1].view;
+  return last.byteOffset + last.length * 4;
+}
+
+SessionTables::SessionTables()
+  : _drivers(NULL)
+  , _results(NULL)
+  , _driversHash(0)
+{
+  memset(_resultsHash, 0, sizeof(_resultsHash));
+}
+
+void SessionTables::attach(char *drivers, char *results)
+{
+  _drivers = drivers;
+  _results = results;
+  clearDrivers();
+  for (int session = 0; session < MaxSessions; session++) {
+    clearResults(session);
+  }
+}
+
+void SessionTables::updateSession(const char *yaml)
+{
+  if (!_drivers || !yaml) return;
+  SessionBlock root = sessionRoot(yaml);
+
+  SessionBlock drivers;
+  if (!sessionFindBlock(root, "DriverInfo:Drivers:", &drivers)) {
+    if (_driversHash) clearDrivers();
+  } else if (hashBlock(drivers) != _driversHash) {
+    clearDrivers();
+    _driversHash = hashBlock(drivers);
+
+    SessionListCursor entries(drivers);
+    SessionBlock entry;
+    while (entries.next(&entry)) {
+      SessionField field;
+      if (!sessionFindValue(entry, "CarIdx", &field)) continue;
+      int carIdx = sessionFieldInt(field, -1);
+      if (carIdx < 0 || carIdx >= MaxCars) continue;
+      writeRow(_drivers, driverColumns, driverColumnTotal, entry, carIdx, &_strings);
+    }
+  }
+
+  bool seen[MaxSessions] = {};
+  SessionBlock sessions;
+  if (sessionFindBlock(root, "SessionInfo:Sessions:", &sessions)) {
+    SessionListCursor entries(sessions);
+    SessionBlock entry;
+    while (entries.next(&entry)) {
+      SessionField field;
+      if (!sessionFindValue(entry, "SessionNum", &field)) continue;
+      int session = sessionFieldInt(field, -1);
+      if (session < 0 || session >= MaxSessions) continue;
+
+      SessionBlock positions;
+      if (!sessionFindBlock(entry, "ResultsPositions:", &positions) || positions.begin == positions.end) continue;
+      seen[session] = true;
+
+      uint64_t hash = hashBlock(positions);
+      if (hash == _resultsHash[session]) continue;
+      clearResults(session);
+      _resultsHash[session] = hash;
+
+      int count = 0;
+      SessionListCursor rows(positions);
+      SessionBlock row;
+      while (rows.next(&row)) {
+        if (!sessionFindValue(row, "Position", &field)) continue;
+        int position = sessionFieldInt(field, 0);
+        if (position < 1 || position > MaxCars) continue;
+        writeRow(_results, resultColumns, resultCountColumn, row, session * MaxCars + position - 1, &_strings);
+        if (position > count) count = position;
+      }
+      reinterpret_cast<int *>(_results + resultColumns[resultCountColumn].view.byteOffset)[session] = count;
+    }
+  }
+
+  // Sessions whose results went away, e.g. after a restart
+  for (int session = 0; session < MaxSessions; session++) {
+    if (!seen[session] && _resultsHash[session]) clearResults(session);
+  }
+}
+
+void SessionTables::clearDrivers()
+{
+  _driversHash = 0;
+  for (int col = 0; col < driverColumnTotal; col++) {
+    const SessionTableColumn &def = driverColumns[col];
+    char *column = _drivers + def.view.byteOffset;
+    for (int car = 0; car < MaxCars; car++) {
+      if (def.kind == Field_Float) reinterpret_cast<float *>(column)[car] = 0.0f;
+      else reinterpret_cast<int *>(column)[car] = def.kind == Field_String ? -1 : 0;
+    }
+  }
+}
+
+void SessionTables::clearResults(int session)
+{
+  _resultsHash[session] = 0;
+  for (int col = 0; col < resultColumnTotal; col++) {
+    const SessionTableColumn &def = resultColumns[col];
+    char *column = _results + def.view.byteOffset;
+    if (col == resultCountColumn) {
+      reinterpret_cast<int *>(column)[session] = 0;
+      continue;
+    }
+    for (int row = session * MaxCars; row < (session + 1) * MaxCars; row++) {
+      switch (def.kind) {
+      case Field_Double:
+        reinterpret_cast<double *>(column)[row] = 0.0;
+        break;
+      case Field_Float:
+        reinterpret_cast<float *>(column)[row] = 0.0f;
+        break;
+      default:
+        // Like string ids, CarIdx needs -1 to tell an empty row from car 0
+        bool none = def.kind == Field_String || 0 == strcmp(def.view.name, "CarIdx");
+        reinterpret_cast<int *>(column)[row] = none ? -1 : 0;
+      }
+    }
+  }
+}
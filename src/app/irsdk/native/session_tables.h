@@ -0,0 +1,57 @@
+#ifndef SESSION_TABLES_H
+#define SESSION_TABLES_H
+
+#include <stdint.h>
+
+#include "./string_table.h"
+#include "./view_column.h"
+
+// Fixed schema tables of the two largest session info sections, so standings
+// don't have to walk them as generic objects:
+//   drivers  DriverInfo:Drivers, indexed by CarIdx
+//   results  SessionInfo:Sessions:ResultsPositions of every session, flattened
+//            as [sessionNum * MaxCars + position - 1]
+//
+// String fields hold ids into an intern table that lives as long as the
+// engine, so ids stay valid across session updates. -1 marks an empty slot.
+// Each section is hashed and only re-parsed when its text changed.
+class SessionTables
+{
+public:
+  static const int MaxCars = 64;
+  static const int MaxSessions = 8;
+
+  static int driverColumnCount();
+  static const ViewColumn &driverColumn(int index);
+  static int driversByteLength();
+
+  static int resultColumnCount();
+  static const ViewColumn &resultColumn(int index);
+  static int resultsByteLength();
+
+  SessionTables();
+
+  // Storage must be at least driversByteLength() / resultsByteLength() bytes,
+  // see CarTable::attach
+  void attach(char *drivers, char *results);
+  void detach() { _drivers = _results = NULL; }
+  bool isAttached() const { return _drivers != NULL; }
+
+  void updateSession(const char *yaml);
+
+  const StringTable &strings() const { return _strings; }
+
+private:
+  void clearDrivers();
+  void clearResults(int session);
+
+  char *_drivers;
+  char *_results;
+  StringTable _strings;
+
+  // Hashes of the section text the tables were last built from
+  uint64_t _driversHash;
+  uint64_t _resultsHash[MaxSessions];
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "./session_worker.h"
+#include "./trace.h"
+
+SessionWorker::SessionWorker()
+  : _stopping(false)
+  , _pending(false)
+  , _pendingUpdate(-1)
+  , _ready(false)
+  , _readyUpdate(-1)
+{
+}
+
+SessionWorker::~SessionWorker()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_stopping = true;
+  }
+  this->_wake.notify_one();
+  if (this->_thread.joinable()) this->_thread.join();
+}
+
+void SessionWorker::submit(int update, const char *session)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    this->_pending = true;
+    this->_pendingUpdate = update;
+    this->_pendingSession.assign(session);
+    // Started on first use so an idle SDK instance doesn't hold a thread
+    if (!this->_thread.joinable()) this->_thread = std::thread(&SessionWorker::run, this);
+  }
+  this->_wake.notify_one();
+}
+
+bool SessionWorker::take(std::string *json, std::unique_ptr<SessionIndex> *index, int *update)
+{
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  if (!this->_ready) return false;
+  this->_ready = false;
+  json->swap(this->_readyJson);
+  index->swap(this->_readyIndex);
+  *update = this->_readyUpdate;
+  return true;
+}
+
+void SessionWorker::run()
+{
+  std::string session;
+  std::string json;
+  traceSetThreadName("irsdk session worker");
+  for (;;) {
+    int update;
+    {
+      std::unique_lock<std::mutex> lock(this->_mutex);
+      this->_wake.wait(lock, [this] { return this->_stopping || this->_pending; });
+      if (this->_stopping) return;
+      session.swap(this->_pendingSession);
+      update = this->_pendingUpdate;
+      this->_pending = false;
+    }
+
+    std::string utf8 = ConvertToUTF8(session.c_str());
+    std::unique_ptr<SessionIndex> index(new SessionIndex());
+    {
+      TRACE_SPAN("parseSessionYaml");
+      index->build(&utf8);
+    }
+    {
+      TRACE_SPAN("sessionToJson");
+      index->toJson(0, &json);
+    }
+
+    std::lock_guard<std::mutex> lock(this->_mutex);
+    // A newer submit will replace this one shortly, skip publishing it
+    if (this->_pending) continue;
+    this->_readyJson.swap(json);
+    this->_readyIndex.swap(index);
+    this->_readyUpdate = update;
+    this->_ready = true;
+  }
+}
@@ -0,0 +1,47 @@
+#ifndef SESSION_WORKER_H
+#define SESSION_WORKER_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "./session_json.h"
+
+// Converts session info updates to JSON and indexes them on a background
+// thread, so the main thread only has to JSON.parse the result instead of
+// running the YAML parser in JS (several ms for a full field). Updates submitted while one is still
+// being converted are coalesced, only the newest one is converted next.
+class SessionWorker
+{
+public:
+  SessionWorker();
+  ~SessionWorker();
+
+  // Copies the raw (Windows-1252) session string, it lives in the sim's
+  // shared memory and can change under the worker
+  void submit(int update, const char *session);
+  // Moves the newest converted update into json and index, false when there
+  // is none since the last take
+  bool take(std::string *json, std::unique_ptr<SessionIndex> *index, int *update);
+
+private:
+  void run();
+
+  std::thread _thread;
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  bool _stopping;
+
+  // Guarded by _mutex
+  bool _pending;
+  int _pendingUpdate;
+  std::string _pendingSession;
+  bool _ready;
+  int _readyUpdate;
+  std::string _readyJson;
+  std::unique_ptr<SessionIndex> _readyIndex;
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "./shared_memory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SharedMemory::SharedMemory()
+  : _data(NULL)
+  , _size(0)
+  , _owner(false)
+#ifdef _WIN32
+  , _mapping(NULL)
+#endif
+{
+#ifndef _WIN32
+  _name[0] = '\0';
+#endif
+}
+
+#ifdef _WIN32
+
+bool SharedMemory::create(const char *name, int size)
+{
+  close();
+
+  HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, size, name);
+  if (!mapping) return false;
+
+  _data = static_cast<char *>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size));
+  if (!_data) {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  _mapping = mapping;
+  _size = size;
+  _owner = true;
+  return true;
+}
+
+bool SharedMemory::open(const char *name, bool readOnly)
+{
+  close();
+
+  DWORD access = readOnly ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS;
+  HANDLE mapping = OpenFileMappingA(access, FALSE, name);
+  if (!mapping) return false;
+
+  _data = static_cast<char *>(MapViewOfFile(mapping, access, 0, 0, 0));
+  if (!_data) {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  MEMORY_BASIC_INFORMATION info;
+  VirtualQuery(_data, &info, sizeof(info));
+  _mapping = mapping;
+  _size = (int)info.RegionSize;
+  _owner = false;
+  return true;
+}
+
+void SharedMemory::close()
+{
+  if (_data) UnmapViewOfFile(_data);
+  if (_mapping) CloseHandle(_mapping);
+  _data = NULL;
+  _mapping = NULL;
+  _size = 0;
+  _owner = false;
+}
+
+#else
+
+// POSIX names are a single path component
+static void posixName(const char *name, char *out, int size)
+{
+  const char *slash = strrchr(name, '\\');
+  snprintf(out, size, "/%s", slash ? slash + 1 : name);
+}
+
+bool SharedMemory::create(const char *name, int size)
+{
+  close();
+  posixName(name, _name, sizeof(_name));
+
+  int fd = shm_open(_name, O_CREAT | O_RDWR, 0644);
+  if (fd < 0) return false;
+
+  void *data = MAP_FAILED;
+  if (0 == ftruncate(fd, size)) {
+    data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    shm_unlink(_name);
+    return false;
+  }
+
+  _data = static_cast<char *>(data);
+  _size = size;
+  _owner = true;
+  return true;
+}
+
+bool SharedMemory::open(const char *name, bool readOnly)
+{
+  close();
+  posixName(name, _name, sizeof(_name));
+
+  int fd = shm_open(_name, readOnly ? O_RDONLY : O_RDWR, 0);
+  if (fd < 0) return false;
+
+  struct stat st;
+  void *data = MAP_FAILED;
+  if (0 == fstat(fd, &st) && st.st_size > 0) {
+    data = mmap(NULL, st.st_size, readOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  ::close(fd);
+  if (data == MAP_FAILED) return false;
+
+  _data = static_cast<char *>(data);
+  _size = (int)st.st_size;
+  _owner = false;
+  return true;
+}
+
+void SharedMemory::close()
+{
+  if (_data) munmap(_data, _size);
+  if (_data && _owner) shm_unlink(_name);
+  _data = NULL;
+  _size = 0;
+  _owner = false;
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SHARED_MEMORY_H
+#define SHARED_MEMORY_H
+
+// A named shared memory segment: a file mapping on Windows, shm_open elsewhere.
+// The creator owns the name; on POSIX it is unlinked again when the creator
+// closes it.
+class SharedMemory
+{
+public:
+  SharedMemory();
+  ~SharedMemory() { close(); }
+
+  bool create(const char *name, int size);
+  bool open(const char *name, bool readOnly);
+  void close();
+
+  bool isOpen() const { return _data != NULL; }
+  char *data() const { return _data; }
+  int size() const { return _size; }
+
+private:
+  SharedMemory(const SharedMemory &);
+  SharedMemory &operator=(const SharedMemory &);
+
+  char *_data;
+  int _size;
+  bool _owner;
+#ifdef _WIN32
+  void *_mapping;
+#else
+  char _name[64];
+#endif
+};
+
+#endif
@@ -0,0 +1,206 @@
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "./sim_producer.h"
+
+static const int numBufs = 3;
+static const int maxVars = 64;
+static const int varHeaderOffset = 256;
+static const int sessionInfoOffset = varHeaderOffset + maxVars * (int)sizeof(irsdk_varHeader);
+static const int sessionCapacity = 128 * 1024;
+static const int bufOffset = sessionInfoOffset + sessionCapacity;
+static const int maxBufLen = 16 * 1024;
+
+static const double lapLength = 4000.0; // m
+static const double pi = 3.14159265358979323846;
+
+static std::string defaultSessionInfo()
+{
+  std::string yaml =
+    "---\n"
+    "WeekendInfo:\n"
+    " TrackName: simtrack\n"
+    " TrackID: 1\n"
+    " TrackLength: 4.00 km\n"
+    " TrackDisplayName: Simulated Raceway\n"
+    "SessionInfo:\n"
+    " Sessions:\n"
+    " - SessionNum: 0\n"
+    "   SessionType: Practice\n"
+    "DriverInfo:\n"
+    " DriverCarIdx: 0\n"
+    " Drivers:\n";
+
+  char entry[160];
+  for (int i = 0; i < SimProducer::CarCount; i++) {
+    snprintf(entry, sizeof(entry),
+      " - CarIdx: %d\n"
+      "   UserName: Sim Driver %d\n"
+      "   CarNumber: \"%d\"\n"
+      "   CarID: 1\n",
+      i, i, i);
+    yaml += entry;
+  }
+  yaml += "...\n";
+  return yaml;
+}
+
+SimProducer::SimProducer()
+  : _header(NULL)
+  , _bufLen(0)
+  , _sessionCapacity(sessionCapacity)
+  , _tickRate(60)
+  , _tickCount(0)
+  , _lapDist(0)
+{
+  _sessionTime = addVar("SessionTime", irsdk_double, 1, "s", "Seconds since session start");
+  _sessionTick = addVar("SessionTick", irsdk_int, 1, "", "Current update number");
+  _speed = addVar("Speed", irsdk_float, 1, "m/s", "GPS vehicle speed");
+  _rpm = addVar("RPM", irsdk_float, 1, "revs/min", "Engine rpm");
+  _gear = addVar("Gear", irsdk_int, 1, "", "-1=reverse  0=neutral  1..n=current gear");
+  _throttle = addVar("Throttle", irsdk_float, 1, "%", "0=off throttle to 1=full throttle");
+  _brake = addVar("Brake", irsdk_float, 1, "%", "0=brake released to 1=max pedal force");
+  _lap = addVar("Lap", irsdk_int, 1, "", "Laps started count");
+  _lapDistPct = addVar("LapDistPct", irsdk_float, 1, "%", "Percentage distance around lap");
+  _playerCarIdx = addVar("PlayerCarIdx", irsdk_int, 1, "", "Players carIdx");
+  _carIdxLap = addVar("CarIdxLap", irsdk_int, CarCount, "", "Laps started by car index");
+  _carIdxLapDistPct = addVar("CarIdxLapDistPct", irsdk_float, CarCount, "%", "Percentage distance around lap by car index");
+  _carIdxOnPitRoad = addVar("CarIdxOnPitRoad", irsdk_bool, CarCount, "", "On pit road between the cones by car index");
+  _producerTime = addVar("ProducerTime", irsdk_double, 1, "s", "Steady clock when the line was published");
+}
+
+int SimProducer::addVar(const char *name, int type, int count, const char *unit, const char *desc)
+{
+  int size = irsdk_VarTypeBytes[type];
+  _bufLen = (_bufLen + size - 1) / size * size;
+
+  irsdk_varHeader var;
+  var.clear();
+  var.type = type;
+  var.offset = _bufLen;
+  var.count = count;
+  strncpy(var.name, name, IRSDK_MAX_STRING - 1);
+  strncpy(var.desc, desc, IRSDK_MAX_DESC - 1);
+  strncpy(var.unit, unit, IRSDK_MAX_STRING - 1);
+  _vars.push_back(var);
+
+  _bufLen += size * count;
+  return var.offset;
+}
+
+bool SimProducer::create(const char *name, int tickRate)
+{
+  int lineLen = (_bufLen + 15) / 16 * 16;
+  if (!_memory.create(name, bufOffset + numBufs * maxBufLen)) return false;
+  if (lineLen > maxBufLen) {
+    _memory.close();
+    return false;
+  }
+
+  memset(_memory.data(), 0, _memory.size());
+  _header = reinterpret_cast<irsdk_header *>(_memory.data());
+  _tickRate = tickRate > 0 ? tickRate : 60;
+  // Tick 0 would look like data in the zeroed buffers
+  _tickCount = 1;
+  _lapDist = 0;
+
+  memcpy(_memory.data() + varHeaderOffset, &_vars[0], _vars.size() * sizeof(irsdk_varHeader));
+  _header->ver = IRSDK_VER;
+  _header->tickRate = _tickRate;
+  _header->numVars = (int)_vars.size();
+  _header->varHeaderOffset = varHeaderOffset;
+  _header->sessionInfoOffset = sessionInfoOffset;
+  _header->numBuf = numBufs;
+  _header->bufLen = _bufLen;
+  for (int i = 0; i < numBufs; i++) {
+    _header->varBuf[i].bufOffset = bufOffset + i * maxBufLen;
+  }
+
+  setSessionInfo(defaultSessionInfo());
+  tick();
+  setConnected(true);
+  return true;
+}
+
+void SimProducer::close()
+{
+  if (_header) setConnected(false);
+  _memory.close();
+  _header = NULL;
+}
+
+void SimProducer::setConnected(bool connected)
+{
+  if (!_header) return;
+  _header->status = connected ? irsdk_stConnected : 0;
+}
+
+void SimProducer::setSessionInfo(const std::string &yaml)
+{
+  if (!_header) return;
+  int length = (int)yaml.size() < _sessionCapacity - 1 ? (int)yaml.size() : _sessionCapacity - 1;
+  char *out = _memory.data() + sessionInfoOffset;
+  memcpy(out, yaml.data(), length);
+  out[length] = '\0';
+  _header->sessionInfoLen = length + 1;
+  std::atomic_thread_fence(std::memory_order_release);
+  _header->sessionInfoUpdate++;
+}
+
+void SimProducer::writeLine(char *line)
+{
+  double time = (double)_tickCount / _tickRate;
+  double pct = _lapDist / lapLength;
+
+  // Fast down the straights, slow through the four corners of each lap
+  double speed = 45.0 + 25.0 * cos(pct * 8.0 * pi);
+  double accel = -sin(pct * 8.0 * pi);
+  int gear = 1 + (int)(speed / 14.0);
+  if (gear > 6) gear = 6;
+
+  float f;
+  int i;
+  memcpy(line + _sessionTime, &time, sizeof(time));
+  memcpy(line + _sessionTick, &_tickCount, sizeof(int));
+  f = (float)speed; memcpy(line + _speed, &f, sizeof(f));
+  f = (float)(2500.0 + fmod(speed, 14.0) * 450.0); memcpy(line + _rpm, &f, sizeof(f));
+  memcpy(line + _gear, &gear, sizeof(int));
+  f = accel >= 0 ? 1.0f : 0.0f; memcpy(line + _throttle, &f, sizeof(f));
+  f = accel < -0.5 ? (float)-accel : 0.0f; memcpy(line + _brake, &f, sizeof(f));
+  i = (int)(_lapDist / lapLength) + 1; memcpy(line + _lap, &i, sizeof(int));
+  f = (float)(pct - floor(pct)); memcpy(line + _lapDistPct, &f, sizeof(f));
+  i = 0; memcpy(line + _playerCarIdx, &i, sizeof(int));
+
+  for (int car = 0; car < CarCount; car++) {
+    // Everyone else circulates a little slower, spread out around the lap
+    double dist = _lapDist * (1.0 - car * 0.002) + car * lapLength / CarCount;
+    i = (int)(dist / lapLength) + 1;
+    f = (float)(dist / lapLength - floor(dist / lapLength));
+    bool pit = car == CarCount - 1;
+    memcpy(line + _carIdxLap + car * sizeof(int), &i, sizeof(int));
+    memcpy(line + _carIdxLapDistPct + car * sizeof(float), &f, sizeof(float));
+    memcpy(line + _carIdxOnPitRoad + car, &pit, sizeof(bool));
+  }
+
+  _lapDist += speed / _tickRate;
+}
+
+void SimProducer::tick()
+{
+  if (!_header) return;
+
+  // The oldest buffer is the one a reader is least likely to be copying
+  irsdk_varBuf &buf = _header->varBuf[_tickCount % numBufs];
+  char *line = _memory.data() + buf.bufOffset;
+  writeLine(line);
+
+  // Stamped last, so a reader's latency covers everything up to the release
+  double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  memcpy(line + _producerTime, &now, sizeof(now));
+  std::atomic_thread_fence(std::memory_order_release);
+  buf.tickCount = _tickCount;
+  _tickCount++;
+}
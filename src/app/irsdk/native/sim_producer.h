@@ -0,0 +1,66 @@
+#ifndef SIM_PRODUCER_H
+#define SIM_PRODUCER_H
+
+#include <string>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+#include "./shared_memory.h"
+
+static const char SIM_PRODUCER_DEFAULT_NAME[] = "Local\\IRDashiesSimMemMap";
+
+// Writes a made up session into a mapping laid out exactly like the sim's, so
+// the relay and anything else built on TelemetrySource can run without iRacing,
+// including on Linux. A handful of player and CarIdx vars move around a lap.
+class SimProducer
+{
+public:
+  static const int CarCount = 64;
+
+  SimProducer();
+
+  bool create(const char *name, int tickRate);
+  void close();
+  bool isOpen() const { return _memory.isOpen(); }
+
+  // Writes the next line into the oldest buffer
+  void tick();
+  void setConnected(bool connected);
+  void setSessionInfo(const std::string &yaml);
+
+  int tickCount() const { return _tickCount; }
+  int varCount() const { return (int)_vars.size(); }
+  int bufLen() const { return _bufLen; }
+
+private:
+  int addVar(const char *name, int type, int count, const char *unit, const char *desc);
+  void writeLine(char *line);
+
+  SharedMemory _memory;
+  irsdk_header *_header;
+  std::vector<irsdk_varHeader> _vars;
+  int _bufLen;
+  int _sessionCapacity;
+  int _tickRate;
+  int _tickCount;
+  double _lapDist;
+
+  int _sessionTime;
+  int _sessionTick;
+  int _speed;
+  int _rpm;
+  int _gear;
+  int _throttle;
+  int _brake;
+  int _lap;
+  int _lapDistPct;
+  int _playerCarIdx;
+  int _carIdxLap;
+  int _carIdxLapDistPct;
+  int _carIdxOnPitRoad;
+  // Steady clock seconds at publish, the clock process.hrtime() reads too,
+  // for measuring latency to the consumers
+  int _producerTime;
+};
+
+#endif
@@ -0,0 +1,75 @@
+// irsdk_sim_producer: writes a made up session into an irsdk style mapping at
+// the sim's tick rate, for running irsdk_relay without iRacing.
+//
+// Usage: irsdk_sim_producer [--name <mapping>] [--rate <hz>] [--seconds <n>]
+
+#include <chrono>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+
+#include "./sim_producer.h"
+
+static volatile sig_atomic_t running = 1;
+
+static void stop(int)
+{
+  running = 0;
+}
+
+static void usage()
+{
+  fprintf(stderr, "Usage: irsdk_sim_producer [--name <mapping>] [--rate <hz>] [--seconds <n>]\n");
+}
+
+int main(int argc, char **argv)
+{
+  std::string name = SIM_PRODUCER_DEFAULT_NAME;
+  int rate = 60;
+  double seconds = 0; // Forever
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (0 == strcmp(arg, "--name")) name = value;
+    else if (0 == strcmp(arg, "--rate")) rate = atoi(value);
+    else if (0 == strcmp(arg, "--seconds")) seconds = atof(value);
+    else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+
+  signal(SIGINT, stop);
+  signal(SIGTERM, stop);
+
+  SimProducer producer;
+  if (rate <= 0 || !producer.create(name.c_str(), rate)) {
+    fprintf(stderr, "irsdk_sim_producer: can't create %s\n", name.c_str());
+    return 1;
+  }
+  fprintf(stderr, "irsdk_sim_producer: writing %d vars to %s at %d Hz\n",
+    producer.varCount(), name.c_str(), rate);
+
+  // Tick on an absolute schedule so sleep overshoot doesn't add up
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::chrono::nanoseconds interval(1000000000LL / rate);
+  std::chrono::steady_clock::time_point next = start + interval;
+  while (running) {
+    std::this_thread::sleep_until(next);
+    producer.tick();
+    next += interval;
+    if (seconds > 0 && next - start > std::chrono::duration<double>(seconds)) break;
+  }
+
+  producer.close();
+  return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Append-only intern table. Ids are stable for the lifetime of the table so
+// typed-array columns can hold them across session updates.
+class StringTable
+{
+public:
+  int intern(const char *str, int len)
+  {
+    std::string key(str, len);
+    auto it = _ids.find(key);
+    if (it != _ids.end()) return it->second;
+
+    int id = (int)_strings.size();
+    _strings.push_back(key);
+    _ids.emplace(std::move(key), id);
+    return id;
+  }
+
+  const std::string &get(int id) const { return _strings[id]; }
+  int size() const { return (int)_strings.size(); }
+
+  void clear()
+  {
+    _strings.clear();
+    _ids.clear();
+  }
+
+private:
+  std::vector<std::string> _strings;
+  std::unordered_map<std::string, int> _ids;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include <string.h>
+
+#include "./sub_tick_stream.h"
+
+SubTickStream::SubTickStream()
+  : _samples(0)
+  , _sessionTimeOffset(-1)
+  , _tickInterval(1.0 / 60)
+  , _capacity(DefaultCapacity)
+  , _written(0)
+  , _first(0)
+  , _lastTime(-1)
+{
+}
+
+void SubTickStream::bindVars(const irsdk_varHeader *vars, int count, int tickRate)
+{
+  _columns.clear();
+  _names.clear();
+  _samples = 0;
+  _sessionTimeOffset = -1;
+  _tickInterval = tickRate > 0 ? 1.0 / tickRate : 1.0 / 60;
+  _first = _written;
+  _lastTime = -1;
+
+  for (int i = 0; vars && i < count; i++) {
+    const irsdk_varHeader &var = vars[i];
+    if (0 == strncmp(var.name, "SessionTime", IRSDK_MAX_STRING) && var.type == irsdk_double) {
+      _sessionTimeOffset = var.offset;
+      continue;
+    }
+
+    size_t length = strnlen(var.name, IRSDK_MAX_STRING);
+    if (length < 3 || 0 != strncmp(var.name + length - 3, "_ST", 3)) continue;
+    if (var.type != irsdk_float && var.type != irsdk_double) continue;
+    if (var.count < 2 || (_samples && var.count != _samples)) continue;
+
+    _samples = var.count;
+    Column column = { var.type, var.offset };
+    _columns.push_back(column);
+    _names.push_back(std::string(var.name, length));
+  }
+
+  // Nothing to timestamp the rows with
+  if (_sessionTimeOffset < 0) {
+    _columns.clear();
+    _names.clear();
+  }
+
+  _times.assign(_capacity, 0);
+  _values.assign((size_t)_capacity * _columns.size(), 0);
+}
+
+void SubTickStream::update(const char *data)
+{
+  if (_columns.empty() || !data) return;
+
+  double time;
+  memcpy(&time, data + _sessionTimeOffset, sizeof(time));
+  // Same line again, e.g. while paused
+  if (time == _lastTime) return;
+
+  double elapsed = time - _lastTime;
+  double interval = _lastTime >= 0 && elapsed > 0 && elapsed < 2 * _tickInterval ? elapsed : _tickInterval;
+  _lastTime = time;
+
+  size_t columns = _columns.size();
+  for (int s = 0; s < _samples; s++) {
+    size_t row = (size_t)(_written % _capacity);
+    _times[row] = time - interval * (_samples - 1 - s) / _samples;
+
+    float *values = &_values[row * columns];
+    for (size_t c = 0; c < columns; c++) {
+      const char *value = data + _columns[c].offset;
+      if (_columns[c].varType == irsdk_double) {
+        double d;
+        memcpy(&d, value + s * sizeof(double), sizeof(d));
+        values[c] = (float)d;
+      } else {
+        memcpy(&values[c], value + s * sizeof(float), sizeof(float));
+      }
+    }
+    _written++;
+  }
+}
+
+long long SubTickStream::read(long long since, std::vector<double> *times, std::vector<float> *values) const
+{
+  times->clear();
+  values->clear();
+
+  // Rows from before the last bind or overwritten since are gone
+  if (since > _written) since = _written;
+  if (since < _written - _capacity) since = _written - _capacity;
+  if (since < _first) since = _first;
+
+  size_t columns = _columns.size();
+  for (long long n = since; n < _written; n++) {
+    size_t row = (size_t)(n % _capacity);
+    times->push_back(_times[row]);
+    values->insert(values->end(), _values.begin() + row * columns, _values.begin() + (row + 1) * columns);
+  }
+  return _written;
+}
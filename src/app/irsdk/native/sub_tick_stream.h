@@ -0,0 +1,59 @@
+#ifndef SUB_TICK_STREAM_H
+#define SUB_TICK_STREAM_H
+
+#include <string>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+
+// Flattens the sim's sub tick vars (the *_ST ones, e.g. SteeringWheelAngle_ST,
+// holding `count` samples taken over one line) into a continuous stream of
+// timestamped rows in a ring buffer. A line's samples are spread evenly over
+// the SessionTime elapsed since the previous line, or one tick when lines
+// were missed, oldest first.
+//
+// Every _ST float or double var with the same count as the first one found
+// becomes a column. Readers keep the row number they got to and ask for
+// everything after it.
+class SubTickStream
+{
+public:
+  static const int DefaultCapacity = 360 * 4;
+
+  SubTickStream();
+
+  void bindVars(const irsdk_varHeader *vars, int count, int tickRate);
+  void update(const char *data);
+
+  bool isAttached() const { return !_columns.empty(); }
+  const std::vector<std::string> &names() const { return _names; }
+  // Row numbers keep counting across binds
+  long long written() const { return _written; }
+
+  // Copies the rows after `since` that are still in the ring, at most
+  // capacity of them, and returns the row number to pass next time.
+  // Values are row major, one per column.
+  long long read(long long since, std::vector<double> *times, std::vector<float> *values) const;
+
+private:
+  struct Column
+  {
+    int varType;
+    int offset;
+  };
+
+  std::vector<Column> _columns;
+  std::vector<std::string> _names;
+  int _samples; // Per line
+  int _sessionTimeOffset;
+  double _tickInterval;
+
+  std::vector<double> _times;
+  std::vector<float> _values;
+  int _capacity;
+  long long _written;
+  long long _first; // First row of the current bind
+  double _lastTime;
+};
+
+#endif
@@ -0,0 +1,210 @@
+#include <math.h>
+#include <string.h>
+
+#include "./telemetry_history.h"
+#include "./var_lookup.h"
+
+static const float Nan = NAN;
+
+LodPyramid::LodPyramid(int capacity)
+  : _capacity(capacity > 2 ? capacity : 2)
+  , _base(0)
+  , _length(0)
+{
+}
+
+void LodPyramid::add(Acc *acc, const Acc &other)
+{
+  if (!other.count) return;
+  if (!acc->count || other.min < acc->min) acc->min = other.min;
+  if (!acc->count || other.max > acc->max) acc->max = other.max;
+  acc->sum += other.sum;
+  acc->count += other.count;
+}
+
+void LodPyramid::push(float value)
+{
+  Acc sample = { value, value, value, value == value ? 1 : 0 };
+  _length++;
+
+  // A level is added once the one below stores its first bucket, which at
+  // that point holds every sample so far
+  if (_running.empty()) {
+    _levels.resize(1);
+    _running.resize(1);
+  }
+
+  for (size_t k = 0; k < _running.size(); k++) {
+    add(&_running[k], sample);
+    if (_length & ((1LL << k) - 1)) continue;
+
+    // Level k just completed a bucket
+    Acc acc = _running[k];
+    if ((int)k >= _base) {
+      Bucket bucket = { acc.count ? acc.min : Nan, acc.count ? acc.max : Nan,
+                        acc.count ? (float)(acc.sum / acc.count) : Nan };
+      _levels[k].push_back(bucket);
+    }
+    if (k + 1 == _running.size()) {
+      _running.push_back(acc);
+      _levels.resize(_running.size());
+      _running[k] = Acc();
+      break;
+    }
+    _running[k] = Acc();
+  }
+
+  // Every base bucket is covered by the level above once it has an even count
+  if ((int)_levels[_base].size() > _capacity && !(_levels[_base].size() & 1)) {
+    std::vector<Bucket>().swap(_levels[_base]);
+    _base++;
+  }
+}
+
+// A stored bucket, the running one, or for levels above the top the two
+// halves combined
+LodPyramid::Acc LodPyramid::bucket(int level, long long index) const
+{
+  Acc acc = Acc();
+  int top = (int)_running.size() - 1;
+  if (level > top) {
+    add(&acc, bucket(level - 1, index * 2));
+    if (((index * 2 + 1) << (level - 1)) < _length) add(&acc, bucket(level - 1, index * 2 + 1));
+    return acc;
+  }
+
+  const std::vector<Bucket> &stored = _levels[level];
+  if (index < (long long)stored.size()) {
+    const Bucket &b = stored[(size_t)index];
+    if (b.mean == b.mean) {
+      // Only the mean needs a count, a full bucket's is its size
+      acc.min = b.min;
+      acc.max = b.max;
+      acc.count = 1 << level;
+      acc.sum = (double)b.mean * acc.count;
+    }
+    return acc;
+  }
+  return _running[level];
+}
+
+int LodPyramid::query(long long from, long long to, int maxBuckets, std::vector<Bucket> *out, long long *first) const
+{
+  out->clear();
+  if (from < 0) from = 0;
+  if (to > _length) to = _length;
+  if (maxBuckets < 1) maxBuckets = 1;
+
+  int level = _base;
+  if (from >= to) {
+    *first = from;
+    return level;
+  }
+  while (((to - 1) >> level) - (from >> level) + 1 > maxBuckets) level++;
+
+  long long start = from >> level;
+  long long end = (to - 1) >> level;
+  *first = start << level;
+  for (long long index = start; index <= end; index++) {
+    Acc acc = bucket(level, index);
+    Bucket b = { acc.count ? acc.min : Nan, acc.count ? acc.max : Nan,
+                 acc.count ? (float)(acc.sum / acc.count) : Nan };
+    out->push_back(b);
+  }
+  return level;
+}
+
+TelemetryHistory::TelemetryHistory()
+  : _nextId(1)
+  , _vars(NULL)
+  , _varCount(0)
+{
+}
+
+int TelemetryHistory::add(const char *name, int index, int capacity)
+{
+  Channel channel = { _nextId++, name, index < 0 ? 0 : index, irsdk_float, -1,
+                      LodPyramid(capacity > 0 ? capacity : DefaultCapacity) };
+  bind(channel);
+  _channels.push_back(channel);
+  return channel.id;
+}
+
+bool TelemetryHistory::remove(int id)
+{
+  for (size_t i = 0; i < _channels.size(); i++) {
+    if (_channels[i].id == id) {
+      _channels.erase(_channels.begin() + i);
+      return true;
+    }
+  }
+  return false;
+}
+
+const LodPyramid *TelemetryHistory::find(int id) const
+{
+  for (size_t i = 0; i < _channels.size(); i++) {
+    if (_channels[i].id == id) return &_channels[i].pyramid;
+  }
+  return NULL;
+}
+
+void TelemetryHistory::bindVars(const irsdk_varHeader *vars, int count)
+{
+  _vars = vars;
+  _varCount = count;
+  for (size_t i = 0; i < _channels.size(); i++) bind(_channels[i]);
+}
+
+void TelemetryHistory::bind(Channel &channel)
+{
+  // Not connected, sampled as gaps until the next bindVars()
+  if (!_vars) {
+    channel.offset = -1;
+    return;
+  }
+  const irsdk_varHeader *var = findVarHeader(_vars, _varCount, channel.name.c_str());
+  if (!var || channel.index >= var->count) {
+    channel.offset = -1;
+    return;
+  }
+  channel.varType = var->type;
+  channel.offset = var->offset + channel.index * irsdk_VarTypeBytes[var->type];
+}
+
+void TelemetryHistory::update(const char *data)
+{
+  for (size_t i = 0; i < _channels.size(); i++) {
+    Channel &channel = _channels[i];
+    if (channel.offset < 0) {
+      channel.pyramid.push(Nan);
+      continue;
+    }
+
+    const char *value = data + channel.offset;
+    float v;
+    switch (channel.varType) {
+      case irsdk_char:
+      case irsdk_bool:
+        v = (float)*(const unsigned char *)value;
+        break;
+      case irsdk_int:
+      case irsdk_bitField: {
+        int n;
+        memcpy(&n, value, sizeof(n));
+        v = (float)n;
+        break;
+      }
+      case irsdk_double: {
+        double d;
+        memcpy(&d, value, sizeof(d));
+        v = (float)d;
+        break;
+      }
+      default:
+        memcpy(&v, value, sizeof(v));
+        break;
+    }
+    channel.pyramid.push(v);
+  }
+}
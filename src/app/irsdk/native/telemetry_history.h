@@ -0,0 +1,103 @@
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+#include <string>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+
+// Level of detail pyramid over one channel. Level k holds the min, max and
+// mean of every aligned run of 2^k samples, so a graph of any range at any
+// zoom is drawn from at most as many buckets as it has pixels. Every sample
+// updates one running bucket per level, storing it once it's full.
+//
+// Memory is bounded: once the finest kept level holds more than capacity
+// buckets it's dropped and the next one up becomes the finest, so a long
+// stint just loses its finest detail. NaN samples are left out of the
+// aggregates.
+class LodPyramid
+{
+public:
+  struct Bucket
+  {
+    float min;
+    float max;
+    float mean;
+  };
+
+  explicit LodPyramid(int capacity);
+
+  void push(float value);
+
+  // Samples pushed in total
+  long long length() const { return _length; }
+  // Finest level still kept
+  int baseLevel() const { return _base; }
+
+  // Buckets covering samples [from, to), at the finest level that needs no
+  // more than maxBuckets of them. Buckets are aligned to their level, so the
+  // first may start before from (its sample index goes in first) and the
+  // last may be partial. Returns the level, samples per bucket is 1 << level.
+  int query(long long from, long long to, int maxBuckets, std::vector<Bucket> *out, long long *first) const;
+
+private:
+  struct Acc
+  {
+    float min;
+    float max;
+    double sum;
+    int count; // Samples that weren't NaN
+  };
+
+  static void add(Acc *acc, const Acc &other);
+  Acc bucket(int level, long long index) const;
+
+  std::vector<std::vector<Bucket> > _levels;
+  std::vector<Acc> _running;
+  int _capacity;
+  int _base;
+  long long _length;
+};
+
+// Pyramids of the channels JS asked for, sampled on every processed line.
+// A channel whose var isn't in the session records NaN so that channels
+// added together stay sample aligned; add SessionTime as a channel to get
+// the x axis.
+class TelemetryHistory
+{
+public:
+  static const int DefaultCapacity = 1 << 18;
+
+  TelemetryHistory();
+
+  int add(const char *name, int index, int capacity);
+  bool remove(int id);
+  int size() const { return (int)_channels.size(); }
+  const LodPyramid *find(int id) const;
+
+  // add() binds against the last table given, so unbindVars() before it goes away
+  void bindVars(const irsdk_varHeader *vars, int count);
+  void unbindVars() { bindVars(NULL, 0); }
+  void update(const char *data);
+
+private:
+  struct Channel
+  {
+    int id;
+    std::string name;
+    int index;
+    int varType;
+    int offset; // -1 while unbound
+    LodPyramid pyramid;
+  };
+
+  void bind(Channel &channel);
+
+  std::vector<Channel> _channels;
+  int _nextId;
+
+  const irsdk_varHeader *_vars;
+  int _varCount;
+};
+
+#endif
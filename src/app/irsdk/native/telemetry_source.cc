@@ -0,0 +1,159 @@
+#include <atomic>
+#include <chrono>
+#include <limits.h>
+#include <string.h>
+#include <thread>
+
+#include "./telemetry_source.h"
+#include "./trace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// Without a data valid event the tick counters are polled at this interval
+static const int pollIntervalUs = 500;
+
+TelemetrySource::TelemetrySource()
+  : _header(NULL)
+  , _lastTickCount(INT_MAX)
+  , _connection(0)
+  , _wasConnected(false)
+#ifdef _WIN32
+  , _dataValidEvent(NULL)
+#endif
+{
+}
+
+bool TelemetrySource::open(const char *name)
+{
+  close();
+  if (!_memory.open(name, true)) return false;
+  if (_memory.size() < (int)sizeof(irsdk_header)) {
+    _memory.close();
+    return false;
+  }
+
+  _header = reinterpret_cast<const irsdk_header *>(_memory.data());
+  _lastTickCount = INT_MAX;
+#ifdef _WIN32
+  // Only the sim's own mapping comes with an event, anything else is polled
+  if (0 == strcmp(name, IRSDK_MEMMAPFILENAME)) {
+    _dataValidEvent = OpenEventA(SYNCHRONIZE, FALSE, IRSDK_DATAVALIDEVENTNAME);
+  }
+#endif
+  return true;
+}
+
+void TelemetrySource::close()
+{
+#ifdef _WIN32
+  if (_dataValidEvent) CloseHandle(_dataValidEvent);
+  _dataValidEvent = NULL;
+#endif
+  _memory.close();
+  _header = NULL;
+  _lastTickCount = INT_MAX;
+  _wasConnected = false;
+}
+
+bool TelemetrySource::isConnected() const
+{
+  return _header && (_header->status & irsdk_stConnected) && isValidLayout();
+}
+
+bool TelemetrySource::isValidLayout() const
+{
+  const irsdk_header *h = _header;
+  int size = _memory.size();
+  if (h->numBuf < 1 || h->numBuf > IRSDK_MAX_BUFS || h->bufLen <= 0) return false;
+  if (h->numVars < 0 || h->varHeaderOffset < 0) return false;
+  if (h->varHeaderOffset + (long long)h->numVars * (long long)sizeof(irsdk_varHeader) > size) return false;
+  if (h->sessionInfoOffset < 0 || h->sessionInfoOffset + (long long)h->sessionInfoLen > size) return false;
+  for (int i = 0; i < h->numBuf; i++) {
+    if (h->varBuf[i].bufOffset < 0 || h->varBuf[i].bufOffset + (long long)h->bufLen > size) return false;
+  }
+  return true;
+}
+
+const irsdk_varHeader *TelemetrySource::vars() const
+{
+  if (!_header) return NULL;
+  return reinterpret_cast<const irsdk_varHeader *>(_memory.data() + _header->varHeaderOffset);
+}
+
+const char *TelemetrySource::sessionInfo() const
+{
+  if (!_header) return NULL;
+  return _memory.data() + _header->sessionInfoOffset;
+}
+
+bool TelemetrySource::getNewData(char *data)
+{
+  if (!isConnected()) {
+    _lastTickCount = INT_MAX;
+    _wasConnected = false;
+    return false;
+  }
+  if (!_wasConnected) {
+    _wasConnected = true;
+    _connection++;
+  }
+
+  const irsdk_header *h = _header;
+  int latest = 0;
+  for (int i = 1; i < h->numBuf; i++) {
+    if (h->varBuf[latest].tickCount < h->varBuf[i].tickCount) latest = i;
+  }
+
+  int tickCount = h->varBuf[latest].tickCount;
+  if (tickCount < _lastTickCount) {
+    // Older than the last line: the producer restarted, treat it as a reconnect
+    if (_lastTickCount != INT_MAX) _connection++;
+  } else if (tickCount == _lastTickCount) {
+    return false;
+  }
+
+  if (!data) {
+    _lastTickCount = tickCount;
+    return true;
+  }
+
+  // Try twice to get the data out before the producer laps us
+  TRACE_SPAN("copyLine");
+  for (int attempt = 0; attempt < 2; attempt++) {
+    int current = h->varBuf[latest].tickCount;
+    memcpy(data, _memory.data() + h->varBuf[latest].bufOffset, h->bufLen);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (current == h->varBuf[latest].tickCount) {
+      _lastTickCount = current;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TelemetrySource::waitForData(int timeoutMs, char *data)
+{
+  if (!_header) return false;
+  if (getNewData(data)) return true;
+
+#ifdef _WIN32
+  if (_dataValidEvent) {
+    {
+      TRACE_SPAN("waitForLine");
+      WaitForSingleObject(_dataValidEvent, timeoutMs);
+    }
+    return getNewData(data);
+  }
+#endif
+  TRACE_SPAN("waitForLine");
+
+  std::chrono::steady_clock::time_point deadline =
+    std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+  while (std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::microseconds(pollIntervalUs));
+    if (getNewData(data)) return true;
+  }
+  return false;
+}
@@ -0,0 +1,52 @@
+#ifndef TELEMETRY_SOURCE_H
+#define TELEMETRY_SOURCE_H
+
+#include "./lib/irsdk_defines.h"
+#include "./shared_memory.h"
+
+// Reads the sim's memory mapped file by name, the same way irsdk_utils does but
+// without its globals, so a process can hold more than one of these and the
+// relay builds on POSIX against the simulated producer.
+class TelemetrySource
+{
+public:
+  TelemetrySource();
+  ~TelemetrySource() { close(); }
+
+  bool open(const char *name);
+  void close();
+  bool isOpen() const { return _memory.isOpen(); }
+
+  // True while the producer reports itself connected
+  bool isConnected() const;
+
+  // Bumped whenever the producer (re)connects, the var table may have changed
+  int connection() const { return _connection; }
+
+  // Waits up to timeoutMs for a line newer than the last one and copies it
+  // into data, which must hold header()->bufLen bytes
+  bool waitForData(int timeoutMs, char *data);
+  bool getNewData(char *data);
+  int tickCount() const { return _lastTickCount; }
+
+  const irsdk_header *header() const { return _header; }
+  const irsdk_varHeader *vars() const;
+  const char *sessionInfo() const;
+
+private:
+  TelemetrySource(const TelemetrySource &);
+  TelemetrySource &operator=(const TelemetrySource &);
+
+  bool isValidLayout() const;
+
+  SharedMemory _memory;
+  const irsdk_header *_header;
+  int _lastTickCount;
+  int _connection;
+  bool _wasConnected;
+#ifdef _WIN32
+  void *_dataValidEvent;
+#endif
+};
+
+#endif
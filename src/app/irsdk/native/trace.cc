@@ -0,0 +1,206 @@
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+
+#include "./trace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+std::atomic<bool> traceOn(false);
+
+namespace
+{
+const int RingEvents = 16384;
+
+struct TraceEvent
+{
+  std::atomic<const char *> name;
+  std::atomic<long long> start;
+  std::atomic<long long> duration;
+};
+
+// One writer, the thread that owns it, and any number of dumps reading it.
+// A dump keeps the events the writer can't have touched while it was copying.
+struct TraceRing
+{
+  std::atomic<long long> head;
+  std::atomic<long long> cleared; // Events before this were dropped by traceClear()
+  std::atomic<bool> owned;
+  std::atomic<const char *> threadName;
+  int threadId;
+  TraceEvent events[RingEvents];
+};
+
+std::mutex ringsMutex;
+// Never freed: a dump may be reading the ring of a thread that just exited,
+// and the next new thread takes it over
+std::vector<TraceRing *> rings;
+
+int currentThreadId()
+{
+#if defined(_WIN32)
+  return (int)GetCurrentThreadId();
+#elif defined(__linux__)
+  return (int)syscall(SYS_gettid);
+#else
+  static std::atomic<int> nextId(1);
+  return nextId++;
+#endif
+}
+
+TraceRing *takeRing()
+{
+  std::lock_guard<std::mutex> lock(ringsMutex);
+  TraceRing *ring = NULL;
+  for (size_t i = 0; i < rings.size() && !ring; i++) {
+    if (!rings[i]->owned.load()) ring = rings[i];
+  }
+  if (!ring) {
+    ring = new TraceRing();
+    rings.push_back(ring);
+  }
+  ring->head.store(0);
+  ring->cleared.store(0);
+  ring->threadName.store(NULL);
+  ring->threadId = currentThreadId();
+  ring->owned.store(true);
+  return ring;
+}
+
+// Gives the ring back when the thread exits. Threads that never record
+// never take one, their name waits here until they do.
+struct ThreadRing
+{
+  TraceRing *ring;
+  const char *name;
+  ThreadRing() : ring(NULL), name(NULL) {}
+  ~ThreadRing()
+  {
+    if (ring) ring->owned.store(false);
+  }
+  TraceRing *get()
+  {
+    if (!ring) {
+      ring = takeRing();
+      ring->threadName.store(name);
+    }
+    return ring;
+  }
+};
+
+thread_local ThreadRing threadRing;
+
+void appendEscaped(std::string *out, const char *text)
+{
+  for (; *text; text++) {
+    char c = *text;
+    if (c == '"' || c == '\\') out->push_back('\\');
+    if ((unsigned char)c < 0x20) continue;
+    out->push_back(c);
+  }
+}
+} // namespace
+
+void traceSetEnabled(bool enabled)
+{
+  traceOn.store(enabled, std::memory_order_relaxed);
+}
+
+void traceSetThreadName(const char *name)
+{
+  threadRing.name = name;
+  if (threadRing.ring) threadRing.ring->threadName.store(name);
+}
+
+long long traceNow()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+void traceRecord(const char *name, long long startNs, long long durationNs)
+{
+  TraceRing *ring = threadRing.get();
+  long long head = ring->head.load(std::memory_order_relaxed);
+  // A dump that sees any of the stores below also sees head move past this
+  // slot's previous event
+  std::atomic_thread_fence(std::memory_order_release);
+  TraceEvent &event = ring->events[head % RingEvents];
+  event.name.store(name, std::memory_order_relaxed);
+  event.start.store(startNs, std::memory_order_relaxed);
+  event.duration.store(durationNs, std::memory_order_relaxed);
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+std::string traceDumpJson()
+{
+  std::string out = "{\"traceEvents\":[";
+  bool first = true;
+  char buffer[160];
+  int pid = (int)getpid();
+
+  std::lock_guard<std::mutex> lock(ringsMutex);
+  std::vector<const char *> names(RingEvents);
+  std::vector<long long> starts(RingEvents);
+  std::vector<long long> durations(RingEvents);
+  for (size_t r = 0; r < rings.size(); r++) {
+    TraceRing *ring = rings[r];
+    long long head = ring->head.load(std::memory_order_acquire);
+    long long from = head > RingEvents ? head - RingEvents : 0;
+    long long cleared = ring->cleared.load(std::memory_order_relaxed);
+    if (from < cleared) from = cleared < head ? cleared : head;
+    for (long long i = from; i < head; i++) {
+      const TraceEvent &event = ring->events[i % RingEvents];
+      names[i - from] = event.name.load(std::memory_order_relaxed);
+      starts[i - from] = event.start.load(std::memory_order_relaxed);
+      durations[i - from] = event.duration.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Events the writer may have overwritten meanwhile, including the one it
+    // may be in the middle of
+    long long now = ring->head.load(std::memory_order_relaxed);
+    long long valid = now - RingEvents + 1 > from ? now - RingEvents + 1 : from;
+
+    const char *threadName = ring->threadName.load();
+    if (threadName) {
+      out += first ? "" : ",";
+      first = false;
+      snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"",
+               pid, ring->threadId);
+      out += buffer;
+      appendEscaped(&out, threadName);
+      out += "\"}}";
+    }
+
+    for (long long i = valid; i < head; i++) {
+      out += first ? "" : ",";
+      first = false;
+      out += "{\"ph\":\"X\",\"cat\":\"irsdk\",\"name\":\"";
+      appendEscaped(&out, names[i - from]);
+      snprintf(buffer, sizeof(buffer), "\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", pid, ring->threadId,
+               starts[i - from] / 1000.0, durations[i - from] / 1000.0);
+      out += buffer;
+    }
+  }
+  out += "],\"displayTimeUnit\":\"ms\"}";
+  return out;
+}
+
+void traceClear()
+{
+  std::lock_guard<std::mutex> lock(ringsMutex);
+  // The owning threads keep writing at their head, dumps start from here on
+  for (size_t r = 0; r < rings.size(); r++) {
+    rings[r]->cleared.store(rings[r]->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,57 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <string>
+
+// Span timings of the native pipeline, dumped as Chrome trace-event JSON that
+// Perfetto or chrome://tracing open next to the Electron traces.
+//
+// Every thread records into a ring of its own, so recording takes no lock and
+// a dump only sees the last RingEvents spans per thread. Off by default; a
+// disabled span costs one relaxed load.
+extern std::atomic<bool> traceOn;
+
+inline bool traceEnabled() { return traceOn.load(std::memory_order_relaxed); }
+void traceSetEnabled(bool enabled);
+
+// Shows up as the thread's name in the dump. Only kept until the thread
+// records its first span, so it costs nothing while tracing is off.
+void traceSetThreadName(const char *name);
+
+// Steady clock in nanoseconds, the clock Chrome's trace timestamps use too
+long long traceNow();
+// name must outlive the dump, i.e. a string literal
+void traceRecord(const char *name, long long startNs, long long durationNs);
+
+// Every span still in the rings, oldest first per thread
+std::string traceDumpJson();
+void traceClear();
+
+// Records the time until the end of the scope
+class TraceSpan
+{
+public:
+  explicit TraceSpan(const char *name)
+    : _name(traceEnabled() ? name : NULL)
+    , _start(_name ? traceNow() : 0)
+  {
+  }
+  ~TraceSpan()
+  {
+    if (_name) traceRecord(_name, _start, traceNow() - _start);
+  }
+
+private:
+  TraceSpan(const TraceSpan &);
+  TraceSpan &operator=(const TraceSpan &);
+
+  const char *_name;
+  long long _start;
+};
+
+#define TRACE_SPAN_CONCAT2(a, b) a##b
+#define TRACE_SPAN_CONCAT(a, b) TRACE_SPAN_CONCAT2(a, b)
+#define TRACE_SPAN(name) TraceSpan TRACE_SPAN_CONCAT(traceSpan, __LINE__)(name)
+
+#endif
@@ -0,0 +1,403 @@
+#include <ctype.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./trigger_set.h"
+#include "./var_lookup.h"
+
+// Deepest evaluation stack an expression may need
+static const int maxStackDepth = 32;
+
+// Recursive descent straight to postfix bytecode, no syntax tree
+class TriggerSet::Compiler
+{
+public:
+  Compiler(const char *source, Trigger *trigger)
+    : _source(source)
+    , _pos(source)
+    , _trigger(trigger)
+    , _depth(0)
+  {
+  }
+
+  bool compile(std::string *error)
+  {
+    skipSpace();
+    if (!*_pos) fail("empty expression");
+    else parseOr();
+    skipSpace();
+    if (_error.empty() && *_pos) fail("unexpected input");
+
+    if (!_error.empty()) {
+      if (error) {
+        char at[32];
+        snprintf(at, sizeof(at), " at column %d", (int)(_pos - _source) + 1);
+        *error = _error + at;
+      }
+      return false;
+    }
+    return true;
+  }
+
+private:
+  void parseOr()
+  {
+    parseAnd();
+    while (_error.empty() && accept("||")) {
+      parseAnd();
+      emit(Op_Or);
+    }
+  }
+
+  void parseAnd()
+  {
+    parseCompare();
+    while (_error.empty() && accept("&&")) {
+      parseCompare();
+      emit(Op_And);
+    }
+  }
+
+  void parseCompare()
+  {
+    parseSum();
+    if (!_error.empty()) return;
+
+    int op;
+    if (accept("<=")) op = Op_Le;
+    else if (accept(">=")) op = Op_Ge;
+    else if (accept("==")) op = Op_Eq;
+    else if (accept("!=")) op = Op_Ne;
+    else if (accept("<")) op = Op_Lt;
+    else if (accept(">")) op = Op_Gt;
+    else return;
+
+    parseSum();
+    emit(op);
+  }
+
+  void parseSum()
+  {
+    parseProduct();
+    while (_error.empty()) {
+      if (accept("+")) {
+        parseProduct();
+        emit(Op_Add);
+      } else if (accept("-")) {
+        parseProduct();
+        emit(Op_Sub);
+      } else {
+        return;
+      }
+    }
+  }
+
+  void parseProduct()
+  {
+    parseUnary();
+    while (_error.empty()) {
+      if (accept("*")) {
+        parseUnary();
+        emit(Op_Mul);
+      } else if (accept("/")) {
+        parseUnary();
+        emit(Op_Div);
+      } else {
+        return;
+      }
+    }
+  }
+
+  void parseUnary()
+  {
+    // "!=" never starts an operand, so a single '!' is always a not
+    if (accept("!")) {
+      parseUnary();
+      emit(Op_Not);
+    } else if (accept("-")) {
+      parseUnary();
+      emit(Op_Neg);
+    } else {
+      parsePrimary();
+    }
+  }
+
+  void parsePrimary()
+  {
+    skipSpace();
+    if (accept("(")) {
+      parseOr();
+      if (_error.empty() && !accept(")")) fail("expected ')'");
+      return;
+    }
+
+    if (isdigit((unsigned char)*_pos) || *_pos == '.') {
+      char *end;
+      double value = strtod(_pos, &end);
+      if (end == _pos) {
+        fail("bad number");
+        return;
+      }
+      _pos = end;
+      emitConst(value);
+      return;
+    }
+
+    if (!isalpha((unsigned char)*_pos) && *_pos != '_') {
+      fail(*_pos ? "expected a value" : "unexpected end of expression");
+      return;
+    }
+
+    const char *start = _pos;
+    while (isalnum((unsigned char)*_pos) || *_pos == '_') _pos++;
+    std::string name(start, _pos - start);
+
+    if (name == "true" || name == "false") {
+      emitConst(name == "true" ? 1.0 : 0.0);
+      return;
+    }
+    if (name.size() >= IRSDK_MAX_STRING) {
+      fail("variable name too long");
+      return;
+    }
+
+    int index = 0;
+    if (accept("[")) {
+      skipSpace();
+      if (!isdigit((unsigned char)*_pos)) {
+        fail("expected an array index");
+        return;
+      }
+      char *end;
+      long value = strtol(_pos, &end, 10);
+      // Out of range values saturate at LONG_MAX, rejected here too
+      if (value < 0 || value > INT_MAX) {
+        fail("array index out of range");
+        return;
+      }
+      index = (int)value;
+      _pos = end;
+      if (!accept("]")) {
+        fail("expected ']'");
+        return;
+      }
+    }
+
+    VarRef ref;
+    ref.name = name;
+    ref.index = index;
+    ref.instr = (int)_trigger->code.size();
+    _trigger->vars.push_back(ref);
+    emit(Op_Var);
+  }
+
+  void emitConst(double value)
+  {
+    emit(Op_Const);
+    _trigger->code.back().value = value;
+  }
+
+  void emit(int op)
+  {
+    if (!_error.empty()) return;
+
+    Instr instr;
+    instr.op = op;
+    instr.varType = irsdk_double;
+    instr.offset = -1;
+    instr.value = 0.0;
+    _trigger->code.push_back(instr);
+
+    if (op == Op_Const || op == Op_Var) {
+      if (++_depth > maxStackDepth) fail("expression too complex");
+    } else if (op != Op_Neg && op != Op_Not) {
+      _depth--;
+    }
+  }
+
+  bool accept(const char *token)
+  {
+    skipSpace();
+    size_t len = strlen(token);
+    if (strncmp(_pos, token, len) != 0) return false;
+    _pos += len;
+    return true;
+  }
+
+  void skipSpace()
+  {
+    while (isspace((unsigned char)*_pos)) _pos++;
+  }
+
+  void fail(const char *message)
+  {
+    if (_error.empty()) _error = message;
+  }
+
+  const char *_source;
+  const char *_pos;
+  Trigger *_trigger;
+  int _depth;
+  std::string _error;
+};
+
+TriggerSet::TriggerSet()
+  : _nextId(1)
+  , _vars(NULL)
+  , _varCount(0)
+{
+}
+
+int TriggerSet::add(const char *source, std::string *error)
+{
+  if (!source) return -1;
+
+  Trigger trigger;
+  trigger.id = _nextId;
+  trigger.bound = false;
+  trigger.active = false;
+
+  Compiler compiler(source, &trigger);
+  if (!compiler.compile(error)) return -1;
+
+  _nextId++;
+  bind(trigger);
+  _triggers.push_back(trigger);
+  return trigger.id;
+}
+
+bool TriggerSet::remove(int id)
+{
+  for (size_t i = 0; i < _triggers.size(); i++) {
+    if (_triggers[i].id != id) continue;
+    _triggers.erase(_triggers.begin() + i);
+    return true;
+  }
+  return false;
+}
+
+void TriggerSet::clear()
+{
+  _triggers.clear();
+  _fired.clear();
+}
+
+void TriggerSet::bindVars(const irsdk_varHeader *vars, int count)
+{
+  _vars = vars;
+  _varCount = count;
+  for (size_t i = 0; i < _triggers.size(); i++) {
+    bind(_triggers[i]);
+    // A new connection starts from scratch, conditions already true fire again.
+    // The table can be mapped at the same address as the last one, so this
+    // can't go by the pointer.
+    _triggers[i].active = false;
+  }
+}
+
+void TriggerSet::bind(Trigger &trigger)
+{
+  // Not connected, update() skips it until the next bindVars()
+  trigger.bound = _vars != NULL;
+  if (!_vars) return;
+
+  for (size_t i = 0; i < trigger.vars.size(); i++) {
+    const VarRef &ref = trigger.vars[i];
+    Instr &instr = trigger.code[ref.instr];
+    const irsdk_varHeader *var = findVarHeader(_vars, _varCount, ref.name.c_str());
+
+    if (!var || ref.index < 0 || ref.index >= var->count) {
+      // Left unbound until a session that has it
+      instr.offset = -1;
+      trigger.bound = false;
+      continue;
+    }
+    instr.varType = var->type;
+    instr.offset = var->offset + ref.index * irsdk_VarTypeBytes[var->type];
+  }
+}
+
+void TriggerSet::update(const char *data)
+{
+  if (!data) return;
+
+  for (size_t i = 0; i < _triggers.size(); i++) {
+    Trigger &trigger = _triggers[i];
+    if (!trigger.bound) continue;
+
+    bool active = evaluate(trigger, data) != 0.0;
+    if (active && !trigger.active) _fired.push_back(trigger.id);
+    trigger.active = active;
+  }
+}
+
+void TriggerSet::drainFired(std::vector<int> *out)
+{
+  out->swap(_fired);
+  _fired.clear();
+}
+
+double TriggerSet::evaluate(const Trigger &trigger, const char *data)
+{
+  double stack[maxStackDepth];
+  int sp = 0;
+
+  const Instr *code = trigger.code.data();
+  const Instr *end = code + trigger.code.size();
+  for (; code != end; code++) {
+    switch (code->op) {
+    case Op_Const:
+      stack[sp++] = code->value;
+      break;
+    case Op_Var: {
+      const char *src = data + code->offset;
+      switch (code->varType) {
+      case irsdk_char:
+      case irsdk_bool:
+        stack[sp++] = (unsigned char)*src;
+        break;
+      case irsdk_int:
+      case irsdk_bitField:
+        stack[sp++] = *reinterpret_cast<const int *>(src);
+        break;
+      case irsdk_float:
+        stack[sp++] = *reinterpret_cast<const float *>(src);
+        break;
+      default:
+        stack[sp++] = *reinterpret_cast<const double *>(src);
+        break;
+      }
+      break;
+    }
+    case Op_Neg:
+      stack[sp - 1] = -stack[sp - 1];
+      break;
+    case Op_Not:
+      stack[sp - 1] = stack[sp - 1] == 0.0 ? 1.0 : 0.0;
+      break;
+    default: {
+      double rhs = stack[--sp];
+      double &lhs = stack[sp - 1];
+      switch (code->op) {
+      case Op_Add: lhs = lhs + rhs; break;
+      case Op_Sub: lhs = lhs - rhs; break;
+      case Op_Mul: lhs = lhs * rhs; break;
+      case Op_Div: lhs = rhs != 0.0 ? lhs / rhs : 0.0; break;
+      case Op_Lt: lhs = lhs < rhs; break;
+      case Op_Le: lhs = lhs <= rhs; break;
+      case Op_Gt: lhs = lhs > rhs; break;
+      case Op_Ge: lhs = lhs >= rhs; break;
+      case Op_Eq: lhs = lhs == rhs; break;
+      case Op_Ne: lhs = lhs != rhs; break;
+      case Op_And: lhs = lhs != 0.0 && rhs != 0.0; break;
+      case Op_Or: lhs = lhs != 0.0 || rhs != 0.0; break;
+      }
+      break;
+    }
+    }
+  }
+
+  return sp > 0 ? stack[sp - 1] : 0.0;
+}
@@ -0,0 +1,102 @@
+#ifndef TRIGGER_SET_H
+#define TRIGGER_SET_H
+
+#include <string>
+#include <vector>
+
+#include "./lib/irsdk_defines.h"
+
+// User defined alerts such as "Speed > 80 && Brake > 0.5", compiled once to
+// a flat stack bytecode. Variable names are resolved to line buffer offsets
+// on every new connection, so a tick is a straight walk over the bytecode.
+//
+// Grammar, loosely C:
+//   expr    := or
+//   or      := and ('||' and)*
+//   and     := compare ('&&' compare)*
+//   compare := sum (('<' | '<=' | '>' | '>=' | '==' | '!=') sum)?
+//   sum     := product (('+' | '-') product)*
+//   product := unary (('*' | '/') unary)*
+//   unary   := ('!' | '-') unary | primary
+//   primary := number | 'true' | 'false' | name ('[' index ']')? | '(' expr ')'
+//
+// A trigger fires when its expression goes from false (zero) to true.
+class TriggerSet
+{
+public:
+  TriggerSet();
+
+  // Returns the trigger id, or -1 with a message in error when it doesn't parse
+  int add(const char *source, std::string *error);
+  bool remove(int id);
+  void clear();
+  int size() const { return (int)_triggers.size(); }
+
+  // Call on every new connection, triggers start inactive again. add() binds
+  // against the last table given, so unbindVars() before it goes away.
+  void bindVars(const irsdk_varHeader *vars, int count);
+  void unbindVars() { bindVars(NULL, 0); }
+  void update(const char *data);
+
+  // Ids of the triggers that fired since the last call, in firing order
+  void drainFired(std::vector<int> *out);
+
+private:
+  enum Op
+  {
+    Op_Const = 0,
+    Op_Var,
+    Op_Neg,
+    Op_Not,
+    Op_Add,
+    Op_Sub,
+    Op_Mul,
+    Op_Div,
+    Op_Lt,
+    Op_Le,
+    Op_Gt,
+    Op_Ge,
+    Op_Eq,
+    Op_Ne,
+    Op_And,
+    Op_Or,
+  };
+
+  struct Instr
+  {
+    int op;
+    int varType;   // Op_Var only, irsdk_VarType
+    int offset;    // Op_Var only, byte offset into the line
+    double value;  // Op_Const only
+  };
+
+  struct VarRef
+  {
+    std::string name;
+    int index;
+    int instr; // Position of the Op_Var to patch when binding
+  };
+
+  struct Trigger
+  {
+    int id;
+    std::vector<Instr> code;
+    std::vector<VarRef> vars;
+    bool bound; // false while any variable is missing from the session
+    bool active;
+  };
+
+  class Compiler;
+
+  void bind(Trigger &trigger);
+  static double evaluate(const Trigger &trigger, const char *data);
+
+  std::vector<Trigger> _triggers;
+  std::vector<int> _fired;
+  int _nextId;
+
+  const irsdk_varHeader *_vars;
+  int _varCount;
+};
+
+#endif
@@ -0,0 +1,297 @@
+// irsdk_trigger_test: compiles trigger expressions with TriggerSet and checks
+// what they evaluate to against a small synthetic line, and which ones are
+// refused: operator precedence, bad syntax, variables the session doesn't
+// have and array indices out of range.
+//
+// Usage: irsdk_trigger_test [--case <name>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "./trigger_set.h"
+
+static void usage()
+{
+  fprintf(stderr, "Usage: irsdk_trigger_test [--case <name>]\n");
+}
+
+// ---------------------------
+// Synthetic session
+// ---------------------------
+// Speed (float), Gear (int), OnPitRoad (bool), CarIdxLap (int[4])
+class Line
+{
+public:
+  Line()
+    : _bufLen(0)
+  {
+    _speed = add("Speed", irsdk_float, 1);
+    _gear = add("Gear", irsdk_int, 1);
+    _onPit = add("OnPitRoad", irsdk_bool, 1);
+    _carLap = add("CarIdxLap", irsdk_int, 4);
+    _data.assign(_bufLen, 0);
+  }
+
+  const irsdk_varHeader *vars() const { return &_vars[0]; }
+  int count() const { return (int)_vars.size(); }
+  const char *data() const { return &_data[0]; }
+
+  void set(float speed, int gear, bool onPit)
+  {
+    memcpy(&_data[_speed], &speed, sizeof(speed));
+    memcpy(&_data[_gear], &gear, sizeof(gear));
+    _data[_onPit] = onPit;
+    for (int car = 0; car < 4; car++) {
+      int lap = 10 + car;
+      memcpy(&_data[_carLap + car * sizeof(int)], &lap, sizeof(lap));
+    }
+  }
+
+private:
+  int add(const char *name, int type, int count)
+  {
+    irsdk_varHeader var;
+    memset(&var, 0, sizeof(var));
+    var.type = type;
+    var.offset = _bufLen;
+    var.count = count;
+    strncpy(var.name, name, IRSDK_MAX_STRING - 1);
+    _vars.push_back(var);
+    _bufLen += count * irsdk_VarTypeBytes[type];
+    return var.offset;
+  }
+
+  std::vector<irsdk_varHeader> _vars;
+  std::vector<char> _data;
+  int _bufLen;
+  int _speed, _gear, _onPit, _carLap;
+};
+
+static bool fail(std::string *error, const std::string &message)
+{
+  *error = message;
+  return false;
+}
+
+// Whether source fires on the first line, i.e. evaluates to true
+static bool fires(const char *source, const Line &line, std::string *error)
+{
+  TriggerSet triggers;
+  triggers.bindVars(line.vars(), line.count());
+  std::string compileError;
+  if (triggers.add(source, &compileError) < 0) {
+    *error = std::string("\"") + source + "\" didn't compile: " + compileError;
+    return false;
+  }
+  triggers.update(line.data());
+  std::vector<int> fired;
+  triggers.drainFired(&fired);
+  return !fired.empty();
+}
+
+struct Expectation
+{
+  const char *source;
+  bool value;
+};
+
+static bool evaluateAll(const Expectation *expectations, size_t count, const Line &line, std::string *error)
+{
+  for (size_t i = 0; i < count; i++) {
+    std::string compileError;
+    bool value = fires(expectations[i].source, line, &compileError);
+    if (!compileError.empty()) return fail(error, compileError);
+    if (value != expectations[i].value) {
+      return fail(error, std::string("\"") + expectations[i].source + "\" is " + (value ? "true" : "false"));
+    }
+  }
+  return true;
+}
+
+struct Refusal
+{
+  const char *source;
+  const char *message; // Start of the error add() gives
+};
+
+static bool refuseAll(const Refusal *refusals, size_t count, std::string *error)
+{
+  for (size_t i = 0; i < count; i++) {
+    TriggerSet triggers;
+    std::string message;
+    if (triggers.add(refusals[i].source, &message) >= 0) {
+      return fail(error, std::string("\"") + refusals[i].source + "\" compiled");
+    }
+    if (0 != message.compare(0, strlen(refusals[i].message), refusals[i].message)) {
+      return fail(error, std::string("\"") + refusals[i].source + "\" gave \"" + message + "\"");
+    }
+  }
+  return true;
+}
+
+// ---------------------------
+// Cases
+// ---------------------------
+static bool precedence(std::string *error)
+{
+  static const Expectation expectations[] = {
+    { "1 + 2 * 3 == 7", true },
+    { "(1 + 2) * 3 == 9", true },
+    { "10 - 4 - 3 == 3", true },
+    { "8 / 4 / 2 == 1", true },
+    { "-2 * -3 == 6", true },
+    { "--1 == 1", true },
+    { "!0 && 0 || 1", true },
+    { "0 || 1 && 0", false },
+    { "!1 == 0", true },
+    { "1 / 0 == 0", true },
+    { "2 < 3 && 3 <= 3 && 4 > 3 && 3 >= 3 && 3 != 4", true },
+    { "Speed > 30 && Gear == 3", true },
+    { "Speed * 2 > 100", true },
+    { "OnPitRoad || Gear < 0", false },
+    { "CarIdxLap[2] == 12 && CarIdxLap == 10", true },
+    { "true && !false", true },
+  };
+  Line line;
+  line.set(55.0f, 3, false);
+  return evaluateAll(expectations, sizeof(expectations) / sizeof(expectations[0]), line, error);
+}
+
+static bool badSyntax(std::string *error)
+{
+  static const Refusal refusals[] = {
+    { "", "empty expression" },
+    { "   ", "empty expression" },
+    { "Speed >", "unexpected end of expression" },
+    { "(1 + 2", "expected ')'" },
+    { "1 2", "unexpected input" },
+    { "1 < 2 < 3", "unexpected input" },
+    { "Speed @ 2", "unexpected input" },
+    { "* 2", "expected a value" },
+    { "CarIdxLap[", "expected an array index" },
+    { "CarIdxLap[x]", "expected an array index" },
+    { "CarIdxLap[-1]", "expected an array index" },
+    { "CarIdxLap[1", "expected ']'" },
+  };
+  if (!refuseAll(refusals, sizeof(refusals) / sizeof(refusals[0]), error)) return false;
+
+  // Deeper than the evaluation stack
+  std::string deep = "1";
+  for (int i = 0; i < 40; i++) deep = "1 + (" + deep + ")";
+  std::string tooLong = std::string(IRSDK_MAX_STRING, 'a') + " > 0";
+  const Refusal generated[] = {
+    { deep.c_str(), "expression too complex" },
+    { tooLong.c_str(), "variable name too long" },
+  };
+  return refuseAll(generated, sizeof(generated) / sizeof(generated[0]), error);
+}
+
+// Variables the session doesn't have compile, but stay unbound and never fire
+// until a session that has them
+static bool unknownVars(std::string *error)
+{
+  Line line;
+  line.set(55.0f, 3, false);
+
+  TriggerSet triggers;
+  triggers.bindVars(line.vars(), line.count());
+  std::string message;
+  int missing = triggers.add("NotAVar > -1000000 || 1", &message);
+  int pastEnd = triggers.add("CarIdxLap[4] > -1000000 || 1", &message);
+  int known = triggers.add("Speed > 0", &message);
+  if (missing < 0 || pastEnd < 0 || known < 0) return fail(error, "didn't compile: " + message);
+
+  triggers.update(line.data());
+  std::vector<int> fired;
+  triggers.drainFired(&fired);
+  if (fired.size() != 1 || fired[0] != known) return fail(error, "an unbound trigger fired");
+
+  // Nothing bound while not connected
+  triggers.unbindVars();
+  triggers.update(line.data());
+  fired.clear();
+  triggers.drainFired(&fired);
+  if (!fired.empty()) return fail(error, "fired while unbound");
+
+  // A new connection starts every trigger inactive, so it fires again
+  triggers.bindVars(line.vars(), line.count());
+  triggers.update(line.data());
+  triggers.drainFired(&fired);
+  if (fired.size() != 1 || fired[0] != known) return fail(error, "didn't fire again on a new connection");
+  return true;
+}
+
+static bool indexRange(std::string *error)
+{
+  static const Refusal refusals[] = {
+    // -1 once truncated to int where long is 64 bits
+    { "CarIdxLap[4294967295] > 0", "array index out of range" },
+    { "CarIdxLap[2147483648] > 0", "array index out of range" },
+    { "CarIdxLap[99999999999999999999999] > 0", "array index out of range" },
+  };
+  if (!refuseAll(refusals, sizeof(refusals) / sizeof(refusals[0]), error)) return false;
+
+  // Valid as an int, but past any var's count: never bound
+  static const Expectation expectations[] = {
+    { "CarIdxLap[2147483647] == 0 || CarIdxLap[3] == 13", false },
+    { "CarIdxLap[3] == 13", true },
+  };
+  Line line;
+  line.set(0.0f, 0, false);
+  return evaluateAll(expectations, sizeof(expectations) / sizeof(expectations[0]), line, error);
+}
+
+struct CaseInfo
+{
+  const char *name;
+  bool (*run)(std::string *error);
+};
+
+static const CaseInfo cases[] = {
+  { "precedence", &precedence },
+  { "badSyntax", &badSyntax },
+  { "unknownVars", &unknownVars },
+  { "indexRange", &indexRange },
+};
+
+int main(int argc, char **argv)
+{
+  std::string only;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      usage();
+      return 2;
+    }
+    if (0 == strcmp(arg, "--case")) only = value;
+    else {
+      usage();
+      return 2;
+    }
+    i++;
+  }
+
+  int failed = 0;
+  int ran = 0;
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    const CaseInfo &info = cases[c];
+    if (!only.empty() && only != info.name) continue;
+    ran++;
+
+    std::string error;
+    bool ok = info.run(&error);
+    if (ok) printf("ok   %s\n", info.name);
+    else printf("FAIL %s: %s\n", info.name, error.c_str());
+    if (!ok) failed++;
+  }
+  if (!ran) {
+    usage();
+    return 2;
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,21 @@
+#ifndef VAR_LOOKUP_H
+#define VAR_LOOKUP_H
+
+#include <string.h>
+
+#include "./lib/irsdk_defines.h"
+
+// Linear lookup over a variable header table. Engines call this once per
+// connection and keep the offsets, never per tick.
+inline const irsdk_varHeader *findVarHeader(const irsdk_varHeader *vars, int count, const char *name)
+{
+  if (!vars || !name) return NULL;
+  for (int i = 0; i < count; i++) {
+    if (0 == strncmp(name, vars[i].name, IRSDK_MAX_STRING)) {
+      return &vars[i];
+    }
+  }
+  return NULL;
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef VIEW_COLUMN_H
+#define VIEW_COLUMN_H
+
+enum ViewColumnType
+{
+  ViewColumn_Int32 = 0,
+  ViewColumn_Float32,
+  ViewColumn_Float64
+};
+
+// Describes one typed-array view over an engine's flat storage block. The
+// binding creates the backing ArrayBuffer once and the engine writes into it
+// in place, so JS never has to fetch or copy the data.
+struct ViewColumn
+{
+  const char *name;
+  ViewColumnType type;
+  int length;     // element count
+  int byteOffset; // must be aligned to the element size
+};
+
+#endif
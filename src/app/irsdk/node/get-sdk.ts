@@ -1,13 +1,22 @@
 import { platform } from 'os';
 
-import type { INativeSDK } from '../native';
+import type { INativeConnectionWatcher, INativeSDK } from '../native';
+import type { SdkSource } from '../types';
 
-import { MockSDK } from './utils/mock-sdk';
+import { MockConnectionWatcher, MockSDK } from './utils/mock-sdk';
 
-export async function getSdkOrMock(): Promise<INativeSDK> {
+export async function getSdkOrMock(source?: SdkSource): Promise<INativeSDK> {
   if (platform() === 'win32') {
     const Sdk = (await import('../native')).NativeSDK;
-    return new Sdk();
+    return new Sdk(source);
   }
   return new MockSDK();
 }
+
+export async function getConnectionWatcherOrMock(): Promise<INativeConnectionWatcher> {
+  if (platform() === 'win32') {
+    const Watcher = (await import('../native')).ConnectionWatcher;
+    return new Watcher();
+  }
+  return new MockConnectionWatcher();
+}
@@ -1,6 +1,6 @@
 import { describe, it, expect, beforeEach, vi } from 'vitest';
 import { IRacingSDK } from './irsdk-node';
-import { getSdkOrMock } from './get-sdk';
+import { getConnectionWatcherOrMock, getSdkOrMock } from './get-sdk';
 import type { INativeSDK } from '../native';
 
 // Mock the getSdkOrMock module
@@ -17,6 +17,11 @@ vi.mock('./get-sdk', () => ({
     getTelemetryVariable: vi.fn(),
     broadcast: vi.fn(),
   } as INativeSDK),
+  getConnectionWatcherOrMock: vi.fn().mockResolvedValue({
+    state: 'absent',
+    start: vi.fn().mockReturnValue(true),
+    stop: vi.fn(),
+  }),
 }));
 
 describe('irsdk-node', () => {
@@ -124,4 +129,138 @@ DriverInfo:
     expect(result?.DriverInfo?.Drivers[0]?.TeamName).toBe("Mike's Team");
     expect(result?.DriverInfo?.Drivers[0]?.UserName).toBe("Coolio O'Brien");
   });
+
+  it('should use the session the native worker parsed until a newer one is ready', () => {
+    const yamlCalls = vi.mocked(mockSdk.getSessionData).mock.calls.length;
+    mockSdk.takeParsedSession = vi
+      .fn()
+      .mockReturnValueOnce({ version: 3, json: '{"WeekendInfo":{"TrackID":123}}' })
+      .mockReturnValueOnce(null)
+      .mockReturnValueOnce({ version: 4, json: '{"WeekendInfo":{"TrackID":456}}' });
+
+    try {
+      const first = sdk.getSessionData();
+      expect(first?.WeekendInfo.TrackID).toBe(123);
+      expect(sdk.getSessionData()).toBe(first);
+      expect(sdk.getSessionData()?.WeekendInfo.TrackID).toBe(456);
+      expect(mockSdk.getSessionData).toHaveBeenCalledTimes(yamlCalls);
+    } finally {
+      delete mockSdk.takeParsedSession;
+    }
+  });
+
+  it('should parse the YAML itself until the native worker has a session', () => {
+    vi.mocked(mockSdk.getSessionData).mockReturnValue('WeekendInfo:\n  TrackID: 789\n');
+    let parsed: { version: number; json: string } | null = null;
+    mockSdk.takeParsedSession = vi.fn(() => {
+      const taken = parsed;
+      parsed = null;
+      return taken;
+    });
+
+    try {
+      expect(sdk.getSessionData()?.WeekendInfo.TrackID).toBe(789);
+      expect(sdk.getSessionView()?.WeekendInfo.TrackID).toBe(789);
+      parsed = { version: 1, json: '{"WeekendInfo":{"TrackID":123}}' };
+      expect(sdk.getSessionData()?.WeekendInfo.TrackID).toBe(123);
+    } finally {
+      delete mockSdk.takeParsedSession;
+    }
+  });
+
+  it('should watch the connection until told to stop', async () => {
+    const callback = vi.fn();
+    const stop = await IRacingSDK.WatchConnection(callback);
+    const watcher = await getConnectionWatcherOrMock();
+
+    expect(watcher.start).toHaveBeenCalledWith(callback);
+    expect(watcher.stop).toHaveBeenCalledTimes(0);
+    stop();
+    expect(watcher.stop).toHaveBeenCalledTimes(1);
+  });
+
+  describe('reused telemetry', () => {
+    // A native like frame, every value backed by the ArrayBuffer the next line is copied into
+    const createRawTelemetry = (vars: number) => {
+      const raw: Record<string, unknown> = {};
+      const bools: ArrayBuffer[] = [];
+      const doubles: Float64Array[] = [];
+      for (let i = 0; i < vars; i++) {
+        const varType = [1, 2, 4, 5][i % 4];
+        const length = i % 10 === 0 ? 64 : 1;
+        const value = new ArrayBuffer(length * [1, 1, 4, 4, 4, 8][varType]);
+        if (varType === 1) bools.push(value);
+        if (varType === 5) doubles.push(new Float64Array(value));
+        raw[`Var${i}`] = { name: `Var${i}`, description: '', unit: '', countAsTime: false, length, varType, value };
+      }
+      return { raw: raw as unknown as ReturnType<INativeSDK['getTelemetryData']>, bools, doubles };
+    };
+
+    // Bytes the JS heap grows by per frame once warmed up. Frames during which
+    // something was collected are left out, so this doesn't depend on when the
+    // GC runs; what a frame allocates shows up in the used heap right away.
+    const heapGrowthPerFrame = async (next: (frame: number) => void) => {
+      const { getHeapStatistics } = await import('node:v8');
+      const usedHeap = () => getHeapStatistics().used_heap_size;
+      const growth = (frame: (f: number) => void) => {
+        let grown = 0;
+        let frames = 0;
+        for (let f = 0; f < 2000; f++) {
+          const before = usedHeap();
+          frame(f);
+          const after = usedHeap();
+          if (after < before) continue;
+          grown += after - before;
+          frames++;
+        }
+        return grown / frames;
+      };
+
+      for (let f = 0; f < 1000; f++) next(f);
+      // Reading the statistics allocates as well, an empty frame counts that out
+      return growth(next) - growth(() => {});
+    };
+
+    it('should refresh the same telemetry object in place', () => {
+      const { raw, bools, doubles } = createRawTelemetry(8);
+      const getTelemetryData = mockSdk.getTelemetryData;
+      mockSdk.getTelemetryData = () => raw;
+      sdk.reuseTelemetry = true;
+
+      try {
+        const first = sdk.getTelemetry();
+        new Int8Array(bools[0])[3] = 1;
+        doubles[0][0] = 12.5;
+        const second = sdk.getTelemetry() as unknown as Record<string, { value: unknown[] }>;
+
+        expect(second).toBe(first);
+        expect(second.Var0.value[3]).toBe(true);
+        expect(second.Var3.value[0]).toBe(12.5);
+      } finally {
+        mockSdk.getTelemetryData = getTelemetryData;
+      }
+    });
+
+    it('should not allocate per frame once warmed up', async () => {
+      const { raw, doubles } = createRawTelemetry(300);
+      const getTelemetryData = mockSdk.getTelemetryData;
+      mockSdk.getTelemetryData = () => raw;
+      const frame = (f: number) => {
+        for (let i = 0; i < doubles.length; i++) doubles[i][0] = f * 0.5;
+        sdk.getTelemetry();
+      };
+
+      try {
+        const copied = await heapGrowthPerFrame(frame);
+        sdk.reuseTelemetry = true;
+        const reused = await heapGrowthPerFrame(frame);
+
+        // A fresh object and value array per var when copying
+        expect(copied).toBeGreaterThan(300 * 32);
+        expect(reused).toBeLessThan(copied / 100);
+      } finally {
+        mockSdk.getTelemetryData = getTelemetryData;
+      }
+    });
+  });
 }); 
\ No newline at end of file
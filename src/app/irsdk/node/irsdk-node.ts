@@ -1,3 +1,4 @@
+import path from 'node:path';
 import yaml from 'js-yaml';
 import {
   BroadcastMessages,
@@ -21,11 +22,25 @@ import {
   SplitTimeInfo,
   WeekendInfo,
   SessionData,
+  CarTableView,
+  SessionTablesView,
+  LapTimingView,
+  LapDeltaView,
+  SdkEvent,
+  QuantizationProfile,
+  HistoryView,
+  SubTickSamples,
+  SdkSource,
+  ReplayState,
+  ConnectionState,
+  AllocationStats,
 } from '../types';
 import type { INativeSDK } from '../native';
 
-import { getSimStatus } from './utils';
-import { getSdkOrMock } from './get-sdk';
+import { getSimStatus, createLazySession, sharedFrameRingByteLength } from './utils';
+import { getConnectionWatcherOrMock, getSdkOrMock } from './get-sdk';
+
+const EMPTY_TRACE = '{"traceEvents":[]}';
 
 function copyTelemData<
 K extends keyof TelemetryVarList = keyof TelemetryVarList,
@@ -41,16 +56,24 @@ T extends TelemetryVarList[K] = TelemetryVarList[K]
     });
     return;
   }
-  // numbers
+  // numbers, Array.from keeps float arrays in unboxed double storage
   if (src.varType === 2 || src.varType === 3) { // int
-    dest[key].value = [...new Int32Array(src.value as number[])];
+    dest[key].value = Array.from(new Int32Array(src.value as number[]));
   } else if (src.varType === 4) { // float
-    dest[key].value = [...new Float32Array(src.value as number[])];
+    dest[key].value = Array.from(new Float32Array(src.value as number[]));
   } else if (src.varType === 5) { // double
-    dest[key].value = [...new Float64Array(src.value as number[])];
+    dest[key].value = Array.from(new Float64Array(src.value as number[]));
   }
 }
 
+// getTelemetry() result in reuse mode and the native buffers its value arrays are refreshed from
+interface TelemetryCache {
+  raw: TelemetryVarList;
+  data: TelemetryVarList;
+  bools: { value: boolean[]; source: Int8Array }[];
+  numbers: { value: number[]; source: Int32Array | Float32Array | Float64Array }[];
+}
+
 export class IRacingSDK {
   // Public
   /**
@@ -59,22 +82,39 @@ export class IRacingSDK {
    */
   public autoEnableTelemetry = false;
 
+  /**
+   * Return the same telemetry object from every `getTelemetry()` call and refresh its values in
+   * place, so steady state frames allocate nothing. Copy a frame before holding on to it.
+   * @default false
+   */
+  public reuseTelemetry = false;
+
   // Private
   private _dataVer = -1;
 
   private _sessionData: SessionData | null = null;
 
+  private _sessionJson: string | null = null;
+
+  private _sessionView: SessionData | null = null;
+
+  private _telemetryCache: TelemetryCache | null = null;
+
   private _sdk?: INativeSDK;
 
   private _sdkReq: Promise<void>;
 
-  constructor() {
-    this._sdkReq = this._loadSDK();
+  /**
+   * @param source Where to read telemetry from, the running sim by default. Each instance
+   * keeps its own connection, so a file can be replayed while another instance reads the sim.
+   */
+  constructor(source?: SdkSource) {
+    this._sdkReq = this._loadSDK(source);
     void IRacingSDK.IsSimRunning();
   }
 
-  private async _loadSDK(): Promise<void> {
-    const sdk = await getSdkOrMock();
+  private async _loadSDK(source?: SdkSource): Promise<void> {
+    const sdk = await getSdkOrMock(source);
     this._sdk = sdk;
     this._sdk.startSDK();
   }
@@ -120,6 +160,18 @@ export class IRacingSDK {
     return false;
   }
 
+  /**
+   * Watches for the sim on a native thread instead of polling for it. The callback runs with
+   * the first state found and then on every change; a connection is reported within a tick of
+   * the sim's first line.
+   * @returns Stops watching.
+   */
+  public static async WatchConnection(callback: (state: ConnectionState) => void): Promise<() => void> {
+    const watcher = await getConnectionWatcherOrMock();
+    watcher.start(callback);
+    return () => watcher.stop();
+  }
+
   public get sessionStatusOK(): boolean {
     return this._sdk?.isRunning() ?? false;
   }
@@ -145,6 +197,10 @@ export class IRacingSDK {
   public stopSDK(): void {
     this._sdk?.stopSDK();
     this._dataVer = -1;
+    this._sessionData = null;
+    this._sessionJson = null;
+    this._sessionView = null;
+    this._telemetryCache = null;
   }
 
   /**
@@ -157,9 +213,27 @@ export class IRacingSDK {
 
   /**
    * Gets the current session data (from yaml format).
-   * @returns {SessionData}
+   *
+   * The native SDK converts each update on a worker thread, so this only
+   * picks up the finished conversion and keeps returning the previous object
+   * until one is ready. A new object means the session changed. Until the
+   * worker has finished its first conversion the YAML is parsed here instead,
+   * so a connected SDK always has a session.
+   * @returns {SessionData} null while there is no session, before the sim
+   * sent one or when it couldn't be parsed.
    */
   public getSessionData(): SessionData | null {
+    if (this._takeParsedSession() && this._sessionJson) {
+      if (!this._sessionData) {
+        try {
+          this._sessionData = JSON.parse(this._sessionJson) as SessionData;
+        } catch (err) {
+          console.error('There was an error getting session data:', err);
+        }
+      }
+      return this._sessionData;
+    }
+
     if (this._sessionData && this._dataVer === this.currDataVersion) return this._sessionData;
     if (!this._sdk) return null;
 
@@ -176,12 +250,45 @@ export class IRacingSDK {
     return null;
   }
 
+  /**
+   * Gets the current session data as a lazy view: each part is only converted
+   * from the native session index when first read, then kept until the next
+   * session update. Cheaper than `getSessionData` when only a few sections
+   * are needed. Falls back to `getSessionData` without a native index or
+   * before the first one is ready.
+   * @returns {SessionData}
+   */
+  public getSessionView(): SessionData | null {
+    if (!this._sdk || !this._takeParsedSession() || !this._sessionJson) return this.getSessionData();
+    if (!this._sessionView) {
+      this._sessionView = createLazySession(this._sdk);
+    }
+    return this._sessionView;
+  }
+
+  /**
+   * Picks up the newest session the native worker finished, dropping the
+   * objects built from the previous one.
+   * @returns false when the native SDK has no session worker.
+   */
+  private _takeParsedSession(): boolean {
+    const parsed = this._sdk?.takeParsedSession?.();
+    if (parsed === undefined) return false;
+    if (parsed) {
+      this._sessionJson = parsed.json;
+      this._dataVer = parsed.version;
+      this._sessionData = null;
+      this._sessionView = null;
+    }
+    return true;
+  }
+
   /**
    * Gets the current weekend info from the session data
    * @returns {WeekendInfo}
    */
   public getWeekendInfo(): WeekendInfo | null {
-    const session = this.getSessionData();
+    const session = this.getSessionView();
     return session?.WeekendInfo ?? null;
   }
 
@@ -190,7 +297,7 @@ export class IRacingSDK {
    * @returns {SessionInfo}
    */
   public getSessionInfo(): SessionList | null {
-    const session = this.getSessionData();
+    const session = this.getSessionView();
     return session?.SessionInfo ?? null;
   }
 
@@ -199,7 +306,7 @@ export class IRacingSDK {
    * @returns {CameraInfo}
    */
   public getCameraInfo(): CameraInfo | null {
-    const session = this.getSessionData();
+    const session = this.getSessionView();
     return session?.CameraInfo ?? null;
   }
 
@@ -208,7 +315,7 @@ export class IRacingSDK {
    * @returns {RadioInfo}
    */
   public getRadioInfo(): RadioInfo | null {
-    const session = this.getSessionData();
+    const session = this.getSessionView();
     return session?.RadioInfo ?? null;
   }
 
@@ -217,7 +324,7 @@ export class IRacingSDK {
    * @returns {DriverInfo}
    */
   public getDriverInfo(): DriverInfo | null {
-    const session = this.getSessionData();
+    const session = this.getSessionView();
     return session?.DriverInfo ?? null;
   }
 
@@ -226,7 +333,7 @@ export class IRacingSDK {
    * @returns {SplitTimeInfo}
    */
   public getSplitInfo(): SplitTimeInfo | null {
-    const session = this.getSessionData();
+    const session = this.getSessionView();
     return session?.SplitTimeInfo ?? null;
   }
 
@@ -235,7 +342,7 @@ export class IRacingSDK {
    * @returns {CarSetupInfo}
    */
   public getCarSetupInfo(): CarSetupInfo | null {
-    const session = this.getSessionData();
+    const session = this.getSessionView();
     return session?.CarSetup ?? null;
   }
 
@@ -243,6 +350,8 @@ export class IRacingSDK {
    * Get the current value of the telemetry variables.
    */
   public getTelemetry(): TelemetryVarList {
+    if (this.reuseTelemetry) return this._getReusedTelemetry();
+
     const rawData = this._sdk?.getTelemetryData();
     const data: Partial<TelemetryVarList> = {};
 
@@ -259,6 +368,344 @@ export class IRacingSDK {
     return data as TelemetryVarList;
   }
 
+  private _getReusedTelemetry(): TelemetryVarList {
+    const rawData = this._sdk?.getTelemetryData(true);
+    if (!rawData) return {} as TelemetryVarList;
+
+    // The native object only changes when the var layout does, copy it once per layout
+    const cache = this._telemetryCache;
+    if (cache?.raw !== rawData) {
+      const next: TelemetryCache = { raw: rawData, data: {} as TelemetryVarList, bools: [], numbers: [] };
+      Object.keys(rawData).forEach((dataKey) => {
+        const key = dataKey as keyof TelemetryVarList;
+        const src = rawData[key];
+        copyTelemData(src, key, next.data);
+
+        // Char values keep the native buffer itself, plain arrays never change
+        const buffer = src.value as unknown;
+        if (!(buffer instanceof ArrayBuffer)) return;
+        const value = next.data[key].value as unknown;
+        if (src.varType === 1) {
+          next.bools.push({ value: value as boolean[], source: new Int8Array(buffer) });
+        } else if (src.varType === 2 || src.varType === 3) {
+          next.numbers.push({ value: value as number[], source: new Int32Array(buffer) });
+        } else if (src.varType === 4) {
+          next.numbers.push({ value: value as number[], source: new Float32Array(buffer) });
+        } else if (src.varType === 5) {
+          next.numbers.push({ value: value as number[], source: new Float64Array(buffer) });
+        }
+      });
+      this._telemetryCache = next;
+      return next.data;
+    }
+
+    // Separate loops so numbers are never boxed on their way through a bool conversion
+    const { bools, numbers } = cache;
+    for (let v = 0; v < bools.length; v++) {
+      const { value, source } = bools[v];
+      for (let i = 0; i < source.length; i++) value[i] = source[i] !== 0;
+    }
+    for (let v = 0; v < numbers.length; v++) {
+      const { value, source } = numbers[v];
+      for (let i = 0; i < source.length; i++) value[i] = source[i];
+    }
+    return cache.data;
+  }
+
+  /**
+   * Gets the per-car table joining the CarIdx telemetry arrays with the driver info.
+   * The returned view and its typed arrays are reused and updated in place on every tick.
+   */
+  public getCarTable(): CarTableView | null {
+    return this._sdk?.getCarTable() ?? null;
+  }
+
+  /**
+   * Gets typed tables of the driver list (by CarIdx) and the results of every session (by position).
+   * The tables are only filled once this has been called, then updated in place on session changes.
+   */
+  public getSessionTables(): SessionTablesView | null {
+    return this._sdk?.getSessionTables() ?? null;
+  }
+
+  /**
+   * Gets the native lap and sector timing for every car.
+   * Timing only starts once this has been called, and the view is updated in place on every tick.
+   */
+  public getLapTiming(): LapTimingView | null {
+    return this._sdk?.getLapTiming() ?? null;
+  }
+
+  /**
+   * Gets the live delta to the reference lap.
+   * The delta only runs once this has been called, and the view is updated in place on every tick.
+   */
+  public getLapDelta(): LapDeltaView | null {
+    return this._sdk?.getLapDelta() ?? null;
+  }
+
+  /**
+   * Drains the events detected since the last call, oldest first.
+   * Detection starts with the first call, so poll this once per tick.
+   */
+  public getEvents(): SdkEvent[] {
+    return this._sdk?.getEvents() ?? [];
+  }
+
+  /**
+   * The sub tick vars (`SteeringWheelAngle_ST` and friends) flattened into
+   * timestamped rows at their full rate, from a ring of the last few seconds.
+   * @param since The `next` of the previous call, 0 for everything still held.
+   */
+  public getSubTickSamples(since = 0): SubTickSamples {
+    return (
+      this._sdk?.getSubTickSamples(since) ?? {
+        next: since,
+        names: [],
+        time: new Float64Array(0),
+        values: {},
+      }
+    );
+  }
+
+  /**
+   * Compile a trigger expression such as `Speed > 80 && Brake > 0.5` or
+   * `FuelLevel < FuelUsePerLap * 2`. It is evaluated natively on every tick and
+   * fires when it goes from false to true, see {@link getFiredTriggers}.
+   * @returns The trigger id, or -1 when the SDK isn't loaded.
+   * @throws When the expression doesn't parse.
+   */
+  public addTrigger(expression: string): number {
+    return this._sdk?.addTrigger(expression) ?? -1;
+  }
+
+  public removeTrigger(id: number): boolean {
+    return this._sdk?.removeTrigger(id) ?? false;
+  }
+
+  public clearTriggers(): void {
+    this._sdk?.clearTriggers();
+  }
+
+  /**
+   * Drains the ids of the triggers that fired since the last call, in firing order.
+   */
+  public getFiredTriggers(): number[] {
+    return this._sdk?.getFiredTriggers() ?? [];
+  }
+
+  /**
+   * Keep a min/max/mean level of detail history of a var, sampled natively on
+   * every tick, so long graphs can be drawn at any zoom, see {@link getHistory}.
+   * Add `SessionTime` too for the x axis; channels added together stay sample aligned.
+   * @param index Element of an array var, e.g. the car index.
+   * @param capacity Finest buckets kept before the finest level is dropped.
+   * @returns The channel id, or -1 when the SDK isn't loaded.
+   */
+  public addHistoryChannel(
+    name: string,
+    index = 0,
+    capacity?: number
+  ): number {
+    return this._sdk?.addHistoryChannel(name, index, capacity) ?? -1;
+  }
+
+  public removeHistoryChannel(id: number): boolean {
+    return this._sdk?.removeHistoryChannel(id) ?? false;
+  }
+
+  /**
+   * Samples `[from, to)` of a history channel in at most `width` buckets, at
+   * the finest resolution that fits.
+   * @param width Usually the graph's width in pixels.
+   */
+  public getHistory(
+    id: number,
+    width: number,
+    from?: number,
+    to?: number
+  ): HistoryView | null {
+    return this._sdk?.getHistory(id, width, from, to) ?? null;
+  }
+
+  /**
+   * Publish every new line into shared memory, so other processes can read
+   * frames with a `FrameReader` instead of receiving a serialized copy.
+   * @param name The shared memory name, defaults to the one `FrameReader` opens.
+   */
+  public startFramePublisher(name?: string): boolean {
+    return this._sdk?.startFramePublisher(name) ?? false;
+  }
+
+  public stopFramePublisher(): void {
+    this._sdk?.stopFramePublisher();
+  }
+
+  /**
+   * The number of the newest frame in shared memory, 0 before the first one.
+   */
+  public getPublishedFrame(): number {
+    return this._sdk?.getPublishedFrame() ?? 0;
+  }
+
+  /**
+   * Publish every new line into a SharedArrayBuffer as well, so worker threads
+   * can read frames with a `SharedFrameReader` instead of receiving a copy of
+   * each one. Post the buffer to them once.
+   * @param slotCapacity Bytes per frame, must hold a whole telemetry line.
+   * @returns The buffer, or null when frames can't be published.
+   */
+  public startSharedFramePublisher(slotCapacity?: number): SharedArrayBuffer | null {
+    if (!this._sdk) return null;
+    const buffer = new SharedArrayBuffer(sharedFrameRingByteLength(slotCapacity));
+    return this._sdk.startSharedFramePublisher(new Uint8Array(buffer)) ? buffer : null;
+  }
+
+  public stopSharedFramePublisher(): void {
+    this._sdk?.stopSharedFramePublisher();
+  }
+
+  /**
+   * Create a binary frame encoder for streaming telemetry to browser widgets,
+   * see `TelemetryStreamDecoder` for the format.
+   * @param vars The vars to stream, every var when empty.
+   * @param changeBitmap Only send the vars that changed since the previous frame.
+   * @param quantization Float vars to send as fixed point codes of the given precision.
+   * @param bitPack Pack the codes as tightly as possible rather than byte aligned.
+   * @returns The encoder id, or -1 when the SDK isn't loaded.
+   */
+  public createFrameEncoder(
+    vars: string[] = [],
+    changeBitmap = false,
+    quantization: QuantizationProfile = {},
+    bitPack = true
+  ): number {
+    return this._sdk?.createFrameEncoder(vars, changeBitmap, quantization, bitPack) ?? -1;
+  }
+
+  /**
+   * Encode the current line. Prefixed with the schema record when it is new.
+   * @param keyframe Send every value even with change bitmaps on, e.g. after dropping output.
+   * @returns The encoded records, or null when there is nothing new to send.
+   */
+  public encodeFrame(id: number, keyframe = false): ArrayBuffer | null {
+    return this._sdk?.encodeFrame(id, keyframe) ?? null;
+  }
+
+  public destroyFrameEncoder(id: number): boolean {
+    return this._sdk?.destroyFrameEncoder(id) ?? false;
+  }
+
+  /**
+   * Record every line the SDK reads to a compressed file, read it back with
+   * `RecordingReader`. Lossless, and cheap enough to leave on for a session.
+   * @returns False when already recording or the file can't be created.
+   */
+  public startRecording(path: string): boolean {
+    return this._sdk?.startRecording(path) ?? false;
+  }
+
+  /**
+   * Flush and close the recording.
+   * @returns False when not recording or the file couldn't be written.
+   */
+  public stopRecording(): boolean {
+    return this._sdk?.stopRecording() ?? false;
+  }
+
+  /**
+   * Change the pace of a `replay` source.
+   * @param speed Multiple of real time, 0 for as fast as lines can be read.
+   * @returns False when the source isn't a replay.
+   */
+  public setReplaySpeed(speed: number): boolean {
+    return this._sdk?.setReplaySpeed(speed) ?? false;
+  }
+
+  /** Start a `replay` source over at its end, or stop there. */
+  public setReplayLoop(loop: boolean): boolean {
+    return this._sdk?.setReplayLoop(loop) ?? false;
+  }
+
+  /**
+   * Carry on a `replay` source from another line. Tick counts keep going up.
+   * @returns False when the source isn't a replay or the line is past its end.
+   */
+  public seekReplay(line: number): boolean {
+    return this._sdk?.seekReplay(line) ?? false;
+  }
+
+  /** Where a `replay` source is at, null for other sources. */
+  public getReplayState(): ReplayState | null {
+    return this._sdk?.getReplayState() ?? null;
+  }
+
+  /**
+   * Record how long the native stages take (waiting for a line, copying it, session
+   * conversion and parsing, building the JS objects). Process wide, not per instance.
+   */
+  public setTracing(enabled: boolean): boolean {
+    return this._sdk?.setTracing(enabled) ?? false;
+  }
+
+  /**
+   * The recent native spans as Chrome trace-event JSON, to open in Perfetto or
+   * chrome://tracing next to the Electron traces.
+   * @param clear Leave the dumped spans out of the next dump.
+   */
+  public dumpTrace(clear = false): string {
+    return this._sdk?.dumpTrace(clear) ?? EMPTY_TRACE;
+  }
+
+  /**
+   * Native heap allocations and N-API values created so far, for the calling thread
+   * and the whole process. Diff two calls to see what a frame costs; two calls in a
+   * row differ by nothing.
+   */
+  public getAllocationStats(): AllocationStats | null {
+    return this._sdk?.getAllocationStats() ?? null;
+  }
+
+  /**
+   * Choose which car the lap delta follows. Changing car drops the current reference lap.
+   * @param carIdx The CarIdx to follow, or -1 for the player's car.
+   */
+  public setLapDeltaCar(carIdx: number): boolean {
+    return this._sdk?.setLapDeltaCar(carIdx) ?? false;
+  }
+
+  /**
+   * Save the current reference lap as `<TrackID>-<CarID>.irdl` in the given directory.
+   * @returns false when there is no reference lap yet or the file couldn't be written.
+   */
+  public saveReferenceLap(directory: string): boolean {
+    const file = this._getReferenceLapFile(directory);
+    return file !== null && (this._sdk?.saveReferenceLap(file) ?? false);
+  }
+
+  /**
+   * Load the reference lap for the current track and car from the given directory.
+   * It stays the reference until a faster lap is driven.
+   */
+  public loadReferenceLap(directory: string): boolean {
+    const file = this._getReferenceLapFile(directory);
+    return file !== null && (this._sdk?.loadReferenceLap(file) ?? false);
+  }
+
+  public clearReferenceLap(): void {
+    this._sdk?.clearReferenceLap();
+  }
+
+  private _getReferenceLapFile(directory: string): string | null {
+    const session = this.getSessionView();
+    const trackId = session?.WeekendInfo?.TrackID;
+    const driverInfo = session?.DriverInfo;
+    const car = driverInfo?.Drivers?.find((driver) => driver.CarIdx === driverInfo.DriverCarIdx);
+    if (trackId === undefined || !car) return null;
+
+    return path.join(directory, `${trackId}-${car.CarID}.irdl`);
+  }
+
   /**
    * Request the value of the given telemetry variable.
    * @param index The number index of the variable. Only use if you know what you are doing!
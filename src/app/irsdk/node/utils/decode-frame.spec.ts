@@ -0,0 +1,61 @@
+import { describe, it, expect } from 'vitest';
+import { decodeTelemetryFrame, decodeTelemetryVar } from './decode-frame';
+import type { FrameVar } from '../../types';
+
+const frameVar = (name: string, varType: number, offset: number, length = 1): FrameVar => ({
+  name,
+  description: `${name} description`,
+  unit: '',
+  countAsTime: false,
+  length,
+  varType,
+  offset,
+});
+
+describe('decodeTelemetryFrame', () => {
+  const vars = [
+    frameVar('SessionTime', 5, 0),
+    frameVar('Gear', 2, 8),
+    frameVar('Speed', 4, 12),
+    frameVar('CarIdxOnPitRoad', 1, 16, 3),
+    frameVar('SessionFlags', 3, 20),
+  ];
+
+  const buffer = new ArrayBuffer(24);
+  const view = new DataView(buffer);
+  view.setFloat64(0, 123.5, true);
+  view.setInt32(8, -1, true);
+  view.setFloat32(12, 44.25, true);
+  view.setUint8(16, 1);
+  view.setUint8(17, 0);
+  view.setUint8(18, 1);
+  view.setUint32(20, 0x80000004, true);
+
+  it('should decode every var type', () => {
+    const telemetry = decodeTelemetryFrame(vars, buffer);
+
+    expect(telemetry.SessionTime.value).toEqual([123.5]);
+    expect(telemetry.Gear.value).toEqual([-1]);
+    expect(telemetry.Speed.value).toEqual([44.25]);
+    expect(telemetry.CarIdxOnPitRoad.value).toEqual([true, false, true]);
+    expect(telemetry.SessionFlags.value).toEqual([0x80000004 | 0]);
+  });
+
+  it('should keep the var header fields', () => {
+    const telemetry = decodeTelemetryFrame(vars, buffer);
+
+    expect(telemetry.Gear).toMatchObject({
+      name: 'Gear',
+      description: 'Gear description',
+      length: 1,
+      varType: 2,
+    });
+  });
+
+  it('should only decode the requested vars', () => {
+    const telemetry = decodeTelemetryFrame(vars, buffer, new Set(['Gear', 'Speed']));
+
+    expect(Object.keys(telemetry)).toEqual(['Gear', 'Speed']);
+    expect(decodeTelemetryVar(vars[0], new DataView(buffer)).value).toEqual([123.5]);
+  });
+});
@@ -0,0 +1,62 @@
+import type { FrameVar, TelemetryVarList } from '../../types';
+
+/**
+ * Decodes a single var of a raw telemetry line.
+ * @param v The var to decode.
+ * @param view A view of the line buffer.
+ */
+export function decodeTelemetryVar(v: FrameVar, view: DataView): TelemetryVarList[keyof TelemetryVarList] {
+  const value: (number | boolean)[] = new Array(v.length);
+  for (let i = 0; i < v.length; i++) {
+    switch (v.varType) {
+      case 0: // char
+        value[i] = view.getUint8(v.offset + i);
+        break;
+      case 1: // bool
+        value[i] = view.getUint8(v.offset + i) !== 0;
+        break;
+      case 2: // int
+      case 3: // bitfield
+        value[i] = view.getInt32(v.offset + i * 4, true);
+        break;
+      case 4: // float
+        value[i] = view.getFloat32(v.offset + i * 4, true);
+        break;
+      case 5: // double
+        value[i] = view.getFloat64(v.offset + i * 8, true);
+        break;
+    }
+  }
+
+  return {
+    name: v.name,
+    description: v.description,
+    unit: v.unit,
+    countAsTime: v.countAsTime,
+    length: v.length,
+    varType: v.varType,
+    value,
+  } as unknown as TelemetryVarList[keyof TelemetryVarList];
+}
+
+/**
+ * Decodes a raw telemetry line into the same shape `IRacingSDK.getTelemetry()` returns.
+ * @param vars The var table of the layout the line was written with.
+ * @param buffer The line buffer.
+ * @param names Only decode these vars, every var when omitted.
+ */
+export function decodeTelemetryFrame(
+  vars: FrameVar[],
+  buffer: ArrayBuffer,
+  names?: ReadonlySet<string> | null
+): TelemetryVarList {
+  const view = new DataView(buffer);
+  const data: Record<string, unknown> = {};
+
+  vars.forEach((v) => {
+    if (names && !names.has(v.name)) return;
+    data[v.name] = decodeTelemetryVar(v, view);
+  });
+
+  return data as unknown as TelemetryVarList;
+}
@@ -1 +1,4 @@
 export * from './sim-status';
+export * from './decode-frame';
+export * from './lazy-session';
+export * from './shared-frame-ring';
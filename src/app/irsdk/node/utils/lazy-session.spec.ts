@@ -0,0 +1,56 @@
+import { describe, it, expect, vi } from 'vitest';
+import { createLazySession } from './lazy-session';
+
+const document = {
+  WeekendInfo: { TrackName: 'spa', TrackID: 163, WeekendOptions: { NumStarters: 20 } },
+  DriverInfo: { DriverCarIdx: 1, Drivers: [{ CarIdx: 0 }, { CarIdx: 1 }] },
+};
+
+// Resolves paths against a plain object the way the native index does
+const source = () => {
+  const at = (path: string[]) =>
+    path.reduce<unknown>((v, k) => (v as Record<string, unknown> | undefined)?.[k], document);
+  const isMap = (v: unknown) => !!v && typeof v === 'object' && !Array.isArray(v);
+  return {
+    getSessionKeys: vi.fn((path: string[]) => {
+      const value = at(path);
+      if (!isMap(value)) return null;
+      const keys = Object.keys(value as object);
+      return { keys, maps: keys.map((k) => isMap((value as Record<string, unknown>)[k])) };
+    }),
+    getSessionJson: vi.fn((path: string[]) => JSON.stringify(at(path) ?? null)),
+  };
+};
+
+describe('createLazySession', () => {
+  it('should only convert the parts that are read', () => {
+    const sdk = source();
+    const session = createLazySession(sdk);
+
+    expect(session?.WeekendInfo.TrackName).toBe('spa');
+    expect(sdk.getSessionKeys).toHaveBeenCalledTimes(2);
+    expect(sdk.getSessionJson).toHaveBeenCalledTimes(1);
+    expect(sdk.getSessionJson).toHaveBeenCalledWith(['WeekendInfo', 'TrackName']);
+  });
+
+  it('should keep values once they are read', () => {
+    const sdk = source();
+    const session = createLazySession(sdk);
+
+    const drivers = session?.DriverInfo.Drivers;
+    expect(drivers).toEqual([{ CarIdx: 0 }, { CarIdx: 1 }]);
+    expect(session?.DriverInfo.Drivers).toBe(drivers);
+    expect(sdk.getSessionJson).toHaveBeenCalledTimes(1);
+  });
+
+  it('should enumerate like the full object', () => {
+    const session = createLazySession(source());
+
+    expect(Object.keys(session ?? {})).toEqual(['WeekendInfo', 'DriverInfo']);
+    expect(JSON.parse(JSON.stringify(session))).toEqual(document);
+  });
+
+  it('should be null without an indexed session', () => {
+    expect(createLazySession({ getSessionKeys: () => null, getSessionJson: () => null })).toBeNull();
+  });
+});
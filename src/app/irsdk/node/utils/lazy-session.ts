@@ -0,0 +1,36 @@
+import type { SessionData } from '../../types';
+import type { INativeSDK } from '../../native';
+
+type SessionSource = Pick<INativeSDK, 'getSessionKeys' | 'getSessionJson'>;
+
+/**
+ * Builds a session object whose properties are only converted when first
+ * read, straight from the native index of the session the SDK last took.
+ * Maps become further lazy objects, everything else (scalars, lists such as
+ * `DriverInfo.Drivers`) is parsed whole on first access and then kept.
+ * @returns null when the SDK has no indexed session.
+ */
+export function createLazySession(sdk: SessionSource): SessionData | null {
+  return lazyMap(sdk, []) as SessionData | null;
+}
+
+function lazyMap(sdk: SessionSource, path: string[]): Record<string, unknown> | null {
+  const node = sdk.getSessionKeys?.(path);
+  if (!node) return null;
+
+  const map: Record<string, unknown> = {};
+  node.keys.forEach((key, i) => {
+    Object.defineProperty(map, key, {
+      enumerable: true,
+      configurable: true,
+      get() {
+        const childPath = [...path, key];
+        const value = node.maps[i] ? lazyMap(sdk, childPath) : JSON.parse(sdk.getSessionJson?.(childPath) ?? 'null');
+        // Swap the accessor for the value so later reads are plain lookups
+        Object.defineProperty(map, key, { value, enumerable: true, configurable: true, writable: true });
+        return value;
+      },
+    });
+  });
+  return map;
+}
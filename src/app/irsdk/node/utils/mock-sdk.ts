@@ -1,6 +1,6 @@
-import type { INativeSDK } from '../../native';
+import type { INativeConnectionWatcher, INativeSDK } from '../../native';
 import type {
-  TelemetryVarList, TelemetryVariable, BroadcastMessages, CameraState, ReplayPositionCommand, ReplaySearchCommand, ReplayStateCommand, ReloadTexturesCommand, ChatCommand, PitCommand, TelemetryCommand, FFBCommand, VideoCaptureCommand,
+  CarTableColumns, CarTableView, SessionTablesView, SessionDriverColumns, SessionResultColumns, LapTimingView, LapDeltaView, SdkEvent, TelemetryVarList, TelemetryVariable, BroadcastMessages, CameraState, ReplayPositionCommand, ReplaySearchCommand, ReplayStateCommand, ReloadTexturesCommand, ChatCommand, PitCommand, TelemetryCommand, FFBCommand, VideoCaptureCommand, QuantizationProfile, HistoryView, SubTickSamples, ConnectionState, ReplayState, AllocationStats,
 } from '../../types';
 
 import { loadMockSessionData, loadMockTelemetry } from './mock-data/loader';
@@ -8,6 +8,117 @@ import { loadMockSessionData, loadMockTelemetry } from './mock-data/loader';
 let mockTelemetry: TelemetryVarList | null = null;
 let MOCK_SESSION: string | null = null;
 
+const CAR_TABLE_MAX_CARS = 64;
+const CAR_TABLE_FLOAT_COLUMNS = [
+  'CarIdxLapDistPct', 'CarIdxLastLapTime', 'CarIdxBestLapTime', 'CarIdxEstTime', 'CarIdxF2Time',
+];
+const CAR_TABLE_INT_COLUMNS = [
+  'CarIdxLap', 'CarIdxLapCompleted', 'CarIdxPosition', 'CarIdxClassPosition', 'CarIdxOnPitRoad',
+  'CarIdxTrackSurface', 'CarNumberRaw', 'CarClassID', 'CarClassColor', 'IRating', 'CarIsPaceCar', 'IsSpectator',
+];
+const CAR_TABLE_STRING_COLUMNS = ['UserName', 'CarNumber', 'CarClassShortName'];
+
+function createEmptyCarTable(): CarTableView {
+  const names = [...CAR_TABLE_FLOAT_COLUMNS, ...CAR_TABLE_INT_COLUMNS, ...CAR_TABLE_STRING_COLUMNS];
+  const buffer = new ArrayBuffer(names.length * CAR_TABLE_MAX_CARS * 4);
+  const columns: Record<string, Int32Array | Float32Array> = {};
+  names.forEach((name, i) => {
+    const offset = i * CAR_TABLE_MAX_CARS * 4;
+    columns[name] = CAR_TABLE_FLOAT_COLUMNS.includes(name)
+      ? new Float32Array(buffer, offset, CAR_TABLE_MAX_CARS)
+      : new Int32Array(buffer, offset, CAR_TABLE_MAX_CARS);
+  });
+  CAR_TABLE_STRING_COLUMNS.forEach((name) => columns[name].fill(-1));
+  return {
+    buffer, columns: columns as unknown as CarTableColumns, strings: [], sessionVersion: -1,
+  };
+}
+
+const LAP_TIMING_MAX_SECTORS = 16;
+
+function createEmptyLapTiming(): LapTimingView {
+  const cars = CAR_TABLE_MAX_CARS;
+  const sectors = cars * LAP_TIMING_MAX_SECTORS;
+  const unknown = (length: number) => new Float32Array(length).fill(-1);
+  const sectorStartPct = unknown(LAP_TIMING_MAX_SECTORS);
+  sectorStartPct[0] = 0;
+  return {
+    buffer: new ArrayBuffer(0),
+    columns: {
+      currentLapTime: unknown(cars),
+      lastLapTime: unknown(cars),
+      bestLapTime: unknown(cars),
+      currentSector: new Int32Array(cars),
+      timedLaps: new Int32Array(cars),
+      currentSectorTimes: unknown(sectors),
+      lastSectorTimes: unknown(sectors),
+      bestSectorTimes: unknown(sectors),
+      sectorStartPct,
+      sectorCount: Int32Array.of(1),
+    },
+    maxCars: cars,
+    maxSectors: LAP_TIMING_MAX_SECTORS,
+  };
+}
+
+const SESSION_TABLES_MAX_SESSIONS = 8;
+
+// Typed arrays named after the keys of an interface, all zero
+function zeroColumns<T>(lengths: Record<string, number>, types: Record<string, Int32ArrayConstructor | Float32ArrayConstructor | Float64ArrayConstructor>): T {
+  const columns: Record<string, Int32Array | Float32Array | Float64Array> = {};
+  Object.entries(lengths).forEach(([name, length]) => {
+    columns[name] = new (types[name] ?? Int32Array)(length);
+  });
+  return columns as unknown as T;
+}
+
+function createEmptySessionTables(): SessionTablesView {
+  const driverNames = ['UserName', 'AbbrevName', 'Initials', 'UserID', 'TeamID', 'TeamName', 'CarNumber', 'CarNumberRaw', 'CarID', 'CarScreenName', 'CarScreenNameShort', 'CarClassID', 'CarClassShortName', 'CarClassColor', 'CarClassEstLapTime', 'IRating', 'LicLevel', 'LicSubLevel', 'LicString', 'LicColor', 'ClubName', 'DivisionName', 'FlairName', 'IsSpectator', 'CarIsPaceCar', 'CarIsAI', 'CurDriverIncidentCount', 'TeamIncidentCount'];
+  const driverStrings = ['UserName', 'AbbrevName', 'Initials', 'TeamName', 'CarNumber', 'CarScreenName', 'CarScreenNameShort', 'CarClassShortName', 'LicString', 'ClubName', 'DivisionName', 'FlairName'];
+  const resultNames = ['Time', 'FastestTime', 'LastTime', 'Position', 'ClassPosition', 'CarIdx', 'Lap', 'FastestLap', 'LapsLed', 'LapsComplete', 'JokerLapsComplete', 'LapsDriven', 'Incidents', 'ReasonOutId', 'ReasonOutStr'];
+  const rows = SESSION_TABLES_MAX_SESSIONS * CAR_TABLE_MAX_CARS;
+
+  const drivers = zeroColumns<SessionDriverColumns>(
+    Object.fromEntries(driverNames.map((name) => [name, CAR_TABLE_MAX_CARS])),
+    { CarClassEstLapTime: Float32Array },
+  );
+  driverStrings.forEach((name) => (drivers[name as keyof SessionDriverColumns] as Int32Array).fill(-1));
+
+  const results = zeroColumns<SessionResultColumns>(
+    { ...Object.fromEntries(resultNames.map((name) => [name, rows])), count: SESSION_TABLES_MAX_SESSIONS },
+    { Time: Float64Array, FastestTime: Float64Array, LastTime: Float64Array, LapsDriven: Float32Array },
+  );
+  results.CarIdx.fill(-1);
+  results.ReasonOutStr.fill(-1);
+
+  return {
+    drivers: { buffer: new ArrayBuffer(0), columns: drivers },
+    results: { buffer: new ArrayBuffer(0), columns: results },
+    strings: [],
+    maxCars: CAR_TABLE_MAX_CARS,
+    maxSessions: SESSION_TABLES_MAX_SESSIONS,
+    sessionVersion: -1,
+  };
+}
+
+const LAP_DELTA_RESOLUTION = 1000;
+
+function createEmptyLapDelta(): LapDeltaView {
+  return {
+    buffer: new ArrayBuffer(0),
+    columns: {
+      delta: new Float32Array(1),
+      deltaRate: new Float32Array(1),
+      predictedLapTime: Float32Array.of(-1),
+      currentLapTime: Float32Array.of(-1),
+      referenceLapTime: Float32Array.of(-1),
+      valid: new Int32Array(1),
+      reference: new Float32Array(LAP_DELTA_RESOLUTION + 1),
+    },
+    resolution: LAP_DELTA_RESOLUTION,
+  };
+}
+
 export class MockSDK implements INativeSDK {
   public currDataVersion: number;
 
@@ -15,6 +126,26 @@ export class MockSDK implements INativeSDK {
 
   private _isRunning: boolean;
 
+  private _carTable: CarTableView | null = null;
+
+  private _sessionTables: SessionTablesView | null = null;
+
+  private _lapTiming: LapTimingView | null = null;
+
+  private _lapDelta: LapDeltaView | null = null;
+
+  private _triggerIds: Set<number> = new Set();
+
+  private _nextTriggerId = 1;
+
+  private _historyIds: Set<number> = new Set();
+
+  private _nextHistoryId = 1;
+
+  private _encoderIds: Set<number> = new Set();
+
+  private _nextEncoderId = 1;
+
   constructor() {
     this.currDataVersion = 1;
     this.enableLogging = false;
@@ -57,11 +188,204 @@ export class MockSDK implements INativeSDK {
     return MOCK_SESSION ?? '';
   }
 
-  public getTelemetryData(): TelemetryVarList {
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public getTelemetryData(_reuse?: boolean): TelemetryVarList {
     // eslint-disable-next-line @typescript-eslint/no-non-null-assertion
     return mockTelemetry!;
   }
 
+  public getCarTable(): CarTableView {
+    if (!this._carTable) this._carTable = createEmptyCarTable();
+    return this._carTable;
+  }
+
+  public getSessionTables(): SessionTablesView {
+    if (!this._sessionTables) this._sessionTables = createEmptySessionTables();
+    return this._sessionTables;
+  }
+
+  public getLapTiming(): LapTimingView {
+    if (!this._lapTiming) this._lapTiming = createEmptyLapTiming();
+    return this._lapTiming;
+  }
+
+  public getLapDelta(): LapDeltaView {
+    if (!this._lapDelta) this._lapDelta = createEmptyLapDelta();
+    return this._lapDelta;
+  }
+
+  public getEvents(): SdkEvent[] {
+    return [];
+  }
+
+  // Recorded snapshots carry no sub tick rows
+  public getSubTickSamples(since = 0): SubTickSamples {
+    return { next: since, names: [], time: new Float64Array(0), values: {} };
+  }
+
+  // Mock data has no line buffer to evaluate against, so triggers never fire
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public addTrigger(_expression: string): number {
+    const id = this._nextTriggerId++;
+    this._triggerIds.add(id);
+    return id;
+  }
+
+  public removeTrigger(id: number): boolean {
+    return this._triggerIds.delete(id);
+  }
+
+  public clearTriggers(): void {
+    this._triggerIds.clear();
+  }
+
+  public getFiredTriggers(): number[] {
+    return [];
+  }
+
+  // Nothing is sampled from mock data, so channels stay empty
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public addHistoryChannel(_name: string, _index?: number, _capacity?: number): number {
+    const id = this._nextHistoryId++;
+    this._historyIds.add(id);
+    return id;
+  }
+
+  public removeHistoryChannel(id: number): boolean {
+    return this._historyIds.delete(id);
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public getHistory(
+    id: number,
+    _width: number,
+    _from?: number,
+    _to?: number
+  ): HistoryView | null {
+    if (!this._historyIds.has(id)) return null;
+    return {
+      length: 0,
+      first: 0,
+      step: 1,
+      min: new Float32Array(0),
+      max: new Float32Array(0),
+      mean: new Float32Array(0),
+    };
+  }
+
+  // Mock data is published over IPC as before
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public startFramePublisher(_name?: string): boolean {
+    return false;
+  }
+
+  public stopFramePublisher(): void {
+    // Never started
+  }
+
+  public getPublishedFrame(): number {
+    return 0;
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public startSharedFramePublisher(_view: Uint8Array): boolean {
+    return false;
+  }
+
+  public stopSharedFramePublisher(): void {
+    // Never started
+  }
+
+  // Mock data has no line buffer to encode, so encoders never produce output
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public createFrameEncoder(
+    _vars?: string[],
+    _changeBitmap?: boolean,
+    _quantization?: QuantizationProfile,
+    _bitPack?: boolean
+  ): number {
+    const id = this._nextEncoderId++;
+    this._encoderIds.add(id);
+    return id;
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public encodeFrame(_id: number, _keyframe?: boolean): ArrayBuffer | null {
+    return null;
+  }
+
+  public destroyFrameEncoder(id: number): boolean {
+    return this._encoderIds.delete(id);
+  }
+
+  // No lines to record either, callers fall back to their own recording
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public startRecording(_path: string): boolean {
+    return false;
+  }
+
+  public stopRecording(): boolean {
+    return false;
+  }
+
+  // The mock is never a replay
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public setReplaySpeed(_speed: number): boolean {
+    return false;
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public setReplayLoop(_loop: boolean): boolean {
+    return false;
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public seekReplay(_line: number): boolean {
+    return false;
+  }
+
+  public getReplayState(): ReplayState | null {
+    return null;
+  }
+
+  // Nothing native to trace
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public setTracing(_enabled: boolean): boolean {
+    return false;
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public dumpTrace(_clear?: boolean): string {
+    return '{"traceEvents":[]}';
+  }
+
+  // Nothing native to count
+  public getAllocationStats(): AllocationStats {
+    const counts = () => ({
+      nativeAllocs: 0, nativeFrees: 0, nativeBytes: 0, napiObjects: 0, napiArrays: 0, napiStrings: 0, napiBuffers: 0,
+    });
+    return { thread: counts(), process: counts(), native: false };
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public setLapDeltaCar(_carIdx: number): boolean {
+    return true;
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public saveReferenceLap(_path: string): boolean {
+    return false;
+  }
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public loadReferenceLap(_path: string): boolean {
+    return false;
+  }
+
+  public clearReferenceLap(): void {
+    // Nothing to clear
+  }
+
   public getTelemetryVariable<T extends boolean | number | string>(index: number): TelemetryVariable<T[]>;
 
   // eslint-disable-next-line @typescript-eslint/unified-signatures
@@ -110,3 +434,20 @@ export class MockSDK implements INativeSDK {
     console.log('Pretending to trigger SDK call:', ...args);
   }
 }
+
+// Mock data is always there, like getSimStatus() away from Windows
+export class MockConnectionWatcher implements INativeConnectionWatcher {
+  public state: ConnectionState = 'absent';
+
+  // eslint-disable-next-line @typescript-eslint/no-unused-vars
+  public start(callback: (state: ConnectionState) => void, _name?: string): boolean {
+    if (this.state !== 'absent') return false;
+    this.state = 'connected';
+    queueMicrotask(() => callback('connected'));
+    return true;
+  }
+
+  public stop(): void {
+    this.state = 'absent';
+  }
+}
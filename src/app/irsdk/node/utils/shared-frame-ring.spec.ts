@@ -0,0 +1,216 @@
+// @vitest-environment node
+import { readFileSync } from 'node:fs';
+import { Worker } from 'node:worker_threads';
+import ts from 'typescript';
+import { describe, it, expect } from 'vitest';
+import type { FrameVar } from '../../types';
+import { decodeTelemetryFrame } from './decode-frame';
+import { SharedFrameReader, SharedFrameWriter, sharedFrameRingByteLength } from './shared-frame-ring';
+
+const frameVar = (name: string, varType: number, offset: number, length = 1): FrameVar => ({
+  name,
+  description: `${name} description`,
+  unit: 'm/s',
+  countAsTime: false,
+  length,
+  varType,
+  offset,
+});
+
+describe('SharedFrameReader', () => {
+  it('should read the var table and each new frame once', () => {
+    const memory = new SharedArrayBuffer(sharedFrameRingByteLength(64));
+    const reader = new SharedFrameReader(memory);
+    expect(reader.isOpen()).toBe(false);
+    expect(reader.read()).toBeNull();
+
+    const writer = new SharedFrameWriter(memory);
+    const vars = [frameVar('SessionTime', 5, 0), frameVar('Speed', 4, 8), frameVar('CarIdxLap', 2, 12, 2)];
+    writer.setLayout(vars, 20);
+    expect(reader.read()).toBeNull();
+
+    const line = new DataView(new ArrayBuffer(20));
+    line.setFloat64(0, 12.5, true);
+    line.setFloat32(8, 41.25, true);
+    line.setInt32(12, 3, true);
+    line.setInt32(16, 4, true);
+    expect(writer.publish(new Uint8Array(line.buffer), 77)).toBe(1);
+
+    expect(reader.getVars()).toEqual(vars);
+    const frame = reader.read();
+    expect(frame).toMatchObject({ frame: 1, tickCount: 77 });
+    const telemetry = decodeTelemetryFrame(reader.getVars() ?? [], frame?.buffer ?? new ArrayBuffer(0));
+    expect(telemetry.SessionTime.value).toEqual([12.5]);
+    expect(telemetry.Speed.value).toEqual([41.25]);
+    expect(telemetry.Speed.unit).toBe('m/s');
+    expect(telemetry.CarIdxLap.value).toEqual([3, 4]);
+
+    expect(reader.read()).toBeNull();
+  });
+
+  it('should pick up a new layout with the first frame written with it', () => {
+    const memory = new SharedArrayBuffer(sharedFrameRingByteLength(64));
+    const writer = new SharedFrameWriter(memory);
+    const reader = new SharedFrameReader(memory);
+
+    writer.setLayout([frameVar('Gear', 2, 0)], 4);
+    writer.publish(new Uint8Array(4), 1);
+    expect(reader.read()?.buffer.byteLength).toBe(4);
+
+    writer.setLayout([frameVar('Gear', 2, 0), frameVar('RPM', 4, 4)], 8);
+    writer.publish(new Uint8Array(8), 2);
+    expect(reader.read()?.buffer.byteLength).toBe(8);
+    expect(reader.getVars()?.map((v) => v.name)).toEqual(['Gear', 'RPM']);
+  });
+
+  it('should not publish lines larger than a slot', () => {
+    const writer = new SharedFrameWriter(new SharedArrayBuffer(sharedFrameRingByteLength(64)));
+    expect(writer.publish(new Uint8Array(65), 1)).toBe(0);
+  });
+});
+
+// The module as compiled for the app, with the worker code after it so that
+// the worker can reach the ring's layout constants too
+const ringModule = () => {
+  const source = readFileSync(new URL('./shared-frame-ring.ts', import.meta.url), 'utf8');
+  return ts.transpileModule(source, {
+    compilerOptions: { target: ts.ScriptTarget.ES2022, module: ts.ModuleKind.ESNext },
+  }).outputText;
+};
+
+const runWorker = (code: string, workerData: unknown) =>
+  new Promise<Record<string, number>>((resolve, reject) => {
+    const worker = new Worker(new URL(`data:text/javascript,${encodeURIComponent(code)}`), { workerData });
+    worker.once('message', resolve);
+    worker.once('error', reject);
+  });
+
+// Publishes frame 1, then starts overwriting the slot readers take next the
+// way publish() does, and stops halfway through the copy until told to go on.
+// control[0] goes from 0 to 1 once paused, and 2 lets it finish.
+const pausedWriterWorker = `
+import { workerData, parentPort } from 'node:worker_threads';
+
+const { memory, control: controlBuffer } = workerData;
+const control = new Int32Array(controlBuffer);
+const words = 1024;
+
+const writer = new SharedFrameWriter(memory);
+writer.setLayout([{ name: 'Frame', description: '', unit: '', countAsTime: false, length: words, varType: 2, offset: 0 }], words * 4);
+writer.publish(new Uint8Array(new Int32Array(words).fill(1).buffer), 1);
+
+const h = new Int32Array(memory, 0, HEADER_BYTES / 4);
+const slotCapacity = h[H_SLOT_CAPACITY];
+const index = Atomics.load(h, H_LATEST);
+const slot = H_SLOTS + index * SLOT_INTS;
+const data = new Int32Array(memory, SLOTS_OFFSET + index * slotCapacity, words);
+const seq = Atomics.load(h, slot + S_SEQ);
+
+Atomics.store(h, slot + S_SEQ, seq + 1);
+data.fill(2, 0, words / 2);
+Atomics.store(control, 0, 1);
+Atomics.notify(control, 0);
+Atomics.wait(control, 0, 1);
+
+data.fill(2, words / 2);
+h[slot + S_FRAME] = 2;
+h[slot + S_TICK_COUNT] = 2;
+Atomics.store(h, slot + S_SEQ, seq + 2);
+Atomics.store(h, H_FRAME, 2);
+parentPort.postMessage({ published: 2 });
+`;
+
+describe('SharedFrameReader against a paused writer', () => {
+  it('should not hand out the slot the writer is in the middle of', async () => {
+    const memory = new SharedArrayBuffer(sharedFrameRingByteLength(4096));
+    const control = new Int32Array(new SharedArrayBuffer(4));
+    const writer = runWorker(`${ringModule()}\n${pausedWriterWorker}`, { memory, control: control.buffer });
+
+    const reader = new SharedFrameReader(memory);
+    try {
+      Atomics.wait(control, 0, 0, 5000);
+      expect(Atomics.load(control, 0)).toBe(1);
+      // Half of frame 2 over frame 1, in the only slot there is to take
+      expect(reader.read()).toBeNull();
+    } finally {
+      Atomics.store(control, 0, 2);
+      Atomics.notify(control, 0);
+    }
+    expect(await writer).toEqual({ published: 2 });
+
+    const frame = reader.read();
+    expect(frame).toMatchObject({ frame: 2, tickCount: 2 });
+    const words = new Int32Array(frame?.buffer ?? new ArrayBuffer(0));
+    expect(words.length).toBe(1024);
+    expect(words.every((word) => word === 2)).toBe(true);
+  }, 10000);
+});
+
+// A writer and several readers on threads of their own, as a stress check of
+// the whole protocol; the paused writer above covers a torn slot for certain.
+// Every line is filled with its frame number and the layout changes its length
+// now and then, so a bad read shows up as a word that isn't the frame number or
+// a line of the wrong length.
+const stressWorker = `
+import { workerData, parentPort } from 'node:worker_threads';
+
+const { role, memory, milliseconds } = workerData;
+const end = Date.now() + milliseconds;
+
+if (role === 'writer') {
+  const writer = new SharedFrameWriter(memory);
+  const layout = (words) => {
+    writer.setLayout([{ name: 'Frame', description: '', unit: '', countAsTime: false, length: words, varType: 2, offset: 0 }], words * 4);
+    return new Int32Array(words);
+  };
+  let line = layout(1024);
+  let frames = 0;
+  while (Date.now() < end) {
+    for (let i = 0; i < 1000; i++) {
+      line.fill(frames + 1);
+      writer.publish(new Uint8Array(line.buffer), frames + 1);
+      frames++;
+    }
+    if (frames % 20000 === 0) line = layout(line.length === 1024 ? 512 : 1024);
+  }
+  parentPort.postMessage({ frames });
+} else {
+  const reader = new SharedFrameReader(memory);
+  let reads = 0;
+  let bad = 0;
+  let last = 0;
+  while (Date.now() < end) {
+    const frame = reader.read();
+    if (!frame) continue;
+    reads++;
+    const words = new Int32Array(frame.buffer);
+    // Layouts switch every 20000 frames
+    const length = Math.floor((frame.frame - 1) / 20000) % 2 === 0 ? 1024 : 512;
+    let ok = frame.frame > last && frame.tickCount === frame.frame && words.length === length;
+    for (let i = 0; ok && i < words.length; i++) ok = words[i] === frame.frame;
+    if (!ok) bad++;
+    last = frame.frame;
+  }
+  parentPort.postMessage({ reads, bad });
+}
+`;
+
+describe('SharedFrameReader across threads', () => {
+  it('should only hand out whole frames to concurrent readers', async () => {
+    const code = `${ringModule()}\n${stressWorker}`;
+
+    const memory = new SharedArrayBuffer(sharedFrameRingByteLength(4096));
+    const milliseconds = 1000;
+    const readers = Array.from({ length: 4 }, () => runWorker(code, { role: 'reader', memory, milliseconds }));
+    const writer = runWorker(code, { role: 'writer', memory, milliseconds });
+
+    const results = await Promise.all(readers);
+    const { frames } = await writer;
+
+    expect(frames).toBeGreaterThan(0);
+    for (const { reads, bad } of results) {
+      expect(reads).toBeGreaterThan(0);
+      expect(bad).toBe(0);
+    }
+  }, 10000);
+});
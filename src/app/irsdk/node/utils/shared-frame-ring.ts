@@ -0,0 +1,264 @@
+import type { FrameVar, SharedFrame } from '../../types';
+
+// The frame ring of native/frame_ring.h laid out in a SharedArrayBuffer, for
+// worker threads of the process that runs the SDK. Keep the two in sync.
+//
+// Only type imports, so the module can be loaded into a worker as is.
+//
+// The seqlocks use Atomics for the counters and plain copies in between. That
+// relies on loads not being reordered with other loads, nor stores with other
+// stores, which holds on x64 where the sim runs.
+
+const MAGIC = 0x46524452; // "RDRF"
+const VERSION = 1;
+const SLOT_COUNT = 3;
+const MAX_VARS = 1024;
+const HEADER_BYTES = 160;
+const VAR_BYTES = 144;
+const SLOTS_OFFSET = HEADER_BYTES + MAX_VARS * VAR_BYTES;
+const MAX_READ_ATTEMPTS = 8;
+const IRSDK_MAX_STRING = 32;
+const IRSDK_MAX_DESC = 64;
+
+export const DEFAULT_SHARED_FRAME_SLOT_CAPACITY = 256 * 1024;
+
+// Int32 indices into FrameRingHeader
+const H_MAGIC = 0;
+const H_VERSION = 1;
+const H_SLOT_CAPACITY = 2;
+const H_MAX_VARS = 3;
+const H_LAYOUT_SEQ = 4;
+const H_VAR_COUNT = 5;
+const H_BUF_LEN = 6;
+const H_LATEST = 7;
+const H_FRAME = 8;
+const H_SLOTS = 16;
+const SLOT_INTS = 8;
+// ...and into each FrameRingSlot
+const S_SEQ = 0;
+const S_FRAME = 1;
+const S_LAYOUT = 2;
+const S_TICK_COUNT = 3;
+const S_LENGTH = 4;
+
+// irsdk_varHeader
+const V_TYPE = 0;
+const V_OFFSET = 4;
+const V_COUNT = 8;
+const V_COUNT_AS_TIME = 12;
+const V_NAME = 16;
+const V_DESC = 48;
+const V_UNIT = 112;
+
+/**
+ * Size of the buffer to allocate for slots of this many bytes each. A slot
+ * must hold a whole telemetry line.
+ */
+export function sharedFrameRingByteLength(slotCapacity = DEFAULT_SHARED_FRAME_SLOT_CAPACITY): number {
+  return SLOTS_OFFSET + SLOT_COUNT * slotCapacity;
+}
+
+const decoder = new TextDecoder();
+const encoder = new TextEncoder();
+
+const readString = (bytes: Uint8Array, offset: number, max: number) => {
+  let end = offset;
+  while (end < offset + max && bytes[end] !== 0) end++;
+  return decoder.decode(bytes.subarray(offset, end));
+};
+
+const writeString = (bytes: Uint8Array, offset: number, max: number, value: string) => {
+  // Always NUL terminated
+  encoder.encodeInto(value, bytes.subarray(offset, offset + max - 1));
+};
+
+/**
+ * Reads the frames `IRacingSDK.startSharedFramePublisher()` publishes, the same
+ * way `FrameReader` reads them from shared memory. Readers never block the
+ * writer; any number of them can read at once, one per thread.
+ */
+export class SharedFrameReader {
+  private readonly _memory: SharedArrayBuffer;
+  private readonly _header: Int32Array;
+  private _vars: FrameVar[] | null = null;
+  private _buffer = new ArrayBuffer(0);
+  // Odd, so the first read always refreshes the layout
+  private _layout = 1;
+  private _lastFrame = 0;
+
+  constructor(memory: SharedArrayBuffer) {
+    this._memory = memory;
+    this._header = new Int32Array(memory, 0, HEADER_BYTES / 4);
+  }
+
+  /** False until the publisher has formatted the buffer. */
+  public isOpen(): boolean {
+    const h = this._header;
+    if (Atomics.load(h, H_MAGIC) !== MAGIC || h[H_VERSION] !== VERSION) return false;
+    return this._memory.byteLength >= sharedFrameRingByteLength(h[H_SLOT_CAPACITY]);
+  }
+
+  public getVars(): FrameVar[] | null {
+    if (!this.isOpen()) return null;
+    if (this._layoutSeq() !== this._layout && !this._refreshLayout()) return null;
+    return this._vars;
+  }
+
+  /**
+   * Returns null when there is no frame newer than the last one read, or the
+   * writer kept overwriting it. The buffer is reused by the next read.
+   */
+  public read(): SharedFrame | null {
+    if (!this.isOpen()) return null;
+    const h = this._header;
+
+    const latest = Atomics.load(h, H_FRAME) >>> 0;
+    if (latest === 0 || latest === this._lastFrame) return null;
+
+    if (this._layoutSeq() !== this._layout && !this._refreshLayout()) return null;
+
+    const slotCapacity = h[H_SLOT_CAPACITY];
+    const out = new Uint8Array(this._buffer);
+    for (let attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+      const index = Atomics.load(h, H_LATEST);
+      if (index < 0) return null;
+
+      const slot = H_SLOTS + index * SLOT_INTS;
+      const before = Atomics.load(h, slot + S_SEQ);
+      if (before & 1) continue;
+
+      const length = h[slot + S_LENGTH];
+      if (length > slotCapacity) return null;
+      out.set(new Uint8Array(this._memory, SLOTS_OFFSET + index * slotCapacity, Math.min(length, out.length)));
+      const frame = h[slot + S_FRAME] >>> 0;
+      const layout = h[slot + S_LAYOUT] >>> 0;
+      const tickCount = h[slot + S_TICK_COUNT];
+
+      if (Atomics.load(h, slot + S_SEQ) !== before) continue;
+      // The writer points latest at the new slot before it bumps the frame
+      // count, so between the two the frame just read is still the latest
+      if (layout !== this._layout || frame === this._lastFrame) return null;
+
+      this._lastFrame = frame;
+      return { frame, layout, tickCount, buffer: this._buffer };
+    }
+    return null;
+  }
+
+  private _layoutSeq() {
+    return (Atomics.load(this._header, H_LAYOUT_SEQ) & ~1) >>> 0;
+  }
+
+  private _refreshLayout() {
+    const h = this._header;
+    for (let attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+      const before = Atomics.load(h, H_LAYOUT_SEQ);
+      if (before & 1) continue;
+
+      const count = Math.min(h[H_VAR_COUNT], MAX_VARS);
+      const bufLen = h[H_BUF_LEN];
+      // Decoded from a private copy, TextDecoder won't take shared memory
+      const table = new Uint8Array(count * VAR_BYTES);
+      table.set(new Uint8Array(this._memory, HEADER_BYTES, table.length));
+
+      if (Atomics.load(h, H_LAYOUT_SEQ) !== before) continue;
+
+      const view = new DataView(table.buffer);
+      const vars: FrameVar[] = new Array(count);
+      for (let i = 0; i < count; i++) {
+        const at = i * VAR_BYTES;
+        vars[i] = {
+          name: readString(table, at + V_NAME, IRSDK_MAX_STRING),
+          description: readString(table, at + V_DESC, IRSDK_MAX_DESC),
+          unit: readString(table, at + V_UNIT, IRSDK_MAX_STRING),
+          countAsTime: table[at + V_COUNT_AS_TIME] !== 0,
+          length: view.getInt32(at + V_COUNT, true),
+          varType: view.getInt32(at + V_TYPE, true),
+          offset: view.getInt32(at + V_OFFSET, true),
+        };
+      }
+
+      this._vars = vars;
+      this._buffer = new ArrayBuffer(Math.max(bufLen, 0));
+      this._layout = before >>> 0;
+      return true;
+    }
+    return false;
+  }
+}
+
+/**
+ * Publishes frames the way the native SDK does, for producers without it.
+ * There must be a single writer per buffer.
+ */
+export class SharedFrameWriter {
+  private readonly _memory: SharedArrayBuffer;
+  private readonly _header: Int32Array;
+  private readonly _slotCapacity: number;
+  private _frame = 0;
+
+  constructor(memory: SharedArrayBuffer) {
+    this._memory = memory;
+    this._header = new Int32Array(memory, 0, HEADER_BYTES / 4);
+    this._slotCapacity = Math.floor((memory.byteLength - SLOTS_OFFSET) / SLOT_COUNT / 8) * 8;
+    if (this._slotCapacity <= 0) throw new RangeError('Shared frame buffer too small');
+
+    const h = this._header;
+    h[H_SLOT_CAPACITY] = this._slotCapacity;
+    h[H_MAX_VARS] = MAX_VARS;
+    Atomics.store(h, H_LATEST, -1);
+    h[H_VERSION] = VERSION;
+    // Readers check the magic last
+    Atomics.store(h, H_MAGIC, MAGIC);
+  }
+
+  public setLayout(vars: FrameVar[], bufLen: number): void {
+    const h = this._header;
+    const count = Math.min(vars.length, MAX_VARS);
+    const seq = Atomics.load(h, H_LAYOUT_SEQ);
+    Atomics.store(h, H_LAYOUT_SEQ, seq + 1);
+
+    const table = new Uint8Array(count * VAR_BYTES);
+    const view = new DataView(table.buffer);
+    for (let i = 0; i < count; i++) {
+      const v = vars[i];
+      const at = i * VAR_BYTES;
+      view.setInt32(at + V_TYPE, v.varType, true);
+      view.setInt32(at + V_OFFSET, v.offset, true);
+      view.setInt32(at + V_COUNT, v.length, true);
+      table[at + V_COUNT_AS_TIME] = v.countAsTime ? 1 : 0;
+      writeString(table, at + V_NAME, IRSDK_MAX_STRING, v.name);
+      writeString(table, at + V_DESC, IRSDK_MAX_DESC, v.description);
+      writeString(table, at + V_UNIT, IRSDK_MAX_STRING, v.unit);
+    }
+    new Uint8Array(this._memory, HEADER_BYTES, table.length).set(table);
+    h[H_VAR_COUNT] = count;
+    h[H_BUF_LEN] = bufLen;
+
+    Atomics.store(h, H_LAYOUT_SEQ, seq + 2);
+  }
+
+  /** Returns the frame number, 0 when the line doesn't fit a slot. */
+  public publish(line: Uint8Array, tickCount: number): number {
+    if (line.length > this._slotCapacity) return 0;
+    const h = this._header;
+
+    // Never touch the slot readers are most likely copying
+    const index = (Atomics.load(h, H_LATEST) + 1) % SLOT_COUNT;
+    const slot = H_SLOTS + index * SLOT_INTS;
+    const seq = Atomics.load(h, slot + S_SEQ);
+    Atomics.store(h, slot + S_SEQ, seq + 1);
+
+    new Uint8Array(this._memory, SLOTS_OFFSET + index * this._slotCapacity, line.length).set(line);
+    this._frame = (this._frame + 1) >>> 0;
+    h[slot + S_FRAME] = this._frame;
+    h[slot + S_LAYOUT] = Atomics.load(h, H_LAYOUT_SEQ);
+    h[slot + S_TICK_COUNT] = tickCount;
+    h[slot + S_LENGTH] = line.length;
+
+    Atomics.store(h, slot + S_SEQ, seq + 2);
+    Atomics.store(h, H_LATEST, index);
+    Atomics.store(h, H_FRAME, this._frame);
+    return this._frame;
+  }
+}
@@ -0,0 +1,25 @@
+/** Allocation counters since the process started, see `getAllocationStats()`. */
+export interface AllocationCounts {
+  /** C++ heap allocations made by the addon, 0 unless `native` is set. */
+  nativeAllocs: number;
+  nativeFrees: number;
+  nativeBytes: number;
+  /** N-API values the addon created, numbers and booleans aside. */
+  napiObjects: number;
+  napiArrays: number;
+  napiStrings: number;
+  /** ArrayBuffers and typed arrays. */
+  napiBuffers: number;
+}
+
+export interface AllocationStats {
+  /** The thread that asked, i.e. the one calling the SDK. */
+  thread: AllocationCounts;
+  /** Every thread, the session worker included. */
+  process: AllocationCounts;
+  /**
+   * Whether native allocations are counted. Only in addons built with
+   * IRSDK_ALLOC_STATS=1 set, the counting allocator stays out of releases.
+   */
+  native: boolean;
+}
@@ -0,0 +1,47 @@
+/** Per-car telemetry columns, refreshed every tick. Indexed by CarIdx. */
+export interface CarTableTelemetryColumns {
+  CarIdxLap: Int32Array;
+  CarIdxLapCompleted: Int32Array;
+  CarIdxLapDistPct: Float32Array;
+  CarIdxPosition: Int32Array;
+  CarIdxClassPosition: Int32Array;
+  /** 0 or 1 */
+  CarIdxOnPitRoad: Int32Array;
+  CarIdxTrackSurface: Int32Array;
+  CarIdxLastLapTime: Float32Array;
+  CarIdxBestLapTime: Float32Array;
+  CarIdxEstTime: Float32Array;
+  CarIdxF2Time: Float32Array;
+}
+
+/**
+ * Per-car DriverInfo columns, refreshed when the session info changes.
+ * String columns hold an index into `CarTableView.strings`, or -1 when the slot is empty.
+ */
+export interface CarTableSessionColumns {
+  UserName: Int32Array;
+  CarNumber: Int32Array;
+  CarNumberRaw: Int32Array;
+  CarClassID: Int32Array;
+  CarClassShortName: Int32Array;
+  CarClassColor: Int32Array;
+  IRating: Int32Array;
+  CarIsPaceCar: Int32Array;
+  IsSpectator: Int32Array;
+}
+
+export type CarTableColumns = CarTableTelemetryColumns & CarTableSessionColumns;
+
+/**
+ * Struct-of-arrays table joining the CarIdx telemetry arrays with DriverInfo:Drivers.
+ * The same object (and the same buffer) is returned on every call and updated in place.
+ */
+export interface CarTableView {
+  /** Backing storage shared by every column. */
+  buffer: ArrayBuffer;
+  columns: CarTableColumns;
+  /** Interned strings referenced by the string columns. Only ever grows. */
+  strings: string[];
+  /** Session info version the session columns were built from. */
+  sessionVersion: number;
+}
@@ -0,0 +1,6 @@
+/**
+ * Where the sim is at, as the native `ConnectionWatcher` reports it:
+ * `absent` while it isn't running, `waiting` while it runs without writing
+ * telemetry (e.g. in the menus) and `connected` while it does.
+ */
+export type ConnectionState = 'absent' | 'waiting' | 'connected';
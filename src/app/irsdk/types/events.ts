@@ -0,0 +1,32 @@
+/** Matches `DetectedEventType` in the native event detector. */
+export enum SdkEventType {
+  /** `SessionFlags` changed, values are `GlobalFlags` bits. */
+  SessionFlags = 0,
+  /** `SessionState` changed, values are `SessionState`. */
+  SessionState,
+  /** `CarIdxTrackSurface` changed, values are `TrackLocation`. */
+  TrackSurface,
+  /** Car entered (1) or left (0) pit road. */
+  PitRoad,
+  /** `CarIdxLapCompleted` changed. */
+  LapCompleted,
+  /** The player's incident count changed. */
+  Incidents,
+  /** `PlayerCarPitSvStatus` changed, values are `PitSvStatus`. */
+  PitServiceStatus,
+  /** Requested pit service changed, values are `PitSvFlags` bits. */
+  PitServiceFlags,
+}
+
+/**
+ * A change of a watched telemetry variable between two consecutive ticks.
+ */
+export interface SdkEvent {
+  type: SdkEventType;
+  /** -1 for session wide events. */
+  carIdx: number;
+  /** SessionTime of the tick the change was seen on. */
+  sessionTime: number;
+  oldValue: number;
+  newValue: number;
+}
@@ -0,0 +1,36 @@
+/**
+ * A variable of a frame published to shared memory, as described by the sim's var header.
+ */
+export interface FrameVar {
+  name: string;
+  description: string;
+  unit: string;
+  countAsTime: boolean;
+  length: number;
+  /** irsdk_VarType: 0 char, 1 bool, 2 int, 3 bitfield, 4 float, 5 double. */
+  varType: number;
+  /** Byte offset into the frame buffer. */
+  offset: number;
+}
+
+/**
+ * A raw telemetry line read back from shared memory. The buffer is reused by the
+ * next read, so decode it straight away.
+ */
+export interface SharedFrame {
+  frame: number;
+  /** Changes whenever the var table does, e.g. on a new connection. */
+  layout: number;
+  tickCount: number;
+  buffer: ArrayBuffer;
+}
+
+/**
+ * A telemetry line read back from a recording, see `RecordingReader`.
+ */
+export interface RecordedFrame {
+  /** Changes whenever the var table does, call getVars() again. */
+  layout: number;
+  tickCount: number;
+  buffer: ArrayBuffer;
+}
@@ -0,0 +1,17 @@
+/**
+ * A range of a history channel at the resolution asked for, see
+ * `IRacingSDK.getHistory`. Bucket `i` covers samples
+ * `[first + i * step, first + (i + 1) * step)`.
+ */
+export interface HistoryView {
+  /** Samples recorded so far. */
+  length: number;
+  /** Sample index of the first bucket, may be before the range asked for. */
+  first: number;
+  /** Samples per bucket, a power of two. */
+  step: number;
+  /** NaN for buckets without a value, e.g. while the var isn't in the session. */
+  min: Float32Array;
+  max: Float32Array;
+  mean: Float32Array;
+}
@@ -1,10 +1,22 @@
 export * from './enums';
 export * from './camera-info';
+export * from './car-table';
+export * from './session-tables';
 export * from './driver-info';
+export * from './lap-timing';
+export * from './lap-delta';
+export * from './events';
+export * from './history';
+export * from './sub-tick';
+export * from './frame';
+export * from './quantization';
 export * from './radio-info';
 export * from './session-info';
 export * from './setup-info';
 export * from './split-info';
 export * from './weekend-info';
 export * from './session-yaml';
+export * from './sdk-source';
+export * from './connection-state';
+export * from './allocation-stats';
 export * from './_GENERATED_telemetry';
@@ -0,0 +1,27 @@
+export interface LapDeltaColumns {
+  /** Seconds ahead (negative) or behind (positive) the reference lap at the current position. Single element. */
+  delta: Float32Array;
+  /** Smoothed change of `delta` per second, negative while gaining time. Single element. */
+  deltaRate: Float32Array;
+  /** Reference lap time plus the current delta, -1 when there is nothing to compare against. Single element. */
+  predictedLapTime: Float32Array;
+  /** Elapsed time of the lap in progress, -1 until the car has crossed the line. Single element. */
+  currentLapTime: Float32Array;
+  /** -1 without a reference lap. Single element. */
+  referenceLapTime: Float32Array;
+  /** 1 while delta and predictedLapTime are meaningful. Single element. */
+  valid: Int32Array;
+  /** Elapsed time at LapDistPct `i / resolution`, the last entry is the lap time itself. */
+  reference: Float32Array;
+}
+
+/**
+ * Live delta of one car (the player's by default) to the best lap seen so far, or
+ * one loaded from disk. Computed natively every tick; the same object is returned on
+ * every call and updated in place. All times are in seconds.
+ */
+export interface LapDeltaView {
+  buffer: ArrayBuffer;
+  columns: LapDeltaColumns;
+  resolution: number;
+}
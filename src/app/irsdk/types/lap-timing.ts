@@ -0,0 +1,29 @@
+export interface LapTimingColumns {
+  /** Elapsed time of the lap in progress, -1 until the car has crossed the line. Indexed by CarIdx. */
+  currentLapTime: Float32Array;
+  lastLapTime: Float32Array;
+  bestLapTime: Float32Array;
+  currentSector: Int32Array;
+  /** Number of fully observed laps. */
+  timedLaps: Int32Array;
+  /** Flattened as `[carIdx * maxSectors + sectorNum]`, -1 when unknown. */
+  currentSectorTimes: Float32Array;
+  lastSectorTimes: Float32Array;
+  bestSectorTimes: Float32Array;
+  /** SplitTimeInfo sector boundaries, -1 past `sectorCount`. */
+  sectorStartPct: Float32Array;
+  /** Single element. */
+  sectorCount: Int32Array;
+}
+
+/**
+ * Lap and sector times for every car, computed natively from CarIdxLapDistPct and
+ * interpolated between ticks. The same object is returned on every call and updated in place.
+ * All times are in seconds.
+ */
+export interface LapTimingView {
+  buffer: ArrayBuffer;
+  columns: LapTimingColumns;
+  maxCars: number;
+  maxSectors: number;
+}
@@ -0,0 +1,34 @@
+/**
+ * How coarsely a float var may be streamed: values are rounded to a multiple
+ * of `precision` above `min` and clamped to `max`.
+ */
+export interface VarQuantization {
+  precision: number;
+  min: number;
+  max: number;
+}
+
+/** Quantization by var name, see `IRacingSDK.createFrameEncoder`. */
+export type QuantizationProfile = Record<string, VarQuantization>;
+
+/**
+ * Precision the overlays actually need for the high rate channels.
+ */
+export const OVERLAY_QUANTIZATION: QuantizationProfile = {
+  // -1 while a car isn't in the world
+  LapDistPct: { precision: 1e-5, min: -1, max: 1 },
+  CarIdxLapDistPct: { precision: 1e-5, min: -1, max: 1 },
+  Throttle: { precision: 1e-3, min: 0, max: 1 },
+  ThrottleRaw: { precision: 1e-3, min: 0, max: 1 },
+  Brake: { precision: 1e-3, min: 0, max: 1 },
+  BrakeRaw: { precision: 1e-3, min: 0, max: 1 },
+  Clutch: { precision: 1e-3, min: 0, max: 1 },
+  FuelLevelPct: { precision: 1e-4, min: 0, max: 1 },
+  SteeringWheelAngle: { precision: 1e-3, min: -20, max: 20 },
+  Speed: { precision: 0.01, min: 0, max: 150 },
+  RPM: { precision: 1, min: 0, max: 25000 },
+  WaterTemp: { precision: 0.1, min: -50, max: 250 },
+  OilTemp: { precision: 0.1, min: -50, max: 250 },
+  AirTemp: { precision: 0.1, min: -50, max: 100 },
+  TrackTempCrew: { precision: 0.1, min: -50, max: 100 },
+};
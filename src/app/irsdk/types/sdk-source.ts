@@ -0,0 +1,43 @@
+/**
+ * Where a native SDK instance reads its lines from. Every instance has a source of its own,
+ * so several can run side by side, e.g. one reading the sim while another replays a file.
+ */
+export type SdkSource =
+  | {
+      source?: 'live';
+      /** Another mapping laid out like the sim's, such as the one irsdk_sim_producer writes. */
+      name?: string;
+    }
+  | {
+      source: 'file';
+      /** A telemetry file (.ibt) written by the sim, read one line per `waitForData()`. */
+      path: string;
+    }
+  | {
+      source: 'replay';
+      /** A telemetry file (.ibt) or a file written by `startRecording()`. */
+      path: string;
+      /** Multiple of real time the lines are paced at, 0 for as fast as they can be read. @default 1 */
+      speed?: number;
+      /** Start over at the end, with tick counts carrying on. @default false */
+      loop?: boolean;
+    }
+  | {
+      source: 'simulated';
+      /** @default 60 */
+      tickRate?: number;
+      /** Hand out lines at the tick rate like the sim, otherwise one on every wait. @default true */
+      paced?: boolean;
+    };
+
+/** Where a `replay` source is at. */
+export interface ReplayState {
+  /** Index of the line handed out last, -1 before the first. */
+  line: number;
+  lineCount: number;
+  speed: number;
+  loop: boolean;
+  /** Lines skipped because the consumer fell behind the pacing, like with the sim. */
+  dropped: number;
+  loops: number;
+}
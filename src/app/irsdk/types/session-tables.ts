@@ -0,0 +1,77 @@
+/**
+ * DriverInfo:Drivers columns, indexed by CarIdx.
+ * String columns hold an index into `SessionTablesView.strings`, or -1 when unset or the slot is empty.
+ */
+export interface SessionDriverColumns {
+  UserName: Int32Array;
+  AbbrevName: Int32Array;
+  Initials: Int32Array;
+  UserID: Int32Array;
+  TeamID: Int32Array;
+  TeamName: Int32Array;
+  CarNumber: Int32Array;
+  CarNumberRaw: Int32Array;
+  CarID: Int32Array;
+  CarScreenName: Int32Array;
+  CarScreenNameShort: Int32Array;
+  CarClassID: Int32Array;
+  CarClassShortName: Int32Array;
+  CarClassColor: Int32Array;
+  CarClassEstLapTime: Float32Array;
+  IRating: Int32Array;
+  LicLevel: Int32Array;
+  LicSubLevel: Int32Array;
+  LicString: Int32Array;
+  LicColor: Int32Array;
+  ClubName: Int32Array;
+  DivisionName: Int32Array;
+  FlairName: Int32Array;
+  /** 0 or 1 */
+  IsSpectator: Int32Array;
+  /** 0 or 1 */
+  CarIsPaceCar: Int32Array;
+  /** 0 or 1 */
+  CarIsAI: Int32Array;
+  CurDriverIncidentCount: Int32Array;
+  TeamIncidentCount: Int32Array;
+}
+
+/**
+ * SessionInfo:Sessions:ResultsPositions of every session, flattened as
+ * `[sessionNum * maxCars + position - 1]`. Empty rows have a CarIdx of -1.
+ */
+export interface SessionResultColumns {
+  Time: Float64Array;
+  FastestTime: Float64Array;
+  LastTime: Float64Array;
+  Position: Int32Array;
+  ClassPosition: Int32Array;
+  CarIdx: Int32Array;
+  Lap: Int32Array;
+  FastestLap: Int32Array;
+  LapsLed: Int32Array;
+  LapsComplete: Int32Array;
+  JokerLapsComplete: Int32Array;
+  LapsDriven: Float32Array;
+  Incidents: Int32Array;
+  ReasonOutId: Int32Array;
+  ReasonOutStr: Int32Array;
+  /** Rows of each session, indexed by SessionNum. */
+  count: Int32Array;
+}
+
+/**
+ * Typed tables of the driver list and the results of every session, extracted natively.
+ * Each section is only re-parsed when its text changed. The same object (and the same
+ * buffers) is returned on every call and updated in place.
+ */
+export interface SessionTablesView {
+  drivers: { buffer: ArrayBuffer; columns: SessionDriverColumns };
+  results: { buffer: ArrayBuffer; columns: SessionResultColumns };
+  /** Interned strings referenced by the string columns. Only ever grows. */
+  strings: string[];
+  maxCars: number;
+  maxSessions: number;
+  /** Session info version the tables were built from. */
+  sessionVersion: number;
+}
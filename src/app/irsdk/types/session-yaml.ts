@@ -21,3 +21,22 @@ export interface SessionData {
   CarSetup: CarSetupInfo;
   QualifyResultsInfo?: { Results: SessionResultsPosition[] };
 }
+
+/**
+ * A session info update converted to JSON by the addon's worker thread,
+ * see `IRacingSDK.getSessionData`.
+ */
+export interface ParsedSession {
+  /** The sim's session info update counter it was read at. */
+  version: number;
+  json: string;
+}
+
+/**
+ * Keys of one map in the native session index, see `IRacingSDK.getSessionView`.
+ */
+export interface SessionKeys {
+  keys: string[];
+  /** Whether the value of each key is a map itself. */
+  maps: boolean[];
+}
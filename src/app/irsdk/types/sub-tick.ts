@@ -0,0 +1,14 @@
+/**
+ * Rows of the flattened sub tick (`*_ST`) vars, e.g. 360Hz steering angle
+ * and torque, see `IRacingSDK.getSubTickSamples`.
+ */
+export interface SubTickSamples {
+  /** Pass back in to get the rows after these. */
+  next: number;
+  /** The `*_ST` vars of the session. */
+  names: string[];
+  /** SessionTime of each row. */
+  time: Float64Array;
+  /** A column per var, one value per row. */
+  values: Record<string, Float32Array>;
+}
@@ -69,6 +69,10 @@ export class OverlayManager {
       roundedCorners: false,
       webPreferences: {
         preload: path.join(__dirname, 'preload.js'),
+        // The preload maps the shared memory telemetry frames through the
+        // native addon. Only the preload gets Node, the page itself stays
+        // context isolated without node integration.
+        sandbox: false,
       },
     });
 
@@ -159,6 +163,8 @@ export class OverlayManager {
       height: 700,
       autoHideMenuBar: true,
       webPreferences: {
+        // Settings shows no telemetry, so its preload keeps the sandbox and
+        // never loads the shared frame reader
         preload: path.join(__dirname, 'preload.js'),
       },
     });
@@ -42,7 +42,7 @@ const App = () => (
   <DashboardProvider bridge={window.dashboardBridge}>
     <RunningStateProvider bridge={window.irsdkBridge}>
       <SessionProvider bridge={window.irsdkBridge} />
-      <TelemetryProvider bridge={window.irsdkBridge} />
+      <TelemetryProvider bridge={window.irsdkBridge} hotVars />
       <HashRouter>
         <EditMode>
           <ThemeManager>
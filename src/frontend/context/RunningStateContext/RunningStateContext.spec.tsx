@@ -9,6 +9,8 @@ describe('RunningStateContext', () => {
     onRunningState: vi.fn(),
     onSessionData: vi.fn(),
     onTelemetry: vi.fn(),
+    onEvents: vi.fn(),
+    onSubTickSamples: vi.fn(),
     stop: vi.fn(),
   };
 
@@ -1,29 +1,38 @@
 import type { IrSdkBridge } from '@irdashies/types';
 import { useTelemetryStore } from './TelemetryStore';
+import { HotTelemetryTracker } from './hotTelemetry';
 import { useEffect } from 'react';
 
 export interface TelemetryProviderProps {
   bridge: IrSdkBridge | Promise<IrSdkBridge>;
+  /** Only have the vars the widgets read shipped with every frame, see `HotTelemetryTracker`. */
+  hotVars?: boolean;
 }
 
-export const TelemetryProvider = ({ bridge }: TelemetryProviderProps) => {
+export const TelemetryProvider = ({ bridge, hotVars = false }: TelemetryProviderProps) => {
   const setTelemetry = useTelemetryStore((state) => state.setTelemetry);
 
   useEffect(() => {
-    if (bridge instanceof Promise) {
-      bridge.then((bridge) => {
-        bridge.onTelemetry((telemetry) => {
-          setTelemetry(telemetry);
-        });
+    const subscribe = (bridge: IrSdkBridge) => {
+      const { setHotTelemetryVars, readTelemetryVar } = bridge;
+      const tracker =
+        hotVars && setHotTelemetryVars && readTelemetryVar
+          ? new HotTelemetryTracker({ setHotTelemetryVars, readTelemetryVar })
+          : null;
+
+      bridge.onTelemetry((telemetry) => {
+        setTelemetry(tracker ? tracker.view(telemetry) : telemetry);
       });
+    };
+
+    if (bridge instanceof Promise) {
+      bridge.then(subscribe);
       return () => bridge.then((bridge) => bridge.stop());
     }
 
-    bridge.onTelemetry((telemetry) => {
-      setTelemetry(telemetry);
-    });
+    subscribe(bridge);
     return () => bridge.stop();
-  }, [bridge, setTelemetry]);
+  }, [bridge, hotVars, setTelemetry]);
 
   return <></>;
 };
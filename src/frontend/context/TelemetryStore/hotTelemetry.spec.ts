@@ -0,0 +1,70 @@
+import { describe, it, expect, vi } from 'vitest';
+import type { Telemetry } from '@irdashies/types';
+import { HotTelemetryTracker } from './hotTelemetry';
+
+const frame = (vars: Record<string, number>) =>
+  Object.fromEntries(Object.entries(vars).map(([name, value]) => [name, { name, value: [value] }])) as unknown as Telemetry;
+
+const createBridge = () => ({
+  setHotTelemetryVars: vi.fn(),
+  readTelemetryVar: vi.fn((name: string) => (name === 'RPM' ? ({ name, value: [9000] } as never) : null)),
+});
+
+describe('HotTelemetryTracker', () => {
+  it('should ship every var until the first window passed, then only the vars read', () => {
+    const bridge = createBridge();
+    const tracker = new HotTelemetryTracker(bridge, { window: 4, relearnEvery: 4 });
+
+    for (let i = 0; i < 3; i++) {
+      expect(tracker.view(frame({ Speed: i, Gear: 3 })).Speed.value).toEqual([i]);
+    }
+    expect(tracker.hotVars).toBeNull();
+    expect(bridge.setHotTelemetryVars).toHaveBeenCalledTimes(0);
+
+    tracker.view(frame({ Speed: 3, Gear: 3 }));
+    expect(bridge.setHotTelemetryVars).toHaveBeenCalledWith(['Speed']);
+    expect([...(tracker.hotVars ?? [])]).toEqual(['Speed']);
+  });
+
+  it('should fetch a var left out of the frame and ship it from then on', () => {
+    const bridge = createBridge();
+    const tracker = new HotTelemetryTracker(bridge, { window: 2, relearnEvery: 2 });
+    void tracker.view(frame({ Speed: 1 })).Speed;
+    void tracker.view(frame({ Speed: 2 })).Speed;
+
+    const view = tracker.view(frame({ Speed: 3 }));
+    expect(view.Speed.value).toEqual([3]);
+    expect(view.RPM.value).toEqual([9000]);
+    expect(view.RPM.value).toEqual([9000]);
+    expect(bridge.readTelemetryVar).toHaveBeenCalledTimes(1);
+
+    tracker.view(frame({ Speed: 4, RPM: 9100 }));
+    expect(bridge.setHotTelemetryVars).toHaveBeenLastCalledWith(['Speed', 'RPM']);
+  });
+
+  it('should not fetch names that are not vars every frame', () => {
+    const bridge = createBridge();
+    const tracker = new HotTelemetryTracker(bridge, { window: 100, relearnEvery: 100 });
+
+    for (let i = 0; i < 5; i++) {
+      expect(tracker.view(frame({ Speed: i })).Missing).toBeUndefined();
+    }
+    expect(bridge.readTelemetryVar).toHaveBeenCalledTimes(1);
+  });
+
+  it('should drop vars nobody read for a window', () => {
+    const bridge = createBridge();
+    const tracker = new HotTelemetryTracker(bridge, { window: 3, relearnEvery: 3 });
+
+    for (let i = 0; i < 3; i++) {
+      const view = tracker.view(frame({ Speed: i, Gear: 3 }));
+      void view.Speed;
+      void view.Gear;
+    }
+    for (let i = 0; i < 6; i++) {
+      void tracker.view(frame({ Speed: i, Gear: 3 })).Speed;
+    }
+
+    expect(bridge.setHotTelemetryVars).toHaveBeenLastCalledWith(['Speed']);
+  });
+});
@@ -0,0 +1,104 @@
+import type { IrSdkBridge, Telemetry } from '@irdashies/types';
+
+type HotTelemetryBridge = Required<Pick<IrSdkBridge, 'setHotTelemetryVars' | 'readTelemetryVar'>>;
+
+export interface HotTelemetryOptions {
+  /** Frames a var stays hot after it was last read. */
+  window?: number;
+  /** Frames between re-learning the hot set, which is when cold vars drop out. */
+  relearnEvery?: number;
+}
+
+/**
+ * Learns which telemetry vars the overlay actually reads and asks the bridge to
+ * only ship those. Every frame is handed out through an instrumented view that
+ * stamps the vars read from it, and fetches a var the frame left out from the
+ * bridge, which makes it hot right away. Vars nobody read for `window` frames
+ * drop out on the next re-learn, so the payload follows the enabled widgets.
+ */
+export class HotTelemetryTracker {
+  private readonly window: number;
+  private readonly relearnEvery: number;
+  private frame = 0;
+  private lastRead = new Map<string, number>();
+  // Null while learning, every var is shipped until the first window passed
+  private hot: Set<string> | null = null;
+  private dirty = false;
+  // Names read that are not vars at all, so they aren't fetched every frame
+  private unknown = new Set<string>();
+  private readonly handler: ProxyHandler<Telemetry>;
+
+  constructor(
+    private readonly bridge: HotTelemetryBridge,
+    { window = 600, relearnEvery = 300 }: HotTelemetryOptions = {}
+  ) {
+    this.window = window;
+    this.relearnEvery = relearnEvery;
+    this.handler = {
+      get: (target, key) => {
+        if (typeof key !== 'string' || key in Object.prototype) return Reflect.get(target, key);
+
+        const value = target[key as keyof Telemetry];
+        if (value !== undefined) {
+          this.lastRead.set(key, this.frame);
+          return value;
+        }
+        return this.readCold(target, key);
+      },
+    };
+  }
+
+  /**
+   * Wraps the next frame.
+   */
+  view(telemetry: Telemetry): Telemetry {
+    this.frame++;
+    if (this.frame % this.relearnEvery === 0 && this.frame >= this.window) {
+      this.relearn();
+    }
+    if (this.dirty) {
+      this.dirty = false;
+      this.bridge.setHotTelemetryVars(this.hot ? [...this.hot] : null);
+    }
+    return new Proxy(telemetry, this.handler);
+  }
+
+  /** The vars shipped with every frame, null while every var is. */
+  get hotVars(): ReadonlySet<string> | null {
+    return this.hot;
+  }
+
+  private readCold(target: Telemetry, key: string) {
+    if (this.unknown.has(key)) return undefined;
+
+    const value = this.bridge.readTelemetryVar(key);
+    if (!value) {
+      this.unknown.add(key);
+      return undefined;
+    }
+
+    // Keep it for the other readers of this frame and ship it from the next one
+    (target as Record<string, unknown>)[key] = value;
+    this.lastRead.set(key, this.frame);
+    if (this.hot && !this.hot.has(key)) {
+      this.hot.add(key);
+      this.dirty = true;
+    }
+    return value;
+  }
+
+  private relearn() {
+    const hot = new Set<string>();
+    this.lastRead.forEach((frame, key) => {
+      if (this.frame - frame < this.window) hot.add(key);
+      else this.lastRead.delete(key);
+    });
+    this.unknown.clear();
+
+    if (this.hot && hot.size === this.hot.size && [...hot].every((key) => this.hot?.has(key))) {
+      return;
+    }
+    this.hot = hot;
+    this.dirty = true;
+  }
+}
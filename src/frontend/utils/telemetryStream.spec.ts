@@ -0,0 +1,172 @@
+import { describe, it, expect } from 'vitest';
+import { TelemetryStreamDecoder } from './telemetryStream';
+
+// Builds records the way frame_encoder.cc does
+class Writer {
+  private bytes: number[] = [];
+
+  u8(v: number) {
+    this.bytes.push(v & 0xff);
+    return this;
+  }
+
+  u16(v: number) {
+    return this.u8(v).u8(v >> 8);
+  }
+
+  i32(v: number) {
+    return this.u16(v).u16(v >> 16);
+  }
+
+  f32(v: number) {
+    const b = new DataView(new ArrayBuffer(4));
+    b.setFloat32(0, v, true);
+    for (let i = 0; i < 4; i++) this.u8(b.getUint8(i));
+    return this;
+  }
+
+  f64(v: number) {
+    const b = new DataView(new ArrayBuffer(8));
+    b.setFloat64(0, v, true);
+    for (let i = 0; i < 8; i++) this.u8(b.getUint8(i));
+    return this;
+  }
+
+  // LSB first, padded to a byte
+  codes(codes: [number, number][]) {
+    let acc = 0n;
+    let n = 0n;
+    codes.forEach(([code, bits]) => {
+      acc |= BigInt(code) << n;
+      n += BigInt(bits);
+    });
+    for (let i = 0n; i < n; i += 8n) this.u8(Number((acc >> i) & 0xffn));
+    return this;
+  }
+
+  str(s: string) {
+    for (const c of s) this.u8(c.charCodeAt(0));
+    return this;
+  }
+
+  record() {
+    const length = this.bytes.length;
+    return new Uint8Array([length & 0xff, (length >> 8) & 0xff, 0, 0, ...this.bytes]);
+  }
+}
+
+const schema = (schemaId: number, vars: [number, number, number, string][]) => {
+  const w = new Writer().u8(0x53).u8(1).u16(schemaId).u16(vars.length).u16(0);
+  vars.forEach(([id, type, count, name]) => w.u16(id).u8(type).u8(name.length).u16(count).str(name));
+  return w.record();
+};
+
+const concat = (...parts: Uint8Array[]) => {
+  const out = new Uint8Array(parts.reduce((n, p) => n + p.length, 0));
+  let at = 0;
+  parts.forEach((p) => {
+    out.set(p, at);
+    at += p.length;
+  });
+  return out;
+};
+
+describe('TelemetryStreamDecoder', () => {
+  const vars: [number, number, number, string][] = [
+    [0, 5, 1, 'SessionTime'],
+    [4, 2, 1, 'Gear'],
+    [7, 4, 1, 'Speed'],
+    [9, 1, 3, 'CarIdxOnPitRoad'],
+  ];
+
+  const fullFrame = (tick: number, gear: number, speed: number) =>
+    new Writer().u8(0x46).u8(0).u16(1).i32(tick).f64(12.5).i32(gear).f32(speed).u8(1).u8(0).u8(1).record();
+
+  it('should decode the schema and a full frame', () => {
+    const decoder = new TelemetryStreamDecoder();
+    const frames = decoder.push(concat(schema(1, vars), fullFrame(100, -1, 44.25)));
+
+    expect(decoder.vars.map((v) => v.name)).toEqual(['SessionTime', 'Gear', 'Speed', 'CarIdxOnPitRoad']);
+    expect(decoder.vars[2]).toEqual({ id: 7, type: 4, count: 1, name: 'Speed', bits: 0, min: 0, step: 0 });
+    expect(frames).toHaveLength(1);
+    expect(frames[0].tickCount).toBe(100);
+    expect(frames[0].values).toEqual({
+      SessionTime: [12.5],
+      Gear: [-1],
+      Speed: [44.25],
+      CarIdxOnPitRoad: [true, false, true],
+    });
+    expect(frames[0].changed).toHaveLength(4);
+  });
+
+  it('should keep unchanged values across change bitmap frames', () => {
+    const decoder = new TelemetryStreamDecoder();
+    decoder.push(concat(schema(1, vars), fullFrame(100, 3, 44.25)));
+
+    // Only Gear (bit 1) and Speed (bit 2) changed
+    const delta = new Writer().u8(0x46).u8(1).u16(1).i32(101).u8(0b0110).i32(4).f32(50.5).record();
+    const [frame] = decoder.push(delta);
+
+    expect(frame.changed).toEqual(['Gear', 'Speed']);
+    expect(frame.values.Gear).toEqual([4]);
+    expect(frame.values.Speed).toEqual([50.5]);
+    expect(frame.values.SessionTime).toEqual([12.5]);
+  });
+
+  it('should reassemble records split across chunks', () => {
+    const decoder = new TelemetryStreamDecoder();
+    const stream = concat(schema(1, vars), fullFrame(100, 2, 1), fullFrame(101, 3, 2));
+
+    const frames = [
+      ...decoder.push(stream.slice(0, 7)),
+      ...decoder.push(stream.slice(7, 60)),
+      ...decoder.push(stream.slice(60)),
+    ];
+
+    expect(frames.map((f) => f.tickCount)).toEqual([100, 101]);
+    expect(frames[1].values.Gear).toEqual([3]);
+  });
+
+  it('should ignore frames of an old schema', () => {
+    const decoder = new TelemetryStreamDecoder();
+    decoder.push(schema(2, [[3, 2, 1, 'Lap']]));
+
+    expect(decoder.push(fullFrame(100, 2, 1))).toEqual([]);
+
+    const [frame] = decoder.push(new Writer().u8(0x46).u8(0).u16(2).i32(5).i32(7).record());
+    expect(frame.values).toEqual({ Lap: [7] });
+  });
+
+  it('should restore quantized values from the bit stream', () => {
+    const decoder = new TelemetryStreamDecoder();
+    const w = new Writer().u8(0x53).u8(1).u16(3).u16(3).u16(1);
+    w.u16(4).u8(2).u8(4).u16(1).str('Gear').u8(0);
+    w.u16(5).u8(4).u8(8).u16(1).str('Throttle').u8(10).f64(0).f64(0.001);
+    w.u16(6).u8(4).u8(16).u16(2).str('CarIdxLapDistPct').u8(18).f64(-1).f64(0.00001);
+    decoder.push(w.record());
+
+    expect(decoder.vars[1]).toEqual({ id: 5, type: 4, count: 1, name: 'Throttle', bits: 10, min: 0, step: 0.001 });
+
+    const frame = new Writer().u8(0x46).u8(0).u16(3).i32(9).i32(4).codes([
+      [500, 10],
+      [150000, 18],
+      [2 ** 18 - 1, 18],
+    ]);
+    const [decoded] = decoder.push(frame.record());
+
+    expect(decoded.values.Gear).toEqual([4]);
+    expect(decoded.values.Throttle[0]).toBeCloseTo(0.5, 6);
+    expect(decoded.values.CarIdxLapDistPct[0]).toBeCloseTo(0.5, 6);
+    expect(decoded.values.CarIdxLapDistPct[1]).toBeNaN();
+
+    // Only the lap position changed
+    const delta = new Writer().u8(0x46).u8(1).u16(3).i32(10).u8(0b100).codes([
+      [100000, 18],
+      [0, 18],
+    ]);
+    const [next] = decoder.push(delta.record());
+    expect(next.changed).toEqual(['CarIdxLapDistPct']);
+    expect(next.values.CarIdxLapDistPct[1]).toBeCloseTo(-1, 6);
+    expect(next.values.Throttle[0]).toBeCloseTo(0.5, 6);
+  });
+});
@@ -0,0 +1,207 @@
+/**
+ * Reference decoder for the binary telemetry stream the widget server sends
+ * (see `frame_encoder.h` for the byte layout). The var names and types arrive
+ * once in a schema record, after that each frame is just packed values,
+ * optionally only the ones that changed.
+ */
+
+const SCHEMA_RECORD = 0x53; // 'S'
+const FRAME_RECORD = 0x46; // 'F'
+const FLAG_CHANGE_BITMAP = 1;
+const SCHEMA_FLAG_QUANTIZED = 1;
+
+// irsdk_VarType: char, bool, int, bitfield, float, double
+const VAR_TYPE_BYTES = [1, 1, 4, 4, 4, 8];
+
+export interface TelemetryStreamVar {
+  /** Index of the var in the sim's var table. */
+  id: number;
+  name: string;
+  /** irsdk_VarType: 0 char, 1 bool, 2 int, 3 bitfield, 4 float, 5 double. */
+  type: number;
+  count: number;
+  /** Width of the fixed point codes of a quantized var, 0 for raw values. */
+  bits: number;
+  /** value = min + code * step, the all ones code is NaN. */
+  min: number;
+  step: number;
+}
+
+export type TelemetryStreamValues = Record<string, (number | boolean)[]>;
+
+export interface TelemetryStreamFrame {
+  tickCount: number;
+  /** Every var of the schema; unchanged ones keep their last value. Reused by the next frame. */
+  values: TelemetryStreamValues;
+  /** Names of the vars this frame carried. */
+  changed: string[];
+}
+
+export class TelemetryStreamDecoder {
+  public vars: TelemetryStreamVar[] = [];
+
+  private _schemaId = -1;
+  private _values: TelemetryStreamValues = {};
+  private _pending = new Uint8Array(0);
+
+  /**
+   * Feed the next chunk of the stream, which may end mid record.
+   * @returns The frames completed by this chunk, oldest first.
+   */
+  public push(chunk: ArrayBuffer | Uint8Array): TelemetryStreamFrame[] {
+    const bytes = chunk instanceof Uint8Array ? chunk : new Uint8Array(chunk);
+    let buffer = bytes;
+    if (this._pending.length) {
+      buffer = new Uint8Array(this._pending.length + bytes.length);
+      buffer.set(this._pending);
+      buffer.set(bytes, this._pending.length);
+    }
+
+    const view = new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+    const frames: TelemetryStreamFrame[] = [];
+    let at = 0;
+    while (at + 4 <= buffer.length) {
+      const length = view.getUint32(at, true);
+      if (at + 4 + length > buffer.length) break;
+      const frame = this.decodeRecord(new DataView(buffer.buffer, buffer.byteOffset + at + 4, length));
+      if (frame) frames.push(frame);
+      at += 4 + length;
+    }
+
+    this._pending = buffer.slice(at);
+    return frames;
+  }
+
+  private decodeRecord(view: DataView): TelemetryStreamFrame | null {
+    const kind = view.getUint8(0);
+    if (kind === SCHEMA_RECORD) {
+      this.decodeSchema(view);
+      return null;
+    }
+    if (kind === FRAME_RECORD && view.getUint16(2, true) === this._schemaId) {
+      return this.decodeFrame(view);
+    }
+    return null;
+  }
+
+  private decodeSchema(view: DataView) {
+    const count = view.getUint16(4, true);
+    const quantized = (view.getUint16(6, true) & SCHEMA_FLAG_QUANTIZED) !== 0;
+    const decoder = new TextDecoder();
+    let at = 8;
+
+    this._schemaId = view.getUint16(2, true);
+    this.vars = [];
+    this._values = {};
+    for (let i = 0; i < count; i++) {
+      const nameLength = view.getUint8(at + 3);
+      const name = decoder.decode(new Uint8Array(view.buffer, view.byteOffset + at + 6, nameLength));
+      const v = { id: view.getUint16(at, true), type: view.getUint8(at + 2), count: view.getUint16(at + 4, true), name, bits: 0, min: 0, step: 0 };
+      at += 6 + nameLength;
+      if (quantized) {
+        v.bits = view.getUint8(at++);
+        if (v.bits) {
+          v.min = view.getFloat64(at, true);
+          v.step = view.getFloat64(at + 8, true);
+          at += 16;
+        }
+      }
+      this.vars.push(v);
+      this._values[name] = new Array(v.count);
+    }
+  }
+
+  private decodeFrame(view: DataView): TelemetryStreamFrame {
+    const flags = view.getUint8(1);
+    const bitmapAt = 8;
+    let at = flags & FLAG_CHANGE_BITMAP ? bitmapAt + Math.ceil(this.vars.length / 8) : bitmapAt;
+    const changed: string[] = [];
+    const quantized: TelemetryStreamVar[] = [];
+
+    this.vars.forEach((v, i) => {
+      if (flags & FLAG_CHANGE_BITMAP && !(view.getUint8(bitmapAt + (i >> 3)) & (1 << (i & 7)))) return;
+      changed.push(v.name);
+
+      // Their codes follow the raw values
+      if (v.bits) {
+        quantized.push(v);
+        return;
+      }
+
+      const value = this._values[v.name];
+      const size = VAR_TYPE_BYTES[v.type];
+      for (let n = 0; n < v.count; n++) {
+        value[n] = readValue(view, v.type, at + n * size);
+      }
+      at += v.count * size;
+    });
+
+    let bit = at * 8;
+    quantized.forEach((v) => {
+      const value = this._values[v.name];
+      const nan = 2 ** v.bits - 1;
+      for (let n = 0; n < v.count; n++) {
+        const code = readBits(view, bit, v.bits);
+        value[n] = code === nan ? NaN : v.min + code * v.step;
+        bit += v.bits;
+      }
+    });
+
+    return { tickCount: view.getInt32(4, true), values: this._values, changed };
+  }
+}
+
+function readValue(view: DataView, type: number, at: number): number | boolean {
+  switch (type) {
+    case 0: // char
+      return view.getUint8(at);
+    case 1: // bool
+      return view.getUint8(at) !== 0;
+    case 2: // int
+    case 3: // bitfield
+      return view.getInt32(at, true);
+    case 4: // float
+      return view.getFloat32(at, true);
+    default: // double
+      return view.getFloat64(at, true);
+  }
+}
+
+// Reads an LSB first code of up to 32 bits
+function readBits(view: DataView, bit: number, bits: number): number {
+  let code = 0;
+  let scale = 1;
+  while (bits > 0) {
+    const shift = bit & 7;
+    const take = Math.min(8 - shift, bits);
+    const chunk = (view.getUint8(bit >> 3) >> shift) & ((1 << take) - 1);
+    code += chunk * scale;
+    scale *= 2 ** take;
+    bit += take;
+    bits -= take;
+  }
+  return code;
+}
+
+/**
+ * Stream telemetry from the widget server until the signal aborts.
+ * @param url e.g. `/telemetry/stream?vars=Speed,Gear&changes=1`
+ */
+export async function streamTelemetry(
+  url: string,
+  onFrame: (frame: TelemetryStreamFrame) => void,
+  signal?: AbortSignal
+): Promise<void> {
+  const response = await fetch(url, { signal });
+  if (!response.ok || !response.body) {
+    throw new Error(`Telemetry stream failed: ${response.status}`);
+  }
+
+  const decoder = new TelemetryStreamDecoder();
+  const reader = response.body.getReader();
+  for (;;) {
+    const { done, value } = await reader.read();
+    if (done) return;
+    decoder.push(value).forEach(onFrame);
+  }
+}
@@ -1,8 +1,15 @@
-import type { Session, Telemetry } from '@irdashies/types';
+import type { Session, SubTickSamples, Telemetry, TelemetryEvent } from '@irdashies/types';
 
 export interface IrSdkBridge {
   onTelemetry: (callback: (value: Telemetry) => void) => void;
   onSessionData: (callback: (value: Session) => void) => void;
   onRunningState: (callback: (value: boolean) => void) => void;
+  onEvents: (callback: (value: TelemetryEvent[]) => void) => void;
+  /** Full rate rows of the `*_ST` vars, pushed once per processed line. */
+  onSubTickSamples: (callback: (value: SubTickSamples) => void) => void;
+  /** Only ship these vars with each telemetry frame, every var when null. */
+  setHotTelemetryVars?: (names: string[] | null) => void;
+  /** Reads a var the last telemetry frame left out, null when there is no such var. */
+  readTelemetryVar?: (name: string) => Telemetry[keyof Telemetry] | null;
   stop: () => void;
 }
@@ -1,4 +1,6 @@
-import type { TelemetryVariable, TelemetryVarList } from '../app/irsdk/types';
+import type { SdkEvent, TelemetryVariable, TelemetryVarList } from '../app/irsdk/types';
 
 export type Telemetry = TelemetryVarList;
 export type TelemetryVar<T extends number[] | boolean[]> = TelemetryVariable<T>;
+export type TelemetryEvent = SdkEvent;
+export type { SubTickSamples } from '../app/irsdk/types';
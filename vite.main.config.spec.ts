@@ -0,0 +1,26 @@
+import { describe, it, expect, afterEach } from 'vitest';
+import { irsdkNativeModule, nativeModuleExports } from './vite.main.config';
+
+const platform = Object.getOwnPropertyDescriptor(process, 'platform');
+
+describe('irsdkNativeModule', () => {
+  afterEach(() => {
+    if (platform) Object.defineProperty(process, 'platform', platform);
+  });
+
+  it('finds every class native/index.js reads off the addon', () => {
+    expect(nativeModuleExports()).toEqual(
+      expect.arrayContaining(['iRacingSdkNode', 'FrameReader', 'RecordingReader', 'ConnectionWatcher'])
+    );
+  });
+
+  it('re-exports all of them from the packaged module', () => {
+    Object.defineProperty(process, 'platform', { value: 'win32' });
+    const plugin = irsdkNativeModule(['build/Release/irsdk_node.node'], '.vite/build/Release/');
+    const code = plugin.transform('', '/some/where/irsdk_node.node') as string;
+
+    for (const name of nativeModuleExports()) {
+      expect(code).toContain(`export const ${name} = native.${name};`);
+    }
+  });
+});
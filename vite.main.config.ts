@@ -30,9 +30,25 @@ export default defineConfig({
   },
 });
 
+// Names native/index.js reads off the addon, e.g. ConnectionWatcher
+export function nativeModuleExports(
+  indexFile = path.join(__dirname, 'src/app/irsdk/native/index.js')
+): string[] {
+  // Commented out requires don't count
+  const source = fs.readFileSync(indexFile, 'utf8').replace(/\/\/.*$/gm, '');
+  const names = [
+    ...source.matchAll(/require\(['"][^'"]*irsdk_node\.node['"]\)\.(\w+)/g),
+  ].map((match) => match[1]);
+  if (!names.length) {
+    throw new Error(`No irsdk_node.node exports found in ${indexFile}`);
+  }
+  return [...new Set(names)];
+}
+
 // this handles the native module for irsdk-node so vite can bundle it as its currently cjs only
 // this plugin will import it using createRequire and copy the native module to the vite build directory
-function irsdkNativeModule(nodeFiles: string[], outDir: string) {
+// the preload build uses it too, for the shared memory frame reader
+export function irsdkNativeModule(nodeFiles: string[], outDir: string) {
   const nodeFileMap = new Map(
     nodeFiles.map((file) => [path.basename(file), file])
   );
@@ -49,10 +65,17 @@ function irsdkNativeModule(nodeFiles: string[], outDir: string) {
       }
       const file = nodeFileMap.get(path.basename(id));
       if (file) {
+        // Everything native/index.js takes off the addon, so a new class
+        // can't go missing from the packaged build
+        const names = nativeModuleExports();
         return `
           import { createRequire } from 'module';
           const customRequire = createRequire(import.meta.url);
-          export const iRacingSdkNode = customRequire('./${file}').iRacingSdkNode;
+          const native = customRequire('./${file}');
+          for (const name of ${JSON.stringify(names)}) {
+            if (!native[name]) throw new Error('irsdk_node.node has no ' + name + ' export');
+          }
+          ${names.map((name) => `export const ${name} = native.${name};`).join('\n          ')}
         `;
       }
       return code;
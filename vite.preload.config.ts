@@ -1,4 +1,12 @@
 import { defineConfig } from 'vite';
+import { irsdkNativeModule } from './vite.main.config';
 
 // https://vitejs.dev/config
-export default defineConfig({});
+export default defineConfig({
+  plugins: [
+    irsdkNativeModule(
+      ['build/Release/irsdk_node.node'],
+      '.vite/build/Release/'
+    ),
+  ],
+});